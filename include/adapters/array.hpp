@@ -1,7 +1,13 @@
 #ifndef DATA_ADAPTER_ARRAY_HPP_INCLUDED
 #define DATA_ADAPTER_ARRAY_HPP_INCLUDED
 
+#include <vector>
+
 #include "../data_adapter.hpp"
+#include "../detail/contiguous_iterator.hpp"
+#include "../detail/radix_sort.hpp"
+#include "../detail/simd.hpp"
+#include "../detail/storage.hpp"
 
 /**
  *              Notes on the implementation of this:
@@ -13,7 +19,7 @@
  * custom implementations. For example, copy, copy_backwards and fill.
  *
  *      Secondly, it was my own principle that the internal members
- * (like used_length, data, and data_size) should never be accessed directly unless
+ * (like used_length, storage, and data_size) should never be accessed directly unless
  * absolutely needed to (like in resize, length, capacity, and at). Since many of
  * those are inlined, there is no performance loss, but it does make things more clear
  * and easy to change if need be.
@@ -28,11 +34,29 @@
  * 'boumd' to their parent containers and should the container be destroyed or resized smaller than the
  * current position the iterator points to, dereferencing the iterator will results in undefined behavior.
  *
- *      Other than that, the iterators are not invalidated when the container changes, since all they store
- * is an offset to the position in the container. Pretty simple stuff.
+ *      Other than that, the iterators are not invalidated when the container changes, since the storage
+ * never moves. They are plain element pointers underneath (see detail/contiguous_iterator.hpp), and all the
+ * shifting and filling done here works on data() directly, so std::copy, std::copy_backward and std::fill
+ * get raw pointers and can turn into memmove/memset or vectorized loops.
+ *
+ *      Finally, the storage is raw memory (see detail/storage.hpp), not a T[N]. Only the elements in
+ * [0, length()) are ever constructed, with placement new, and they are destroyed as soon as they fall
+ * off the end. So constructing or clearing an adapter costs O(length()), not O(N), and nothing at all
+ * for trivially destructible types, and T doesn't have to be default constructible unless something
+ * like resize( n ) or popping an empty adapter needs a default value. With DATA_ADAPTER_DYNAMIC_DISPATCH
+ * those are virtual and always instantiated, so there it does have to be.
  *
+ *      Anything that shifts elements up does it the way std::vector does, constructing into the unused
+ * slots and assigning over the used ones, so used_length always covers exactly what is alive.
+ * secure_clear() is there for when the old bytes have to be wiped too.
  */
 
+namespace da {
+    //Reads a snapshot straight into the unused storage, see io/snapshot.hpp
+    template <typename T, size_t N>
+    void load( DataAdapter<T[N]> &a, const char *path );
+}
+
 template <typename T, size_t N>
 class DataAdapter<T[N]> : public DataAdapterBase<T[N], T, DataAdapter<T[N]> > {
     public:
@@ -49,44 +73,425 @@ class DataAdapter<T[N]> : public DataAdapterBase<T[N], T, DataAdapter<T[N]> > {
         typedef typename _Base::const_reverse_iterator  const_reverse_iterator;
 
     private:
-        value_type data;
+        template <typename U, size_t M> friend void da::load( DataAdapter<U[M]> &, const char * );
+
+        da::detail::raw_storage<T, N> storage;
         static size_type data_size;
         size_type used_length;
 
-    public:
-        DataAdapter() {
-            this->clear();
+        //Destroys everything from n on
+        void truncate( size_type n ) {
+            element_type *d = this->data();
+
+            da::detail::destroy( d + n, d + this->length() );
+
+            this->used_length = n;
+        }
+
+        /*
+            Inserts one element at off, which must be at most length() with room to spare.
+            Like std::vector, the last element is moved into the first unused slot and the rest are moved up by
+            assignment, so no slot is ever left unconstructed if something throws halfway through.
+        */
+        template <typename V>
+        element_type *insert_one( size_type off, V &val ) {
+            size_type len = this->length();
+
+            element_type *d = this->data();
+
+            if ( off < len ) {
+                DATA_ADAPTER_STAT_ADD( shifted, len - off )
+
+                element_type *last = d + len - 1;
+
+                ::new( static_cast<void *>( last + 1 ) ) element_type( DATA_ADAPTER_MOVE( *last ) );
+
+                ++this->used_length;
+
+                //A plain loop, since GCC warns about move_backward here (-Warray-bounds) when it could be empty
+                for ( element_type *p = last; p != d + off; --p ) {
+                    *p = DATA_ADAPTER_MOVE( *( p - 1 ) );
+                }
+
+                d[off] = DATA_ADAPTER_MOVE( val );
+
+            } else {
+                ::new( static_cast<void *>( d + len ) ) element_type( DATA_ADAPTER_MOVE( val ) );
+
+                ++this->used_length;
+            }
+
+            return d + off;
+        }
+
+        /*
+            Inserts [first, last), which is n elements, at off, the same way. The tail moves into unused slots as far as it reaches
+            past the old end, and anything of the new elements that lands past the old end is constructed there,
+            so used_length always covers exactly the constructed slots.
+        */
+        template <typename _ForwardIterator>
+        element_type *insert_n( size_type off, _ForwardIterator first, _ForwardIterator last, size_type n ) {
+            size_type len = this->length();
+            size_type after = len - off;
+
+            element_type *d = this->data();
+
+            DATA_ADAPTER_STAT_ADD( shifted, after )
+
+            if ( after > n ) {
+                DATA_ADAPTER_UNINITIALIZED_MOVE( d + len - n, d + len, d + len );
+                this->used_length = len + n;
+
+                DATA_ADAPTER_MOVE_BACKWARD( d + off, d + len - n, d + len );
+
+                std::copy( first, last, d + off );
+
+            } else {
+                _ForwardIterator mid = first;
+                std::advance( mid, after );
+
+                std::uninitialized_copy( mid, last, d + len );
+                this->used_length = off + n;
+
+                DATA_ADAPTER_UNINITIALIZED_MOVE( d + off, d + len, d + off + n );
+                this->used_length = len + n;
+
+                std::copy( first, mid, d + off );
+            }
+
+            return d + off;
+        }
+
+        //Fill version of insert_n
+        element_type *insert_fill_n( size_type off, size_type n, const element_type &val ) {
+            size_type len = this->length();
+            size_type after = len - off;
+
+            element_type *d = this->data();
+
+            DATA_ADAPTER_STAT_ADD( shifted, after )
+            DATA_ADAPTER_STAT_ADD( filled, n )
+
+            if ( after > n ) {
+                DATA_ADAPTER_UNINITIALIZED_MOVE( d + len - n, d + len, d + len );
+                this->used_length = len + n;
+
+                DATA_ADAPTER_MOVE_BACKWARD( d + off, d + len - n, d + len );
+
+                std::fill( d + off, d + off + n, val );
+
+            } else {
+                std::uninitialized_fill( d + len, d + off + n, val );
+                this->used_length = off + n;
+
+                DATA_ADAPTER_UNINITIALIZED_MOVE( d + off, d + len, d + off + n );
+                this->used_length = len + n;
+
+                std::fill( d + off, d + len, val );
+            }
+
+            return d + off;
+        }
+
+        //Closes [f, l) by moving the tail down, then destroys what is left over at the end
+        void close_gap( size_type f, size_type l ) {
+            size_type len = this->length();
+
+            element_type *d = this->data();
+
+            DATA_ADAPTER_STAT_ADD( shifted, len - l )
+
+            DATA_ADAPTER_MOVE_RANGE( d + l, d + len, d + f );
+
+            this->truncate( len - ( l - f ) );
+        }
+
+        /*
+            The range versions of insert and assign, by what they are given. Forward ranges are counted first, so
+            there is one bounds check, one shift and one copy. Input ranges can only be read once, so their elements
+            are constructed at the end as they come, where nothing has to move, and rotated into place at the end.
+        */
+        template <typename _Integer>
+        iterator insert_range( iterator pos, _Integer n, _Integer val, da::detail::integral_range_tag ) {
+            return this->insert( pos, static_cast<size_type>( n ), static_cast<element_type>( val ) );
+        }
+
+        template <typename _ForwardIterator>
+        iterator insert_range( iterator pos, _ForwardIterator first, _ForwardIterator last, std::forward_iterator_tag ) {
+            DATA_ADAPTER_STAT_SCOPE( insert_range )
+
+            size_type off = pos.offset();
+            size_type n = std::distance( first, last );
+
+            if ( n == 0 ) {
+                return this->end();
+            }
+
+            if ( off > this->length() || this->length() + n > this->capacity() ) {
+                DATA_ADAPTER_STAT_ADD( thrown, 1 )
+                throw std::out_of_range( "DataAdapter::insert(range): Out of Range" );
+            }
+
+            //Shifting would move our own elements around under first and last
+            if ( da::detail::points_into( first, this->data(), this->data() + this->length() ) ) {
+                std::vector<element_type> tmp( first, last );
+
+                this->insert_n( off, tmp.begin(), tmp.end(), n );
+
+            } else {
+                this->insert_n( off, first, last, n );
+            }
+
+            return this->begin() + off;
         }
 
-        DataAdapter( size_type n, const element_type &val = element_type( 0x0 ) ) {
-            this->clear();
+        template <typename _InputIterator>
+        iterator insert_range( iterator pos, _InputIterator first, _InputIterator last, std::input_iterator_tag ) {
+            DATA_ADAPTER_STAT_SCOPE( insert_range )
+
+            size_type off = pos.offset();
+            size_type len = this->length();
+
+            if ( off > len ) {
+                DATA_ADAPTER_STAT_ADD( thrown, 1 )
+                throw std::out_of_range( "DataAdapter::insert(range): Out of Range" );
+            }
+
+            try {
+                for ( ; first != last; ++first ) {
+                    if ( this->full() ) {
+                        DATA_ADAPTER_STAT_ADD( thrown, 1 )
+                        throw std::out_of_range( "DataAdapter::insert(range): Out of Range" );
+                    }
+
+                    ::new( static_cast<void *>( this->data() + this->used_length ) ) element_type( *first );
+                    ++this->used_length;
+                }
+
+            } catch ( ... ) {
+                this->truncate( len );
+                throw;
+            }
+
+            element_type *d = this->data();
+
+            DATA_ADAPTER_STAT_ADD( shifted, len - off )
+
+            std::rotate( d + off, d + len, d + this->used_length );
+
+            return this->begin() + off;
+        }
+
+        template <typename _Integer>
+        void assign_range( _Integer n, _Integer val, da::detail::integral_range_tag ) {
+            this->assign( static_cast<size_type>( n ), static_cast<element_type>( val ) );
+        }
+
+        template <typename _ForwardIterator>
+        void assign_range( _ForwardIterator first, _ForwardIterator last, std::forward_iterator_tag ) {
+            size_type n = std::distance( first, last );
+
+            if ( n <= this->capacity() ) {
+                size_type len = this->length();
+
+                if ( n <= len ) {
+                    std::copy( first, last, this->data() );
+                    this->truncate( n );
+
+                } else {
+                    _ForwardIterator mid = first;
+                    std::advance( mid, len );
+
+                    std::copy( first, mid, this->data() );
+                    std::uninitialized_copy( mid, last, this->data() + len );
+                    this->used_length = n;
+                }
+
+            } else {
+                DATA_ADAPTER_STAT_ADD( thrown, 1 )
+                throw std::out_of_range( "DataAdapter::assign: Out of Range" );
+            }
+        }
+
+        //Whatever was read before a range that turns out too long is left
+        template <typename _InputIterator>
+        void assign_range( _InputIterator first, _InputIterator last, std::input_iterator_tag ) {
+            this->truncate( 0 );
+            this->insert_range( this->begin(), first, last, std::input_iterator_tag() );
+        }
+
+        /*
+            Merges the sorted elements of [first, last) into the sorted contents, which must have room for them
+            after length(). This goes backward from the end, so each element is moved once, straight into its
+            final slot, which is constructed if it is past the old end and assigned otherwise.
+            On ties the new element goes after the existing ones, like upper_bound.
+            Returns the position of the first of the new elements.
+        */
+        template <typename _BidirectionalIterator>
+        iterator merge_back( _BidirectionalIterator first, _BidirectionalIterator last ) {
+            element_type *d = this->data();
+
+            size_type len = this->length();
+            size_type i = len;
+            size_type w = i + std::distance( first, last );
+            size_type n = w;
+
+            //Slots from here to n have been constructed, and are destroyed again if anything throws
+            size_type built = n;
+
+            try {
+                while ( last != first ) {
+                    --last;
+
+                    while ( i != 0 && *last < d[i - 1] ) {
+                        if ( --w >= len ) {
+                            ::new( static_cast<void *>( d + w ) ) element_type( DATA_ADAPTER_MOVE( d[--i] ) );
+                            built = w;
+
+                        } else {
+                            d[w] = DATA_ADAPTER_MOVE( d[--i] );
+                        }
+                    }
+
+                    if ( --w >= len ) {
+                        ::new( static_cast<void *>( d + w ) ) element_type( DATA_ADAPTER_MOVE( *last ) );
+                        built = w;
+
+                    } else {
+                        d[w] = DATA_ADAPTER_MOVE( *last );
+                    }
+                }
+
+            } catch ( ... ) {
+                da::detail::destroy( d + built, d + n );
+                throw;
+            }
+
+            //Every slot from the old end on has been constructed by now, since w stopped at i, which is at most len
+            this->used_length = n;
+
+            DATA_ADAPTER_STAT_ADD( shifted, len - i )
+
+            return this->begin() + w;
+        }
+
+    public:
+        DataAdapter() : used_length( 0 ) {}
+
+        DataAdapter( size_type n, const element_type &val = element_type() ) : used_length( 0 ) {
             this->insert( this->begin(), n, val );
         }
 
-        explicit DataAdapter( const value_type &val ) {
+        explicit DataAdapter( const value_type &val ) : used_length( 0 ) {
             this->assign( val, val + N );
         }
 
-        DataAdapter( const DataAdapter &a ) {
-            this->clear();
-            this->resize( a.length() );
-            std::copy( a.begin(), a.end(), this->begin() );
+        DataAdapter( const DataAdapter &a ) : used_length( 0 ) {
+            std::uninitialized_copy( a.data(), a.data() + a.length(), this->data() );
+            this->used_length = a.length();
         }
 
+        //Assigns over the elements both have, then constructs or destroys the difference
         DataAdapter &operator=( const DataAdapter &a ) {
-            this->clear();
-            this->resize( a.length() );
-            std::copy( a.begin(), a.end(), this->begin() );
+            if ( this != &a ) {
+                size_type len = this->length();
+                size_type alen = a.length();
+
+                if ( alen <= len ) {
+                    std::copy( a.data(), a.data() + alen, this->data() );
+                    this->truncate( alen );
+
+                } else {
+                    std::copy( a.data(), a.data() + len, this->data() );
+                    std::uninitialized_copy( a.data() + len, a.data() + alen, this->data() + len );
+                    this->used_length = alen;
+                }
+            }
 
             return *this;
         }
 
-        inline bool operator==(const DataAdapter& da) const {
-            return std::lexicographical_compare( this->begin(), this->end(), da.begin(), da.end() ) == false;
+#if DATA_ADAPTER_CXX11
+        //The storage can't be stolen, but the elements can be moved one by one
+        DataAdapter( DataAdapter &&a ) : used_length( 0 ) {
+            DATA_ADAPTER_UNINITIALIZED_MOVE( a.data(), a.data() + a.length(), this->data() );
+            this->used_length = a.length();
+            a.truncate( 0 );
         }
 
-        inline bool operator<(const DataAdapter& da) const {
-            return std::lexicographical_compare( this->begin(), this->end(), da.begin(), da.end() ) == true;
+        DataAdapter &operator=( DataAdapter &&a ) {
+            if ( this != &a ) {
+                size_type len = this->length();
+                size_type alen = a.length();
+
+                if ( alen <= len ) {
+                    std::move( a.data(), a.data() + alen, this->data() );
+                    this->truncate( alen );
+
+                } else {
+                    std::move( a.data(), a.data() + len, this->data() );
+                    DATA_ADAPTER_UNINITIALIZED_MOVE( a.data() + len, a.data() + alen, this->data() + len );
+                    this->used_length = alen;
+                }
+
+                a.truncate( 0 );
+            }
+
+            return *this;
+        }
+#endif // DATA_ADAPTER_CXX11
+
+        ~DataAdapter() {
+            this->truncate( 0 );
+        }
+
+        //Replaces the contents with [first, last), without needing element_type to be default constructible like resize does
+        template <typename _InputIterator>
+        void assign( _InputIterator first, _InputIterator last ) {
+            this->assign_range( first, last, typename da::detail::range_kind<_InputIterator>::type() );
+        }
+
+        //Replaces the contents with n copies of val
+        void assign( size_type n, const element_type &val ) {
+            if ( n <= this->capacity() ) {
+                //val could be one of our own elements
+                element_type tmp( val );
+
+                size_type len = this->length();
+                element_type *d = this->data();
+
+                DATA_ADAPTER_STAT_ADD( filled, n )
+
+                if ( n <= len ) {
+                    std::fill( d, d + n, tmp );
+                    this->truncate( n );
+
+                } else {
+                    std::fill( d, d + len, tmp );
+                    std::uninitialized_fill( d + len, d + n, tmp );
+                    this->used_length = n;
+                }
+
+            } else {
+                DATA_ADAPTER_STAT_ADD( thrown, 1 )
+                throw std::out_of_range( "DataAdapter::assign: Out of Range" );
+            }
+        }
+
+        inline bool operator==( const DataAdapter &da ) const {
+            return da::detail::equal( this->data(), this->length(), da.data(), da.length() );
+        }
+
+        inline int compare( const DataAdapter &da ) const {
+            return da::detail::compare( this->data(), this->length(), da.data(), da.length() );
+        }
+
+        inline bool operator<( const DataAdapter &da ) const {
+            return this->compare( da ) < 0;
+        }
+
+        inline size_type hash() const {
+            return da::detail::hash( this->data(), this->length() );
         }
 
         inline size_type capacity() const {
@@ -98,32 +503,108 @@ class DataAdapter<T[N]> : public DataAdapterBase<T[N], T, DataAdapter<T[N]> > {
         }
 
         void push_back( const element_type &n = element_type() )    {
-            //uses the previous length returned by resize to dictate the position of the last element
-            this->at( this->resize( this->length() + 1 ) ) = n;
+            DATA_ADAPTER_STAT_SCOPE( push_back )
+
+            if ( !this->full() ) {
+                ::new( static_cast<void *>( this->data() + this->length() ) ) element_type( n );
+                ++this->used_length;
+
+            } else {
+                DATA_ADAPTER_STAT_ADD( thrown, 1 )
+                throw std::out_of_range( "DataAdapter::push_back: Out of Range" );
+            }
         }
 
         void push_front( const element_type &val = element_type() )   {
+            DATA_ADAPTER_STAT_SCOPE( push_front )
+
+            if ( !this->full() ) {
+                //val could be one of our own elements, which the shift would move out from under it
+                element_type tmp( val );
+
+                this->insert_one( 0, tmp );
+
+            } else {
+                DATA_ADAPTER_STAT_ADD( thrown, 1 )
+                throw std::out_of_range( "DataAdapter::push_front: Out of Range" );
+            }
+        }
+
+#if DATA_ADAPTER_CXX11
+        void push_back( element_type &&n ) {
+            DATA_ADAPTER_STAT_SCOPE( push_back )
+
             if ( !this->full() ) {
+                ::new( static_cast<void *>( this->data() + this->length() ) ) element_type( std::move( n ) );
+                ++this->used_length;
 
-                iterator first = this->begin();
-                iterator last = this->end();
+            } else {
+                DATA_ADAPTER_STAT_ADD( thrown, 1 )
+                throw std::out_of_range( "DataAdapter::push_back: Out of Range" );
+            }
+        }
 
-                this->resize( this->length() + 1 );
+        void push_front( element_type &&val ) {
+            DATA_ADAPTER_STAT_SCOPE( push_front )
 
-                std::copy_backward( first, last, this->end() );
+            if ( !this->full() ) {
+                element_type tmp( std::move( val ) );
 
-                *first = val;
+                this->insert_one( 0, tmp );
 
             } else {
+                DATA_ADAPTER_STAT_ADD( thrown, 1 )
                 throw std::out_of_range( "DataAdapter::push_front: Out of Range" );
             }
         }
 
+        //Constructs the new element directly in the first unused slot
+        template <typename... Args>
+        element_type &emplace_back( Args &&... args ) {
+            DATA_ADAPTER_STAT_SCOPE( emplace )
+
+            if ( !this->full() ) {
+                element_type *p = this->data() + this->length();
+
+                ::new( static_cast<void *>( p ) ) element_type( std::forward<Args>( args )... );
+                ++this->used_length;
+
+                return *p;
+
+            } else {
+                DATA_ADAPTER_STAT_ADD( thrown, 1 )
+                throw std::out_of_range( "DataAdapter::emplace_back: Out of Range" );
+            }
+        }
+
+        template <typename... Args>
+        iterator emplace( iterator pos, Args &&... args ) {
+            DATA_ADAPTER_STAT_SCOPE( emplace )
+
+            size_type off = pos.offset();
+
+            if ( off <= this->length() && !this->full() ) {
+                //Constructed before shifting, in case args refer to our own elements
+                element_type tmp( std::forward<Args>( args )... );
+
+                this->insert_one( off, tmp );
+
+                return this->begin() + off;
+
+            } else {
+                DATA_ADAPTER_STAT_ADD( thrown, 1 )
+                throw std::out_of_range( "DataAdapter::emplace: Out of Range" );
+            }
+        }
+#endif // DATA_ADAPTER_CXX11
+
         element_type pop_back() {
+            DATA_ADAPTER_STAT_SCOPE( pop_back )
+
             if ( !this->empty() ) {
-                element_type ret = this->back();
+                element_type ret = DATA_ADAPTER_MOVE( this->back() );
 
-                this->resize( this->length() - 1 );
+                this->truncate( this->length() - 1 );
 
                 return ret;
 
@@ -133,29 +614,42 @@ class DataAdapter<T[N]> : public DataAdapterBase<T[N], T, DataAdapter<T[N]> > {
         }
 
         element_type pop_front()    {
-            element_type ret = this->front();
+            DATA_ADAPTER_STAT_SCOPE( pop_front )
 
-            std::copy( this->begin() + 1, this->end() - 1, this->begin() );
+            if ( !this->empty() ) {
+                element_type ret = DATA_ADAPTER_MOVE( this->front() );
+
+                this->close_gap( 0, 1 );
 
-            this->resize( this->length() - 1 );
+                return ret;
 
-            return ret;
+            } else {
+                return element_type();
+            }
+        }
+
+        inline element_type *data() {
+            return this->storage.data();
+        }
+
+        inline const element_type *data() const {
+            return this->storage.data();
         }
 
         inline element_type &at( size_type n ) {
-            return this->data[n];
+            return this->data()[n];
         }
 
         inline const element_type at( size_type n ) const {
-            return this->data[n];
+            return this->data()[n];
         }
 
         inline element_type &at( iterator it ) {
-            return this->at( it.off );
+            return this->at( it.offset() );
         }
 
         inline const element_type at( const_iterator it ) const {
-            return this->at( it.off );
+            return this->at( it.offset() );
         }
 
         inline element_type front() const {
@@ -184,44 +678,142 @@ class DataAdapter<T[N]> : public DataAdapterBase<T[N], T, DataAdapter<T[N]> > {
             }
         }
 
-        iterator sorted_insert( const element_type &n ) {
-            //First, add it to the end
-            this->push_back( n );
+#if DATA_ADAPTER_CXX11
+        //sort( threads ) from the base, which the sort() below would hide
+        using _Base::sort;
+#endif // DATA_ADAPTER_CXX11
 
-            //Then insert it into the proper place
-            for ( size_type i = this->length() - 1; i > 0; --i ) {
-                if ( this->at( i ) < this->at( i - 1 ) ) {
-                    std::swap( this->at( i ), this->at( i - 1 ) );
+        //On data() directly, which is a radix sort for elements with a da::radix_key (see detail/radix_sort.hpp)
+        void sort() {
+            DATA_ADAPTER_STAT_SCOPE( sort )
 
-                } else {
-                    return this->begin() + i;
-                }
+            da::detail::sort( this->data(), this->data() + this->length() );
+        }
+
+        /*
+            Searches run over data() directly, with the SIMD kernels from detail/simd.hpp for arithmetic
+            element types and the std algorithms for anything else, so there is no iterator in the way either.
+        */
+        inline iterator find( const element_type &n ) {
+            DATA_ADAPTER_STAT_SCOPE( find )
+
+            return this->begin() + ( da::detail::find( this->data(), this->data() + this->length(), n ) - this->data() );
+        }
+
+        iterator find_sorted( const element_type &n ) {
+            DATA_ADAPTER_STAT_SCOPE( find_sorted )
+
+            const element_type *last = this->data() + this->length();
+            const element_type *p = da::detail::lower_bound( this->data(), last, n );
+
+            if ( p != last && *p == n ) {
+                return this->begin() + ( p - this->data() );
+
+            } else {
+                return this->end();
             }
+        }
+
+        inline size_type count( const element_type &n ) const {
+            return da::detail::count( this->data(), this->data() + this->length(), n );
+        }
+
+        inline bool contains( const element_type &n ) const {
+            return da::detail::find( this->data(), this->data() + this->length(), n ) != this->data() + this->length();
+        }
+
+        inline iterator min_element() {
+            return this->begin() + ( da::detail::min_element( this->data(), this->data() + this->length() ) - this->data() );
+        }
+
+        inline iterator max_element() {
+            return this->begin() + ( da::detail::max_element( this->data(), this->data() + this->length() ) - this->data() );
+        }
+
+        //Binary search for the position, then a single block shift to make room
+        iterator sorted_insert( const element_type &n ) {
+            DATA_ADAPTER_STAT_SCOPE( sorted_insert )
+
+            return this->insert( this->begin() + ( std::upper_bound( this->data(), this->data() + this->length(), n ) - this->data() ), n );
+        }
+
+#if DATA_ADAPTER_CXX11
+        iterator sorted_insert( element_type &&n ) {
+            DATA_ADAPTER_STAT_SCOPE( sorted_insert )
+
+            return this->emplace( this->begin() + ( std::upper_bound( this->data(), this->data() + this->length(), n ) - this->data() ), std::move( n ) );
+        }
+#endif // DATA_ADAPTER_CXX11
+
+        /*
+            Inserts a whole batch into sorted contents. The batch is copied and sorted on its own,
+            then merged in from the back, so every existing element moves at most once, however
+            large the batch is. Returns the position of the smallest new element, or end() for an empty batch.
+        */
+        template <typename _InputIterator>
+        iterator sorted_insert( _InputIterator first, _InputIterator last ) {
+            DATA_ADAPTER_STAT_SCOPE( sorted_insert )
+
+            std::vector<element_type> batch( first, last );
+
+            if ( batch.empty() ) {
+                return this->end();
+
+            } else if ( this->length() + batch.size() <= this->capacity() ) {
+                //Stable, so equal elements end up in the same order as inserting them one by one
+                std::stable_sort( batch.begin(), batch.end() );
+
+                return this->merge_back( batch.begin(), batch.end() );
 
-            return this->begin();
+            } else {
+                DATA_ADAPTER_STAT_ADD( thrown, 1 )
+                throw std::out_of_range( "DataAdapter::sorted_insert(range): Out of Range" );
+            }
         }
 
         //single element
-        inline iterator insert( iterator pos, const element_type &val ) {
-            return this->insert( pos, 1, val );
+        iterator insert( iterator pos, const element_type &val ) {
+            DATA_ADAPTER_STAT_SCOPE( insert )
+
+            size_type off = pos.offset();
+
+            if ( off <= this->length() && !this->full() ) {
+                element_type tmp( val );
+
+                this->insert_one( off, tmp );
+
+                return this->begin() + off;
+
+            } else {
+                DATA_ADAPTER_STAT_ADD( thrown, 1 )
+                throw std::out_of_range( "DataAdapter::insert: Out of Range" );
+            }
         }
 
+#if DATA_ADAPTER_CXX11
+        iterator insert( iterator pos, element_type &&val ) {
+            DATA_ADAPTER_STAT_SCOPE( insert )
+
+            return this->emplace( pos, std::move( val ) );
+        }
+#endif // DATA_ADAPTER_CXX11
+
         //fill
         iterator insert( iterator pos, size_type n, const element_type &val ) {
-            if ( n != 0 ) {
-                if ( pos <= this->end() && this->length() + n <= this->capacity() ) {
+            DATA_ADAPTER_STAT_SCOPE( insert_fill )
 
-                    iterator first = this->begin() + pos;
-                    iterator last = this->end();
+            if ( n != 0 ) {
+                size_type off = pos.offset();
 
-                    this->resize( this->length() + n );
+                if ( off <= this->length() && this->length() + n <= this->capacity() ) {
+                    element_type tmp( val );
 
-                    std::copy_backward( first, last, this->end() );
-                    std::fill( first, first + n, val );
+                    this->insert_fill_n( off, n, tmp );
 
-                    return first;
+                    return this->begin() + off;
 
                 } else {
+                    DATA_ADAPTER_STAT_ADD( thrown, 1 )
                     throw std::out_of_range( "DataAdapter::insert(fill): Out of Range" );
                 }
             } else {
@@ -231,22 +823,29 @@ class DataAdapter<T[N]> : public DataAdapterBase<T[N], T, DataAdapter<T[N]> > {
 
         //range
         iterator insert( iterator pos, const_iterator first, const_iterator last ) {
+            DATA_ADAPTER_STAT_SCOPE( insert_range )
+
             if ( first != last && first < last ) {
-                if ( pos <= this->end() && this->length() + ( last - first ) <= this->capacity() ) {
+                size_type off = pos.offset();
+                size_type diff = last - first;
 
-                    size_type diff = last - first;
+                if ( off <= this->length() && this->length() + diff <= this->capacity() ) {
+                    const element_type *d = this->data();
 
-                    iterator f = this->begin() + pos;
-                    iterator l = this->end();
+                    //Shifting would move our own elements around under first and last
+                    if ( first.base() >= d && first.base() < d + this->length() ) {
+                        std::vector<element_type> tmp( first.base(), last.base() );
 
-                    this->resize( this->length() + diff );
+                        this->insert_n( off, tmp.begin(), tmp.end(), diff );
 
-                    std::copy_backward( f, l, this->end() );
-                    std::copy( first, last, f );
+                    } else {
+                        this->insert_n( off, first.base(), last.base(), diff );
+                    }
 
-                    return f;
+                    return this->begin() + off;
 
                 } else {
+                    DATA_ADAPTER_STAT_ADD( thrown, 1 )
                     throw std::out_of_range( "DataAdapter::insert(range): Out of Range" );
                 }
             } else {
@@ -254,11 +853,29 @@ class DataAdapter<T[N]> : public DataAdapterBase<T[N], T, DataAdapter<T[N]> > {
             }
         }
 
-        //Clear is unique in that is zeros the memory just in case
+        //Any other range, from any kind of iterator, or a count and a value
+        template <typename _InputIterator>
+        iterator insert( iterator pos, _InputIterator first, _InputIterator last ) {
+            return this->insert_range( pos, first, last, typename da::detail::range_kind<_InputIterator>::type() );
+        }
+
+        //Only destroys the live elements, so it costs nothing at all for trivially destructible types
         void clear() {
-            //Also, this doesn't use iterators as those rely on the used length
-            std::fill( this->data, this->data + this->capacity(), element_type() );
-            this->used_length = 0;
+            DATA_ADAPTER_STAT_SCOPE( clear )
+
+            this->truncate( 0 );
+        }
+
+        /*
+            Clears, then zeros every byte of the storage, used or not, in a way the compiler
+            can't optimize away. For when the elements held something that shouldn't linger in memory.
+        */
+        void secure_clear() {
+            DATA_ADAPTER_STAT_SCOPE( clear )
+
+            this->truncate( 0 );
+
+            da::detail::secure_zero( this->data(), sizeof( value_type ) );
         }
 
         inline size_type resize( size_type n ) {
@@ -266,24 +883,28 @@ class DataAdapter<T[N]> : public DataAdapterBase<T[N], T, DataAdapter<T[N]> > {
         }
 
         size_type resize( size_type n, const element_type &v ) {
+            DATA_ADAPTER_STAT_SCOPE( resize )
+
             if ( n <= this->capacity() ) {
 
                 size_type ret = this->length();
 
-                if ( n < this->length() ) {
-                    this->used_length = n;
+                if ( n > ret ) {
+                    DATA_ADAPTER_STAT_ADD( filled, n - ret )
 
-                } else {
-                    size_type ol = this->used_length;
+                    //Only the newly exposed elements are constructed, from the fill value
+                    std::uninitialized_fill( this->data() + ret, this->data() + n, v );
 
                     this->used_length = n;
 
-                    std::fill( this->begin() + n, this->end(), v );
+                } else {
+                    this->truncate( n );
                 }
 
                 return ret;
 
             } else {
+                DATA_ADAPTER_STAT_ADD( thrown, 1 )
                 throw std::out_of_range( "DataAdapter::resize: Out of Range" );
             }
         }
@@ -293,247 +914,114 @@ class DataAdapter<T[N]> : public DataAdapterBase<T[N], T, DataAdapter<T[N]> > {
         }
 
         iterator erase( iterator first, iterator last ) {
-            size_type diff = ( last - first );
-
-            if ( last <= this->end() && diff <= this->length() ) {
+            DATA_ADAPTER_STAT_SCOPE( erase )
 
-                iterator f = this->begin() + first;
-                iterator l = this->begin() + last;
+            size_type f = first.offset();
+            size_type l = last.offset();
 
-                std::copy( l, this->end(), f );
+            if ( f <= l && l <= this->length() ) {
 
-                this->resize( this->length() - diff );
+                this->close_gap( f, l );
 
-                return f;
+                return this->begin() + f;
 
             } else {
+                DATA_ADAPTER_STAT_ADD( thrown, 1 )
                 throw std::out_of_range( "DataAdapter::erase(range): Out of Range" );
             }
         }
-};
 
-template <typename T, size_t N>
-typename DataAdapter<T[N]>::size_type DataAdapter<T[N]>::data_size =
-    sizeof( DataAdapter<T[N]>::value_type ) / sizeof( DataAdapter<T[N]>::element_type );
-
-/*Mutable iterator class template*/
-template <typename T, size_t N>
-class DataApapterIterator<T[N]>
-    : public std::iterator<std::random_access_iterator_tag, T> {
-    public:
-        typedef std::iterator<std::random_access_iterator_tag, T> iterator_traits;
+        /*
+            Erases every element pred( element ) is true for and returns how many there were. The elements kept
+            are moved down over the gaps in one pass, instead of shifting the whole tail once per erase.
+        */
+        template <typename _Predicate>
+        size_type erase_if( _Predicate pred ) {
+            DATA_ADAPTER_STAT_SCOPE( erase_if )
 
-        typedef typename iterator_traits::iterator_category     iterator_category;
-        typedef typename iterator_traits::value_type            value_type;
-        typedef typename iterator_traits::difference_type       difference_type;
-        typedef typename iterator_traits::pointer               pointer;
-        typedef typename iterator_traits::reference             reference;
+            element_type *d = this->data();
+            size_type len = this->length();
 
-        typedef DataAdapter<T[N]> parent_type;
+            element_type *first;
+            element_type *last = da::detail::remove_if( d, d + len, pred, first );
 
-        friend class DataAdapter<T[N]>;
+            DATA_ADAPTER_STAT_ADD( shifted, last - first )
 
-    private:
-        //Keep a pointer to the parent
-        parent_type *parent;
-        difference_type off;
-
-    public:
-        DataApapterIterator() : parent( NULL ), off( 0 ) {}
-        DataApapterIterator( parent_type *x, difference_type ioff = 0 ) : parent( x ), off( ioff ) {}
-        DataApapterIterator( parent_type &x, difference_type ioff = 0 ) : parent( &x ), off( ioff ) {}
-        DataApapterIterator( const DataApapterIterator &it ) : parent( it.parent ), off( it.off ) {}
-
-        inline DataApapterIterator &operator=( const DataApapterIterator &it ) {
-            this->parent = it.parent;
-            this->off = it.off;
-            return *this;
-        }
+            this->truncate( last - d );
 
-        inline bool operator==( const DataApapterIterator &it ) const {
-            return this->parent == it.parent && this->off == it.off;
+            return len - this->length();
         }
 
-        inline bool operator!=( const DataApapterIterator &it ) const {
-            return this->parent != it.parent || this->off != it.off;
-        }
+        //Moves the last element into pos instead of shifting everything after it down
+        iterator unordered_erase( iterator pos ) {
+            DATA_ADAPTER_STAT_SCOPE( unordered_erase )
 
-        inline reference operator*() {
-            return this->parent->at( this->off );
-        }
+            size_type off = pos.offset();
+            size_type len = this->length();
 
-        inline reference operator[]( difference_type n ) {
-            return *( *this + n );
-        }
+            if ( off < len ) {
+                element_type *d = this->data();
 
-        inline pointer operator->() {
-            return &( this->parent->at( this->off ) );
-        }
+                if ( off + 1 != len ) {
+                    DATA_ADAPTER_STAT_ADD( shifted, 1 )
 
-        //VERY IMPORTANT for converting and comparing to const_iterators
-        inline operator typename parent_type::const_iterator() const {
-            return typename parent_type::const_iterator( this->parent ) + this->off;
-        }
-
-#define DATA_ADAPTER_ITERATOR_UNARY_OP(op)              \
-    inline DataApapterIterator& operator op() {         \
-        this->off op;                                   \
-        return *this;                                   \
-    }                                                   \
-    inline DataApapterIterator operator op( int ) {     \
-        DataApapterIterator tmp( *this );               \
-        this->off op;                                   \
-        return tmp;                                     \
-    }
-
-        DATA_ADAPTER_ITERATOR_UNARY_OP( ++ )
-        DATA_ADAPTER_ITERATOR_UNARY_OP( -- )
-
-        inline DataApapterIterator operator+( const DataApapterIterator &it ) const {
-            DataApapterIterator tmp( *this );
-            tmp.off += it.off;
-            return tmp;
-        }
-        inline DataApapterIterator operator+( difference_type n ) const {
-            DataApapterIterator tmp( *this );
-            tmp.off += n;
-            return tmp;
-        }
-        inline DataApapterIterator &operator +=( const DataApapterIterator &it ) {
-            this->off += it.off;
-            return *this;
-        }
-        inline DataApapterIterator &operator +=( difference_type n ) {
-            this->off += n;
-            return *this;
-        }
+                    d[off] = DATA_ADAPTER_MOVE( d[len - 1] );
+                }
 
-        inline difference_type operator-( const DataApapterIterator &it ) const {
-            return this->off - it.off;
-        }
-        inline DataApapterIterator operator-( difference_type n ) const {
-            DataApapterIterator tmp( *this );
-            tmp.off -= n;
-            return tmp;
-        }
-        inline DataApapterIterator &operator -=( const DataApapterIterator &it ) {
-            this->off -= it.off;
-            return *this;
-        }
-        inline DataApapterIterator &operator -=( difference_type n ) {
-            this->off -= n;
-            return *this;
-        }
+                this->truncate( len - 1 );
 
-#define DATA_ADAPTER_ITERATOR_COMP_OP(op)                               \
-    inline bool operator op( const DataApapterIterator& it ) const {    \
-        return this->off op it.off;                                     \
-    }
+                return this->begin() + off;
 
-        DATA_ADAPTER_ITERATOR_COMP_OP( < )
-        DATA_ADAPTER_ITERATOR_COMP_OP( > )
-        DATA_ADAPTER_ITERATOR_COMP_OP( <= )
-        DATA_ADAPTER_ITERATOR_COMP_OP( >= )
+            } else {
+                DATA_ADAPTER_STAT_ADD( thrown, 1 )
+                throw std::out_of_range( "DataAdapter::unordered_erase: Out of Range" );
+            }
+        }
 };
 
-
-/*Immutable iterator class template*/
 template <typename T, size_t N>
-class DataApapterIterator<const T[N]> : public std::iterator<std::random_access_iterator_tag, T> {
-    public:
-        typedef std::iterator<std::random_access_iterator_tag, T> iterator_traits;
-
-        typedef typename iterator_traits::iterator_category     iterator_category;
-        typedef typename iterator_traits::value_type            value_type;
-        typedef typename iterator_traits::difference_type       difference_type;
-        typedef typename iterator_traits::pointer               pointer;
-        typedef typename iterator_traits::reference             reference;
-
-        typedef DataAdapter<T[N]> parent_type;
-
-        friend class DataAdapter<T[N]>;
-
-    private:
-        //Keep a pointer to the parent
-        const parent_type *parent;
-        difference_type off;
+typename DataAdapter<T[N]>::size_type DataAdapter<T[N]>::data_size =
+    sizeof( DataAdapter<T[N]>::value_type ) / sizeof( DataAdapter<T[N]>::element_type );
 
+/*Mutable iterator class template*/
+template <typename T, size_t N>
+class DataApapterIterator<T[N]>
+    : public da::detail::contiguous_iterator<DataApapterIterator<T[N]>, DataAdapter<T[N]>, T> {
     public:
-        DataApapterIterator() : parent( NULL ), off( 0 ) {}
-        DataApapterIterator( const parent_type *x, difference_type ioff = 0 ) : parent( x ), off( ioff ) {}
-        DataApapterIterator( const parent_type &x, difference_type ioff = 0 ) : parent( &x ), off( ioff ) {}
-        DataApapterIterator( const DataApapterIterator &it ) : parent( it.parent ), off( it.off ) {}
-
-        inline DataApapterIterator &operator=( const DataApapterIterator &it ) {
-            this->parent = it.parent;
-            this->off = it.off;
-            return *this;
-        }
+        typedef da::detail::contiguous_iterator<DataApapterIterator<T[N]>, DataAdapter<T[N]>, T> _Base;
 
-        inline bool operator==( const DataApapterIterator &it ) const {
-            return this->parent == it.parent && this->off == it.off;
-        }
+        typedef typename _Base::difference_type         difference_type;
+        typedef typename _Base::parent_type             parent_type;
 
-        inline bool operator!=( const DataApapterIterator &it ) const {
-            return this->parent != it.parent || this->off != it.off;
-        }
+        DataApapterIterator() {}
+        DataApapterIterator( parent_type *x, difference_type ioff = 0 ) : _Base( x, ioff ) {}
+        DataApapterIterator( parent_type &x, difference_type ioff = 0 ) : _Base( &x, ioff ) {}
 
-        inline value_type operator*() {
-            return this->parent->at( this->off );
-        }
+        //VERY IMPORTANT for converting and comparing to const_iterators
+        inline operator typename parent_type::const_iterator() const {
+            if ( this->parent != NULL ) {
+                return typename parent_type::const_iterator( this->parent, this->offset() );
 
-        inline value_type operator[]( difference_type n ) {
-            return *( *this + n );
+            } else {
+                return typename parent_type::const_iterator();
+            }
         }
+};
 
-        DATA_ADAPTER_ITERATOR_UNARY_OP( ++ )
-        DATA_ADAPTER_ITERATOR_UNARY_OP( -- )
-
-        inline DataApapterIterator operator+( const DataApapterIterator &it ) const {
-            DataApapterIterator tmp( *this );
-            tmp.off += it.off;
-            return tmp;
-        }
-        inline DataApapterIterator operator+( difference_type n ) const {
-            DataApapterIterator tmp( *this );
-            tmp.off += n;
-            return tmp;
-        }
-        inline DataApapterIterator &operator +=( const DataApapterIterator &it ) {
-            this->off += it.off;
-            return *this;
-        }
-        inline DataApapterIterator &operator +=( difference_type n ) {
-            this->off += n;
-            return *this;
-        }
+/*Immutable iterator class template*/
+template <typename T, size_t N>
+class DataApapterIterator<const T[N]>
+    : public da::detail::contiguous_iterator<DataApapterIterator<const T[N]>, const DataAdapter<T[N]>, const T> {
+    public:
+        typedef da::detail::contiguous_iterator<DataApapterIterator<const T[N]>, const DataAdapter<T[N]>, const T> _Base;
 
-        inline difference_type operator-( const DataApapterIterator &it ) const {
-            return this->off - it.off;
-        }
-        inline DataApapterIterator operator-( difference_type n ) const {
-            DataApapterIterator tmp( *this );
-            tmp.off -= n;
-            return tmp;
-        }
-        inline DataApapterIterator &operator -=( const DataApapterIterator &it ) {
-            this->off -= it.off;
-            return *this;
-        }
-        inline DataApapterIterator &operator -=( difference_type n ) {
-            this->off -= n;
-            return *this;
-        }
+        typedef typename _Base::difference_type         difference_type;
+        typedef typename _Base::parent_type             parent_type;
 
-        DATA_ADAPTER_ITERATOR_COMP_OP( < )
-        DATA_ADAPTER_ITERATOR_COMP_OP( > )
-        DATA_ADAPTER_ITERATOR_COMP_OP( <= )
-        DATA_ADAPTER_ITERATOR_COMP_OP( >= )
+        DataApapterIterator() {}
+        DataApapterIterator( parent_type *x, difference_type ioff = 0 ) : _Base( x, ioff ) {}
+        DataApapterIterator( parent_type &x, difference_type ioff = 0 ) : _Base( &x, ioff ) {}
 };
 
-#undef DATA_ADAPTER_ITERATOR_UNARY_OP
-#undef DATA_ADAPTER_ITERATOR_BINARY_OP
-#undef DATA_ADAPTER_ITERATOR_COMP_OP
-
 #endif // DATA_ADAPTER_ARRAY_HPP_INCLUDED
 
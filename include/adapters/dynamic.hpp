@@ -0,0 +1,116 @@
+#ifndef DATA_ADAPTER_DYNAMIC_HPP_INCLUDED
+#define DATA_ADAPTER_DYNAMIC_HPP_INCLUDED
+
+#include <memory>
+
+#include "../data_adapter.hpp"
+#include "../detail/contiguous_iterator.hpp"
+#include "../detail/growable.hpp"
+
+/**
+ *              Notes on the implementation of this:
+ *
+ *      This is the growable version of the array adapter, for when N isn't known up front. The elements
+ * live in one heap block from the allocator, and everything the array adapter does within its fixed
+ * storage is done the same way here, with the same std::vector style construction into unused slots.
+ * The implementation is shared with the small buffer adapter, in detail/growable.hpp.
+ * The difference is that running out of room grows the block instead of throwing: by half of the
+ * current capacity, and at least 8 elements, so a run of push_backs is amortized O(1). reserve()
+ * and shrink_to_fit() set the capacity explicitly, and std::out_of_range is only thrown for positions
+ * out of bounds or a size over the allocator's max_size().
+ *
+ *      Growing moves the elements to the new block. For trivially relocatable types (see
+ * da::is_trivially_relocatable in detail/storage.hpp) that is a memcpy, and if the allocator can
+ * reallocate (da::allocator_reallocates in detail/allocator.hpp, like da::malloc_allocator) it is a single
+ * realloc, which often doesn't have to copy at all. Anything else is moved element by element,
+ * or copied if moving could throw.
+ *
+ *      The allocator is any standard allocator for T, and is kept by value, so a stateful one like an
+ * arena works. Elements are constructed with placement new rather than through it.
+ *
+ *      Iterators are the same plain pointers the array adapter uses, so, like std::vector's, they are
+ * invalidated by anything that grows or shrinks the capacity.
+ */
+
+namespace da {
+    template <typename T, typename Alloc = std::allocator<T> >
+    struct dynamic {};
+}
+
+template <typename T, typename Alloc>
+class DataAdapter<da::dynamic<T, Alloc> > : public da::detail::growable<da::dynamic<T, Alloc>, T, Alloc, 0> {
+    public:
+        typedef da::detail::growable<da::dynamic<T, Alloc>, T, Alloc, 0> _Growable;
+
+        typedef typename _Growable::element_type        element_type;
+        typedef typename _Growable::size_type           size_type;
+        typedef typename _Growable::allocator_type      allocator_type;
+
+        DataAdapter() {}
+
+        explicit DataAdapter( const allocator_type &a ) : _Growable( a ) {}
+
+        DataAdapter( size_type n, const element_type &val = element_type(), const allocator_type &a = allocator_type() )
+            : _Growable( n, val, a ) {}
+
+        DataAdapter( const DataAdapter &a ) : _Growable( a ) {}
+
+        DataAdapter &operator=( const DataAdapter &a ) {
+            _Growable::operator=( a );
+
+            return *this;
+        }
+
+#if DATA_ADAPTER_CXX11
+        //Takes over the whole block, leaving a empty and without one
+        DataAdapter( DataAdapter &&a ) : _Growable( std::move( a ) ) {}
+
+        DataAdapter &operator=( DataAdapter &&a ) {
+            _Growable::operator=( std::move( a ) );
+
+            return *this;
+        }
+#endif // DATA_ADAPTER_CXX11
+};
+
+/*Mutable iterator class template*/
+template <typename T, typename Alloc>
+class DataApapterIterator<da::dynamic<T, Alloc> >
+    : public da::detail::contiguous_iterator<DataApapterIterator<da::dynamic<T, Alloc> >, DataAdapter<da::dynamic<T, Alloc> >, T> {
+    public:
+        typedef da::detail::contiguous_iterator<DataApapterIterator<da::dynamic<T, Alloc> >, DataAdapter<da::dynamic<T, Alloc> >, T> _Base;
+
+        typedef typename _Base::difference_type         difference_type;
+        typedef typename _Base::parent_type             parent_type;
+
+        DataApapterIterator() {}
+        DataApapterIterator( parent_type *x, difference_type ioff = 0 ) : _Base( x, ioff ) {}
+        DataApapterIterator( parent_type &x, difference_type ioff = 0 ) : _Base( &x, ioff ) {}
+
+        //VERY IMPORTANT for converting and comparing to const_iterators
+        inline operator typename parent_type::const_iterator() const {
+            if ( this->parent != NULL ) {
+                return typename parent_type::const_iterator( this->parent, this->offset() );
+
+            } else {
+                return typename parent_type::const_iterator();
+            }
+        }
+};
+
+/*Immutable iterator class template*/
+template <typename T, typename Alloc>
+class DataApapterIterator<const da::dynamic<T, Alloc> >
+    : public da::detail::contiguous_iterator<DataApapterIterator<const da::dynamic<T, Alloc> >, const DataAdapter<da::dynamic<T, Alloc> >, const T> {
+    public:
+        typedef da::detail::contiguous_iterator<DataApapterIterator<const da::dynamic<T, Alloc> >, const DataAdapter<da::dynamic<T, Alloc> >, const T> _Base;
+
+        typedef typename _Base::difference_type         difference_type;
+        typedef typename _Base::parent_type             parent_type;
+
+        DataApapterIterator() {}
+        DataApapterIterator( parent_type *x, difference_type ioff = 0 ) : _Base( x, ioff ) {}
+        DataApapterIterator( parent_type &x, difference_type ioff = 0 ) : _Base( &x, ioff ) {}
+};
+
+#endif // DATA_ADAPTER_DYNAMIC_HPP_INCLUDED
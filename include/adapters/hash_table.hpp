@@ -0,0 +1,1217 @@
+#ifndef DATA_ADAPTER_HASH_TABLE_HPP_INCLUDED
+#define DATA_ADAPTER_HASH_TABLE_HPP_INCLUDED
+
+#include "../data_adapter.hpp"
+
+#if !DATA_ADAPTER_CXX11
+#error "DataAdapter<da::hash_table<K, V> > requires C++11"
+#endif // DATA_ADAPTER_CXX11
+
+#include <cstdint>
+#include <functional>
+#include <initializer_list>
+#include <memory>
+#include <utility>
+#include <vector>
+
+//DATA_ADAPTER_HASH_TABLE_PORTABLE forces the 8 byte group, to test it on machines with SSE2
+#if !defined(DATA_ADAPTER_HASH_TABLE_PORTABLE) && ( defined(__SSE2__) || defined(_M_X64) || ( defined(_M_IX86_FP) && _M_IX86_FP >= 2 ) )
+#   define DATA_ADAPTER_HASH_TABLE_SSE2 1
+#   include <emmintrin.h>
+#else
+#   define DATA_ADAPTER_HASH_TABLE_SSE2 0
+#endif
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#   include <intrin.h>
+#endif
+
+/**
+ *              Notes on the implementation of this:
+ *
+ *      This is a flat, open addressing hash table in the style of Abseil's SwissTable. Elements live
+ * directly in one array of slots, so there is no allocation per element, and next to it is an array of one
+ * byte of metadata per slot, the control bytes. A control byte is either empty, deleted (a tombstone), the
+ * sentinel that marks the end of the table, or, for a full slot, the low 7 bits of the element's hash (H2).
+ *
+ *      Lookups start at a position taken from the rest of the hash (H1) and look at a whole group of control
+ * bytes at once: 16 with SSE2, otherwise 8 using plain 64 bit arithmetic. The group gives a bitmask of the
+ * slots whose H2 matches, so the key itself is only compared for roughly one in 128 non-matching slots, and
+ * an empty byte in the group ends the search. Groups are probed quadratically.
+ *
+ *      The number of slots is always a power of two minus one, and the first group's worth of control
+ * bytes is cloned after the sentinel, so a group can be loaded from any position without wrapping around.
+ * The table grows at 7/8 load, or with one slot left for tables smaller than a group.
+ *
+ *      For the common interface, elements are std::pair<const K, V> and are identified by their keys alone.
+ * Since there is no order, positional operations do their best: push_back, push_front, sorted_insert and
+ * the hinted inserts just insert, front() and back() are the first and last elements in iteration order,
+ * at( n ) is the nth element in iteration order (so linear), and sort() and stable_sort() do nothing.
+ * capacity() is the number of elements the table holds before it has to grow, so full() being true only
+ * means the next insert will rehash.
+ *
+ *      Iterators are forward iterators, and are invalidated by anything that rehashes the table.
+ *
+ *      The hash is mixed before being split into H1 and H2, since std::hash is the identity for integers
+ * on most implementations, which would leave H2 with no entropy at all.
+ *
+ *      at( key ) is not provided, since it would collide with the positional at( size_type ) for integer
+ * keys. Use find( key ) or operator[] instead.
+ */
+
+namespace da {
+
+    template <typename K, typename V, typename Hash = std::hash<K>, typename KeyEqual = std::equal_to<K> >
+    struct hash_table {};
+
+    namespace detail {
+        namespace hash_table {
+
+            typedef signed char ctrl_t;
+
+            static const ctrl_t ctrl_empty      = -128;
+            static const ctrl_t ctrl_deleted    = -2;
+            static const ctrl_t ctrl_sentinel   = -1;
+
+            inline int trailing_zeros( uint64_t x ) {
+#if defined(_MSC_VER) && !defined(__clang__)
+                unsigned long r;
+                _BitScanForward64( &r, x );
+                return static_cast<int>( r );
+#else
+                return __builtin_ctzll( x );
+#endif
+            }
+
+            inline int leading_zeros( uint64_t x ) {
+#if defined(_MSC_VER) && !defined(__clang__)
+                unsigned long r;
+                _BitScanReverse64( &r, x );
+                return 63 - static_cast<int>( r );
+#else
+                return __builtin_clzll( x );
+#endif
+            }
+
+            /*
+                Set of matching positions within a group. Each position is one bit for SSE2,
+                or the top bit of its byte for the portable group, hence the shift.
+            */
+            template <int W, int Shift>
+            class bitmask {
+                private:
+                    uint64_t mask;
+
+                public:
+                    explicit bitmask( uint64_t m ) : mask( m ) {}
+
+                    inline operator bool() const {
+                        return this->mask != 0;
+                    }
+
+                    inline int lowest() const {
+                        return trailing_zeros( this->mask ) >> Shift;
+                    }
+
+                    //Pops the lowest position
+                    inline int next() {
+                        int i = this->lowest();
+                        this->mask &= this->mask - 1;
+                        return i;
+                    }
+
+                    inline int trailing() const {
+                        return this->mask != 0 ? this->lowest() : W;
+                    }
+
+                    inline int leading() const {
+                        return this->mask != 0 ? ( leading_zeros( this->mask ) - ( 64 - W * ( 1 << Shift ) ) ) >> Shift : W;
+                    }
+            };
+
+#if DATA_ADAPTER_HASH_TABLE_SSE2
+            struct group {
+                static const size_t width = 16;
+
+                typedef bitmask<16, 0> mask_type;
+
+                __m128i ctrl;
+
+                explicit group( const ctrl_t *p ) : ctrl( _mm_loadu_si128( reinterpret_cast<const __m128i *>( p ) ) ) {}
+
+                inline mask_type match( ctrl_t h2 ) const {
+                    return mask_type( static_cast<uint32_t>( _mm_movemask_epi8( _mm_cmpeq_epi8( _mm_set1_epi8( h2 ), this->ctrl ) ) ) );
+                }
+
+                inline mask_type match_empty() const {
+                    return this->match( ctrl_empty );
+                }
+
+                inline mask_type match_empty_or_deleted() const {
+                    return mask_type( this->match_empty_or_deleted_bits() );
+                }
+
+                inline int count_leading_empty_or_deleted() const {
+                    return mask_type( ~this->match_empty_or_deleted_bits() & 0xFFFF ).trailing();
+                }
+
+                //Empty and deleted are the only values below the sentinel
+                inline uint32_t match_empty_or_deleted_bits() const {
+                    return static_cast<uint32_t>( _mm_movemask_epi8( _mm_cmpgt_epi8( _mm_set1_epi8( ctrl_sentinel ), this->ctrl ) ) );
+                }
+            };
+#else
+            struct group {
+                static const size_t width = 8;
+
+                typedef bitmask<8, 3> mask_type;
+
+                static const uint64_t lsbs = 0x0101010101010101ULL;
+                static const uint64_t msbs = 0x8080808080808080ULL;
+
+                uint64_t ctrl;
+
+                //Assembled byte by byte so position i is always byte i, whatever the endianness
+                explicit group( const ctrl_t *p ) : ctrl( 0 ) {
+                    for ( size_t i = 0; i < width; ++i ) {
+                        this->ctrl |= static_cast<uint64_t>( static_cast<unsigned char>( p[i] ) ) << ( 8 * i );
+                    }
+                }
+
+                //May report false positives right after a real match, which the key comparison weeds out
+                inline mask_type match( ctrl_t h2 ) const {
+                    uint64_t x = this->ctrl ^ ( lsbs * static_cast<unsigned char>( h2 ) );
+                    return mask_type( ( x - lsbs ) & ~x & msbs );
+                }
+
+                inline mask_type match_empty() const {
+                    return mask_type( ( this->ctrl & ~( this->ctrl << 6 ) ) & msbs );
+                }
+
+                inline mask_type match_empty_or_deleted() const {
+                    return mask_type( this->match_empty_or_deleted_bits() );
+                }
+
+                inline int count_leading_empty_or_deleted() const {
+                    return mask_type( ~this->match_empty_or_deleted_bits() & msbs ).trailing();
+                }
+
+                inline uint64_t match_empty_or_deleted_bits() const {
+                    return ( this->ctrl & ~( this->ctrl << 7 ) ) & msbs;
+                }
+            };
+#endif // DATA_ADAPTER_HASH_TABLE_SSE2
+
+            //Control bytes of a table without any slots, so lookups need no special case for it
+            inline ctrl_t *empty_group() {
+                alignas( 16 ) static ctrl_t g[group::width] = {
+                    ctrl_sentinel, ctrl_empty, ctrl_empty, ctrl_empty,
+                    ctrl_empty, ctrl_empty, ctrl_empty, ctrl_empty,
+#if DATA_ADAPTER_HASH_TABLE_SSE2
+                    ctrl_empty, ctrl_empty, ctrl_empty, ctrl_empty,
+                    ctrl_empty, ctrl_empty, ctrl_empty, ctrl_empty
+#endif
+                };
+
+                return g;
+            }
+
+            inline size_t mix( size_t h ) {
+                uint64_t x = static_cast<uint64_t>( h ) * 0x9E3779B97F4A7C15ULL;
+                return static_cast<size_t>( x ^ ( x >> 32 ) );
+            }
+
+            inline size_t h1( size_t hash ) {
+                return hash >> 7;
+            }
+
+            inline ctrl_t h2( size_t hash ) {
+                return static_cast<ctrl_t>( hash & 0x7F );
+            }
+
+            //Tables smaller than a group would get no empty slot at all at 7/8, and probing relies on one
+            inline size_t capacity_to_growth( size_t capacity ) {
+                if ( capacity < group::width ) {
+                    return capacity == 0 ? 0 : capacity - 1;
+                }
+
+                return capacity - capacity / 8;
+            }
+
+            //Smallest valid capacity holding n elements without growing
+            inline size_t growth_to_capacity( size_t n ) {
+                size_t capacity = group::width - 1;
+
+                while ( capacity_to_growth( capacity ) < n ) {
+                    capacity = capacity * 2 + 1;
+                }
+
+                return capacity;
+            }
+
+            struct probe_seq {
+                size_t mask;
+                size_t offset;
+                size_t index;
+
+                probe_seq( size_t hash, size_t m ) : mask( m ), offset( hash & m ), index( 0 ) {}
+
+                inline size_t at( size_t i ) const {
+                    return ( this->offset + i ) & this->mask;
+                }
+
+                inline void next() {
+                    this->index += group::width;
+                    this->offset = ( this->offset + this->index ) & this->mask;
+                }
+            };
+        }
+    }
+}
+
+template <typename K, typename V, typename H, typename E>
+class DataAdapter<da::hash_table<K, V, H, E> >
+    : public DataAdapterBase<da::hash_table<K, V, H, E>, std::pair<const K, V>, DataAdapter<da::hash_table<K, V, H, E> > > {
+    public:
+        typedef DataAdapterBase<da::hash_table<K, V, H, E>, std::pair<const K, V>, DataAdapter<da::hash_table<K, V, H, E> > > _Base;
+
+        typedef typename _Base::value_type              value_type;
+        typedef typename _Base::element_type            element_type;
+        typedef typename _Base::pointer_type            pointer_type;
+        typedef typename _Base::size_type               size_type;
+
+        typedef typename _Base::iterator                iterator;
+        typedef typename _Base::const_iterator          const_iterator;
+
+        typedef K                                       key_type;
+        typedef V                                       mapped_type;
+        typedef H                                       hasher;
+        typedef E                                       key_equal;
+
+        friend class DataApapterIterator<value_type>;
+        friend class DataApapterIterator<const value_type>;
+
+    private:
+        typedef da::detail::hash_table::ctrl_t          ctrl_t;
+        typedef da::detail::hash_table::group           group;
+        typedef da::detail::hash_table::probe_seq       probe_seq;
+
+        typedef std::allocator<element_type>            slot_allocator;
+        typedef std::allocator<ctrl_t>                  ctrl_allocator;
+
+        ctrl_t *ctrl;
+        element_type *slots;
+        size_type used_length;
+        size_type slot_count;
+        size_type growth_left;
+
+        hasher hash_fn;
+        key_equal eq_fn;
+
+        inline size_type hash_of( const key_type &key ) const {
+            return da::detail::hash_table::mix( this->hash_fn( key ) );
+        }
+
+        //Writes a control byte and its clone past the sentinel, if it has one
+        inline void set_ctrl( size_type i, ctrl_t h ) {
+            const size_type cloned = group::width - 1;
+
+            this->ctrl[i] = h;
+            this->ctrl[( ( i - cloned ) & this->slot_count ) + ( cloned & this->slot_count )] = h;
+        }
+
+        void reset_ctrl() {
+            std::fill( this->ctrl, this->ctrl + this->slot_count + group::width, da::detail::hash_table::ctrl_empty );
+            this->ctrl[this->slot_count] = da::detail::hash_table::ctrl_sentinel;
+            this->growth_left = da::detail::hash_table::capacity_to_growth( this->slot_count ) - this->used_length;
+        }
+
+        //Index of the slot holding key, or slot_count if there is none
+        size_type find_index( const key_type &key ) const {
+            size_type hash = this->hash_of( key );
+            probe_seq seq( da::detail::hash_table::h1( hash ), this->slot_count );
+
+            for ( ;; ) {
+                group g( this->ctrl + seq.offset );
+
+                for ( typename group::mask_type m = g.match( da::detail::hash_table::h2( hash ) ); m; ) {
+                    size_type i = seq.at( m.next() );
+
+                    if ( this->eq_fn( this->slots[i].first, key ) ) {
+                        return i;
+                    }
+                }
+
+                if ( g.match_empty() ) {
+                    return this->slot_count;
+                }
+
+                seq.next();
+            }
+        }
+
+        size_type find_first_non_full( size_type hash ) const {
+            probe_seq seq( da::detail::hash_table::h1( hash ), this->slot_count );
+
+            for ( ;; ) {
+                typename group::mask_type m = group( this->ctrl + seq.offset ).match_empty_or_deleted();
+
+                if ( m ) {
+                    return seq.at( m.lowest() );
+                }
+
+                seq.next();
+            }
+        }
+
+        /*
+            Finds a free slot for an element with the given hash, growing first if need be. Nothing is claimed
+            yet: the caller constructs the element there and then calls claim(), so a constructor that throws
+            leaves the table as it was.
+        */
+        size_type prepare_insert( size_type hash ) {
+            size_type target = this->find_first_non_full( hash );
+
+            if ( this->growth_left == 0 && this->ctrl[target] != da::detail::hash_table::ctrl_deleted ) {
+                this->grow();
+                target = this->find_first_non_full( hash );
+            }
+
+            return target;
+        }
+
+        //Marks the slot prepare_insert() gave as full, once its element is constructed
+        void claim( size_type target, size_type hash ) {
+            ++this->used_length;
+
+            if ( this->ctrl[target] == da::detail::hash_table::ctrl_empty ) {
+                --this->growth_left;
+            }
+
+            this->set_ctrl( target, da::detail::hash_table::h2( hash ) );
+        }
+
+        /*
+            Either the slot already holding key, and true, or a free one from prepare_insert(), and false.
+            hash is set to the hash of key for the claim() that follows.
+        */
+        std::pair<size_type, bool> find_or_prepare_insert( const key_type &key, size_type &hash ) {
+            size_type i = this->find_index( key );
+
+            if ( i != this->slot_count ) {
+                return std::pair<size_type, bool>( i, true );
+
+            } else {
+                hash = this->hash_of( key );
+                return std::pair<size_type, bool>( this->prepare_insert( hash ), false );
+            }
+        }
+
+        void grow() {
+            if ( this->slot_count == 0 ) {
+                this->rehash_to( group::width - 1 );
+
+            } else if ( this->slot_count > group::width && this->used_length * 32 <= this->slot_count * 25 ) {
+                //Mostly tombstones, so clean them up without growing
+                this->rehash_to( this->slot_count );
+
+            } else {
+                this->rehash_to( this->slot_count * 2 + 1 );
+            }
+        }
+
+        /*
+            Everything that can throw, the hasher and both allocations, happens before any member changes,
+            so a failure leaves the table as it was. Moving the elements is taken not to throw.
+        */
+        void rehash_to( size_type new_count ) {
+            std::vector<size_type> hashes;
+            hashes.reserve( this->used_length );
+
+            for ( size_type i = 0; i != this->slot_count; ++i ) {
+                if ( this->ctrl[i] >= 0 ) {
+                    hashes.push_back( this->hash_of( this->slots[i].first ) );
+                }
+            }
+
+            ctrl_allocator ca;
+            slot_allocator sa;
+
+            ctrl_t *new_ctrl = ca.allocate( new_count + group::width );
+            element_type *new_slots;
+
+            try {
+                new_slots = sa.allocate( new_count );
+
+            } catch ( ... ) {
+                ca.deallocate( new_ctrl, new_count + group::width );
+                throw;
+            }
+
+            ctrl_t *old_ctrl = this->ctrl;
+            element_type *old_slots = this->slots;
+            size_type old_count = this->slot_count;
+
+            this->ctrl = new_ctrl;
+            this->slots = new_slots;
+            this->slot_count = new_count;
+
+            this->reset_ctrl();
+
+            for ( size_type i = 0, h = 0; i != old_count; ++i ) {
+                if ( old_ctrl[i] >= 0 ) {
+                    size_type hash = hashes[h++];
+                    size_type target = this->find_first_non_full( hash );
+
+                    ::new( static_cast<void *>( this->slots + target ) ) element_type( std::move( old_slots[i] ) );
+                    old_slots[i].~element_type();
+
+                    this->set_ctrl( target, da::detail::hash_table::h2( hash ) );
+                }
+            }
+
+            this->growth_left = da::detail::hash_table::capacity_to_growth( this->slot_count ) - this->used_length;
+
+            if ( old_count != 0 ) {
+                ca.deallocate( old_ctrl, old_count + group::width );
+                sa.deallocate( old_slots, old_count );
+            }
+        }
+
+        void erase_index( size_type i ) {
+            using da::detail::hash_table::ctrl_empty;
+            using da::detail::hash_table::ctrl_deleted;
+
+            this->slots[i].~element_type();
+            --this->used_length;
+
+            /*
+                If the window around the slot was never entirely full, no probe sequence ever
+                went past it, so it can go straight back to empty instead of becoming a tombstone.
+            */
+            size_type before = ( i - group::width ) & this->slot_count;
+
+            typename group::mask_type empty_after = group( this->ctrl + i ).match_empty();
+            typename group::mask_type empty_before = group( this->ctrl + before ).match_empty();
+
+            bool never_full = empty_before && empty_after &&
+                              static_cast<size_type>( empty_after.trailing() + empty_before.leading() ) < group::width;
+
+            this->set_ctrl( i, never_full ? ctrl_empty : ctrl_deleted );
+
+            if ( never_full ) {
+                ++this->growth_left;
+            }
+        }
+
+        void destroy_all() {
+            for ( size_type i = 0; i != this->slot_count; ++i ) {
+                if ( this->ctrl[i] >= 0 ) {
+                    this->slots[i].~element_type();
+                }
+            }
+        }
+
+        void release() {
+            this->destroy_all();
+
+            if ( this->slot_count != 0 ) {
+                ctrl_allocator().deallocate( this->ctrl, this->slot_count + group::width );
+                slot_allocator().deallocate( this->slots, this->slot_count );
+            }
+
+            this->ctrl = da::detail::hash_table::empty_group();
+            this->slots = NULL;
+            this->used_length = 0;
+            this->slot_count = 0;
+            this->growth_left = 0;
+        }
+
+        inline iterator iterator_at( size_type i ) {
+            return iterator( this->ctrl + i, this->slots + i );
+        }
+
+        inline const_iterator iterator_at( size_type i ) const {
+            return const_iterator( this->ctrl + i, this->slots + i );
+        }
+
+        //Index of the slot an iterator points to
+        inline size_type index_of( const_iterator it ) const {
+            return it.ctrl - this->ctrl;
+        }
+
+    public:
+        explicit DataAdapter( size_type n = 0, const hasher &hf = hasher(), const key_equal &eq = key_equal() )
+            : ctrl( da::detail::hash_table::empty_group() ), slots( NULL ), used_length( 0 ), slot_count( 0 ), growth_left( 0 ),
+              hash_fn( hf ), eq_fn( eq ) {
+            this->reserve( n );
+        }
+
+        template <typename _InputIterator>
+        DataAdapter( _InputIterator first, _InputIterator last, size_type n = 0 )
+            : ctrl( da::detail::hash_table::empty_group() ), slots( NULL ), used_length( 0 ), slot_count( 0 ), growth_left( 0 ) {
+            this->reserve( n );
+            this->insert( first, last );
+        }
+
+        DataAdapter( std::initializer_list<element_type> il )
+            : ctrl( da::detail::hash_table::empty_group() ), slots( NULL ), used_length( 0 ), slot_count( 0 ), growth_left( 0 ) {
+            this->reserve( il.size() );
+            this->insert( il.begin(), il.end() );
+        }
+
+        DataAdapter( const DataAdapter &a )
+            : ctrl( da::detail::hash_table::empty_group() ), slots( NULL ), used_length( 0 ), slot_count( 0 ), growth_left( 0 ),
+              hash_fn( a.hash_fn ), eq_fn( a.eq_fn ) {
+            this->reserve( a.length() );
+
+            for ( const_iterator it = a.cbegin(); it != a.cend(); ++it ) {
+                //Keys are known to be unique, so only a free slot is needed
+                size_type hash = this->hash_of( it->first );
+                size_type i = this->prepare_insert( hash );
+
+                ::new( static_cast<void *>( this->slots + i ) ) element_type( *it );
+                this->claim( i, hash );
+            }
+        }
+
+        DataAdapter( DataAdapter &&a )
+            : ctrl( a.ctrl ), slots( a.slots ), used_length( a.used_length ), slot_count( a.slot_count ), growth_left( a.growth_left ),
+              hash_fn( std::move( a.hash_fn ) ), eq_fn( std::move( a.eq_fn ) ) {
+            a.ctrl = da::detail::hash_table::empty_group();
+            a.slots = NULL;
+            a.used_length = 0;
+            a.slot_count = 0;
+            a.growth_left = 0;
+        }
+
+        DataAdapter &operator=( const DataAdapter &a ) {
+            if ( this != &a ) {
+                DataAdapter tmp( a );
+                this->swap( tmp );
+            }
+
+            return *this;
+        }
+
+        DataAdapter &operator=( DataAdapter &&a ) {
+            if ( this != &a ) {
+                this->release();
+                this->swap( a );
+            }
+
+            return *this;
+        }
+
+        ~DataAdapter() {
+            this->release();
+        }
+
+        void swap( DataAdapter &a ) {
+            std::swap( this->ctrl, a.ctrl );
+            std::swap( this->slots, a.slots );
+            std::swap( this->used_length, a.used_length );
+            std::swap( this->slot_count, a.slot_count );
+            std::swap( this->growth_left, a.growth_left );
+            std::swap( this->hash_fn, a.hash_fn );
+            std::swap( this->eq_fn, a.eq_fn );
+        }
+
+        //Same keys with equal values, whatever the order
+        bool operator==( const DataAdapter &da ) const {
+            if ( this->length() != da.length() ) {
+                return false;
+            }
+
+            for ( const_iterator it = this->cbegin(); it != this->cend(); ++it ) {
+                const_iterator other = da.find( it->first );
+
+                if ( other == da.cend() || !( other->second == it->second ) ) {
+                    return false;
+                }
+            }
+
+            return true;
+        }
+
+        //Hash tables have no meaningful order, so this only orders by size
+        inline int compare( const DataAdapter &da ) const {
+            return da::detail::compare_lengths( this->length(), da.length() );
+        }
+
+        inline bool operator<( const DataAdapter &da ) const {
+            return this->length() < da.length();
+        }
+
+        //The same for equal tables, whatever order their entries are in, since the entries' hashes are added up
+        size_type hash() const {
+            size_type h = 0;
+
+            for ( const_iterator it = this->cbegin(); it != this->cend(); ++it ) {
+                size_t k = this->hash_fn( it->first );
+                da::detail::hasher entry;
+
+                entry.update( &k, sizeof( k ) );
+                da::detail::hash_element( entry, it->second, da::detail::bool_tag<da::is_trivially_comparable<V>::value>() );
+
+                h += entry.finish();
+            }
+
+            return h;
+        }
+
+        inline size_type length() const {
+            return this->used_length;
+        }
+
+        inline size_type size() const {
+            return this->used_length;
+        }
+
+        inline size_type capacity() const {
+            return this->used_length + this->growth_left;
+        }
+
+        inline size_type bucket_count() const {
+            return this->slot_count;
+        }
+
+        inline float load_factor() const {
+            return this->slot_count != 0 ? static_cast<float>( this->used_length ) / static_cast<float>( this->slot_count ) : 0.0f;
+        }
+
+        inline float max_load_factor() const {
+            return 7.0f / 8.0f;
+        }
+
+        inline hasher hash_function() const {
+            return this->hash_fn;
+        }
+
+        inline key_equal key_eq() const {
+            return this->eq_fn;
+        }
+
+        //Makes room for n elements in total without rehashing
+        void reserve( size_type n ) {
+            if ( n > this->capacity() ) {
+                this->rehash_to( da::detail::hash_table::growth_to_capacity( n ) );
+            }
+        }
+
+        //Rehashes into at least n slots, or the fewest that hold the current elements
+        void rehash( size_type n ) {
+            size_type count = da::detail::hash_table::growth_to_capacity( this->used_length );
+
+            while ( count < n ) {
+                count = count * 2 + 1;
+            }
+
+            if ( this->used_length == 0 && n == 0 ) {
+                this->release();
+
+            } else if ( count != this->slot_count ) {
+                this->rehash_to( count );
+            }
+        }
+
+        iterator begin() {
+            iterator it = this->iterator_at( 0 );
+            it.skip_empty_or_deleted();
+            return it;
+        }
+
+        iterator end() {
+            return this->iterator_at( this->slot_count );
+        }
+
+        const_iterator cbegin() const {
+            const_iterator it = this->iterator_at( 0 );
+            it.skip_empty_or_deleted();
+            return it;
+        }
+
+        const_iterator cend() const {
+            return this->iterator_at( this->slot_count );
+        }
+
+        inline const_iterator begin() const {
+            return this->cbegin();
+        }
+
+        inline const_iterator end() const {
+            return this->cend();
+        }
+
+        iterator find( const key_type &key ) {
+            return this->iterator_at( this->find_index( key ) );
+        }
+
+        const_iterator find( const key_type &key ) const {
+            return this->iterator_at( this->find_index( key ) );
+        }
+
+        inline iterator find( const element_type &e ) {
+            return this->find( e.first );
+        }
+
+        inline iterator find_sorted( const element_type &e ) {
+            return this->find( e.first );
+        }
+
+        inline size_type count( const key_type &key ) const {
+            return this->find_index( key ) != this->slot_count ? 1 : 0;
+        }
+
+        inline bool contains( const key_type &key ) const {
+            return this->find_index( key ) != this->slot_count;
+        }
+
+        inline size_type count( const element_type &e ) const {
+            return this->count( e.first );
+        }
+
+        inline bool contains( const element_type &e ) const {
+            return this->contains( e.first );
+        }
+
+        std::pair<iterator, bool> insert( const element_type &e ) {
+            size_type hash;
+            std::pair<size_type, bool> r = this->find_or_prepare_insert( e.first, hash );
+
+            if ( !r.second ) {
+                ::new( static_cast<void *>( this->slots + r.first ) ) element_type( e );
+                this->claim( r.first, hash );
+            }
+
+            return std::pair<iterator, bool>( this->iterator_at( r.first ), !r.second );
+        }
+
+        std::pair<iterator, bool> insert( element_type &&e ) {
+            size_type hash;
+            std::pair<size_type, bool> r = this->find_or_prepare_insert( e.first, hash );
+
+            if ( !r.second ) {
+                ::new( static_cast<void *>( this->slots + r.first ) ) element_type( std::move( e ) );
+                this->claim( r.first, hash );
+            }
+
+            return std::pair<iterator, bool>( this->iterator_at( r.first ), !r.second );
+        }
+
+        template <typename _InputIterator>
+        void insert( _InputIterator first, _InputIterator last ) {
+            for ( ; first != last; ++first ) {
+                this->insert( *first );
+            }
+        }
+
+        //Only constructs the value if key isn't there yet
+        template <typename _Key, typename... Args>
+        std::pair<iterator, bool> try_emplace( _Key &&key, Args &&... args ) {
+            size_type hash;
+            std::pair<size_type, bool> r = this->find_or_prepare_insert( key, hash );
+
+            if ( !r.second ) {
+                ::new( static_cast<void *>( this->slots + r.first ) )
+                element_type( std::piecewise_construct,
+                              std::forward_as_tuple( std::forward<_Key>( key ) ),
+                              std::forward_as_tuple( std::forward<Args>( args )... ) );
+
+                this->claim( r.first, hash );
+            }
+
+            return std::pair<iterator, bool>( this->iterator_at( r.first ), !r.second );
+        }
+
+        template <typename... Args>
+        std::pair<iterator, bool> emplace( Args &&... args ) {
+            return this->insert( element_type( std::forward<Args>( args )... ) );
+        }
+
+        template <typename _Key, typename _Value>
+        std::pair<iterator, bool> insert_or_assign( _Key &&key, _Value &&value ) {
+            std::pair<iterator, bool> r = this->try_emplace( std::forward<_Key>( key ), std::forward<_Value>( value ) );
+
+            if ( !r.second ) {
+                r.first->second = std::forward<_Value>( value );
+            }
+
+            return r;
+        }
+
+        inline mapped_type &operator[]( const key_type &key ) {
+            return this->try_emplace( key ).first->second;
+        }
+
+        inline mapped_type &operator[]( key_type &&key ) {
+            return this->try_emplace( std::move( key ) ).first->second;
+        }
+
+        size_type erase( const key_type &key ) {
+            size_type i = this->find_index( key );
+
+            if ( i != this->slot_count ) {
+                this->erase_index( i );
+                return 1;
+
+            } else {
+                return 0;
+            }
+        }
+
+        iterator erase( iterator pos ) {
+            iterator next = pos;
+            ++next;
+
+            this->erase_index( this->index_of( pos ) );
+
+            return next;
+        }
+
+        iterator erase( iterator first, iterator last ) {
+            while ( first != last ) {
+                first = this->erase( first );
+            }
+
+            return last;
+        }
+
+        void clear() {
+            this->destroy_all();
+            this->used_length = 0;
+
+            if ( this->slot_count != 0 ) {
+                this->reset_ctrl();
+            }
+        }
+
+        //Common interface
+
+        inline void push_back( const element_type &e ) {
+            this->insert( e );
+        }
+
+        inline void push_front( const element_type &e ) {
+            this->insert( e );
+        }
+
+        inline void push_back( element_type &&e ) {
+            this->insert( std::move( e ) );
+        }
+
+        inline void push_front( element_type &&e ) {
+            this->insert( std::move( e ) );
+        }
+
+        element_type pop_back() {
+            if ( !this->empty() ) {
+                size_type i = this->index_of( this->back_iterator() );
+                element_type ret( std::move( this->slots[i] ) );
+
+                this->erase_index( i );
+
+                return ret;
+
+            } else {
+                return element_type();
+            }
+        }
+
+        element_type pop_front() {
+            if ( !this->empty() ) {
+                size_type i = this->index_of( this->cbegin() );
+                element_type ret( std::move( this->slots[i] ) );
+
+                this->erase_index( i );
+
+                return ret;
+
+            } else {
+                return element_type();
+            }
+        }
+
+        //nth element in iteration order
+        element_type &at( size_type n ) {
+            iterator it = this->begin();
+            std::advance( it, n );
+            return *it;
+        }
+
+        const element_type at( size_type n ) const {
+            const_iterator it = this->cbegin();
+            std::advance( it, n );
+            return *it;
+        }
+
+        inline element_type &at( iterator it ) {
+            return *it;
+        }
+
+        inline const element_type at( const_iterator it ) const {
+            return *it;
+        }
+
+        inline element_type &front() {
+            return *this->begin();
+        }
+
+        inline element_type front() const {
+            return *this->cbegin();
+        }
+
+        inline element_type &back() {
+            return this->slots[this->index_of( this->back_iterator() )];
+        }
+
+        inline element_type back() const {
+            return *this->back_iterator();
+        }
+
+        inline iterator insert( iterator, const element_type &e ) {
+            return this->insert( e ).first;
+        }
+
+        inline iterator insert( iterator, element_type &&e ) {
+            return this->insert( std::move( e ) ).first;
+        }
+
+        //Keys are unique, so any n above zero inserts once
+        iterator insert( iterator, size_type n, const element_type &e ) {
+            if ( n != 0 ) {
+                return this->insert( e ).first;
+
+            } else {
+                return this->end();
+            }
+        }
+
+        iterator insert( iterator, const_iterator first, const_iterator last ) {
+            if ( first != last ) {
+                key_type key = first->first;
+
+                this->insert( first, last );
+
+                return this->find( key );
+
+            } else {
+                return this->end();
+            }
+        }
+
+        //Any other range, which is only read once, so input iterators are fine too
+        template <typename _InputIterator>
+        iterator insert( iterator, _InputIterator first, _InputIterator last ) {
+            if ( first != last ) {
+                key_type key = this->insert( *first ).first->first;
+
+                this->insert( ++first, last );
+
+                return this->find( key );
+
+            } else {
+                return this->end();
+            }
+        }
+
+        inline iterator sorted_insert( const element_type &e ) {
+            return this->insert( e ).first;
+        }
+
+        inline iterator sorted_insert( element_type &&e ) {
+            return this->insert( std::move( e ) ).first;
+        }
+
+        //There is no position for a whole batch, so this returns end()
+        template <typename _InputIterator>
+        iterator sorted_insert( _InputIterator first, _InputIterator last ) {
+            this->insert( first, last );
+
+            return this->end();
+        }
+
+        //Shrinking drops elements from the end of the iteration order, growing only reserves room
+        size_type resize( size_type n ) {
+            size_type ret = this->length();
+
+            while ( this->length() > n ) {
+                this->erase_index( this->index_of( this->back_iterator() ) );
+            }
+
+            this->reserve( n );
+
+            return ret;
+        }
+
+        inline size_type resize( size_type n, const element_type & ) {
+            return this->resize( n );
+        }
+
+        inline void sort() {}
+        inline void stable_sort() {}
+        inline void sort( unsigned ) {}
+        inline void stable_sort( unsigned ) {}
+
+    private:
+        //Iterator to the last element in iteration order, found by scanning back from the end
+        const_iterator back_iterator() const {
+            size_type i = this->slot_count;
+
+            while ( i != 0 ) {
+                --i;
+
+                if ( this->ctrl[i] >= 0 ) {
+                    return this->iterator_at( i );
+                }
+            }
+
+            return this->cend();
+        }
+};
+
+/*Mutable iterator class template*/
+template <typename K, typename V, typename H, typename E>
+class DataApapterIterator<da::hash_table<K, V, H, E> > {
+    public:
+        typedef std::forward_iterator_tag               iterator_category;
+        typedef std::pair<const K, V>                   value_type;
+        typedef std::ptrdiff_t                          difference_type;
+        typedef value_type                             *pointer;
+        typedef value_type                             &reference;
+
+        typedef DataAdapter<da::hash_table<K, V, H, E> > parent_type;
+
+        friend class DataAdapter<da::hash_table<K, V, H, E> >;
+        friend class DataApapterIterator<const da::hash_table<K, V, H, E> >;
+
+    private:
+        typedef da::detail::hash_table::ctrl_t ctrl_t;
+
+        const ctrl_t *ctrl;
+        value_type *slot;
+
+        DataApapterIterator( const ctrl_t *c, value_type *s ) : ctrl( c ), slot( s ) {}
+
+        //The sentinel is the only non-full byte that stops this
+        inline void skip_empty_or_deleted() {
+            while ( *this->ctrl < da::detail::hash_table::ctrl_sentinel ) {
+                int shift = da::detail::hash_table::group( this->ctrl ).count_leading_empty_or_deleted();
+
+                this->ctrl += shift;
+                this->slot += shift;
+            }
+        }
+
+    public:
+        DataApapterIterator() : ctrl( NULL ), slot( NULL ) {}
+
+        explicit DataApapterIterator( parent_type *x ) : ctrl( NULL ), slot( NULL ) {
+            *this = x->begin();
+        }
+
+        inline bool operator==( const DataApapterIterator &it ) const {
+            return this->ctrl == it.ctrl;
+        }
+
+        inline bool operator!=( const DataApapterIterator &it ) const {
+            return this->ctrl != it.ctrl;
+        }
+
+        inline reference operator*() const {
+            return *this->slot;
+        }
+
+        inline pointer operator->() const {
+            return this->slot;
+        }
+
+        inline DataApapterIterator &operator++() {
+            ++this->ctrl;
+            ++this->slot;
+            this->skip_empty_or_deleted();
+            return *this;
+        }
+
+        inline DataApapterIterator operator++( int ) {
+            DataApapterIterator tmp( *this );
+            ++*this;
+            return tmp;
+        }
+
+        //VERY IMPORTANT for converting and comparing to const_iterators
+        inline operator typename parent_type::const_iterator() const {
+            return typename parent_type::const_iterator( this->ctrl, this->slot );
+        }
+};
+
+/*Immutable iterator class template*/
+template <typename K, typename V, typename H, typename E>
+class DataApapterIterator<const da::hash_table<K, V, H, E> > {
+    public:
+        typedef std::forward_iterator_tag               iterator_category;
+        typedef std::pair<const K, V>                   value_type;
+        typedef std::ptrdiff_t                          difference_type;
+        typedef const value_type                       *pointer;
+        typedef const value_type                       &reference;
+
+        typedef DataAdapter<da::hash_table<K, V, H, E> > parent_type;
+
+        friend class DataAdapter<da::hash_table<K, V, H, E> >;
+        friend class DataApapterIterator<da::hash_table<K, V, H, E> >;
+
+    private:
+        typedef da::detail::hash_table::ctrl_t ctrl_t;
+
+        const ctrl_t *ctrl;
+        const value_type *slot;
+
+        DataApapterIterator( const ctrl_t *c, const value_type *s ) : ctrl( c ), slot( s ) {}
+
+        inline void skip_empty_or_deleted() {
+            while ( *this->ctrl < da::detail::hash_table::ctrl_sentinel ) {
+                int shift = da::detail::hash_table::group( this->ctrl ).count_leading_empty_or_deleted();
+
+                this->ctrl += shift;
+                this->slot += shift;
+            }
+        }
+
+    public:
+        DataApapterIterator() : ctrl( NULL ), slot( NULL ) {}
+
+        explicit DataApapterIterator( const parent_type *x ) : ctrl( NULL ), slot( NULL ) {
+            *this = x->cbegin();
+        }
+
+        inline bool operator==( const DataApapterIterator &it ) const {
+            return this->ctrl == it.ctrl;
+        }
+
+        inline bool operator!=( const DataApapterIterator &it ) const {
+            return this->ctrl != it.ctrl;
+        }
+
+        inline reference operator*() const {
+            return *this->slot;
+        }
+
+        inline pointer operator->() const {
+            return this->slot;
+        }
+
+        inline DataApapterIterator &operator++() {
+            ++this->ctrl;
+            ++this->slot;
+            this->skip_empty_or_deleted();
+            return *this;
+        }
+
+        inline DataApapterIterator operator++( int ) {
+            DataApapterIterator tmp( *this );
+            ++*this;
+            return tmp;
+        }
+};
+
+#endif // DATA_ADAPTER_HASH_TABLE_HPP_INCLUDED
@@ -0,0 +1,421 @@
+#ifndef DATA_ADAPTER_MAPPED_HPP_INCLUDED
+#define DATA_ADAPTER_MAPPED_HPP_INCLUDED
+
+#include "../data_adapter.hpp"
+
+#if !DATA_ADAPTER_CXX11
+#error "DataAdapter<da::mapped<T> > requires C++11"
+#endif // DATA_ADAPTER_CXX11
+
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <string>
+#include <type_traits>
+
+#include "../detail/allocator.hpp"
+#include "../detail/contiguous_iterator.hpp"
+#include "../detail/growable.hpp"
+#include "../io/snapshot.hpp"
+
+#if !DATA_ADAPTER_HAS_MMAP
+#error "DataAdapter<da::mapped<T> > requires mmap"
+#endif // DATA_ADAPTER_HAS_MMAP
+
+/**
+ *              Notes on the implementation of this:
+ *
+ *      This is da::dynamic with its block in a memory mapped file instead of on the heap, for arrays too big
+ * to copy around at startup, or to share between processes. Everything but where the block comes from is
+ * detail/growable.hpp, through an allocator, da::detail::mapped_allocator, that maps the file: the block is
+ * the file past a 64 byte header, which makes it the snapshot format of io/snapshot.hpp. So a file written
+ * by a mapped adapter can be read with da::load, or mapped read only by any number of other processes with
+ * da::load_mapped, and a snapshot saved with da::save can be opened as a mapped adapter and changed in place.
+ *
+ *      Growing extends the file with ftruncate and remaps it, with mremap where there is one, so the elements
+ * are never copied, and neither is anything else: pages are only read in from the page cache or the disk
+ * when they are touched, and only the ones that changed are written back. Opening a file maps it as it is,
+ * with as much capacity as it holds, without reading or writing any of the elements.
+ *
+ *      The length in the header is only brought up to date by flush(), and when the adapter goes away, since
+ * keeping it up to date on every change would dirty the header's page all the time. The checksum is only
+ * taken by flush(), since that means reading every element. When the adapter goes away, the header always
+ * marks the checksum as stale, even right after a flush, since elements change through references it never
+ * sees. da::load then skips the check and mapped_snapshot::verify() fails, and closing a file never costs
+ * more than writing its header. flush() also waits until the file is on the disk, with msync. Until then,
+ * the kernel writes pages back whenever it likes, so a process that dies without flushing leaves the
+ * elements it changed in the file, but with the length of the last flush or close.
+ *
+ *      advise() passes an access pattern on to madvise for the whole file, and it is applied again every time
+ * the file is remapped. Sequential is for scans, random for lookups, and willneed starts reading the file in
+ * ahead of time, which is the way to warm it up after a restart.
+ *
+ *      A default constructed adapter has an anonymous mapping, with nothing to flush, which is mostly useful
+ * for code that takes any adapter. Mapped adapters can't be copied, moved or swapped, since that would mean
+ * two of them writing to the same file. Elements must be trivially copyable, and are never constructed or
+ * destroyed as far as the file is concerned.
+ */
+
+namespace da {
+    template <typename T>
+    struct mapped {};
+
+    //Access patterns for DataAdapter<da::mapped<T> >::advise
+    struct advice {
+        enum type {
+            normal,
+            sequential,
+            random,
+            willneed
+        };
+    };
+
+    namespace detail {
+
+        //The file a mapped adapter is in, and where it is mapped, shared by every copy of its allocator
+        struct file_mapping {
+            int fd;
+            char *base;
+            size_t bytes;
+            advice::type hint;
+
+            file_mapping() : fd( -1 ), base( NULL ), bytes( 0 ), hint( advice::normal ) {}
+
+            ~file_mapping() {
+                if ( this->base != NULL ) {
+                    ::munmap( this->base, this->bytes );
+                }
+
+                if ( this->fd >= 0 ) {
+                    ::close( this->fd );
+                }
+            }
+
+            void advise() {
+                static const int advices[] = { MADV_NORMAL, MADV_SEQUENTIAL, MADV_RANDOM, MADV_WILLNEED };
+
+                if ( this->base != NULL ) {
+                    ::madvise( this->base, this->bytes, advices[this->hint] );
+                }
+            }
+
+            //Maps the first bytes of the file, which must be at least that long, or anonymous memory without one
+            bool map( size_t n ) {
+                void *p = this->fd >= 0 ? ::mmap( NULL, n, PROT_READ | PROT_WRITE, MAP_SHARED, this->fd, 0 )
+                                        : ::mmap( NULL, n, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0 );
+
+                if ( p == MAP_FAILED ) {
+                    return false;
+                }
+
+                this->base = static_cast<char *>( p );
+                this->bytes = n;
+                this->advise();
+
+                return true;
+            }
+
+            void unmap() {
+                if ( this->base != NULL ) {
+                    ::munmap( this->base, this->bytes );
+
+                    this->base = NULL;
+                    this->bytes = 0;
+                }
+            }
+
+            //Resizes the mapping to n bytes, extending or truncating the file first
+            bool remap( size_t n ) {
+                if ( this->fd >= 0 && ::ftruncate( this->fd, static_cast<off_t>( n ) ) != 0 ) {
+                    return false;
+                }
+
+                if ( this->base == NULL ) {
+                    return this->map( n );
+                }
+
+#if defined(__linux__) && defined(MREMAP_MAYMOVE)
+                void *p = ::mremap( this->base, this->bytes, n, MREMAP_MAYMOVE );
+
+                if ( p == MAP_FAILED ) {
+                    return false;
+                }
+
+                this->base = static_cast<char *>( p );
+                this->bytes = n;
+                this->advise();
+
+                return true;
+#else
+                //The file keeps the contents, but anonymous memory has to be copied
+                char *old = this->base;
+                size_t old_bytes = this->bytes;
+
+                if ( !this->map( n ) ) {
+                    this->base = old;
+                    return false;
+                }
+
+                if ( this->fd < 0 ) {
+                    std::memcpy( this->base, old, old_bytes < n ? old_bytes : n );
+                }
+
+                ::munmap( old, old_bytes );
+
+                return true;
+#endif
+            }
+        };
+
+        /*
+            Hands out the part of the file past the header as the block for n elements. There is only ever one
+            block at a time, which the adapter makes sure of, and deallocating it only unmaps it, the file
+            keeps its contents and its size.
+        */
+        template <typename T>
+        class mapped_allocator {
+            public:
+                typedef T               value_type;
+                typedef T              *pointer;
+                typedef const T        *const_pointer;
+                typedef T              &reference;
+                typedef const T        &const_reference;
+                typedef std::size_t     size_type;
+                typedef std::ptrdiff_t  difference_type;
+
+                template <typename U>
+                struct rebind {
+                    typedef mapped_allocator<U> other;
+                };
+
+                std::shared_ptr<file_mapping> file;
+
+                mapped_allocator() : file( std::make_shared<file_mapping>() ) {}
+
+                template <typename U>
+                mapped_allocator( const mapped_allocator<U> &a ) : file( a.file ) {}
+
+                pointer allocate( size_type n, const void * = 0 ) {
+                    if ( n > this->max_size() || !this->file->remap( sizeof( snapshot_header ) + n * sizeof( T ) ) ) {
+                        throw std::bad_alloc();
+                    }
+
+                    return reinterpret_cast<pointer>( this->file->base + sizeof( snapshot_header ) );
+                }
+
+                inline pointer reallocate( pointer, size_type, size_type new_n ) {
+                    return this->allocate( new_n );
+                }
+
+                inline void deallocate( pointer, size_type ) {
+                    this->file->unmap();
+                }
+
+                inline size_type max_size() const {
+                    return ( static_cast<size_type>( -1 ) - sizeof( snapshot_header ) ) / sizeof( T );
+                }
+        };
+
+        template <typename T, typename U>
+        inline bool operator==( const mapped_allocator<T> &a, const mapped_allocator<U> &b ) {
+            return a.file == b.file;
+        }
+
+        template <typename T, typename U>
+        inline bool operator!=( const mapped_allocator<T> &a, const mapped_allocator<U> &b ) {
+            return a.file != b.file;
+        }
+    }
+
+    template <typename T>
+    struct allocator_reallocates<da::detail::mapped_allocator<T> > {
+        static const bool value = true;
+    };
+}
+
+template <typename T>
+class DataAdapter<da::mapped<T> > : public da::detail::growable<da::mapped<T>, T, da::detail::mapped_allocator<T>, 0> {
+    public:
+        typedef da::detail::growable<da::mapped<T>, T, da::detail::mapped_allocator<T>, 0> _Growable;
+
+        typedef typename _Growable::element_type        element_type;
+        typedef typename _Growable::size_type           size_type;
+        typedef typename _Growable::allocator_type      allocator_type;
+
+    private:
+        static_assert( std::is_trivially_copyable<T>::value, "DataAdapter<da::mapped<T> > needs trivially copyable elements" );
+        static_assert( alignof( T ) <= sizeof( da::snapshot_header ), "DataAdapter<da::mapped<T> > elements can't be aligned past the header" );
+
+        inline da::detail::file_mapping &file() const {
+            return *this->get_allocator().file;
+        }
+
+        //Brings the header in the file up to date with the length and capacity, and the checksum or that it is stale
+        void write_header( bool checked ) {
+            da::detail::file_mapping &f = this->file();
+
+            if ( f.fd < 0 ) {
+                return;
+            }
+
+            da::snapshot_header h;
+
+            std::memset( &h, 0, sizeof( h ) );
+            std::memcpy( h.magic, da::detail::snapshot_magic, sizeof( h.magic ) );
+
+            h.version = da::snapshot_header::current_version;
+            h.byte_order = da::snapshot_header::native_byte_order;
+            h.element_size = sizeof( T );
+            h.header_size = sizeof( da::snapshot_header );
+            h.length = this->length();
+            h.capacity = this->capacity();
+
+            if ( checked ) {
+                h.checksum = da::detail::checksum( this->data(), this->length() * sizeof( T ) );
+
+            } else {
+                h.flags = da::snapshot_header::stale_checksum;
+            }
+
+            if ( f.base != NULL ) {
+                std::memcpy( f.base, &h, sizeof( h ) );
+
+            } else if ( ::pwrite( f.fd, &h, sizeof( h ), 0 ) != static_cast<ssize_t>( sizeof( h ) ) ) {
+                throw da::snapshot_error( "DataAdapter::flush: Can't write the header" );
+            }
+        }
+
+    public:
+        //Anonymous memory, without a file
+        DataAdapter() {}
+
+        /*
+            Opens the snapshot file at path, or creates an empty one if there is nothing there, and maps it.
+            Throws a da::snapshot_error if it can't, or if the file isn't a snapshot of T.
+        */
+        explicit DataAdapter( const char *path ) {
+            da::detail::file_mapping &f = this->file();
+
+            f.fd = ::open( path, O_RDWR | O_CREAT, 0644 );
+
+            if ( f.fd < 0 ) {
+                throw da::snapshot_error( std::string( "DataAdapter::open: Can't open " ) + path );
+            }
+
+            struct stat st;
+
+            if ( ::fstat( f.fd, &st ) != 0 ) {
+                throw da::snapshot_error( std::string( "DataAdapter::open: Can't open " ) + path );
+            }
+
+            if ( st.st_size == 0 ) {
+                this->write_header( true );
+                return;
+            }
+
+            da::snapshot_header h;
+            std::uint64_t file_size = static_cast<std::uint64_t>( st.st_size );
+
+            if ( ::pread( f.fd, &h, sizeof( h ), 0 ) != static_cast<ssize_t>( sizeof( h ) ) ) {
+                std::memset( &h, 0, sizeof( h ) );
+            }
+
+            da::detail::check_snapshot_header<T>( h, file_size, "open" );
+
+            //Blocks always start right after the header this writes
+            if ( h.header_size != sizeof( da::snapshot_header ) ) {
+                throw da::snapshot_error( "DataAdapter::open: Unsupported version" );
+            }
+
+            size_type cap = static_cast<size_type>( ( file_size - sizeof( h ) ) / sizeof( T ) );
+
+            if ( cap != 0 ) {
+                if ( !f.map( sizeof( h ) + cap * sizeof( T ) ) ) {
+                    throw da::snapshot_error( std::string( "DataAdapter::open: Can't map " ) + path );
+                }
+
+                this->adopt( reinterpret_cast<element_type *>( f.base + sizeof( h ) ), static_cast<size_type>( h.length ), cap );
+            }
+        }
+
+        DataAdapter( const DataAdapter & ) = delete;
+        DataAdapter &operator=( const DataAdapter & ) = delete;
+
+        void swap( DataAdapter & ) = delete;
+
+        //Leaves the header up to date but for the checksum. The rest of the file is written back by the kernel
+        ~DataAdapter() {
+            try {
+                this->write_header( false );
+
+            } catch ( ... ) {
+            }
+        }
+
+        //Writes the header with a fresh checksum and waits until the whole file is on the disk
+        void flush() {
+            da::detail::file_mapping &f = this->file();
+
+            this->write_header( true );
+
+            if ( f.base != NULL ) {
+                if ( ::msync( f.base, f.bytes, MS_SYNC ) != 0 ) {
+                    throw da::snapshot_error( "DataAdapter::flush: msync failed" );
+                }
+
+            } else if ( f.fd >= 0 && ::fsync( f.fd ) != 0 ) {
+                throw da::snapshot_error( "DataAdapter::flush: fsync failed" );
+            }
+        }
+
+        //How the file will be accessed, for the kernel's read ahead, until the next call
+        void advise( da::advice::type a ) {
+            da::detail::file_mapping &f = this->file();
+
+            f.hint = a;
+            f.advise();
+        }
+};
+
+/*Mutable iterator class template*/
+template <typename T>
+class DataApapterIterator<da::mapped<T> >
+    : public da::detail::contiguous_iterator<DataApapterIterator<da::mapped<T> >, DataAdapter<da::mapped<T> >, T> {
+    public:
+        typedef da::detail::contiguous_iterator<DataApapterIterator<da::mapped<T> >, DataAdapter<da::mapped<T> >, T> _Base;
+
+        typedef typename _Base::difference_type         difference_type;
+        typedef typename _Base::parent_type             parent_type;
+
+        DataApapterIterator() {}
+        DataApapterIterator( parent_type *x, difference_type ioff = 0 ) : _Base( x, ioff ) {}
+        DataApapterIterator( parent_type &x, difference_type ioff = 0 ) : _Base( &x, ioff ) {}
+
+        //VERY IMPORTANT for converting and comparing to const_iterators
+        inline operator typename parent_type::const_iterator() const {
+            if ( this->parent != NULL ) {
+                return typename parent_type::const_iterator( this->parent, this->offset() );
+
+            } else {
+                return typename parent_type::const_iterator();
+            }
+        }
+};
+
+/*Immutable iterator class template*/
+template <typename T>
+class DataApapterIterator<const da::mapped<T> >
+    : public da::detail::contiguous_iterator<DataApapterIterator<const da::mapped<T> >, const DataAdapter<da::mapped<T> >, const T> {
+    public:
+        typedef da::detail::contiguous_iterator<DataApapterIterator<const da::mapped<T> >, const DataAdapter<da::mapped<T> >, const T> _Base;
+
+        typedef typename _Base::difference_type         difference_type;
+        typedef typename _Base::parent_type             parent_type;
+
+        DataApapterIterator() {}
+        DataApapterIterator( parent_type *x, difference_type ioff = 0 ) : _Base( x, ioff ) {}
+        DataApapterIterator( parent_type &x, difference_type ioff = 0 ) : _Base( &x, ioff ) {}
+};
+
+#endif // DATA_ADAPTER_MAPPED_HPP_INCLUDED
@@ -0,0 +1,965 @@
+#ifndef DATA_ADAPTER_RING_HPP_INCLUDED
+#define DATA_ADAPTER_RING_HPP_INCLUDED
+
+#include <vector>
+
+#include "../data_adapter.hpp"
+#include "../detail/contiguous_iterator.hpp"
+#include "../detail/radix_sort.hpp"
+
+/**
+ *              Notes on the implementation of this:
+ *
+ *      This is a circular buffer over the same kind of static storage the array adapter uses. Instead of the
+ * elements always starting at storage[0], they start at storage[head] and wrap around the end of the array,
+ * so adding or removing an element at either end only moves head or the length, never the other elements.
+ * That makes it a good fit for fixed capacity queues, where the array adapter has to shift everything for
+ * every push_front and pop_front.
+ *
+ *      Inserting or erasing in the middle still has to move elements, but it only moves whichever side of
+ * the position is shorter, so at most half of them.
+ *
+ *      Everything else is the same as the array adapter, so the two can replace each other: the same
+ * constructors, the same std::out_of_range exceptions when full or out of bounds, and popping an empty
+ * buffer returns a default constructed element. Unlike the array adapter, the storage here is a plain
+ * element_type[N] that is always fully constructed, so clear() still zeros all of it.
+ *
+ *      Iterators are random access, and hold their parent and a logical position, so begin() + 0 is always
+ * the first element whatever head is. They are invalidated the same way as the array adapter's, by
+ * anything that makes their position past the end, but since head moves, an iterator might refer to a
+ * different element after a push_front, pop_front, or an insert or erase that moved the front side.
+ *
+ *      The elements aren't contiguous, so there is no data(). linearize() rotates them so they start at
+ * storage[0] and returns a pointer to them, and sort() and stable_sort() use that to sort plain pointers.
+ */
+
+namespace da {
+    template <typename T, size_t N>
+    struct ring {};
+
+    namespace detail {
+
+        /*
+            Common implementation of the ring buffer iterators, in the same shape as contiguous_iterator.
+
+            The position is a logical offset from the first element, and dereferencing goes through
+            parent->slot(), which does the wrap around.
+        */
+        template <typename _Derived, typename _Parent, typename E>
+        class ring_iterator {
+            public:
+                typedef std::random_access_iterator_tag                 iterator_category;
+                typedef typename remove_const<E>::type                  value_type;
+                typedef std::ptrdiff_t                                  difference_type;
+                typedef E                                              *pointer;
+                typedef E                                              &reference;
+
+                typedef _Parent                                         parent_type;
+
+            protected:
+                parent_type *parent;
+                difference_type off;
+
+                inline _Derived &self() {
+                    return *static_cast<_Derived *>( this );
+                }
+
+                inline const _Derived &self() const {
+                    return *static_cast<const _Derived *>( this );
+                }
+
+            public:
+                ring_iterator() : parent( NULL ), off( 0 ) {}
+
+                ring_iterator( parent_type *x, difference_type ioff ) : parent( x ), off( ioff ) {}
+
+                //Position of the iterator within its parent
+                inline difference_type offset() const {
+                    return this->off;
+                }
+
+                inline parent_type *container() const {
+                    return this->parent;
+                }
+
+                inline bool operator==( const _Derived &it ) const {
+                    return this->parent == it.parent && this->off == it.off;
+                }
+
+                inline bool operator!=( const _Derived &it ) const {
+                    return !( *this == it );
+                }
+
+                inline reference operator*() const {
+                    return this->parent->slot( this->off );
+                }
+
+                inline reference operator[]( difference_type n ) const {
+                    return this->parent->slot( this->off + n );
+                }
+
+                inline pointer operator->() const {
+                    return &this->parent->slot( this->off );
+                }
+
+                inline _Derived &operator++() {
+                    ++this->off;
+                    return self();
+                }
+
+                inline _Derived operator++( int ) {
+                    _Derived tmp( self() );
+                    ++this->off;
+                    return tmp;
+                }
+
+                inline _Derived &operator--() {
+                    --this->off;
+                    return self();
+                }
+
+                inline _Derived operator--( int ) {
+                    _Derived tmp( self() );
+                    --this->off;
+                    return tmp;
+                }
+
+                inline _Derived operator+( const _Derived &it ) const {
+                    _Derived tmp( self() );
+                    tmp.off += it.off;
+                    return tmp;
+                }
+                inline _Derived operator+( difference_type n ) const {
+                    _Derived tmp( self() );
+                    tmp.off += n;
+                    return tmp;
+                }
+                inline _Derived &operator +=( const _Derived &it ) {
+                    this->off += it.off;
+                    return self();
+                }
+                inline _Derived &operator +=( difference_type n ) {
+                    this->off += n;
+                    return self();
+                }
+
+                inline difference_type operator-( const _Derived &it ) const {
+                    return this->off - it.off;
+                }
+                inline _Derived operator-( difference_type n ) const {
+                    _Derived tmp( self() );
+                    tmp.off -= n;
+                    return tmp;
+                }
+                inline _Derived &operator -=( const _Derived &it ) {
+                    this->off -= it.off;
+                    return self();
+                }
+                inline _Derived &operator -=( difference_type n ) {
+                    this->off -= n;
+                    return self();
+                }
+
+                inline bool operator<( const _Derived &it ) const {
+                    return this->off < it.off;
+                }
+                inline bool operator>( const _Derived &it ) const {
+                    return this->off > it.off;
+                }
+                inline bool operator<=( const _Derived &it ) const {
+                    return this->off <= it.off;
+                }
+                inline bool operator>=( const _Derived &it ) const {
+                    return this->off >= it.off;
+                }
+        };
+    }
+}
+
+template <typename T, size_t N>
+class DataAdapter<da::ring<T, N> > : public DataAdapterBase<da::ring<T, N>, T, DataAdapter<da::ring<T, N> > > {
+    public:
+        typedef DataAdapterBase<da::ring<T, N>, T, DataAdapter<da::ring<T, N> > > _Base;
+
+        typedef typename _Base::value_type              value_type;
+        typedef typename _Base::element_type            element_type;
+        typedef typename _Base::pointer_type            pointer_type;
+        typedef typename _Base::size_type               size_type;
+
+        typedef typename _Base::iterator                iterator;
+        typedef typename _Base::const_iterator          const_iterator;
+        typedef typename _Base::reverse_iterator        reverse_iterator;
+        typedef typename _Base::const_reverse_iterator  const_reverse_iterator;
+
+        template <typename, typename, typename> friend class da::detail::ring_iterator;
+
+    private:
+        element_type storage[N];
+        size_type head;
+        size_type used_length;
+
+        //Physical index of logical position n, for any n in [-N, 2N)
+        static inline size_type wrap( std::ptrdiff_t n ) {
+            return static_cast<size_type>( n < 0 ? n + static_cast<std::ptrdiff_t>( N ) :
+                                           n >= static_cast<std::ptrdiff_t>( N ) ? n - static_cast<std::ptrdiff_t>( N ) : n );
+        }
+
+        inline element_type &slot( std::ptrdiff_t n ) {
+            return this->storage[wrap( static_cast<std::ptrdiff_t>( this->head ) + n )];
+        }
+
+        inline const element_type &slot( std::ptrdiff_t n ) const {
+            return this->storage[wrap( static_cast<std::ptrdiff_t>( this->head ) + n )];
+        }
+
+        /*
+            Moves n elements from logical position src to dst, in whichever direction is safe for the
+            overlap. Both ranges are split where they wrap, so every piece is moved with plain pointers
+            and can turn into memmove for simple types, like the array adapter's shifts.
+        */
+        void shift( size_type src, size_type dst, size_type n ) {
+            element_type *d = this->storage;
+
+            DATA_ADAPTER_STAT_ADD( shifted, n )
+
+            if ( dst < src ) {
+                while ( n != 0 ) {
+                    size_type ps = wrap( static_cast<std::ptrdiff_t>( this->head + src ) );
+                    size_type pd = wrap( static_cast<std::ptrdiff_t>( this->head + dst ) );
+                    size_type c = std::min( n, std::min( N - ps, N - pd ) );
+
+                    DATA_ADAPTER_MOVE_RANGE( d + ps, d + ps + c, d + pd );
+
+                    src += c;
+                    dst += c;
+                    n -= c;
+                }
+
+            } else if ( src < dst ) {
+                while ( n != 0 ) {
+                    size_type ps = wrap( static_cast<std::ptrdiff_t>( this->head + src + n - 1 ) ) + 1;
+                    size_type pd = wrap( static_cast<std::ptrdiff_t>( this->head + dst + n - 1 ) ) + 1;
+                    size_type c = std::min( n, std::min( ps, pd ) );
+
+                    DATA_ADAPTER_MOVE_BACKWARD( d + ps - c, d + ps, d + pd );
+
+                    n -= c;
+                }
+            }
+        }
+
+        /*
+            Opens n slots at offset off, by moving either the elements before it down or the ones
+            after it up, whichever are fewer. Bounds are checked by the callers.
+        */
+        void open_gap( size_type off, size_type n ) {
+            size_type len = this->length();
+
+            if ( off < len - off ) {
+                this->head = wrap( static_cast<std::ptrdiff_t>( this->head ) - static_cast<std::ptrdiff_t>( n ) );
+                this->shift( n, 0, off );
+
+            } else {
+                this->shift( off, off + n, len - off );
+            }
+
+            this->used_length = len + n;
+        }
+
+        //Closes [f, l) the same way, moving whichever side is shorter
+        void close_gap( size_type f, size_type l ) {
+            size_type len = this->length();
+
+            if ( f < len - l ) {
+                this->shift( 0, l - f, f );
+                this->head = wrap( static_cast<std::ptrdiff_t>( this->head + ( l - f ) ) );
+
+            } else {
+                this->shift( l, f, len - l );
+            }
+
+            this->used_length = len - ( l - f );
+        }
+
+        //Same as the array adapter's merge_back, through the wrapping slots
+        template <typename _BidirectionalIterator>
+        iterator merge_back( _BidirectionalIterator first, _BidirectionalIterator last ) {
+            size_type len = this->length();
+            size_type i = len;
+            size_type w = i + std::distance( first, last );
+
+            this->used_length = w;
+
+            while ( last != first ) {
+                --last;
+
+                while ( i != 0 && *last < this->slot( i - 1 ) ) {
+                    this->slot( --w ) = DATA_ADAPTER_MOVE( this->slot( --i ) );
+                }
+
+                this->slot( --w ) = DATA_ADAPTER_MOVE( *last );
+            }
+
+            DATA_ADAPTER_STAT_ADD( shifted, len - i )
+
+            return this->begin() + w;
+        }
+
+        /*
+            The range versions of insert, like the array adapter's. Forward ranges open the gap once, on
+            whichever side is shorter, and input ranges are written past the end as they come and rotated
+            into place once.
+        */
+        template <typename _Integer>
+        iterator insert_range( iterator pos, _Integer n, _Integer val, da::detail::integral_range_tag ) {
+            return this->insert( pos, static_cast<size_type>( n ), static_cast<element_type>( val ) );
+        }
+
+        template <typename _ForwardIterator>
+        iterator insert_range( iterator pos, _ForwardIterator first, _ForwardIterator last, std::forward_iterator_tag ) {
+            DATA_ADAPTER_STAT_SCOPE( insert_range )
+
+            size_type off = pos.offset();
+            size_type n = std::distance( first, last );
+
+            if ( n == 0 ) {
+                return this->end();
+            }
+
+            if ( off > this->length() || this->length() + n > this->capacity() ) {
+                DATA_ADAPTER_STAT_ADD( thrown, 1 )
+                throw std::out_of_range( "DataAdapter::insert(range): Out of Range" );
+            }
+
+            //Opening the gap would move our own elements around under first and last
+            if ( da::detail::points_into( first, this->storage, this->storage + N ) ) {
+                std::vector<element_type> tmp( first, last );
+
+                this->open_gap( off, n );
+
+                std::copy( tmp.begin(), tmp.end(), this->begin() + off );
+
+            } else {
+                this->open_gap( off, n );
+
+                std::copy( first, last, this->begin() + off );
+            }
+
+            return this->begin() + off;
+        }
+
+        template <typename _InputIterator>
+        iterator insert_range( iterator pos, _InputIterator first, _InputIterator last, std::input_iterator_tag ) {
+            DATA_ADAPTER_STAT_SCOPE( insert_range )
+
+            size_type off = pos.offset();
+            size_type len = this->length();
+
+            if ( off > len ) {
+                DATA_ADAPTER_STAT_ADD( thrown, 1 )
+                throw std::out_of_range( "DataAdapter::insert(range): Out of Range" );
+            }
+
+            try {
+                for ( ; first != last; ++first ) {
+                    if ( this->full() ) {
+                        DATA_ADAPTER_STAT_ADD( thrown, 1 )
+                        throw std::out_of_range( "DataAdapter::insert(range): Out of Range" );
+                    }
+
+                    this->slot( this->used_length ) = *first;
+                    ++this->used_length;
+                }
+
+            } catch ( ... ) {
+                this->used_length = len;
+                throw;
+            }
+
+            DATA_ADAPTER_STAT_ADD( shifted, len - off )
+
+            std::rotate( this->begin() + off, this->begin() + len, this->end() );
+
+            return this->begin() + off;
+        }
+
+        template <typename _Integer>
+        void assign_range( _Integer n, _Integer val, da::detail::integral_range_tag ) {
+            this->assign( static_cast<size_type>( n ), static_cast<element_type>( val ) );
+        }
+
+        //Resetting head would move our own elements out from under first, so those are copied aside first
+        template <typename _ForwardIterator>
+        void assign_range( _ForwardIterator first, _ForwardIterator last, std::forward_iterator_tag ) {
+            if ( first != last && da::detail::points_into( first, this->storage, this->storage + N ) ) {
+                std::vector<element_type> tmp( first, last );
+
+                this->assign_range( tmp.begin(), tmp.end(), std::forward_iterator_tag() );
+
+            } else {
+                this->head = 0;
+                this->used_length = 0;
+
+                this->insert( this->end(), first, last );
+            }
+        }
+
+        template <typename _InputIterator>
+        void assign_range( _InputIterator first, _InputIterator last, std::input_iterator_tag ) {
+            this->head = 0;
+            this->used_length = 0;
+
+            this->insert( this->end(), first, last );
+        }
+
+        void copy_from( const DataAdapter &a ) {
+            this->head = 0;
+            this->used_length = a.length();
+
+            std::copy( a.begin(), a.end(), this->storage );
+        }
+
+    public:
+        DataAdapter() {
+            this->clear();
+        }
+
+        DataAdapter( size_type n, const element_type &val = element_type() ) {
+            this->clear();
+            this->insert( this->begin(), n, val );
+        }
+
+        explicit DataAdapter( const element_type ( &val )[N] ) {
+            this->clear();
+            this->assign( val, val + N );
+        }
+
+        DataAdapter( const DataAdapter &a ) {
+            this->copy_from( a );
+        }
+
+        DataAdapter &operator=( const DataAdapter &a ) {
+            if ( this != &a ) {
+                this->copy_from( a );
+            }
+
+            return *this;
+        }
+
+#if DATA_ADAPTER_CXX11
+        DataAdapter( DataAdapter &&a ) : head( 0 ), used_length( a.length() ) {
+            std::move( a.begin(), a.end(), this->storage );
+            a.head = 0;
+            a.used_length = 0;
+        }
+
+        DataAdapter &operator=( DataAdapter &&a ) {
+            if ( this != &a ) {
+                std::move( a.begin(), a.end(), this->storage );
+                this->head = 0;
+                this->used_length = a.length();
+                a.head = 0;
+                a.used_length = 0;
+            }
+
+            return *this;
+        }
+#endif // DATA_ADAPTER_CXX11
+
+        inline bool operator==( const DataAdapter &da ) const {
+            return this->length() == da.length() && std::equal( this->begin(), this->end(), da.begin() );
+        }
+
+        inline size_type capacity() const {
+            return N;
+        }
+
+        inline size_type length() const {
+            return this->used_length;
+        }
+
+        void push_back( const element_type &n = element_type() ) {
+            DATA_ADAPTER_STAT_SCOPE( push_back )
+
+            if ( !this->full() ) {
+                //The new slot is never one of our elements, so n can't be moved out from under us
+                this->slot( this->used_length ) = n;
+                ++this->used_length;
+
+            } else {
+                DATA_ADAPTER_STAT_ADD( thrown, 1 )
+                throw std::out_of_range( "DataAdapter::push_back: Out of Range" );
+            }
+        }
+
+        void push_front( const element_type &val = element_type() ) {
+            DATA_ADAPTER_STAT_SCOPE( push_front )
+
+            if ( !this->full() ) {
+                this->slot( -1 ) = val;
+                this->head = wrap( static_cast<std::ptrdiff_t>( this->head ) - 1 );
+                ++this->used_length;
+
+            } else {
+                DATA_ADAPTER_STAT_ADD( thrown, 1 )
+                throw std::out_of_range( "DataAdapter::push_front: Out of Range" );
+            }
+        }
+
+#if DATA_ADAPTER_CXX11
+        void push_back( element_type &&n ) {
+            DATA_ADAPTER_STAT_SCOPE( push_back )
+
+            if ( !this->full() ) {
+                this->slot( this->used_length ) = std::move( n );
+                ++this->used_length;
+
+            } else {
+                DATA_ADAPTER_STAT_ADD( thrown, 1 )
+                throw std::out_of_range( "DataAdapter::push_back: Out of Range" );
+            }
+        }
+
+        void push_front( element_type &&val ) {
+            DATA_ADAPTER_STAT_SCOPE( push_front )
+
+            if ( !this->full() ) {
+                this->slot( -1 ) = std::move( val );
+                this->head = wrap( static_cast<std::ptrdiff_t>( this->head ) - 1 );
+                ++this->used_length;
+
+            } else {
+                DATA_ADAPTER_STAT_ADD( thrown, 1 )
+                throw std::out_of_range( "DataAdapter::push_front: Out of Range" );
+            }
+        }
+
+        template <typename... Args>
+        element_type &emplace_back( Args &&... args ) {
+            DATA_ADAPTER_STAT_SCOPE( emplace )
+
+            if ( !this->full() ) {
+                element_type &e = this->slot( this->used_length );
+
+                e = element_type( std::forward<Args>( args )... );
+                ++this->used_length;
+
+                return e;
+
+            } else {
+                DATA_ADAPTER_STAT_ADD( thrown, 1 )
+                throw std::out_of_range( "DataAdapter::emplace_back: Out of Range" );
+            }
+        }
+
+        template <typename... Args>
+        element_type &emplace_front( Args &&... args ) {
+            DATA_ADAPTER_STAT_SCOPE( emplace )
+
+            if ( !this->full() ) {
+                element_type &e = this->slot( -1 );
+
+                e = element_type( std::forward<Args>( args )... );
+                this->head = wrap( static_cast<std::ptrdiff_t>( this->head ) - 1 );
+                ++this->used_length;
+
+                return e;
+
+            } else {
+                DATA_ADAPTER_STAT_ADD( thrown, 1 )
+                throw std::out_of_range( "DataAdapter::emplace_front: Out of Range" );
+            }
+        }
+
+        template <typename... Args>
+        iterator emplace( iterator pos, Args &&... args ) {
+            DATA_ADAPTER_STAT_SCOPE( emplace )
+
+            size_type off = pos.offset();
+
+            if ( off <= this->length() && !this->full() ) {
+                //Constructed before shifting, in case args refer to our own elements
+                element_type tmp( std::forward<Args>( args )... );
+
+                this->open_gap( off, 1 );
+                this->at( off ) = std::move( tmp );
+
+                return this->begin() + off;
+
+            } else {
+                DATA_ADAPTER_STAT_ADD( thrown, 1 )
+                throw std::out_of_range( "DataAdapter::emplace: Out of Range" );
+            }
+        }
+#endif // DATA_ADAPTER_CXX11
+
+        element_type pop_back() {
+            DATA_ADAPTER_STAT_SCOPE( pop_back )
+
+            if ( !this->empty() ) {
+                --this->used_length;
+
+                return DATA_ADAPTER_MOVE( this->slot( this->used_length ) );
+
+            } else {
+                return element_type();
+            }
+        }
+
+        element_type pop_front() {
+            DATA_ADAPTER_STAT_SCOPE( pop_front )
+
+            if ( !this->empty() ) {
+                element_type ret = DATA_ADAPTER_MOVE( this->slot( 0 ) );
+
+                this->head = wrap( static_cast<std::ptrdiff_t>( this->head ) + 1 );
+                --this->used_length;
+
+                return ret;
+
+            } else {
+                return element_type();
+            }
+        }
+
+        /*
+            Rotates the storage so the elements start at storage[0], and returns a pointer to them.
+            After this, the first length() elements are contiguous until the next push_front,
+            or anything else that moves the front.
+        */
+        element_type *linearize() {
+            if ( this->head != 0 ) {
+                std::rotate( this->storage, this->storage + this->head, this->storage + N );
+                this->head = 0;
+            }
+
+            return this->storage;
+        }
+
+        inline element_type &at( size_type n ) {
+            return this->slot( n );
+        }
+
+        inline const element_type at( size_type n ) const {
+            return this->slot( n );
+        }
+
+        inline element_type &at( iterator it ) {
+            return this->at( it.offset() );
+        }
+
+        inline const element_type at( const_iterator it ) const {
+            return this->at( it.offset() );
+        }
+
+        inline element_type front() const {
+            return this->at( 0 );
+        }
+
+        inline element_type &front() {
+            return this->at( 0 );
+        }
+
+        element_type back() const {
+            if ( !this->empty() ) {
+                return this->at( this->length() - 1 );
+
+            } else {
+                return this->front();
+            }
+        }
+
+        element_type &back() {
+            if ( !this->empty() ) {
+                return this->at( this->length() - 1 );
+
+            } else {
+                return this->front();
+            }
+        }
+
+        //Binary search for the position, then insert there, which moves the shorter side
+        iterator sorted_insert( const element_type &n ) {
+            DATA_ADAPTER_STAT_SCOPE( sorted_insert )
+
+            return this->insert( std::upper_bound( this->begin(), this->end(), n ), n );
+        }
+
+#if DATA_ADAPTER_CXX11
+        iterator sorted_insert( element_type &&n ) {
+            DATA_ADAPTER_STAT_SCOPE( sorted_insert )
+
+            return this->insert( std::upper_bound( this->begin(), this->end(), n ), std::move( n ) );
+        }
+#endif // DATA_ADAPTER_CXX11
+
+        //Sorts a copy of the batch, then merges it in from the back
+        template <typename _InputIterator>
+        iterator sorted_insert( _InputIterator first, _InputIterator last ) {
+            DATA_ADAPTER_STAT_SCOPE( sorted_insert )
+
+            std::vector<element_type> batch( first, last );
+
+            if ( batch.empty() ) {
+                return this->end();
+
+            } else if ( this->length() + batch.size() <= this->capacity() ) {
+                std::stable_sort( batch.begin(), batch.end() );
+
+                return this->merge_back( batch.begin(), batch.end() );
+
+            } else {
+                DATA_ADAPTER_STAT_ADD( thrown, 1 )
+                throw std::out_of_range( "DataAdapter::sorted_insert(range): Out of Range" );
+            }
+        }
+
+        //single element
+        iterator insert( iterator pos, const element_type &val ) {
+            DATA_ADAPTER_STAT_SCOPE( insert )
+
+            size_type off = pos.offset();
+
+            if ( off <= this->length() && !this->full() ) {
+                //val could be one of our own elements, which the shift would move out from under it
+                element_type tmp( val );
+
+                this->open_gap( off, 1 );
+                this->at( off ) = DATA_ADAPTER_MOVE( tmp );
+
+                return this->begin() + off;
+
+            } else {
+                DATA_ADAPTER_STAT_ADD( thrown, 1 )
+                throw std::out_of_range( "DataAdapter::insert: Out of Range" );
+            }
+        }
+
+#if DATA_ADAPTER_CXX11
+        iterator insert( iterator pos, element_type &&val ) {
+            DATA_ADAPTER_STAT_SCOPE( insert )
+
+            return this->emplace( pos, std::move( val ) );
+        }
+#endif // DATA_ADAPTER_CXX11
+
+        //fill
+        iterator insert( iterator pos, size_type n, const element_type &val ) {
+            DATA_ADAPTER_STAT_SCOPE( insert_fill )
+
+            if ( n != 0 ) {
+                size_type off = pos.offset();
+
+                if ( off <= this->length() && this->length() + n <= this->capacity() ) {
+                    element_type tmp( val );
+
+                    this->open_gap( off, n );
+
+                    iterator first = this->begin() + off;
+
+                    DATA_ADAPTER_STAT_ADD( filled, n )
+
+                    std::fill( first, first + n, tmp );
+
+                    return first;
+
+                } else {
+                    DATA_ADAPTER_STAT_ADD( thrown, 1 )
+                    throw std::out_of_range( "DataAdapter::insert(fill): Out of Range" );
+                }
+            } else {
+                return this->end();
+            }
+        }
+
+        //range
+        iterator insert( iterator pos, const_iterator first, const_iterator last ) {
+            DATA_ADAPTER_STAT_SCOPE( insert_range )
+
+            if ( first != last && first < last ) {
+                size_type off = pos.offset();
+                size_type diff = last - first;
+
+                if ( off <= this->length() && this->length() + diff <= this->capacity() ) {
+
+                    //Opening the gap would move our own elements around under first and last
+                    if ( first.container() == this ) {
+                        std::vector<element_type> tmp( first, last );
+
+                        this->open_gap( off, diff );
+
+                        std::copy( tmp.begin(), tmp.end(), this->begin() + off );
+
+                    } else {
+                        this->open_gap( off, diff );
+
+                        std::copy( first, last, this->begin() + off );
+                    }
+
+                    return this->begin() + off;
+
+                } else {
+                    DATA_ADAPTER_STAT_ADD( thrown, 1 )
+                    throw std::out_of_range( "DataAdapter::insert(range): Out of Range" );
+                }
+            } else {
+                return this->end();
+            }
+        }
+
+        //Any other range, from any kind of iterator, or a count and a value
+        template <typename _InputIterator>
+        iterator insert( iterator pos, _InputIterator first, _InputIterator last ) {
+            return this->insert_range( pos, first, last, typename da::detail::range_kind<_InputIterator>::type() );
+        }
+
+        //Like the generic ones, but without clear() zeroing slots that are about to be written anyway
+        template <typename _InputIterator>
+        void assign( _InputIterator first, _InputIterator last ) {
+            this->assign_range( first, last, typename da::detail::range_kind<_InputIterator>::type() );
+        }
+
+        void assign( size_type n, const element_type &val ) {
+            element_type tmp( val );
+
+            this->head = 0;
+            this->used_length = 0;
+
+            this->insert( this->end(), n, tmp );
+        }
+
+        //Zeros the whole storage just in case, since every slot is a live element anyway
+        void clear() {
+            DATA_ADAPTER_STAT_SCOPE( clear )
+            DATA_ADAPTER_STAT_ADD( filled, N )
+
+            std::fill( this->storage, this->storage + N, element_type() );
+            this->head = 0;
+            this->used_length = 0;
+        }
+
+        inline size_type resize( size_type n ) {
+            return this->resize( n, element_type() );
+        }
+
+        size_type resize( size_type n, const element_type &v ) {
+            DATA_ADAPTER_STAT_SCOPE( resize )
+
+            if ( n <= this->capacity() ) {
+
+                size_type ret = this->length();
+
+                if ( n > ret ) {
+                    DATA_ADAPTER_STAT_ADD( filled, n - ret )
+
+                    this->used_length = n;
+
+                    //Only the newly exposed elements get the fill value
+                    std::fill( this->begin() + ret, this->end(), v );
+
+                } else {
+                    this->used_length = n;
+                }
+
+                return ret;
+
+            } else {
+                DATA_ADAPTER_STAT_ADD( thrown, 1 )
+                throw std::out_of_range( "DataAdapter::resize: Out of Range" );
+            }
+        }
+
+        inline iterator erase( iterator pos ) {
+            return this->erase( pos, pos + 1 );
+        }
+
+        iterator erase( iterator first, iterator last ) {
+            DATA_ADAPTER_STAT_SCOPE( erase )
+
+            size_type f = first.offset();
+            size_type l = last.offset();
+
+            if ( f <= l && l <= this->length() ) {
+
+                this->close_gap( f, l );
+
+                return this->begin() + f;
+
+            } else {
+                DATA_ADAPTER_STAT_ADD( thrown, 1 )
+                throw std::out_of_range( "DataAdapter::erase(range): Out of Range" );
+            }
+        }
+
+        //Both sort on plain pointers once the elements are contiguous, sort() with a radix sort where it can
+        void sort() {
+            DATA_ADAPTER_STAT_SCOPE( sort )
+
+            element_type *d = this->linearize();
+
+            da::detail::sort( d, d + this->length() );
+        }
+
+        void stable_sort() {
+            DATA_ADAPTER_STAT_SCOPE( stable_sort )
+
+            element_type *d = this->linearize();
+
+            std::stable_sort( d, d + this->length() );
+        }
+
+#if DATA_ADAPTER_CXX11
+        void sort( unsigned threads ) {
+            DATA_ADAPTER_STAT_SCOPE( sort )
+
+            element_type *d = this->linearize();
+
+            da::detail::parallel_sort( d, d + this->length(), threads, false );
+        }
+
+        void stable_sort( unsigned threads ) {
+            DATA_ADAPTER_STAT_SCOPE( stable_sort )
+
+            element_type *d = this->linearize();
+
+            da::detail::parallel_sort( d, d + this->length(), threads, true );
+        }
+#endif // DATA_ADAPTER_CXX11
+};
+
+/*Mutable iterator class template*/
+template <typename T, size_t N>
+class DataApapterIterator<da::ring<T, N> >
+    : public da::detail::ring_iterator<DataApapterIterator<da::ring<T, N> >, DataAdapter<da::ring<T, N> >, T> {
+    public:
+        typedef da::detail::ring_iterator<DataApapterIterator<da::ring<T, N> >, DataAdapter<da::ring<T, N> >, T> _Base;
+
+        typedef typename _Base::difference_type         difference_type;
+        typedef typename _Base::parent_type             parent_type;
+
+        DataApapterIterator() {}
+        DataApapterIterator( parent_type *x, difference_type ioff = 0 ) : _Base( x, ioff ) {}
+        DataApapterIterator( parent_type &x, difference_type ioff = 0 ) : _Base( &x, ioff ) {}
+
+        //VERY IMPORTANT for converting and comparing to const_iterators
+        inline operator typename parent_type::const_iterator() const {
+            return typename parent_type::const_iterator( this->parent, this->off );
+        }
+};
+
+/*Immutable iterator class template*/
+template <typename T, size_t N>
+class DataApapterIterator<const da::ring<T, N> >
+    : public da::detail::ring_iterator<DataApapterIterator<const da::ring<T, N> >, const DataAdapter<da::ring<T, N> >, const T> {
+    public:
+        typedef da::detail::ring_iterator<DataApapterIterator<const da::ring<T, N> >, const DataAdapter<da::ring<T, N> >, const T> _Base;
+
+        typedef typename _Base::difference_type         difference_type;
+        typedef typename _Base::parent_type             parent_type;
+
+        DataApapterIterator() {}
+        DataApapterIterator( parent_type *x, difference_type ioff = 0 ) : _Base( x, ioff ) {}
+        DataApapterIterator( parent_type &x, difference_type ioff = 0 ) : _Base( &x, ioff ) {}
+};
+
+#endif // DATA_ADAPTER_RING_HPP_INCLUDED
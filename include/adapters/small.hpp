@@ -0,0 +1,106 @@
+#ifndef DATA_ADAPTER_SMALL_HPP_INCLUDED
+#define DATA_ADAPTER_SMALL_HPP_INCLUDED
+
+#include <memory>
+
+#include "../data_adapter.hpp"
+#include "../detail/contiguous_iterator.hpp"
+#include "../detail/growable.hpp"
+
+/**
+ *              Notes on the implementation of this:
+ *
+ *      This is a small buffer adapter, the array adapter and the dynamic adapter in one. The first N
+ * elements are kept inline in the object, in the same uninitialized storage the array adapter uses, so
+ * a container that stays small never allocates. Once it needs more than N, the elements move to a heap
+ * block from the allocator, which then grows like the dynamic adapter's, and shrink_to_fit() moves
+ * them back in once they fit again. capacity() is N until then, and the size of the heap block after.
+ * The implementation is shared with the dynamic adapter, in detail/growable.hpp.
+ *
+ *      Moving an adapter that is on the heap takes over the block, but one that is still inline has to
+ * move its elements one by one, like the array adapter. Iterators are plain pointers, invalidated by
+ * anything that changes the capacity, including spilling over to the heap.
+ */
+
+namespace da {
+    template <typename T, size_t N, typename Alloc = std::allocator<T> >
+    struct small {};
+}
+
+template <typename T, size_t N, typename Alloc>
+class DataAdapter<da::small<T, N, Alloc> > : public da::detail::growable<da::small<T, N, Alloc>, T, Alloc, N> {
+    public:
+        typedef da::detail::growable<da::small<T, N, Alloc>, T, Alloc, N> _Growable;
+
+        typedef typename _Growable::element_type        element_type;
+        typedef typename _Growable::size_type           size_type;
+        typedef typename _Growable::allocator_type      allocator_type;
+
+        DataAdapter() {}
+
+        explicit DataAdapter( const allocator_type &a ) : _Growable( a ) {}
+
+        DataAdapter( size_type n, const element_type &val = element_type(), const allocator_type &a = allocator_type() )
+            : _Growable( n, val, a ) {}
+
+        DataAdapter( const DataAdapter &a ) : _Growable( a ) {}
+
+        DataAdapter &operator=( const DataAdapter &a ) {
+            _Growable::operator=( a );
+
+            return *this;
+        }
+
+#if DATA_ADAPTER_CXX11
+        //Takes over a heap block, or moves the elements out of a's inline storage, leaving a empty either way
+        DataAdapter( DataAdapter &&a ) : _Growable( std::move( a ) ) {}
+
+        DataAdapter &operator=( DataAdapter &&a ) {
+            _Growable::operator=( std::move( a ) );
+
+            return *this;
+        }
+#endif // DATA_ADAPTER_CXX11
+};
+
+/*Mutable iterator class template*/
+template <typename T, size_t N, typename Alloc>
+class DataApapterIterator<da::small<T, N, Alloc> >
+    : public da::detail::contiguous_iterator<DataApapterIterator<da::small<T, N, Alloc> >, DataAdapter<da::small<T, N, Alloc> >, T> {
+    public:
+        typedef da::detail::contiguous_iterator<DataApapterIterator<da::small<T, N, Alloc> >, DataAdapter<da::small<T, N, Alloc> >, T> _Base;
+
+        typedef typename _Base::difference_type         difference_type;
+        typedef typename _Base::parent_type             parent_type;
+
+        DataApapterIterator() {}
+        DataApapterIterator( parent_type *x, difference_type ioff = 0 ) : _Base( x, ioff ) {}
+        DataApapterIterator( parent_type &x, difference_type ioff = 0 ) : _Base( &x, ioff ) {}
+
+        //VERY IMPORTANT for converting and comparing to const_iterators
+        inline operator typename parent_type::const_iterator() const {
+            if ( this->parent != NULL ) {
+                return typename parent_type::const_iterator( this->parent, this->offset() );
+
+            } else {
+                return typename parent_type::const_iterator();
+            }
+        }
+};
+
+/*Immutable iterator class template*/
+template <typename T, size_t N, typename Alloc>
+class DataApapterIterator<const da::small<T, N, Alloc> >
+    : public da::detail::contiguous_iterator<DataApapterIterator<const da::small<T, N, Alloc> >, const DataAdapter<da::small<T, N, Alloc> >, const T> {
+    public:
+        typedef da::detail::contiguous_iterator<DataApapterIterator<const da::small<T, N, Alloc> >, const DataAdapter<da::small<T, N, Alloc> >, const T> _Base;
+
+        typedef typename _Base::difference_type         difference_type;
+        typedef typename _Base::parent_type             parent_type;
+
+        DataApapterIterator() {}
+        DataApapterIterator( parent_type *x, difference_type ioff = 0 ) : _Base( x, ioff ) {}
+        DataApapterIterator( parent_type &x, difference_type ioff = 0 ) : _Base( &x, ioff ) {}
+};
+
+#endif // DATA_ADAPTER_SMALL_HPP_INCLUDED
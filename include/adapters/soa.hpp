@@ -0,0 +1,1311 @@
+#ifndef DATA_ADAPTER_SOA_HPP_INCLUDED
+#define DATA_ADAPTER_SOA_HPP_INCLUDED
+
+#include "../data_adapter.hpp"
+
+#if !DATA_ADAPTER_CXX11
+#error "DataAdapter<da::soa<std::tuple<...>, N> > requires C++11"
+#endif // DATA_ADAPTER_CXX11
+
+#ifdef DATA_ADAPTER_DYNAMIC_DISPATCH
+#error "DataAdapter<da::soa<std::tuple<...>, N> > has no element_type & to give the virtual interface"
+#endif // DATA_ADAPTER_DYNAMIC_DISPATCH
+
+#include <cstring>
+#include <initializer_list>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "../detail/radix_sort.hpp"
+#include "../detail/storage.hpp"
+
+/**
+ *              Notes on the implementation of this:
+ *
+ *      This is the array adapter for records, stored as a structure of arrays. A DataAdapter<Rec[N]> keeps
+ * whole records next to each other, so a scan over one field of them pulls every other field through the
+ * cache with it. Here the record is described as a std::tuple of its fields, and each field has an array
+ * of N of its own, a column, so a scan over one field only reads that field's column. Each column starts
+ * on a cache line of its own.
+ *
+ *      element_type is the tuple, and what the adapter holds is rows of it, one element of every column at
+ * the same position. There is no tuple stored anywhere to return a reference to, so at(), operator[], the
+ * iterators and so on give a row_reference instead, a tuple of references to the row's fields. Reading
+ * one converts it to the tuple, assigning to it assigns every field, and they compare like the tuples
+ * do, so the common interface and the generic algorithms in DataAdapterBase, and the standard ones, work
+ * on rows as if they were elements. Those don't know about columns though, so the adapter also gives:
+ *
+ *      column<I>() is the Ith column, with begin(), end(), data() and operator[], for scanning one field,
+ *      find_by<I>( key ) finds the first row whose Ith field is key, by scanning that column alone,
+ *      sort_by<I>() stably sorts the rows by their Ith field. The column is sorted together with the
+ *      position of each row, by radix sort when the field has a da::radix_key, and the permutation that
+ *      gives is then applied to every column in turn.
+ *      sort() and stable_sort() do the same with whole rows compared, and erase_if() and the shifts of
+ *      insert and erase also go column by column.
+ *
+ *      Since there is no element_type & to give, this only works with static dispatch.
+ *
+ *      Like the ring adapter, the columns are plain arrays, so every slot is a live element and the fields
+ * have to be default constructible. Otherwise it behaves like the array adapter: the same capacity, the
+ * same std::out_of_range exceptions when full or out of bounds, and popping an empty adapter returns a
+ * default constructed element. Iterators are random access, hold their parent and a position, and are
+ * invalidated by anything that makes their position past the end.
+ */
+
+namespace da {
+
+    template <typename _Tuple, size_t N>
+    struct soa {};
+
+    namespace detail {
+        namespace soa {
+
+            //For expanding over the columns
+            template <size_t... I>
+            struct indices {};
+
+            template <size_t N, size_t... I>
+            struct make_indices : make_indices<N - 1, N - 1, I...> {};
+
+            template <size_t... I>
+            struct make_indices<0, I...> {
+                typedef indices<I...> type;
+            };
+
+            /*
+                One row of the adapter, as references to its fields. Es are the field types, const for
+                the rows of a const adapter. Assigning to it assigns through to the fields, never rebinds.
+            */
+            template <typename... Es>
+            class row_reference {
+                public:
+                    typedef std::tuple<typename std::remove_const<Es>::type...>  value_type;
+                    typedef std::tuple<Es &...>                                 tuple_type;
+
+                private:
+                    tuple_type fields;
+
+                public:
+                    explicit row_reference( Es &... es ) : fields( es... ) {}
+
+                    row_reference( const row_reference &r ) : fields( r.fields ) {}
+
+                    inline operator value_type() const {
+                        return value_type( this->fields );
+                    }
+
+                    inline const tuple_type &tuple() const {
+                        return this->fields;
+                    }
+
+                    template <size_t I>
+                    inline typename std::tuple_element<I, tuple_type>::type get() const {
+                        return std::get<I>( this->fields );
+                    }
+
+                    inline row_reference &operator=( const row_reference &r ) {
+                        this->fields = r.fields;
+                        return *this;
+                    }
+
+                    template <typename... Fs>
+                    inline row_reference &operator=( const row_reference<Fs...> &r ) {
+                        this->fields = r.tuple();
+                        return *this;
+                    }
+
+                    inline row_reference &operator=( const value_type &v ) {
+                        this->fields = v;
+                        return *this;
+                    }
+
+                    inline row_reference &operator=( value_type &&v ) {
+                        this->fields = std::move( v );
+                        return *this;
+                    }
+            };
+
+            template <typename... Es, size_t... I>
+            inline void swap_rows( const row_reference<Es...> &a, const row_reference<Es...> &b, indices<I...> ) {
+                using std::swap;
+
+                int expand[] = { 0, ( swap( std::get<I>( a.tuple() ), std::get<I>( b.tuple() ) ), 0 )... };
+                ( void ) expand;
+            }
+
+            //Found by the standard algorithms, which swap *a and *b, both rvalues here
+            template <typename... Es>
+            inline void swap( row_reference<Es...> a, row_reference<Es...> b ) {
+                swap_rows( a, b, typename make_indices<sizeof...( Es )>::type() );
+            }
+
+            //Rows compare with each other and with tuples the same way the tuples do
+            template <typename... As, typename... Bs>
+            inline bool operator==( const row_reference<As...> &a, const row_reference<Bs...> &b ) {
+                return a.tuple() == b.tuple();
+            }
+
+            template <typename... As, typename... Bs>
+            inline bool operator==( const row_reference<As...> &a, const std::tuple<Bs...> &b ) {
+                return a.tuple() == b;
+            }
+
+            template <typename... As, typename... Bs>
+            inline bool operator==( const std::tuple<As...> &a, const row_reference<Bs...> &b ) {
+                return a == b.tuple();
+            }
+
+            template <typename... As, typename... Bs>
+            inline bool operator!=( const row_reference<As...> &a, const row_reference<Bs...> &b ) {
+                return !( a.tuple() == b.tuple() );
+            }
+
+            template <typename... As, typename... Bs>
+            inline bool operator!=( const row_reference<As...> &a, const std::tuple<Bs...> &b ) {
+                return !( a.tuple() == b );
+            }
+
+            template <typename... As, typename... Bs>
+            inline bool operator!=( const std::tuple<As...> &a, const row_reference<Bs...> &b ) {
+                return !( a == b.tuple() );
+            }
+
+            template <typename... As, typename... Bs>
+            inline bool operator<( const row_reference<As...> &a, const row_reference<Bs...> &b ) {
+                return a.tuple() < b.tuple();
+            }
+
+            template <typename... As, typename... Bs>
+            inline bool operator<( const row_reference<As...> &a, const std::tuple<Bs...> &b ) {
+                return a.tuple() < b;
+            }
+
+            template <typename... As, typename... Bs>
+            inline bool operator<( const std::tuple<As...> &a, const row_reference<Bs...> &b ) {
+                return a < b.tuple();
+            }
+
+            //One column, for scanning a single field with plain pointers
+            template <typename T>
+            class column_view {
+                private:
+                    T *first;
+                    T *last;
+
+                public:
+                    typedef T                                          *iterator;
+                    typedef size_t                                      size_type;
+
+                    column_view( T *f, T *l ) : first( f ), last( l ) {}
+
+                    inline T *begin() const {
+                        return this->first;
+                    }
+
+                    inline T *end() const {
+                        return this->last;
+                    }
+
+                    inline T *data() const {
+                        return this->first;
+                    }
+
+                    inline size_type size() const {
+                        return static_cast<size_type>( this->last - this->first );
+                    }
+
+                    inline T &operator[]( size_type n ) const {
+                        return this->first[n];
+                    }
+            };
+
+            /*
+                What is done to every column alike. Each one is called with the column's elements, and
+                the column of the other adapter where there is one.
+            */
+            struct shift_up {
+                size_t off, len, n;
+
+                template <typename T>
+                inline void operator()( T *d ) const {
+                    std::move_backward( d + this->off, d + this->len, d + this->len + this->n );
+                }
+            };
+
+            struct shift_down {
+                size_t f, l, len;
+
+                template <typename T>
+                inline void operator()( T *d ) const {
+                    std::move( d + this->l, d + this->len, d + this->f );
+                }
+            };
+
+            struct rotate {
+                size_t first, middle, last;
+
+                template <typename T>
+                inline void operator()( T *d ) const {
+                    std::rotate( d + this->first, d + this->middle, d + this->last );
+                }
+            };
+
+            struct reset {
+                size_t first, last;
+
+                template <typename T>
+                inline void operator()( T *d ) const {
+                    std::fill( d + this->first, d + this->last, T() );
+                }
+            };
+
+            struct move_row {
+                size_t from, to;
+
+                template <typename T>
+                inline void operator()( T *d ) const {
+                    d[this->to] = std::move( d[this->from] );
+                }
+            };
+
+            //Moves the rows whose keep is set down over the others, from first on
+            struct compact {
+                const unsigned char *keep;
+                size_t first, len;
+
+                template <typename T>
+                inline void operator()( T *d ) const {
+                    T *out = d + this->first;
+
+                    for ( size_t i = this->first; i < this->len; ++i ) {
+                        if ( this->keep[i] ) {
+                            *out = std::move( d[i] );
+                            ++out;
+                        }
+                    }
+                }
+            };
+
+            /*
+                Row i of the result is row order[i] now. Columns of trivially relocatable fields are gathered
+                through the one scratch block as bytes, the others through a vector of their own.
+            */
+            struct permute {
+                const size_t *order;
+                size_t len;
+                void *scratch;
+
+                template <typename T>
+                inline void operator()( T *d ) const {
+                    this->gather( d, da::detail::bool_tag<da::is_trivially_relocatable<T>::value>() );
+                }
+
+                template <typename T>
+                void gather( T *d, da::detail::bool_tag<true> ) const {
+                    T *tmp = static_cast<T *>( this->scratch );
+
+                    for ( size_t i = 0; i < this->len; ++i ) {
+                        std::memcpy( static_cast<void *>( tmp + i ), static_cast<const void *>( d + this->order[i] ), sizeof( T ) );
+                    }
+
+                    std::memcpy( static_cast<void *>( d ), static_cast<const void *>( tmp ), this->len * sizeof( T ) );
+                }
+
+                template <typename T>
+                void gather( T *d, da::detail::bool_tag<false> ) const {
+                    std::vector<T> tmp;
+                    tmp.reserve( this->len );
+
+                    for ( size_t i = 0; i < this->len; ++i ) {
+                        tmp.push_back( std::move( d[this->order[i]] ) );
+                    }
+
+                    std::move( tmp.begin(), tmp.end(), d );
+                }
+            };
+
+            //The largest of the field types, for the scratch block of permute
+            template <typename... Ts>
+            struct max_size;
+
+            template <typename T>
+            struct max_size<T> {
+                static const size_t value = sizeof( T );
+            };
+
+            template <typename T, typename... Ts>
+            struct max_size<T, Ts...> {
+                static const size_t value = sizeof( T ) > max_size<Ts...>::value ? sizeof( T ) : max_size<Ts...>::value;
+            };
+
+            struct copy_column {
+                size_t len;
+
+                template <typename T>
+                inline void operator()( T *d, const T *s ) const {
+                    std::copy( s, s + this->len, d );
+                }
+            };
+
+            struct move_column {
+                size_t len;
+
+                template <typename T>
+                inline void operator()( T *d, T *s ) const {
+                    std::move( s, s + this->len, d );
+                }
+            };
+
+            struct equal_column {
+                size_t len;
+                bool *result;
+
+                template <typename T>
+                inline void operator()( const T *a, const T *b ) const {
+                    *this->result = *this->result && da::detail::equal( a, this->len, b, this->len );
+                }
+            };
+
+            struct hash_column {
+                size_t len;
+                size_t *result;
+
+                template <typename T>
+                inline void operator()( const T *d ) const {
+                    *this->result ^= da::detail::hash( d, this->len ) + 0x9E3779B9 + ( *this->result << 6 ) + ( *this->result >> 2 );
+                }
+            };
+
+            /*
+                Common implementation of the row iterators, in the same shape as ring_iterator. The position is
+                a row number, and dereferencing gives parent->row() of it.
+            */
+            template <typename _Derived, typename _Parent, typename _Reference>
+            class row_iterator {
+                public:
+                    typedef std::random_access_iterator_tag                 iterator_category;
+                    typedef typename _Reference::value_type                 value_type;
+                    typedef std::ptrdiff_t                                  difference_type;
+                    typedef void                                            pointer;
+                    typedef _Reference                                      reference;
+
+                    typedef _Parent                                         parent_type;
+
+                protected:
+                    parent_type *parent;
+                    difference_type off;
+
+                    inline _Derived &self() {
+                        return *static_cast<_Derived *>( this );
+                    }
+
+                    inline const _Derived &self() const {
+                        return *static_cast<const _Derived *>( this );
+                    }
+
+                public:
+                    row_iterator() : parent( NULL ), off( 0 ) {}
+
+                    row_iterator( parent_type *x, difference_type ioff ) : parent( x ), off( ioff ) {}
+
+                    //Position of the iterator within its parent
+                    inline difference_type offset() const {
+                        return this->off;
+                    }
+
+                    inline parent_type *container() const {
+                        return this->parent;
+                    }
+
+                    inline bool operator==( const _Derived &it ) const {
+                        return this->parent == it.parent && this->off == it.off;
+                    }
+
+                    inline bool operator!=( const _Derived &it ) const {
+                        return !( *this == it );
+                    }
+
+                    inline reference operator*() const {
+                        return this->parent->row( this->off );
+                    }
+
+                    inline reference operator[]( difference_type n ) const {
+                        return this->parent->row( this->off + n );
+                    }
+
+                    inline _Derived &operator++() {
+                        ++this->off;
+                        return self();
+                    }
+
+                    inline _Derived operator++( int ) {
+                        _Derived tmp( self() );
+                        ++this->off;
+                        return tmp;
+                    }
+
+                    inline _Derived &operator--() {
+                        --this->off;
+                        return self();
+                    }
+
+                    inline _Derived operator--( int ) {
+                        _Derived tmp( self() );
+                        --this->off;
+                        return tmp;
+                    }
+
+                    inline _Derived operator+( difference_type n ) const {
+                        _Derived tmp( self() );
+                        tmp.off += n;
+                        return tmp;
+                    }
+                    inline _Derived &operator +=( difference_type n ) {
+                        this->off += n;
+                        return self();
+                    }
+
+                    inline difference_type operator-( const _Derived &it ) const {
+                        return this->off - it.off;
+                    }
+                    inline _Derived operator-( difference_type n ) const {
+                        _Derived tmp( self() );
+                        tmp.off -= n;
+                        return tmp;
+                    }
+                    inline _Derived &operator -=( difference_type n ) {
+                        this->off -= n;
+                        return self();
+                    }
+
+                    inline bool operator<( const _Derived &it ) const {
+                        return this->off < it.off;
+                    }
+                    inline bool operator>( const _Derived &it ) const {
+                        return this->off > it.off;
+                    }
+                    inline bool operator<=( const _Derived &it ) const {
+                        return this->off <= it.off;
+                    }
+                    inline bool operator>=( const _Derived &it ) const {
+                        return this->off >= it.off;
+                    }
+            };
+
+            //A field of the sort_by() column and its row, ordered by the field and then the row
+            template <typename K>
+            struct keyed {
+                K key;
+                size_t row;
+
+                inline bool operator<( const keyed &k ) const {
+                    return this->key < k.key || ( !( k.key < this->key ) && this->row < k.row );
+                }
+            };
+
+            //The radix key of the field, if it has one, since radix sorting is stable too
+            template <typename K, bool = da::radix_key<K>::value>
+            struct keyed_radix_key {
+                static const bool value = false;
+            };
+
+            template <typename K>
+            struct keyed_radix_key<K, true> {
+                static const bool value = true;
+                typedef typename da::radix_key<K>::type type;
+
+                //-0.0 gets the key of 0.0, since operator< ties them and the sort has to keep their order
+                static inline type get( const keyed<K> &k ) {
+                    return da::radix_key<K>::get( std::is_floating_point<K>::value && k.key == K() ? K() : k.key );
+                }
+            };
+        }
+    }
+
+    template <typename K>
+    struct radix_key<da::detail::soa::keyed<K> > : da::detail::soa::keyed_radix_key<K> {};
+}
+
+template <typename... Ts, size_t N>
+class DataAdapter<da::soa<std::tuple<Ts...>, N> >
+    : public DataAdapterBase<da::soa<std::tuple<Ts...>, N>, std::tuple<Ts...>, DataAdapter<da::soa<std::tuple<Ts...>, N> > > {
+    public:
+        typedef DataAdapterBase<da::soa<std::tuple<Ts...>, N>, std::tuple<Ts...>, DataAdapter<da::soa<std::tuple<Ts...>, N> > > _Base;
+
+        typedef typename _Base::value_type              value_type;
+        typedef typename _Base::element_type            element_type;
+        typedef typename _Base::pointer_type            pointer_type;
+        typedef typename _Base::size_type               size_type;
+
+        typedef typename _Base::iterator                iterator;
+        typedef typename _Base::const_iterator          const_iterator;
+        typedef typename _Base::reverse_iterator        reverse_iterator;
+        typedef typename _Base::const_reverse_iterator  const_reverse_iterator;
+
+        typedef da::detail::soa::row_reference<Ts...>          reference;
+        typedef da::detail::soa::row_reference<const Ts...>    const_reference;
+
+        //The type of the Ith field, and its column
+        template <size_t I>
+        using field_type = typename std::tuple_element<I, element_type>::type;
+
+        template <size_t I>
+        using column_view = da::detail::soa::column_view<field_type<I> >;
+
+        template <size_t I>
+        using const_column_view = da::detail::soa::column_view<const field_type<I> >;
+
+        template <typename, typename, typename> friend class da::detail::soa::row_iterator;
+
+        using _Base::sorted_insert;
+
+    private:
+        typedef typename da::detail::soa::make_indices<sizeof...( Ts )>::type columns_type;
+
+        template <typename T>
+        struct alignas( da::detail::cache_line_size ) column_storage {
+            T data[N];
+        };
+
+        std::tuple<column_storage<Ts>...> columns;
+        size_type used_length;
+
+        template <size_t I>
+        inline field_type<I> *column_data() {
+            return std::get<I>( this->columns ).data;
+        }
+
+        template <size_t I>
+        inline const field_type<I> *column_data() const {
+            return std::get<I>( this->columns ).data;
+        }
+
+        template <size_t... I>
+        inline reference row( size_type n, da::detail::soa::indices<I...> ) {
+            return reference( std::get<I>( this->columns ).data[n]... );
+        }
+
+        template <size_t... I>
+        inline const_reference row( size_type n, da::detail::soa::indices<I...> ) const {
+            return const_reference( std::get<I>( this->columns ).data[n]... );
+        }
+
+        //Moves the fields of row n out into a tuple
+        template <size_t... I>
+        inline element_type take( size_type n, da::detail::soa::indices<I...> ) {
+            return element_type( std::move( std::get<I>( this->columns ).data[n] )... );
+        }
+
+        inline reference row( size_type n ) {
+            return this->row( n, columns_type() );
+        }
+
+        inline const_reference row( size_type n ) const {
+            return this->row( n, columns_type() );
+        }
+
+        //Calls f with every column, and with the same column of a where there is one
+        template <typename _Function, size_t... I>
+        inline void each_column( const _Function &f, da::detail::soa::indices<I...> ) {
+            int expand[] = { 0, ( f( std::get<I>( this->columns ).data ), 0 )... };
+            ( void ) expand;
+        }
+
+        template <typename _Function, size_t... I>
+        inline void each_column( const _Function &f, da::detail::soa::indices<I...> ) const {
+            int expand[] = { 0, ( f( std::get<I>( this->columns ).data ), 0 )... };
+            ( void ) expand;
+        }
+
+        template <typename _Function, typename _Other, size_t... I>
+        inline void each_column( const _Function &f, _Other &a, da::detail::soa::indices<I...> ) const {
+            int expand[] = { 0, ( f( std::get<I>( this->columns ).data, std::get<I>( a.columns ).data ), 0 )... };
+            ( void ) expand;
+        }
+
+        template <typename _Function, typename _Other, size_t... I>
+        inline void each_column( const _Function &f, _Other &a, da::detail::soa::indices<I...> ) {
+            int expand[] = { 0, ( f( std::get<I>( this->columns ).data, std::get<I>( a.columns ).data ), 0 )... };
+            ( void ) expand;
+        }
+
+        template <typename _Function>
+        inline void each_column( const _Function &f ) {
+            this->each_column( f, columns_type() );
+        }
+
+        template <typename _Function>
+        inline void each_column( const _Function &f ) const {
+            this->each_column( f, columns_type() );
+        }
+
+        //Opens n rows at off by moving the rest up, and closes [f, l) by moving the rest down. Bounds are checked by the callers.
+        void open_gap( size_type off, size_type n ) {
+            size_type len = this->length();
+
+            //Nothing to shift, and moving a row onto itself would empty its strings
+            if ( n == 0 ) {
+                return;
+            }
+
+            DATA_ADAPTER_STAT_ADD( shifted, len - off )
+
+            da::detail::soa::shift_up s = { off, len, n };
+            this->each_column( s );
+
+            this->used_length = len + n;
+        }
+
+        void close_gap( size_type f, size_type l ) {
+            size_type len = this->length();
+
+            if ( f == l ) {
+                return;
+            }
+
+            DATA_ADAPTER_STAT_ADD( shifted, len - l )
+
+            da::detail::soa::shift_down s = { f, l, len };
+            this->each_column( s );
+
+            this->used_length = len - ( l - f );
+        }
+
+        //Puts every row where order says, see da::detail::soa::permute
+        void permute( const std::vector<size_type> &order ) {
+            //Freed even if a column of the other kind throws
+            struct scratch_block {
+                void *p;
+
+                ~scratch_block() {
+                    ::operator delete( this->p );
+                }
+            } scratch = { ::operator new( order.size() * da::detail::soa::max_size<Ts...>::value ) };
+
+            da::detail::soa::permute p = { order.data(), order.size(), scratch.p };
+            this->each_column( p );
+        }
+
+        //The range versions of insert, like the ring adapter's
+        template <typename _Integer>
+        iterator insert_range( iterator pos, _Integer n, _Integer val, da::detail::integral_range_tag ) {
+            return this->insert( pos, static_cast<size_type>( n ), static_cast<element_type>( val ) );
+        }
+
+        template <typename _ForwardIterator>
+        iterator insert_range( iterator pos, _ForwardIterator first, _ForwardIterator last, std::forward_iterator_tag ) {
+            DATA_ADAPTER_STAT_SCOPE( insert_range )
+
+            size_type off = pos.offset();
+            size_type n = std::distance( first, last );
+
+            if ( n == 0 ) {
+                return this->end();
+            }
+
+            if ( off > this->length() || this->length() + n > this->capacity() ) {
+                DATA_ADAPTER_STAT_ADD( thrown, 1 )
+                throw std::out_of_range( "DataAdapter::insert(range): Out of Range" );
+            }
+
+            //Any of our iterator types, reverse ones too, could refer to rows the insert moves
+            if ( da::detail::is_own_iterator<DataAdapter, _ForwardIterator>::value ) {
+                std::vector<element_type> tmp( first, last );
+
+                this->open_gap( off, n );
+
+                std::copy( tmp.begin(), tmp.end(), this->begin() + off );
+
+            } else {
+                this->open_gap( off, n );
+
+                std::copy( first, last, this->begin() + off );
+            }
+
+            return this->begin() + off;
+        }
+
+        template <typename _InputIterator>
+        iterator insert_range( iterator pos, _InputIterator first, _InputIterator last, std::input_iterator_tag ) {
+            DATA_ADAPTER_STAT_SCOPE( insert_range )
+
+            size_type off = pos.offset();
+            size_type len = this->length();
+
+            if ( off > len ) {
+                DATA_ADAPTER_STAT_ADD( thrown, 1 )
+                throw std::out_of_range( "DataAdapter::insert(range): Out of Range" );
+            }
+
+            try {
+                for ( ; first != last; ++first ) {
+                    if ( this->full() ) {
+                        DATA_ADAPTER_STAT_ADD( thrown, 1 )
+                        throw std::out_of_range( "DataAdapter::insert(range): Out of Range" );
+                    }
+
+                    this->row( this->used_length ) = *first;
+                    ++this->used_length;
+                }
+
+            } catch ( ... ) {
+                this->used_length = len;
+                throw;
+            }
+
+            DATA_ADAPTER_STAT_ADD( shifted, len - off )
+
+            da::detail::soa::rotate r = { off, len, this->used_length };
+            this->each_column( r );
+
+            return this->begin() + off;
+        }
+
+        void copy_from( const DataAdapter &a ) {
+            da::detail::soa::copy_column c = { a.length() };
+            this->each_column( c, a, columns_type() );
+
+            this->used_length = a.length();
+        }
+
+    public:
+        DataAdapter() : used_length( 0 ) {}
+
+        DataAdapter( size_type n, const element_type &val = element_type() ) : used_length( 0 ) {
+            this->insert( this->begin(), n, val );
+        }
+
+        DataAdapter( std::initializer_list<element_type> il ) : used_length( 0 ) {
+            this->insert( this->begin(), il.begin(), il.end() );
+        }
+
+        DataAdapter( const DataAdapter &a ) : used_length( 0 ) {
+            this->copy_from( a );
+        }
+
+        DataAdapter &operator=( const DataAdapter &a ) {
+            if ( this != &a ) {
+                this->copy_from( a );
+            }
+
+            return *this;
+        }
+
+        DataAdapter( DataAdapter &&a ) : used_length( a.length() ) {
+            da::detail::soa::move_column m = { a.length() };
+            this->each_column( m, a, columns_type() );
+
+            a.used_length = 0;
+        }
+
+        DataAdapter &operator=( DataAdapter &&a ) {
+            if ( this != &a ) {
+                da::detail::soa::move_column m = { a.length() };
+                this->each_column( m, a, columns_type() );
+
+                this->used_length = a.length();
+                a.used_length = 0;
+            }
+
+            return *this;
+        }
+
+        //Column by column, with memcmp for the columns that allow it
+        bool operator==( const DataAdapter &da ) const {
+            bool result = this->length() == da.length();
+
+            da::detail::soa::equal_column e = { this->length(), &result };
+            this->each_column( e, da, columns_type() );
+
+            return result;
+        }
+
+        //Every column hashed on its own, then the hashes combined
+        size_type hash() const {
+            size_type result = this->length();
+
+            da::detail::soa::hash_column h = { this->length(), &result };
+            this->each_column( h );
+
+            return result;
+        }
+
+        inline size_type capacity() const {
+            return N;
+        }
+
+        inline size_type length() const {
+            return this->used_length;
+        }
+
+        /*
+            The Ith column, as one contiguous range of the Ith fields of every row. Valid until the length
+            changes, but its elements are the adapter's own, so writing to them changes the rows.
+        */
+        template <size_t I>
+        inline column_view<I> column() {
+            return column_view<I>( this->column_data<I>(), this->column_data<I>() + this->length() );
+        }
+
+        template <size_t I>
+        inline const_column_view<I> column() const {
+            return const_column_view<I>( this->column_data<I>(), this->column_data<I>() + this->length() );
+        }
+
+        void push_back( const element_type &n = element_type() ) {
+            DATA_ADAPTER_STAT_SCOPE( push_back )
+
+            if ( !this->full() ) {
+                this->row( this->used_length ) = n;
+                ++this->used_length;
+
+            } else {
+                DATA_ADAPTER_STAT_ADD( thrown, 1 )
+                throw std::out_of_range( "DataAdapter::push_back: Out of Range" );
+            }
+        }
+
+        void push_back( element_type &&n ) {
+            DATA_ADAPTER_STAT_SCOPE( push_back )
+
+            if ( !this->full() ) {
+                this->row( this->used_length ) = std::move( n );
+                ++this->used_length;
+
+            } else {
+                DATA_ADAPTER_STAT_ADD( thrown, 1 )
+                throw std::out_of_range( "DataAdapter::push_back: Out of Range" );
+            }
+        }
+
+        void push_front( const element_type &val = element_type() ) {
+            this->insert( this->begin(), val );
+        }
+
+        void push_front( element_type &&val ) {
+            this->insert( this->begin(), std::move( val ) );
+        }
+
+        //The fields are constructed together as a tuple first, since they have no place of their own to be constructed in
+        template <typename... Args>
+        reference emplace_back( Args &&... args ) {
+            DATA_ADAPTER_STAT_SCOPE( emplace )
+
+            if ( !this->full() ) {
+                reference r = this->row( this->used_length );
+
+                r = element_type( std::forward<Args>( args )... );
+                ++this->used_length;
+
+                return r;
+
+            } else {
+                DATA_ADAPTER_STAT_ADD( thrown, 1 )
+                throw std::out_of_range( "DataAdapter::emplace_back: Out of Range" );
+            }
+        }
+
+        template <typename... Args>
+        iterator emplace( iterator pos, Args &&... args ) {
+            return this->insert( pos, element_type( std::forward<Args>( args )... ) );
+        }
+
+        element_type pop_back() {
+            DATA_ADAPTER_STAT_SCOPE( pop_back )
+
+            if ( !this->empty() ) {
+                --this->used_length;
+
+                return this->take( this->used_length, columns_type() );
+
+            } else {
+                return element_type();
+            }
+        }
+
+        element_type pop_front() {
+            DATA_ADAPTER_STAT_SCOPE( pop_front )
+
+            if ( !this->empty() ) {
+                element_type ret( this->take( 0, columns_type() ) );
+
+                this->close_gap( 0, 1 );
+
+                return ret;
+
+            } else {
+                return element_type();
+            }
+        }
+
+        inline reference at( size_type n ) {
+            return this->row( n );
+        }
+
+        inline const_reference at( size_type n ) const {
+            return this->row( n );
+        }
+
+        inline reference at( iterator it ) {
+            return this->row( it.offset() );
+        }
+
+        inline const_reference at( const_iterator it ) const {
+            return this->row( it.offset() );
+        }
+
+        inline reference operator[]( size_type n ) {
+            return this->row( n );
+        }
+
+        inline const_reference operator[]( size_type n ) const {
+            return this->row( n );
+        }
+
+        inline reference front() {
+            return this->row( 0 );
+        }
+
+        inline const_reference front() const {
+            return this->row( 0 );
+        }
+
+        inline reference back() {
+            return this->row( this->empty() ? 0 : this->length() - 1 );
+        }
+
+        inline const_reference back() const {
+            return this->row( this->empty() ? 0 : this->length() - 1 );
+        }
+
+        iterator sorted_insert( const element_type &n ) {
+            DATA_ADAPTER_STAT_SCOPE( sorted_insert )
+
+            return this->insert( std::upper_bound( this->begin(), this->end(), n ), n );
+        }
+
+        iterator sorted_insert( element_type &&n ) {
+            DATA_ADAPTER_STAT_SCOPE( sorted_insert )
+
+            iterator pos = std::upper_bound( this->begin(), this->end(), n );
+
+            return this->insert( pos, std::move( n ) );
+        }
+
+        //single element
+        iterator insert( iterator pos, const element_type &val ) {
+            return this->insert( pos, element_type( val ) );
+        }
+
+        iterator insert( iterator pos, element_type &&val ) {
+            DATA_ADAPTER_STAT_SCOPE( insert )
+
+            size_type off = pos.offset();
+
+            if ( off <= this->length() && !this->full() ) {
+                this->open_gap( off, 1 );
+                this->row( off ) = std::move( val );
+
+                return this->begin() + off;
+
+            } else {
+                DATA_ADAPTER_STAT_ADD( thrown, 1 )
+                throw std::out_of_range( "DataAdapter::insert: Out of Range" );
+            }
+        }
+
+        //fill
+        iterator insert( iterator pos, size_type n, const element_type &val ) {
+            DATA_ADAPTER_STAT_SCOPE( insert_fill )
+
+            if ( n != 0 ) {
+                size_type off = pos.offset();
+
+                if ( off <= this->length() && this->length() + n <= this->capacity() ) {
+                    element_type tmp( val );
+
+                    this->open_gap( off, n );
+
+                    DATA_ADAPTER_STAT_ADD( filled, n )
+
+                    for ( size_type i = off; i < off + n; ++i ) {
+                        this->row( i ) = tmp;
+                    }
+
+                    return this->begin() + off;
+
+                } else {
+                    DATA_ADAPTER_STAT_ADD( thrown, 1 )
+                    throw std::out_of_range( "DataAdapter::insert(fill): Out of Range" );
+                }
+            } else {
+                return this->end();
+            }
+        }
+
+        //Any range, from any kind of iterator, or a count and a value
+        template <typename _InputIterator>
+        iterator insert( iterator pos, _InputIterator first, _InputIterator last ) {
+            return this->insert_range( pos, first, last, typename da::detail::range_kind<_InputIterator>::type() );
+        }
+
+        //The slots are live elements, so the ones in use are reset, to let go of whatever they hold
+        void clear() {
+            DATA_ADAPTER_STAT_SCOPE( clear )
+            DATA_ADAPTER_STAT_ADD( filled, this->length() )
+
+            da::detail::soa::reset r = { 0, this->length() };
+            this->each_column( r );
+
+            this->used_length = 0;
+        }
+
+        inline size_type resize( size_type n ) {
+            return this->resize( n, element_type() );
+        }
+
+        size_type resize( size_type n, const element_type &v ) {
+            DATA_ADAPTER_STAT_SCOPE( resize )
+
+            if ( n <= this->capacity() ) {
+                size_type ret = this->length();
+
+                if ( n > ret ) {
+                    DATA_ADAPTER_STAT_ADD( filled, n - ret )
+
+                    element_type tmp( v );
+
+                    for ( size_type i = ret; i < n; ++i ) {
+                        this->row( i ) = tmp;
+                    }
+                }
+
+                this->used_length = n;
+
+                return ret;
+
+            } else {
+                DATA_ADAPTER_STAT_ADD( thrown, 1 )
+                throw std::out_of_range( "DataAdapter::resize: Out of Range" );
+            }
+        }
+
+        inline iterator erase( iterator pos ) {
+            return this->erase( pos, pos + 1 );
+        }
+
+        iterator erase( iterator first, iterator last ) {
+            DATA_ADAPTER_STAT_SCOPE( erase )
+
+            size_type f = first.offset();
+            size_type l = last.offset();
+
+            if ( f <= l && l <= this->length() ) {
+
+                this->close_gap( f, l );
+
+                return this->begin() + f;
+
+            } else {
+                DATA_ADAPTER_STAT_ADD( thrown, 1 )
+                throw std::out_of_range( "DataAdapter::erase(range): Out of Range" );
+            }
+        }
+
+        /*
+            Erases every row pred( row ) is true for, where row is a const_reference, and returns how many
+            there were. pred is called once per row, then each column is compacted in one pass of its own.
+        */
+        template <typename _Predicate>
+        size_type erase_if( _Predicate pred ) {
+            DATA_ADAPTER_STAT_SCOPE( erase_if )
+
+            const DataAdapter &self = *this;
+            size_type len = this->length();
+            size_type first = 0;
+
+            while ( first < len && !pred( self.row( first ) ) ) {
+                ++first;
+            }
+
+            if ( first == len ) {
+                return 0;
+            }
+
+            std::vector<unsigned char> keep( len, 0 );
+            size_type kept = first;
+
+            for ( size_type i = first + 1; i < len; ++i ) {
+                if ( !pred( self.row( i ) ) ) {
+                    keep[i] = 1;
+                    ++kept;
+                }
+            }
+
+            DATA_ADAPTER_STAT_ADD( shifted, kept - first )
+
+            da::detail::soa::compact c = { keep.data(), first, len };
+            this->each_column( c );
+
+            this->used_length = kept;
+
+            return len - kept;
+        }
+
+        //Moves the last row into pos instead of shifting everything after it down
+        iterator unordered_erase( iterator pos ) {
+            DATA_ADAPTER_STAT_SCOPE( unordered_erase )
+
+            size_type off = pos.offset();
+            size_type len = this->length();
+
+            if ( off < len ) {
+                if ( off + 1 != len ) {
+                    DATA_ADAPTER_STAT_ADD( shifted, 1 )
+
+                    da::detail::soa::move_row m = { len - 1, off };
+                    this->each_column( m );
+                }
+
+                --this->used_length;
+
+                return this->begin() + off;
+
+            } else {
+                DATA_ADAPTER_STAT_ADD( thrown, 1 )
+                throw std::out_of_range( "DataAdapter::unordered_erase: Out of Range" );
+            }
+        }
+
+        //The first row whose Ith field is key, or end(), looking at that column only
+        template <size_t I>
+        iterator find_by( const field_type<I> &key ) {
+            DATA_ADAPTER_STAT_SCOPE( find )
+
+            const field_type<I> *d = this->column_data<I>();
+
+            return this->begin() + ( std::find( d, d + this->length(), key ) - d );
+        }
+
+        template <size_t I>
+        const_iterator find_by( const field_type<I> &key ) const {
+            DATA_ADAPTER_STAT_SCOPE( find )
+
+            const field_type<I> *d = this->column_data<I>();
+
+            return this->cbegin() + ( std::find( d, d + this->length(), key ) - d );
+        }
+
+        /*
+            Stably sorts the rows by their Ith field. The column is sorted as pairs of each field and its row,
+            which is a radix sort for fields with a da::radix_key, and the order of the rows that gives is then
+            applied to every column.
+        */
+        template <size_t I>
+        void sort_by() {
+            DATA_ADAPTER_STAT_SCOPE( stable_sort )
+
+            typedef da::detail::soa::keyed<field_type<I> > keyed_type;
+
+            size_type len = this->length();
+            const field_type<I> *d = this->column_data<I>();
+
+            std::vector<keyed_type> keyed;
+            keyed.reserve( len );
+
+            for ( size_type i = 0; i < len; ++i ) {
+                keyed_type k = { d[i], i };
+                keyed.push_back( k );
+            }
+
+            da::detail::sort( keyed.data(), keyed.data() + len );
+
+            std::vector<size_type> order( len );
+
+            for ( size_type i = 0; i < len; ++i ) {
+                order[i] = keyed[i].row;
+            }
+
+            this->permute( order );
+        }
+
+        //Whole rows, compared like the tuples, through the order of the rows and then the same permutation
+        void sort() {
+            DATA_ADAPTER_STAT_SCOPE( sort )
+
+            std::vector<size_type> order( this->length() );
+
+            for ( size_type i = 0; i < order.size(); ++i ) {
+                order[i] = i;
+            }
+
+            const DataAdapter &self = *this;
+
+            std::sort( order.begin(), order.end(), [&self]( size_type a, size_type b ) {
+                return self.row( a ) < self.row( b );
+            } );
+
+            this->permute( order );
+        }
+
+        void stable_sort() {
+            DATA_ADAPTER_STAT_SCOPE( stable_sort )
+
+            std::vector<size_type> order( this->length() );
+
+            for ( size_type i = 0; i < order.size(); ++i ) {
+                order[i] = i;
+            }
+
+            const DataAdapter &self = *this;
+
+            std::stable_sort( order.begin(), order.end(), [&self]( size_type a, size_type b ) {
+                return self.row( a ) < self.row( b );
+            } );
+
+            this->permute( order );
+        }
+};
+
+/*Mutable iterator class template*/
+template <typename... Ts, size_t N>
+class DataApapterIterator<da::soa<std::tuple<Ts...>, N> >
+    : public da::detail::soa::row_iterator<DataApapterIterator<da::soa<std::tuple<Ts...>, N> >,
+      DataAdapter<da::soa<std::tuple<Ts...>, N> >, da::detail::soa::row_reference<Ts...> > {
+    public:
+        typedef da::detail::soa::row_iterator<DataApapterIterator<da::soa<std::tuple<Ts...>, N> >,
+                DataAdapter<da::soa<std::tuple<Ts...>, N> >, da::detail::soa::row_reference<Ts...> > _Base;
+
+        typedef typename _Base::difference_type         difference_type;
+        typedef typename _Base::parent_type             parent_type;
+
+        DataApapterIterator() {}
+        DataApapterIterator( parent_type *x, difference_type ioff = 0 ) : _Base( x, ioff ) {}
+        DataApapterIterator( parent_type &x, difference_type ioff = 0 ) : _Base( &x, ioff ) {}
+
+        //VERY IMPORTANT for converting and comparing to const_iterators
+        inline operator typename parent_type::const_iterator() const {
+            return typename parent_type::const_iterator( this->parent, this->off );
+        }
+};
+
+/*Immutable iterator class template*/
+template <typename... Ts, size_t N>
+class DataApapterIterator<const da::soa<std::tuple<Ts...>, N> >
+    : public da::detail::soa::row_iterator<DataApapterIterator<const da::soa<std::tuple<Ts...>, N> >,
+      const DataAdapter<da::soa<std::tuple<Ts...>, N> >, da::detail::soa::row_reference<const Ts...> > {
+    public:
+        typedef da::detail::soa::row_iterator<DataApapterIterator<const da::soa<std::tuple<Ts...>, N> >,
+                const DataAdapter<da::soa<std::tuple<Ts...>, N> >, da::detail::soa::row_reference<const Ts...> > _Base;
+
+        typedef typename _Base::difference_type         difference_type;
+        typedef typename _Base::parent_type             parent_type;
+
+        DataApapterIterator() {}
+        DataApapterIterator( parent_type *x, difference_type ioff = 0 ) : _Base( x, ioff ) {}
+        DataApapterIterator( parent_type &x, difference_type ioff = 0 ) : _Base( &x, ioff ) {}
+};
+
+#endif // DATA_ADAPTER_SOA_HPP_INCLUDED
@@ -0,0 +1,269 @@
+#ifndef DATA_ADAPTER_MPMC_QUEUE_HPP_INCLUDED
+#define DATA_ADAPTER_MPMC_QUEUE_HPP_INCLUDED
+
+#include "../data_adapter.hpp"
+
+#if !DATA_ADAPTER_CXX11
+#error "da::mpmc_queue<T, N> requires C++11"
+#endif // DATA_ADAPTER_CXX11
+
+#include <atomic>
+#include <cstddef>
+#include <new>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+#include "../detail/storage.hpp"
+
+#if defined(__SSE2__) || defined(_M_X64) || ( defined(_M_IX86_FP) && _M_IX86_FP >= 2 )
+#   include <emmintrin.h>
+#   define DATA_ADAPTER_SPIN_PAUSE() _mm_pause()
+#else
+#   define DATA_ADAPTER_SPIN_PAUSE()
+#endif
+
+/**
+ *              Notes on the implementation of this:
+ *
+ *      This is Dmitry Vyukov's bounded queue, for any number of producer and consumer threads sharing one
+ * buffer without a lock. The buffer is inline, like the array adapter's, and holds N elements rounded up to
+ * a power of two, so that a position maps to its slot with a mask.
+ *
+ *      Every slot has a sequence number next to the element, which says whose turn it is. For the slot of
+ * position p, the sequence is p when the slot is free for the producer of p, p + 1 once that producer has
+ * stored its element there, and p + capacity once the consumer of p has taken it out, which is the next
+ * producer's turn. A producer claims a position by moving the shared tail past it with a compare and swap,
+ * but only after seeing that the slot's sequence says it is free, so a full queue is noticed without
+ * writing anything, and the same for consumers, the head, and an empty queue. After the claim, each thread
+ * has its slot to itself until it publishes it with a release store of the new sequence. So there is no
+ * lock anywhere, and threads only ever contend on the head or the tail, each on a cache line of its own.
+ *
+ *      try_push and try_pop give up and return false when the queue is full or empty. push and pop wait
+ * instead, spinning for a while and then yielding the rest of their time slice between attempts, so they
+ * never sleep on a lock but don't burn a core for long either.
+ *
+ *      Once a position is claimed, its slot has to be published whatever happens, or every thread after it
+ * would wait on it forever. So T's move constructor and move assignment must not throw. Pushing something
+ * that could throw while being constructed in place (like a copy) constructs it before claiming a position.
+ */
+
+namespace da {
+    namespace detail {
+
+        //The smallest power of two that is at least n
+        constexpr size_t round_up_pow2( size_t n, size_t p = 1 ) {
+            return p >= n ? p : round_up_pow2( n, p * 2 );
+        }
+
+        //Waiting for another thread: a few spins with a pause, then giving up the time slice each time
+        class backoff {
+            private:
+                unsigned spins;
+
+            public:
+                backoff() : spins( 0 ) {}
+
+                inline void wait() {
+                    if ( this->spins < 16 ) {
+                        for ( unsigned i = 0; i < ( 1u << this->spins ) && i < 64; ++i ) {
+                            DATA_ADAPTER_SPIN_PAUSE();
+                        }
+
+                        ++this->spins;
+
+                    } else {
+                        std::this_thread::yield();
+                    }
+                }
+        };
+    }
+
+    template <typename T, size_t N>
+    class mpmc_queue {
+        public:
+            typedef T           element_type;
+            typedef size_t      size_type;
+
+            static const size_type static_capacity = da::detail::round_up_pow2( N );
+
+        private:
+            static_assert( N > 0, "da::mpmc_queue needs room for at least one element" );
+            static_assert( std::is_nothrow_move_constructible<T>::value && std::is_nothrow_move_assignable<T>::value,
+                           "da::mpmc_queue needs elements that can be moved without throwing" );
+
+            static const size_type mask = static_capacity - 1;
+
+            struct cell {
+                std::atomic<size_type> sequence;
+                da::detail::raw_storage<T, 1> element;
+            };
+
+            alignas( da::detail::cache_line_size ) std::atomic<size_type> tail;
+            alignas( da::detail::cache_line_size ) std::atomic<size_type> head;
+            alignas( da::detail::cache_line_size ) cell cells[static_capacity];
+
+            //The free slot at the tail and its position, with tail moved past it, or NULL if the queue is full
+            cell *claim_tail( size_type &pos ) {
+                pos = this->tail.load( std::memory_order_relaxed );
+
+                for ( ;; ) {
+                    cell *c = &this->cells[pos & mask];
+                    std::ptrdiff_t dif = static_cast<std::ptrdiff_t>( c->sequence.load( std::memory_order_acquire ) - pos );
+
+                    if ( dif == 0 ) {
+                        if ( this->tail.compare_exchange_weak( pos, pos + 1, std::memory_order_relaxed ) ) {
+                            return c;
+                        }
+
+                    } else if ( dif < 0 ) {
+                        return NULL;
+
+                    } else {
+                        pos = this->tail.load( std::memory_order_relaxed );
+                    }
+                }
+            }
+
+            //The full slot at the head, with head moved past it, or NULL if the queue is empty
+            cell *claim_head( size_type &pos ) {
+                pos = this->head.load( std::memory_order_relaxed );
+
+                for ( ;; ) {
+                    cell *c = &this->cells[pos & mask];
+                    std::ptrdiff_t dif = static_cast<std::ptrdiff_t>( c->sequence.load( std::memory_order_acquire ) - ( pos + 1 ) );
+
+                    if ( dif == 0 ) {
+                        if ( this->head.compare_exchange_weak( pos, pos + 1, std::memory_order_relaxed ) ) {
+                            return c;
+                        }
+
+                    } else if ( dif < 0 ) {
+                        return NULL;
+
+                    } else {
+                        pos = this->head.load( std::memory_order_relaxed );
+                    }
+                }
+            }
+
+            template <typename... Args>
+            bool emplace_tail( std::true_type, Args &&... args ) {
+                size_type pos;
+                cell *c = this->claim_tail( pos );
+
+                if ( c == NULL ) {
+                    return false;
+                }
+
+                ::new( static_cast<void *>( c->element.data() ) ) T( std::forward<Args>( args )... );
+                c->sequence.store( pos + 1, std::memory_order_release );
+
+                return true;
+            }
+
+            //Constructing could throw, so that happens first, and the claimed slot only gets a move
+            template <typename... Args>
+            bool emplace_tail( std::false_type, Args &&... args ) {
+                T val( std::forward<Args>( args )... );
+
+                return this->emplace_tail( std::true_type(), std::move( val ) );
+            }
+
+        public:
+            mpmc_queue() : tail( 0 ), head( 0 ) {
+                for ( size_type i = 0; i < static_capacity; ++i ) {
+                    this->cells[i].sequence.store( i, std::memory_order_relaxed );
+                }
+            }
+
+            mpmc_queue( const mpmc_queue & ) = delete;
+            mpmc_queue &operator=( const mpmc_queue & ) = delete;
+
+            //Nothing else can be using the queue by now, so everything from head to tail is a live element
+            ~mpmc_queue() {
+                size_type h = this->head.load( std::memory_order_relaxed );
+                size_type t = this->tail.load( std::memory_order_relaxed );
+
+                for ( ; h != t; ++h ) {
+                    this->cells[h & mask].element.data()->~T();
+                }
+            }
+
+            //Constructs the element in place, and returns false without doing so if the queue is full
+            template <typename... Args>
+            inline bool try_emplace( Args &&... args ) {
+                return this->emplace_tail( typename std::is_nothrow_constructible<T, Args &&...>::type(), std::forward<Args>( args )... );
+            }
+
+            inline bool try_push( const element_type &val ) {
+                return this->try_emplace( val );
+            }
+
+            inline bool try_push( element_type &&val ) {
+                return this->try_emplace( std::move( val ) );
+            }
+
+            //Moves the front element into val, and returns false if the queue is empty
+            bool try_pop( element_type &val ) {
+                size_type pos;
+                cell *c = this->claim_head( pos );
+
+                if ( c == NULL ) {
+                    return false;
+                }
+
+                T *p = c->element.data();
+
+                val = std::move( *p );
+                p->~T();
+
+                c->sequence.store( pos + static_capacity, std::memory_order_release );
+
+                return true;
+            }
+
+            //Waits for room if the queue is full. The copy is made once, up front
+            void push( const element_type &val ) {
+                this->push( element_type( val ) );
+            }
+
+            void push( element_type &&val ) {
+                da::detail::backoff b;
+
+                while ( !this->try_push( std::move( val ) ) ) {
+                    b.wait();
+                }
+            }
+
+            //Waits for an element if the queue is empty
+            void pop( element_type &val ) {
+                da::detail::backoff b;
+
+                while ( !this->try_pop( val ) ) {
+                    b.wait();
+                }
+            }
+
+            //Only a snapshot, since other threads can push and pop while this runs
+            inline size_type size() const {
+                size_type h = this->head.load( std::memory_order_acquire );
+                size_type t = this->tail.load( std::memory_order_acquire );
+
+                return t > h ? ( t - h < static_capacity ? t - h : static_capacity ) : 0;
+            }
+
+            inline bool empty() const {
+                return this->size() == 0;
+            }
+
+            inline size_type capacity() const {
+                return static_capacity;
+            }
+    };
+
+    template <typename T, size_t N>
+    const typename mpmc_queue<T, N>::size_type mpmc_queue<T, N>::static_capacity;
+}
+
+#endif // DATA_ADAPTER_MPMC_QUEUE_HPP_INCLUDED
@@ -0,0 +1,243 @@
+#ifndef DATA_ADAPTER_READ_MOSTLY_HPP_INCLUDED
+#define DATA_ADAPTER_READ_MOSTLY_HPP_INCLUDED
+
+#include "../data_adapter.hpp"
+
+#if !DATA_ADAPTER_CXX11
+#error "da::read_mostly<Adapter> requires C++11"
+#endif // DATA_ADAPTER_CXX11
+
+#include <atomic>
+#include <cstddef>
+#include <mutex>
+#include <thread>
+
+#include "../detail/storage.hpp"
+
+/**
+ *              Notes on the implementation of this:
+ *
+ *      da::read_mostly<Adapter> holds the current version of an adapter behind an atomic pointer, for tables
+ * that many threads read all the time and something changes now and then. A version is never changed once
+ * it is published. Writers copy the current version, change the copy and publish it in its place, and
+ * readers take a snapshot, which is the version that was current when they took it, and keep it for as long
+ * as they hold the snapshot, however many versions get published meanwhile.
+ *
+ *      Old versions are reclaimed like in RCU. A reader counts itself in before loading the pointer and out
+ * when it lets go of the snapshot, and a writer deletes the version it replaced only after it has seen every
+ * count drop to zero once after publishing. Since all of those are sequentially consistent, a reader that
+ * loaded the old pointer counted itself in before the publish, so the writer sees it until it is gone.
+ * Waiting on a single count could wait forever though, if readers kept coming, so there are two per slot and
+ * an epoch says which one new readers use. The writer moves the epoch on, so only readers from before keep the
+ * other count from dropping, waits for it, and does the same again for the first one.
+ *
+ *      The counts are spread over Slots slots on cache lines of their own, and every thread is given a slot the
+ * first time it reads, in turns. With no more reading threads than slots, each has one to itself, and a read
+ * only ever writes to the line of its thread's slot, and only reads two lines writers write to a few times for
+ * each version. So reads never wait for anything, neither writers nor each other, and don't slow each other down
+ * however many cores read at once.
+ *
+ *      Writers are serialized by a mutex, and wait for the readers of the version they replaced, so a thread
+ * must not write while it holds a snapshot of the same read_mostly, or it waits for itself forever. Snapshots
+ * must not outlive the read_mostly either.
+ *
+ *      If the change throws, nothing is published, and the copy is thrown away.
+ */
+
+namespace da {
+    namespace detail {
+
+        //Handed out in turns, once per thread, for picking a slot of a read_mostly
+        inline size_t reader_index() {
+            static std::atomic<size_t> next( 0 );
+            static thread_local size_t index = next.fetch_add( 1, std::memory_order_relaxed );
+
+            return index;
+        }
+    }
+
+    template <typename _Adapter, size_t Slots = 32>
+    class read_mostly {
+        public:
+            typedef _Adapter                                adapter_type;
+            typedef typename _Adapter::element_type         element_type;
+            typedef typename _Adapter::size_type            size_type;
+            typedef typename _Adapter::const_iterator       const_iterator;
+
+        private:
+            static_assert( Slots > 0, "da::read_mostly needs at least one reader slot" );
+
+            struct alignas( da::detail::cache_line_size ) slot {
+                std::atomic<size_t> readers[2];
+            };
+
+            alignas( da::detail::cache_line_size ) std::atomic<_Adapter *> current;
+            std::atomic<size_t> epoch;
+
+            alignas( da::detail::cache_line_size ) std::mutex write_lock;
+
+            //Readers write to these through a const read_mostly too
+            mutable slot slots[Slots];
+
+            void init_slots() {
+                for ( size_t s = 0; s < Slots; ++s ) {
+                    this->slots[s].readers[0].store( 0, std::memory_order_relaxed );
+                    this->slots[s].readers[1].store( 0, std::memory_order_relaxed );
+                }
+            }
+
+            //Waits until every reader that could still have the version just replaced is done with it
+            void synchronize() {
+                for ( int round = 0; round < 2; ++round ) {
+                    size_t old = this->epoch.fetch_add( 1 ) & 1;
+
+                    for ( size_t s = 0; s < Slots; ++s ) {
+                        while ( this->slots[s].readers[old].load() != 0 ) {
+                            std::this_thread::yield();
+                        }
+                    }
+                }
+            }
+
+            //Publishes next in place of the current version, which is deleted once nobody reads it any more
+            void publish( _Adapter *next ) {
+                _Adapter *old = this->current.exchange( next );
+
+                this->synchronize();
+
+                delete old;
+            }
+
+        public:
+            /*
+                The version a reader took, with the const part of the adapter's interface, which is all
+                anybody can do with it. It can be moved but not copied.
+            */
+            class snapshot {
+                private:
+                    std::atomic<size_t> *readers;
+                    _Adapter *version;
+
+                    friend class read_mostly;
+
+                    snapshot( std::atomic<size_t> *r, _Adapter *v ) : readers( r ), version( v ) {}
+
+                public:
+                    snapshot( snapshot &&s ) : readers( s.readers ), version( s.version ) {
+                        s.readers = NULL;
+                    }
+
+                    snapshot( const snapshot & ) = delete;
+                    snapshot &operator=( const snapshot & ) = delete;
+
+                    ~snapshot() {
+                        if ( this->readers != NULL ) {
+                            this->readers->fetch_sub( 1, std::memory_order_release );
+                        }
+                    }
+
+                    inline const _Adapter &operator*() const {
+                        return *this->version;
+                    }
+
+                    inline const _Adapter *operator->() const {
+                        return this->version;
+                    }
+
+                    inline const _Adapter &get() const {
+                        return *this->version;
+                    }
+
+                    inline const_iterator begin() const {
+                        return this->version->cbegin();
+                    }
+
+                    inline const_iterator end() const {
+                        return this->version->cend();
+                    }
+
+                    inline size_type length() const {
+                        return this->version->length();
+                    }
+
+                    inline bool empty() const {
+                        return this->version->empty();
+                    }
+
+                    //The adapter's own searches, which don't change it, so it's safe to call them from every reader
+                    inline const_iterator find( const element_type &n ) const {
+                        return this->version->find( n );
+                    }
+
+                    inline const_iterator find_sorted( const element_type &n ) const {
+                        return this->version->find_sorted( n );
+                    }
+
+                    inline bool contains( const element_type &n ) const {
+                        return this->version->contains( n );
+                    }
+
+                    inline size_type count( const element_type &n ) const {
+                        return this->version->count( n );
+                    }
+            };
+
+            read_mostly() : current( new _Adapter() ), epoch( 0 ) {
+                this->init_slots();
+            }
+
+            explicit read_mostly( const _Adapter &a ) : current( new _Adapter( a ) ), epoch( 0 ) {
+                this->init_slots();
+            }
+
+            read_mostly( const read_mostly & ) = delete;
+            read_mostly &operator=( const read_mostly & ) = delete;
+
+            //Nothing can be reading by now
+            ~read_mostly() {
+                delete this->current.load( std::memory_order_relaxed );
+            }
+
+            //Never waits, whatever writers are doing
+            snapshot read() const {
+                slot &s = this->slots[da::detail::reader_index() % Slots];
+                std::atomic<size_t> *readers = &s.readers[this->epoch.load( std::memory_order_relaxed ) & 1];
+
+                readers->fetch_add( 1 );
+
+                return snapshot( readers, this->current.load() );
+            }
+
+            /*
+                Publishes a copy of the current version, changed by f( adapter_type & ), and returns after the
+                version it replaced is gone. However many changes f makes, readers see either none or all of them.
+            */
+            template <typename _Function>
+            void update( _Function f ) {
+                std::lock_guard<std::mutex> g( this->write_lock );
+
+                _Adapter *next = new _Adapter( *this->current.load( std::memory_order_relaxed ) );
+
+                try {
+                    f( *next );
+
+                } catch ( ... ) {
+                    delete next;
+                    throw;
+                }
+
+                this->publish( next );
+            }
+
+            //Publishes a copy of a as the new version
+            void store( const _Adapter &a ) {
+                _Adapter *next = new _Adapter( a );
+
+                std::lock_guard<std::mutex> g( this->write_lock );
+
+                this->publish( next );
+            }
+    };
+}
+
+#endif // DATA_ADAPTER_READ_MOSTLY_HPP_INCLUDED
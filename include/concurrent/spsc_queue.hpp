@@ -0,0 +1,236 @@
+#ifndef DATA_ADAPTER_SPSC_QUEUE_HPP_INCLUDED
+#define DATA_ADAPTER_SPSC_QUEUE_HPP_INCLUDED
+
+#include "../data_adapter.hpp"
+
+#if !DATA_ADAPTER_CXX11
+#error "da::spsc_queue<T, N> requires C++11"
+#endif // DATA_ADAPTER_CXX11
+
+#include <atomic>
+#include <cstddef>
+#include <new>
+#include <utility>
+
+#include "../detail/storage.hpp"
+
+/**
+ *              Notes on the implementation of this:
+ *
+ *      This is a bounded queue for handing elements from exactly one producer thread to exactly one consumer
+ * thread without a lock, in the same raw storage for N elements the array adapter uses (see
+ * detail/storage.hpp). Elements are constructed in their slot by the push and destroyed by the pop, so
+ * only what is in the queue is ever alive.
+ *
+ *      head is the count of elements ever popped and tail the count ever pushed, so tail - head is the
+ * length and element i lives in slot i % N, which is a mask when N is a power of two. Only the consumer
+ * writes head and only the producer writes tail. A push constructs the element and then publishes it with
+ * a release store of tail, which the consumer's acquire load of tail pairs with, and the same the other way
+ * around for the slot a pop frees up.
+ *
+ *      head and tail are on cache lines of their own, so the two threads don't fight over one line on every
+ * operation. Each side also keeps a copy of the other side's index, which it only loads again when the copy
+ * says the queue is full (for the producer) or empty (for the consumer). So while the queue is neither, a
+ * push or pop touches nothing the other thread writes, and push_n and pop_n publish a whole batch with one store.
+ *
+ *      The queue itself is not an adapter: nothing besides the try_ operations, push_n and pop_n is safe
+ * while both threads are running, so it only has those, and some approximate observers. Which thread is
+ * the producer and which the consumer can change, but only with synchronization in between, like joining.
+ *
+ *      If constructing an element throws in a push, it isn't pushed, and push_n still publishes the ones
+ * before it. If moving one out throws in a pop, it stays at the front of the queue.
+ */
+
+namespace da {
+    template <typename T, size_t N>
+    class spsc_queue {
+        public:
+            typedef T           element_type;
+            typedef size_t      size_type;
+
+        private:
+            static_assert( N > 0, "da::spsc_queue needs room for at least one element" );
+
+            //The consumer's line: what it writes, and its copy of tail
+            alignas( da::detail::cache_line_size ) std::atomic<size_type> head;
+            size_type tail_cache;
+
+            //The producer's line
+            alignas( da::detail::cache_line_size ) std::atomic<size_type> tail;
+            size_type head_cache;
+
+            alignas( da::detail::cache_line_size ) da::detail::raw_storage<T, N> storage;
+
+            inline T *slot( size_type i ) {
+                return this->storage.data() + i % N;
+            }
+
+            //Room for the producer from t on, loading head again only if the copy says there is less than n
+            inline size_type room( size_type t, size_type n ) {
+                size_type free = N - ( t - this->head_cache );
+
+                if ( free < n ) {
+                    this->head_cache = this->head.load( std::memory_order_acquire );
+                    free = N - ( t - this->head_cache );
+                }
+
+                return free;
+            }
+
+            //Elements for the consumer from h on, the same way
+            inline size_type available( size_type h, size_type n ) {
+                size_type ready = this->tail_cache - h;
+
+                if ( ready < n ) {
+                    this->tail_cache = this->tail.load( std::memory_order_acquire );
+                    ready = this->tail_cache - h;
+                }
+
+                return ready;
+            }
+
+        public:
+            spsc_queue() : head( 0 ), tail_cache( 0 ), tail( 0 ), head_cache( 0 ) {}
+
+            spsc_queue( const spsc_queue & ) = delete;
+            spsc_queue &operator=( const spsc_queue & ) = delete;
+
+            ~spsc_queue() {
+                size_type h = this->head.load( std::memory_order_relaxed );
+                size_type t = this->tail.load( std::memory_order_relaxed );
+
+                for ( ; h != t; ++h ) {
+                    this->slot( h )->~T();
+                }
+            }
+
+            //Producer only. Constructs the element in place, and returns false without doing so if the queue is full
+            template <typename... Args>
+            bool try_emplace( Args &&... args ) {
+                size_type t = this->tail.load( std::memory_order_relaxed );
+
+                if ( this->room( t, 1 ) == 0 ) {
+                    return false;
+                }
+
+                ::new( static_cast<void *>( this->slot( t ) ) ) T( std::forward<Args>( args )... );
+
+                this->tail.store( t + 1, std::memory_order_release );
+
+                return true;
+            }
+
+            inline bool try_push( const element_type &val ) {
+                return this->try_emplace( val );
+            }
+
+            inline bool try_push( element_type &&val ) {
+                return this->try_emplace( std::move( val ) );
+            }
+
+            //Consumer only. Moves the front element into val, and returns false if the queue is empty
+            bool try_pop( element_type &val ) {
+                size_type h = this->head.load( std::memory_order_relaxed );
+
+                if ( this->available( h, 1 ) == 0 ) {
+                    return false;
+                }
+
+                T *p = this->slot( h );
+
+                val = std::move( *p );
+                p->~T();
+
+                this->head.store( h + 1, std::memory_order_release );
+
+                return true;
+            }
+
+            /*
+                Producer only. Pushes as many of the n elements from first as fit, and returns how many that was.
+                They are all published at once, so the consumer sees either none or all of them.
+            */
+            template <typename _InputIterator>
+            size_type push_n( _InputIterator first, size_type n ) {
+                size_type t = this->tail.load( std::memory_order_relaxed );
+                size_type free = this->room( t, n );
+
+                if ( n > free ) {
+                    n = free;
+                }
+
+                size_type done = 0;
+
+                try {
+                    for ( ; done < n; ++done, ++first ) {
+                        ::new( static_cast<void *>( this->slot( t + done ) ) ) T( *first );
+                    }
+
+                } catch ( ... ) {
+                    this->tail.store( t + done, std::memory_order_release );
+                    throw;
+                }
+
+                this->tail.store( t + n, std::memory_order_release );
+
+                return n;
+            }
+
+            //Consumer only. Moves up to n elements out to out, and returns how many that was
+            template <typename _OutputIterator>
+            size_type pop_n( _OutputIterator out, size_type n ) {
+                size_type h = this->head.load( std::memory_order_relaxed );
+                size_type ready = this->available( h, n );
+
+                if ( n > ready ) {
+                    n = ready;
+                }
+
+                size_type done = 0;
+
+                try {
+                    for ( ; done < n; ++done, ++out ) {
+                        T *p = this->slot( h + done );
+
+                        *out = std::move( *p );
+                        p->~T();
+                    }
+
+                } catch ( ... ) {
+                    this->head.store( h + done, std::memory_order_release );
+                    throw;
+                }
+
+                this->head.store( h + n, std::memory_order_release );
+
+                return n;
+            }
+
+            /*
+                These are exact when the queue isn't being used, and otherwise only something the length was
+                at some point during the call. The consumer can rely on there being at least size() elements,
+                and the producer on there being room for at least capacity() - size() more.
+            */
+            inline size_type size() const {
+                size_type h = this->head.load( std::memory_order_acquire );
+                size_type t = this->tail.load( std::memory_order_acquire );
+
+                //Loading head first means t can't be behind it
+                return t - h;
+            }
+
+            inline bool empty() const {
+                return this->size() == 0;
+            }
+
+            inline bool full() const {
+                return this->size() == N;
+            }
+
+            inline size_type capacity() const {
+                return N;
+            }
+    };
+}
+
+#endif // DATA_ADAPTER_SPSC_QUEUE_HPP_INCLUDED
@@ -8,7 +8,37 @@
 //C++ Libraries
 #include <iterator>
 #include <algorithm>
+#include <functional>
+#include <limits>
 #include <stdexcept>
+#include <utility>
+#include <vector>
+
+/*
+    C++11 layer.
+
+    The library itself is C++98, but when compiled as C++11 or later the adapters also get
+    rvalue overloads, emplace operations, and move instead of copy wherever elements are shifted around.
+    Defining DATA_ADAPTER_NO_CXX11 turns all of that off again.
+*/
+#if !defined(DATA_ADAPTER_NO_CXX11) && ( __cplusplus >= 201103L || ( defined(_MSC_VER) && _MSC_VER >= 1900 ) )
+#   define DATA_ADAPTER_CXX11 1
+#else
+#   define DATA_ADAPTER_CXX11 0
+#endif
+
+#if DATA_ADAPTER_CXX11
+#   define DATA_ADAPTER_MOVE(x)         std::move( x )
+#   define DATA_ADAPTER_MOVE_RANGE      std::move
+#   define DATA_ADAPTER_MOVE_BACKWARD   std::move_backward
+#else
+#   define DATA_ADAPTER_MOVE(x)         ( x )
+#   define DATA_ADAPTER_MOVE_RANGE      std::copy
+#   define DATA_ADAPTER_MOVE_BACKWARD   std::copy_backward
+#endif // DATA_ADAPTER_CXX11
+
+#include "./detail/stats.hpp"
+#include "./detail/compare.hpp"
 
 //This will house specialized iterator functionality for each specialization of DataAdapter
 template <typename T>
@@ -30,9 +60,200 @@ namespace std {
 }
 #endif // _MSC_VER
 
+namespace da {
+    namespace detail {
+
+        /*
+            The generic sort() and stable_sort() need random access. Adapters whose elements can't be
+            reordered in place provide their own, but with virtual dispatch the generic ones are still
+            compiled for them, so they need something to compile to.
+        */
+        template <typename _RandomAccessIterator>
+        inline void sort( _RandomAccessIterator first, _RandomAccessIterator last, std::random_access_iterator_tag ) {
+            std::sort( first, last );
+        }
+
+        template <typename _ForwardIterator>
+        inline void sort( _ForwardIterator, _ForwardIterator, std::forward_iterator_tag ) {
+            throw std::logic_error( "DataAdapter::sort: elements can't be reordered" );
+        }
+
+        template <typename _RandomAccessIterator>
+        inline void stable_sort( _RandomAccessIterator first, _RandomAccessIterator last, std::random_access_iterator_tag ) {
+            std::stable_sort( first, last );
+        }
+
+        template <typename _ForwardIterator>
+        inline void stable_sort( _ForwardIterator, _ForwardIterator, std::forward_iterator_tag ) {
+            throw std::logic_error( "DataAdapter::stable_sort: elements can't be reordered" );
+        }
+
+        /*
+            std::remove_if, calling pred once for each element, which also sets removed to where the first
+            element removed was, so callers can tell how many of the rest were moved.
+        */
+        template <typename _ForwardIterator, typename _Predicate>
+        _ForwardIterator remove_if( _ForwardIterator first, _ForwardIterator last, _Predicate pred, _ForwardIterator &removed ) {
+            removed = first = std::find_if( first, last, pred );
+
+            if ( first != last ) {
+                for ( _ForwardIterator it = first; ++it != last; ) {
+                    if ( !pred( *it ) ) {
+                        *first = DATA_ADAPTER_MOVE( *it );
+                        ++first;
+                    }
+                }
+            }
+
+            return first;
+        }
+
+        /*
+            The generic erase_if() and unordered_erase(). With random access, the elements to keep are compacted
+            and the tail erased at once, and the last element is moved into the place of the one erased. Adapters
+            that can't reorder their elements erase them one at a time, which is cheap for them anyway.
+        */
+        template <typename _Adapter, typename _Predicate>
+        typename _Adapter::size_type erase_if( _Adapter &a, _Predicate pred, std::random_access_iterator_tag ) {
+            typename _Adapter::iterator last = a.end();
+            typename _Adapter::iterator it = std::remove_if( a.begin(), last, pred );
+
+            typename _Adapter::size_type n = static_cast<typename _Adapter::size_type>( last - it );
+
+            a.erase( it, last );
+
+            return n;
+        }
+
+        template <typename _Adapter, typename _Predicate>
+        typename _Adapter::size_type erase_if( _Adapter &a, _Predicate pred, std::forward_iterator_tag ) {
+            typename _Adapter::size_type n = 0;
+            typename _Adapter::iterator it = a.begin();
+
+            while ( it != a.end() ) {
+                if ( pred( *it ) ) {
+                    it = a.erase( it );
+                    ++n;
+
+                } else {
+                    ++it;
+                }
+            }
+
+            return n;
+        }
+
+        template <typename _Adapter>
+        typename _Adapter::iterator unordered_erase( _Adapter &a, typename _Adapter::iterator pos, std::random_access_iterator_tag ) {
+            typename _Adapter::size_type off = static_cast<typename _Adapter::size_type>( pos.offset() );
+
+            if ( off + 1 < a.length() ) {
+                typename _Adapter::iterator last = a.end() - 1;
+
+                *pos = DATA_ADAPTER_MOVE( *last );
+                a.erase( last );
+
+                return pos;
+
+            } else {
+                //The last element, or out of range, which erase throws for
+                return a.erase( pos );
+            }
+        }
+
+        template <typename _Adapter>
+        typename _Adapter::iterator unordered_erase( _Adapter &a, typename _Adapter::iterator pos, std::forward_iterator_tag ) {
+            return a.erase( pos );
+        }
+
+        //Tells the range members called with a count and a value, like insert( pos, 3, 5 ), from those given iterators
+        struct integral_range_tag {};
+
+        template <typename _InputIterator, bool = std::numeric_limits<_InputIterator>::is_integer>
+        struct range_kind {
+            typedef typename std::iterator_traits<_InputIterator>::iterator_category type;
+        };
+
+        template <typename _Integer>
+        struct range_kind<_Integer, true> {
+            typedef integral_range_tag type;
+        };
+
+        template <typename A, typename B>
+        struct same_type {
+            static const bool value = false;
+        };
+
+        template <typename A>
+        struct same_type<A, A> {
+            static const bool value = true;
+        };
+
+        /*
+            Whether the range starting at first is made of elements in [begin, end), which inserting or assigning
+            would move out from under it. Only iterators that refer to Ts at all can be, so no others are dereferenced.
+        */
+        template <typename _ForwardIterator, typename T>
+        inline bool points_into( _ForwardIterator first, const T *begin, const T *end, bool_tag<true> ) {
+            std::less<const T *> less;
+            const T *p = &*first;
+
+            return !less( p, begin ) && less( p, end );
+        }
+
+        template <typename _ForwardIterator, typename T>
+        inline bool points_into( _ForwardIterator, const T *, const T *, bool_tag<false> ) {
+            return false;
+        }
+
+        template <typename _ForwardIterator, typename T>
+        inline bool points_into( _ForwardIterator first, const T *begin, const T *end ) {
+            typedef typename std::iterator_traits<_ForwardIterator>::reference reference;
+
+            return points_into( first, begin, end, bool_tag < same_type<reference, T &>::value || same_type<reference, const T &>::value > () );
+        }
+
+        //Whether _Iterator is one of _Adapter's own iterator types, the only way into adapters that aren't contiguous
+        template <typename _Adapter, typename _Iterator>
+        struct is_own_iterator {
+            static const bool value = same_type<_Iterator, typename _Adapter::iterator>::value ||
+                                      same_type<_Iterator, typename _Adapter::const_iterator>::value ||
+                                      same_type<_Iterator, typename _Adapter::reverse_iterator>::value ||
+                                      same_type<_Iterator, typename _Adapter::const_reverse_iterator>::value;
+        };
+    }
+}
+
+#if DATA_ADAPTER_CXX11
+#   include "./detail/parallel_sort.hpp"
+#endif // DATA_ADAPTER_CXX11
+
+/*
+    Dispatch mode.
+
+    By default DataAdapterBase dispatches statically: every common operation is routed
+    through static_cast<_Derived *>( this ) to non-virtual members of the specialization,
+    so the compiler can inline whole iterator and algorithm paths.
+
+    Defining DATA_ADAPTER_DYNAMIC_DISPATCH before including any DataAdapter header brings back
+    the original virtual interface, for code that needs to work on adapters through a
+    DataAdapterBase reference at runtime. It has to be defined the same way in every
+    translation unit of a program.
+*/
+#ifdef DATA_ADAPTER_DYNAMIC_DISPATCH
+#   define DATA_ADAPTER_VIRTUAL         virtual
+#   define DATA_ADAPTER_ABSTRACT(decl)  virtual decl = 0;
+#else
+#   define DATA_ADAPTER_VIRTUAL
+#   define DATA_ADAPTER_ABSTRACT(decl)
+#endif // DATA_ADAPTER_DYNAMIC_DISPATCH
+
 /*
     This is a base class that defines commonly used operations on data structures
     and provide a single interface for working with differing data structures.
+
+    All of the operations here go through derived(), so whichever dispatch mode is in use,
+    a specialization can replace any of them just by declaring a member with the same name.
 */
 
 template <typename T, typename K, typename _Derived>
@@ -49,139 +270,335 @@ class DataAdapterBase {
         typedef std::reverse_iterator<const_iterator>       const_reverse_iterator;
         typedef _Derived                                    derived_type;
 
-        template <typename _ForwardIterator>
-        void assign( _ForwardIterator first, _ForwardIterator last ) {
-            this->resize( last - first );
-            std::copy( first, last, this->begin() );
+    protected:
+        inline derived_type &derived() {
+            return *static_cast<derived_type *>( this );
         }
 
-        virtual bool operator==(const derived_type& da) const = 0;
-        virtual bool operator<(const derived_type& da) const = 0;
+        inline const derived_type &derived() const {
+            return *static_cast<const derived_type *>( this );
+        }
+
+    public:
+        //Counters for this adapter type, only updated when DATA_ADAPTER_INSTRUMENTATION is defined
+        static da::stats &stats() {
+            static da::stats s;
+            return s;
+        }
 
-        virtual size_type length() const = 0;
-        virtual size_type capacity() const = 0;
+        /*
+            Generic versions of the range members, for adapters without their own: everything goes through insert.
+            Like the std containers, two integers are a count and a value, not a range.
+        */
+        template <typename _InputIterator>
+        void assign( _InputIterator first, _InputIterator last ) {
+            this->assign_range( first, last, da::detail::bool_tag<da::detail::is_own_iterator<derived_type, _InputIterator>::value>() );
+        }
+
+        void assign( size_type n, const element_type &val ) {
+            element_type tmp( val );
 
-        virtual inline bool empty() const {
-            return this->length() == 0;
+            this->derived().clear();
+            this->derived().insert( this->derived().end(), n, tmp );
         }
 
-        virtual inline bool full() const {
-            return this->length() == this->capacity();
+        template <typename _InputIterator>
+        void append( _InputIterator first, _InputIterator last ) {
+            this->derived().insert( this->derived().end(), first, last );
         }
 
-        virtual void push_back( const element_type & )    = 0;
-        virtual void push_front( const element_type & )   = 0;
-        virtual element_type pop_back()     = 0;
-        virtual element_type pop_front()    = 0;
+    private:
+        //The range could be our own elements, which clear() would destroy before they are read, so it is copied aside first
+        template <typename _InputIterator>
+        void assign_range( _InputIterator first, _InputIterator last, da::detail::bool_tag<true> ) {
+            std::vector<element_type> tmp( first, last );
 
-        virtual element_type &at( size_type ) = 0;
-        virtual const element_type at( size_type ) const = 0;
-        virtual element_type &at( iterator ) = 0;
-        virtual const element_type at( const_iterator ) const = 0;
+            this->derived().clear();
+            this->derived().insert( this->derived().end(), tmp.begin(), tmp.end() );
+        }
+
+        template <typename _InputIterator>
+        void assign_range( _InputIterator first, _InputIterator last, da::detail::bool_tag<false> ) {
+            this->derived().clear();
+            this->derived().insert( this->derived().end(), first, last );
+        }
+
+    public:
+        /*
+            Less than, equal to or greater than zero as this orders before, the same as or after da, in one pass:
+            by the elements' operator< in order, and then the shorter one first. The ordering comparisons below
+            are defined by it. Equality uses the elements' operator== instead, like every specialization does with
+            its faster ways to tell it (see detail/compare.hpp), so elements that don't order, like NaN, aren't equal.
+        */
+        DATA_ADAPTER_VIRTUAL int compare( const derived_type &da ) const {
+            return da::detail::compare( this->derived().cbegin(), this->derived().cend(), da.cbegin(), da.cend() );
+        }
+
+        DATA_ADAPTER_VIRTUAL inline bool operator==( const derived_type &da ) const {
+            return this->derived().length() == da.length() && std::equal( this->derived().cbegin(), this->derived().cend(), da.cbegin() );
+        }
+
+        DATA_ADAPTER_VIRTUAL inline bool operator<( const derived_type &da ) const {
+            return this->derived().compare( da ) < 0;
+        }
+
+        inline bool operator!=( const derived_type &da ) const {
+            return !( this->derived() == da );
+        }
+
+        inline bool operator>( const derived_type &da ) const {
+            return this->derived().compare( da ) > 0;
+        }
+
+        inline bool operator<=( const derived_type &da ) const {
+            return this->derived().compare( da ) <= 0;
+        }
+
+        inline bool operator>=( const derived_type &da ) const {
+            return this->derived().compare( da ) >= 0;
+        }
+
+        /*
+            The same for adapters that are equal, for using them as keys of hash tables. Not virtual, so that
+            it's only compiled for element types that can be hashed, when it's used.
+        */
+        inline size_type hash() const {
+            return da::detail::hash( this->derived().cbegin(), this->derived().cend() );
+        }
+
+        DATA_ADAPTER_ABSTRACT( size_type length() const )
+        DATA_ADAPTER_ABSTRACT( size_type capacity() const )
+
+        DATA_ADAPTER_VIRTUAL inline bool empty() const {
+            return this->derived().length() == 0;
+        }
+
+        DATA_ADAPTER_VIRTUAL inline bool full() const {
+            return this->derived().length() == this->derived().capacity();
+        }
+
+        DATA_ADAPTER_ABSTRACT( void push_back( const element_type & ) )
+        DATA_ADAPTER_ABSTRACT( void push_front( const element_type & ) )
+        DATA_ADAPTER_ABSTRACT( element_type pop_back() )
+        DATA_ADAPTER_ABSTRACT( element_type pop_front() )
+
+#if DATA_ADAPTER_CXX11
+        DATA_ADAPTER_ABSTRACT( void push_back( element_type && ) )
+        DATA_ADAPTER_ABSTRACT( void push_front( element_type && ) )
+#endif // DATA_ADAPTER_CXX11
+
+        DATA_ADAPTER_ABSTRACT( element_type &at( size_type ) )
+        DATA_ADAPTER_ABSTRACT( const element_type at( size_type ) const )
+        DATA_ADAPTER_ABSTRACT( element_type &at( iterator ) )
+        DATA_ADAPTER_ABSTRACT( const element_type at( const_iterator ) const )
 
         inline element_type &operator[]( size_type n ) {
-            return this->at( n );
+            return this->derived().at( n );
         }
 
         inline const element_type operator[]( size_type n ) const {
-            return this->at( n );
+            return this->derived().at( n );
+        }
+
+        DATA_ADAPTER_ABSTRACT( iterator insert( iterator, const element_type & ) )
+        DATA_ADAPTER_ABSTRACT( iterator insert( iterator, size_type, const element_type & ) )
+        DATA_ADAPTER_ABSTRACT( iterator insert( iterator, const_iterator, const_iterator ) )
+
+        DATA_ADAPTER_ABSTRACT( iterator sorted_insert( const element_type & ) )
+
+#if DATA_ADAPTER_CXX11
+        DATA_ADAPTER_ABSTRACT( iterator insert( iterator, element_type && ) )
+        DATA_ADAPTER_ABSTRACT( iterator sorted_insert( element_type && ) )
+#endif // DATA_ADAPTER_CXX11
+
+        /*
+            Generic batch version of sorted_insert. The batch is sorted and inserted from its largest element
+            down, one at a time, so the last insert is the smallest and its position is still valid to return.
+            Specializations that can merge the whole batch at once provide their own.
+        */
+        template <typename _InputIterator>
+        iterator sorted_insert( _InputIterator first, _InputIterator last ) {
+            std::vector<element_type> batch( first, last );
+
+            iterator ret = this->derived().end();
+
+            std::stable_sort( batch.begin(), batch.end() );
+
+            for ( typename std::vector<element_type>::reverse_iterator it = batch.rbegin(); it != batch.rend(); ++it ) {
+                ret = this->derived().sorted_insert( DATA_ADAPTER_MOVE( *it ) );
+            }
+
+            return ret;
         }
 
-        virtual iterator insert( iterator, const element_type & ) = 0;
-        virtual iterator insert( iterator, size_type, const element_type & ) = 0;
-        virtual iterator insert( iterator, const_iterator, const_iterator ) = 0;
+        DATA_ADAPTER_ABSTRACT( void clear() )
 
-        virtual iterator sorted_insert( const element_type & ) = 0;
+        DATA_ADAPTER_ABSTRACT( size_type resize( size_type ) )
+        DATA_ADAPTER_ABSTRACT( size_type resize( size_type, const element_type & ) )
 
-        virtual void clear() = 0;
+        DATA_ADAPTER_ABSTRACT( iterator erase( iterator ) )
+        DATA_ADAPTER_ABSTRACT( iterator erase( iterator, iterator ) )
 
-        virtual size_type resize( size_type ) = 0;
-        virtual size_type resize( size_type, const element_type & ) = 0;
+        //Erases every element pred( element ) is true for, in one pass, and returns how many there were
+        template <typename _Predicate>
+        size_type erase_if( _Predicate pred ) {
+            DATA_ADAPTER_STAT_SCOPE( erase_if )
 
-        virtual iterator erase( iterator ) = 0;
-        virtual iterator erase( iterator, iterator ) = 0;
+            return da::detail::erase_if( this->derived(), pred, typename std::iterator_traits<iterator>::iterator_category() );
+        }
+
+        /*
+            Erases the element at pos by moving the last one into its place, so nothing else moves, and returns
+            pos, where the next element to look at now is. The order of the rest isn't kept.
+        */
+        DATA_ADAPTER_VIRTUAL iterator unordered_erase( iterator pos ) {
+            DATA_ADAPTER_STAT_SCOPE( unordered_erase )
+
+            return da::detail::unordered_erase( this->derived(), pos, typename std::iterator_traits<iterator>::iterator_category() );
+        }
 
-        virtual iterator begin() {
-            return iterator( dynamic_cast<derived_type *>( this ) );
+        DATA_ADAPTER_VIRTUAL iterator begin() {
+            return iterator( &this->derived() );
         }
 
-        virtual iterator end() {
-            iterator tmp( dynamic_cast<derived_type *>( this ) );
-            std::advance( tmp, this->length() );
+        DATA_ADAPTER_VIRTUAL iterator end() {
+            iterator tmp( &this->derived() );
+            std::advance( tmp, this->derived().length() );
             return tmp;
         }
 
-        virtual const_iterator cbegin() const {
-            return const_iterator( dynamic_cast<const derived_type *>( this ) );
+        DATA_ADAPTER_VIRTUAL const_iterator cbegin() const {
+            return const_iterator( &this->derived() );
         }
 
-        virtual const_iterator cend() const {
-            const_iterator tmp( dynamic_cast<const derived_type *>( this ) );
-            std::advance( tmp, this->length() );
+        DATA_ADAPTER_VIRTUAL const_iterator cend() const {
+            const_iterator tmp( &this->derived() );
+            std::advance( tmp, this->derived().length() );
             return tmp;
         }
 
         inline const_iterator begin() const {
-            return this->cbegin();
+            return this->derived().cbegin();
         }
 
         inline const_iterator end() const {
-            return this->cend();
+            return this->derived().cend();
         }
 
         inline reverse_iterator rbegin() {
-            return reverse_iterator( this->end() );
+            return reverse_iterator( this->derived().end() );
         }
 
         inline reverse_iterator rend() {
-            return reverse_iterator( this->begin() );
+            return reverse_iterator( this->derived().begin() );
         }
 
         inline const_reverse_iterator crbegin() const {
-            return const_reverse_iterator( this->cend() );
+            return const_reverse_iterator( this->derived().cend() );
         }
 
         inline const_reverse_iterator crend() const {
-            return const_reverse_iterator( this->cbegin() );
+            return const_reverse_iterator( this->derived().cbegin() );
         }
 
-        virtual element_type back() const   = 0;
-        virtual element_type front() const  = 0;
-        virtual element_type &back()  = 0;
-        virtual element_type &front() = 0;
+        DATA_ADAPTER_ABSTRACT( element_type back() const )
+        DATA_ADAPTER_ABSTRACT( element_type front() const )
+        DATA_ADAPTER_ABSTRACT( element_type &back() )
+        DATA_ADAPTER_ABSTRACT( element_type &front() )
 
         //These are implementation defined, as alternatives exist for varying data structures
-        virtual inline void sort() {
-            std::sort( this->begin(), this->end() );
+        DATA_ADAPTER_VIRTUAL inline void sort() {
+            DATA_ADAPTER_STAT_SCOPE( sort )
+
+            da::detail::sort( this->derived().begin(), this->derived().end(),
+                              typename std::iterator_traits<iterator>::iterator_category() );
+        }
+
+        DATA_ADAPTER_VIRTUAL inline void stable_sort() {
+            DATA_ADAPTER_STAT_SCOPE( stable_sort )
+
+            da::detail::stable_sort( this->derived().begin(), this->derived().end(),
+                                     typename std::iterator_traits<iterator>::iterator_category() );
         }
 
-        virtual inline void stable_sort() {
-            std::stable_sort( this->begin(), this->end() );
+#if DATA_ADAPTER_CXX11
+        /*
+            The same sorts split across up to threads threads, or one per core for 0. See detail/parallel_sort.hpp.
+            Ranges too short to be worth it are sorted on the calling thread.
+        */
+        inline void sort( unsigned threads ) {
+            DATA_ADAPTER_STAT_SCOPE( sort )
+
+            da::detail::parallel_sort( this->derived().begin(), this->derived().end(), threads, false,
+                                       typename std::iterator_traits<iterator>::iterator_category() );
+        }
+
+        inline void stable_sort( unsigned threads ) {
+            DATA_ADAPTER_STAT_SCOPE( stable_sort )
+
+            da::detail::parallel_sort( this->derived().begin(), this->derived().end(), threads, true,
+                                       typename std::iterator_traits<iterator>::iterator_category() );
         }
+#endif // DATA_ADAPTER_CXX11
 
-        virtual inline iterator find( const element_type &n ) {
-            return std::find( this->begin(), this->end(), n );
+        DATA_ADAPTER_VIRTUAL inline iterator find( const element_type &n ) {
+            DATA_ADAPTER_STAT_SCOPE( find )
+
+            return std::find( this->derived().begin(), this->derived().end(), n );
         }
 
-        virtual iterator find_sorted( const element_type &n ) {
-            iterator it = std::lower_bound( this->begin(), this->end(), n );
+        DATA_ADAPTER_VIRTUAL iterator find_sorted( const element_type &n ) {
+            DATA_ADAPTER_STAT_SCOPE( find_sorted )
+
+            iterator last = this->derived().end();
+            iterator it = std::lower_bound( this->derived().begin(), last, n );
 
-            if ( it != this->end() && *it == n ) {
+            if ( it != last && *it == n ) {
                 return it;
 
             } else {
-                return this->end();
+                return last;
             }
         }
 
-        virtual ~DataAdapterBase() {}
+        DATA_ADAPTER_VIRTUAL size_type count( const element_type &n ) const {
+            return static_cast<size_type>( std::count( this->derived().cbegin(), this->derived().cend(), n ) );
+        }
+
+        DATA_ADAPTER_VIRTUAL bool contains( const element_type &n ) const {
+            return std::find( this->derived().cbegin(), this->derived().cend(), n ) != this->derived().cend();
+        }
+
+        //The first smallest or largest element, or end() if there are none
+        DATA_ADAPTER_VIRTUAL iterator min_element() {
+            return std::min_element( this->derived().begin(), this->derived().end() );
+        }
+
+        DATA_ADAPTER_VIRTUAL iterator max_element() {
+            return std::max_element( this->derived().begin(), this->derived().end() );
+        }
+
+        DATA_ADAPTER_VIRTUAL ~DataAdapterBase() {}
 };
 
 //Initial declaration, not specialized, does nothing.
-//Will actually cause a compiler error if used because it's still an abstract class.
+//Will actually cause a compiler error if used, since none of the operations are defined.
 template <typename T>
 class DataAdapter : public DataAdapterBase<T, T, DataAdapter<T> > {};
 
+#if DATA_ADAPTER_CXX11
+namespace std {
+
+    //So that adapters can be keys of std::unordered_map, da::hash_table and the like
+    template <typename T>
+    struct hash<DataAdapter<T> > {
+        inline size_t operator()( const DataAdapter<T> &a ) const {
+            return a.hash();
+        }
+    };
+}
+#endif // DATA_ADAPTER_CXX11
+
 //Using iterators, this should be able to print out any implementation of DataAdapter
 template <typename T>
 std::ostream &operator<<( std::ostream &out, const DataAdapter<T> &d ) {
@@ -2,5 +2,30 @@
 #define DATA_ADAPTER_ALL_ADAPTERS_HPP_INCLUDE
 
 #include "./adapters/array.hpp"
+#include "./adapters/ring.hpp"
+#include "./adapters/dynamic.hpp"
+#include "./adapters/small.hpp"
+
+#include "./indexes/eytzinger.hpp"
+
+#if DATA_ADAPTER_CXX11
+#include "./adapters/hash_table.hpp"
+
+//Rows are proxies there, with no element_type & for the virtual interface
+#ifndef DATA_ADAPTER_DYNAMIC_DISPATCH
+#include "./adapters/soa.hpp"
+#endif // DATA_ADAPTER_DYNAMIC_DISPATCH
+
+#include "./concurrent/mpmc_queue.hpp"
+#include "./concurrent/read_mostly.hpp"
+#include "./concurrent/spsc_queue.hpp"
+
+#include "./io/snapshot.hpp"
+#include "./io/text.hpp"
+
+#if DATA_ADAPTER_HAS_MMAP
+#include "./adapters/mapped.hpp"
+#endif // DATA_ADAPTER_HAS_MMAP
+#endif // DATA_ADAPTER_CXX11
 
 #endif // DATA_ADAPTER_ALL_ADAPTERS_HPP_INCLUDE
@@ -0,0 +1,119 @@
+#ifndef DATA_ADAPTER_DETAIL_ALLOCATOR_HPP_INCLUDED
+#define DATA_ADAPTER_DETAIL_ALLOCATOR_HPP_INCLUDED
+
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+
+namespace da {
+
+    /*
+        Whether an allocator can grow or shrink a block it handed out, keeping its contents.
+        Such an allocator provides
+
+            pointer reallocate( pointer p, size_type old_n, size_type new_n );
+
+        which returns the (possibly moved) block or throws std::bad_alloc, leaving p alone if it does.
+        Growable adapters use it instead of allocate, copy and deallocate for trivially relocatable elements.
+        Specialize this for an arena or pool allocator that can extend blocks in place.
+    */
+    template <typename Alloc>
+    struct allocator_reallocates {
+        static const bool value = false;
+    };
+
+    /*
+        A standard allocator on top of std::malloc, std::realloc and std::free,
+        so that growing a block of trivially relocatable elements can be a realloc.
+    */
+    template <typename T>
+    class malloc_allocator {
+        public:
+            typedef T               value_type;
+            typedef T              *pointer;
+            typedef const T        *const_pointer;
+            typedef T              &reference;
+            typedef const T        &const_reference;
+            typedef std::size_t     size_type;
+            typedef std::ptrdiff_t  difference_type;
+
+            template <typename U>
+            struct rebind {
+                typedef malloc_allocator<U> other;
+            };
+
+            malloc_allocator() {}
+
+            template <typename U>
+            malloc_allocator( const malloc_allocator<U> & ) {}
+
+            inline pointer address( reference x ) const {
+                return &x;
+            }
+
+            inline const_pointer address( const_reference x ) const {
+                return &x;
+            }
+
+            pointer allocate( size_type n, const void * = 0 ) {
+                if ( n > this->max_size() ) {
+                    throw std::bad_alloc();
+                }
+
+                void *p = std::malloc( n * sizeof( T ) );
+
+                if ( p == NULL && n != 0 ) {
+                    throw std::bad_alloc();
+                }
+
+                return static_cast<pointer>( p );
+            }
+
+            pointer reallocate( pointer p, size_type, size_type new_n ) {
+                if ( new_n > this->max_size() ) {
+                    throw std::bad_alloc();
+                }
+
+                void *np = std::realloc( p, new_n * sizeof( T ) );
+
+                if ( np == NULL && new_n != 0 ) {
+                    throw std::bad_alloc();
+                }
+
+                return static_cast<pointer>( np );
+            }
+
+            inline void deallocate( pointer p, size_type ) {
+                std::free( p );
+            }
+
+            inline size_type max_size() const {
+                return static_cast<size_type>( -1 ) / sizeof( T );
+            }
+
+            inline void construct( pointer p, const T &val ) {
+                ::new( static_cast<void *>( p ) ) T( val );
+            }
+
+            inline void destroy( pointer p ) {
+                p->~T();
+            }
+    };
+
+    template <typename T, typename U>
+    inline bool operator==( const malloc_allocator<T> &, const malloc_allocator<U> & ) {
+        return true;
+    }
+
+    template <typename T, typename U>
+    inline bool operator!=( const malloc_allocator<T> &, const malloc_allocator<U> & ) {
+        return false;
+    }
+
+    template <typename T>
+    struct allocator_reallocates<malloc_allocator<T> > {
+        static const bool value = true;
+    };
+}
+
+#endif // DATA_ADAPTER_DETAIL_ALLOCATOR_HPP_INCLUDED
@@ -0,0 +1,344 @@
+#ifndef DATA_ADAPTER_DETAIL_COMPARE_HPP_INCLUDED
+#define DATA_ADAPTER_DETAIL_COMPARE_HPP_INCLUDED
+
+#include <cstddef>
+#include <cstring>
+#include <algorithm>
+
+#if DATA_ADAPTER_CXX11
+#   include <functional>
+#   include <type_traits>
+#endif // DATA_ADAPTER_CXX11
+
+#include "./storage.hpp"
+
+/*
+    Comparing and hashing whole adapters.
+
+    compare() is a three way comparison in one pass, lexicographic by the elements' operator< and then
+    by length, and the relational operators are all defined by it. For elements whose bytes are equal
+    exactly when they are (see da::is_trivially_comparable), the adapters that keep their elements in one
+    block go through them with memcmp, which compares many at a time, and only look at single elements
+    where two blocks differ. Equality checks the lengths first and is a single memcmp then.
+
+    hash() runs over the bytes of those elements in bulk, eight bytes at a time in four independent lanes
+    (the same structure as xxHash64). Elements that aren't trivially comparable are hashed one by one
+    with da::hash_value, which is std::hash with C++11, and the results are hashed the same way. The hash
+    doesn't depend on how the elements are split into blocks, so adapters that are equal hash the same
+    whatever their storage, and adapters that can't hash in bulk simply feed their elements in one at a time.
+    It isn't meant to be cryptographic, or to stay the same between versions.
+*/
+
+namespace da {
+
+    /*
+        Whether two Ts are equal exactly when their bytes are, so they can be compared with memcmp and hashed
+        by their bytes. That is integers, pointers, and with C++11 enums. Floating point numbers aren't, since
+        0.0 == -0.0 and NaN != NaN, and neither are classes, which may have padding or an operator== of their own.
+        It can be specialized for classes that are safe, like a struct of two ints compared member by member.
+    */
+#if DATA_ADAPTER_CXX11
+    template <typename T>
+    struct is_trivially_comparable {
+        static const bool value = std::is_integral<T>::value || std::is_enum<T>::value || std::is_pointer<T>::value;
+    };
+#else
+    template <typename T>
+    struct is_trivially_comparable {
+        static const bool value = false;
+    };
+
+    template <typename T>
+    struct is_trivially_comparable<T *> {
+        static const bool value = true;
+    };
+
+#   define DATA_ADAPTER_TRIVIALLY_COMPARABLE(type)      \
+        template <>                                     \
+        struct is_trivially_comparable<type> {          \
+            static const bool value = true;             \
+        };
+
+    DATA_ADAPTER_TRIVIALLY_COMPARABLE( bool )
+    DATA_ADAPTER_TRIVIALLY_COMPARABLE( char )
+    DATA_ADAPTER_TRIVIALLY_COMPARABLE( signed char )
+    DATA_ADAPTER_TRIVIALLY_COMPARABLE( unsigned char )
+    DATA_ADAPTER_TRIVIALLY_COMPARABLE( wchar_t )
+    DATA_ADAPTER_TRIVIALLY_COMPARABLE( short )
+    DATA_ADAPTER_TRIVIALLY_COMPARABLE( unsigned short )
+    DATA_ADAPTER_TRIVIALLY_COMPARABLE( int )
+    DATA_ADAPTER_TRIVIALLY_COMPARABLE( unsigned int )
+    DATA_ADAPTER_TRIVIALLY_COMPARABLE( long )
+    DATA_ADAPTER_TRIVIALLY_COMPARABLE( unsigned long )
+
+#   undef DATA_ADAPTER_TRIVIALLY_COMPARABLE
+#endif // DATA_ADAPTER_CXX11
+
+    //Hashes of elements that aren't hashed by their bytes. Overload it for types of your own
+#if DATA_ADAPTER_CXX11
+    template <typename T>
+    inline size_t hash_value( const T &x ) {
+        return std::hash<T>()( x );
+    }
+#endif // DATA_ADAPTER_CXX11
+
+    //Equal numbers hash the same, so both zeros are hashed as one
+    inline size_t hash_value( float x ) {
+        double d = x == 0 ? 0.0 : static_cast<double>( x );
+        size_t h = 0;
+
+        std::memcpy( &h, &d, sizeof( h ) < sizeof( d ) ? sizeof( h ) : sizeof( d ) );
+        return h;
+    }
+
+    inline size_t hash_value( double x ) {
+        double d = x == 0 ? 0.0 : x;
+        size_t h = 0;
+
+        std::memcpy( &h, &d, sizeof( h ) < sizeof( d ) ? sizeof( h ) : sizeof( d ) );
+        return h;
+    }
+
+    namespace detail {
+
+        //The constants of the hash, for the width of size_t
+        template <size_t Size>
+        struct hash_constants {
+            static size_t prime1() { return 0x9E3779B1UL; }
+            static size_t prime2() { return 0x85EBCA77UL; }
+            static size_t prime3() { return 0xC2B2AE3DUL; }
+            static const int rotation = 13;
+            static const int shift = 15;
+        };
+
+        //Put together from halves, since C++98 has no 64 bit literals
+        template <>
+        struct hash_constants<8> {
+            static size_t make( unsigned long hi, unsigned long lo ) {
+                return ( static_cast<size_t>( hi ) << 16 << 16 ) | static_cast<size_t>( lo );
+            }
+
+            static size_t prime1() { return make( 0x9E3779B1UL, 0x85EBCA87UL ); }
+            static size_t prime2() { return make( 0xC2B2AE3DUL, 0x27D4EB4FUL ); }
+            static size_t prime3() { return make( 0x165667B1UL, 0x9E3779F9UL ); }
+            static const int rotation = 31;
+            static const int shift = 29;
+        };
+
+        /*
+            Hashes a stream of bytes, given in pieces of any size, to the same value as if it came in one piece.
+            Whole blocks of four words go through four lanes, and the rest waits in a buffer for more.
+        */
+        class hasher {
+            private:
+                typedef hash_constants<sizeof( size_t )> constants;
+
+                static const size_t block_size = 4 * sizeof( size_t );
+
+                size_t lanes[4];
+                size_t total;
+                size_t buffered;
+                unsigned char buffer[block_size];
+
+                static inline size_t rotate( size_t x, int r ) {
+                    return ( x << r ) | ( x >> ( sizeof( size_t ) * 8 - r ) );
+                }
+
+                static inline size_t round( size_t lane, size_t word ) {
+                    return rotate( lane + word * constants::prime2(), constants::rotation ) * constants::prime1();
+                }
+
+                static inline size_t word( const unsigned char *p ) {
+                    size_t w;
+                    std::memcpy( &w, p, sizeof( w ) );
+                    return w;
+                }
+
+                inline void block( const unsigned char *p ) {
+                    this->lanes[0] = round( this->lanes[0], word( p ) );
+                    this->lanes[1] = round( this->lanes[1], word( p + sizeof( size_t ) ) );
+                    this->lanes[2] = round( this->lanes[2], word( p + 2 * sizeof( size_t ) ) );
+                    this->lanes[3] = round( this->lanes[3], word( p + 3 * sizeof( size_t ) ) );
+                }
+
+            public:
+                explicit hasher( size_t seed = 0 ) : total( 0 ), buffered( 0 ) {
+                    this->lanes[0] = seed + constants::prime1() + constants::prime2();
+                    this->lanes[1] = seed + constants::prime2();
+                    this->lanes[2] = seed;
+                    this->lanes[3] = seed - constants::prime1();
+                }
+
+                void update( const void *data, size_t n ) {
+                    const unsigned char *p = static_cast<const unsigned char *>( data );
+
+                    this->total += n;
+
+                    if ( this->buffered != 0 ) {
+                        size_t take = std::min( n, block_size - this->buffered );
+
+                        std::memcpy( this->buffer + this->buffered, p, take );
+                        this->buffered += take;
+                        p += take;
+                        n -= take;
+
+                        if ( this->buffered < block_size ) {
+                            return;
+                        }
+
+                        this->block( this->buffer );
+                        this->buffered = 0;
+                    }
+
+                    for ( ; n >= block_size; p += block_size, n -= block_size ) {
+                        this->block( p );
+                    }
+
+                    std::memcpy( this->buffer, p, n );
+                    this->buffered = n;
+                }
+
+                size_t finish() const {
+                    size_t h = rotate( this->lanes[0], 1 ) + rotate( this->lanes[1], 7 ) +
+                               rotate( this->lanes[2], 12 ) + rotate( this->lanes[3], 18 );
+
+                    h += this->total;
+
+                    size_t i = 0;
+
+                    for ( ; i + sizeof( size_t ) <= this->buffered; i += sizeof( size_t ) ) {
+                        h = rotate( h ^ round( 0, word( this->buffer + i ) ), constants::rotation - 4 ) * constants::prime1() + constants::prime3();
+                    }
+
+                    for ( ; i < this->buffered; ++i ) {
+                        h = rotate( h ^ ( this->buffer[i] * constants::prime3() ), 11 ) * constants::prime1();
+                    }
+
+                    h ^= h >> constants::shift;
+                    h *= constants::prime2();
+                    h ^= h >> ( constants::shift + 3 );
+                    h *= constants::prime3();
+                    h ^= h >> ( constants::shift + 1 );
+
+                    return h;
+                }
+        };
+
+        //One element into the hash, by its bytes or by its hash_value
+        template <typename T>
+        inline void hash_element( hasher &h, const T &x, bool_tag<true> ) {
+            h.update( &x, sizeof( T ) );
+        }
+
+        template <typename T>
+        inline void hash_element( hasher &h, const T &x, bool_tag<false> ) {
+            size_t v = hash_value( x );
+            h.update( &v, sizeof( v ) );
+        }
+
+        template <typename _InputIterator>
+        size_t hash( _InputIterator first, _InputIterator last ) {
+            typedef typename std::iterator_traits<_InputIterator>::value_type T;
+
+            hasher h;
+
+            for ( ; first != last; ++first ) {
+                T x = *first;
+                hash_element( h, x, bool_tag<da::is_trivially_comparable<T>::value>() );
+            }
+
+            return h.finish();
+        }
+
+        //A block of elements, all at once if their bytes will do
+        template <typename T>
+        inline size_t hash( const T *first, size_t n, bool_tag<true> ) {
+            hasher h;
+            h.update( first, n * sizeof( T ) );
+            return h.finish();
+        }
+
+        template <typename T>
+        inline size_t hash( const T *first, size_t n, bool_tag<false> ) {
+            return hash( first, first + n );
+        }
+
+        template <typename T>
+        inline size_t hash( const T *first, size_t n ) {
+            return hash( first, n, bool_tag<da::is_trivially_comparable<T>::value>() );
+        }
+
+        template <typename T>
+        inline int compare_elements( const T &a, const T &b ) {
+            return a < b ? -1 : b < a ? 1 : 0;
+        }
+
+        inline int compare_lengths( size_t a, size_t b ) {
+            return a < b ? -1 : b < a ? 1 : 0;
+        }
+
+        template <typename _InputIterator1, typename _InputIterator2>
+        int compare( _InputIterator1 first1, _InputIterator1 last1, _InputIterator2 first2, _InputIterator2 last2 ) {
+            for ( ; first1 != last1 && first2 != last2; ++first1, ++first2 ) {
+                if ( *first1 < *first2 ) {
+                    return -1;
+                }
+
+                if ( *first2 < *first1 ) {
+                    return 1;
+                }
+            }
+
+            return first1 != last1 ? 1 : first2 != last2 ? -1 : 0;
+        }
+
+        //How many elements memcmp looks at at once, before the first difference is looked for element by element
+        static const size_t compare_block_bytes = 256;
+
+        template <typename T>
+        int compare( const T *a, size_t na, const T *b, size_t nb, bool_tag<true> ) {
+            static const size_t block = compare_block_bytes / sizeof( T ) > 0 ? compare_block_bytes / sizeof( T ) : 1;
+
+            size_t n = std::min( na, nb );
+
+            for ( size_t i = 0; i < n; i += block ) {
+                size_t m = std::min( block, n - i );
+
+                if ( std::memcmp( a + i, b + i, m * sizeof( T ) ) != 0 ) {
+                    std::pair<const T *, const T *> d = std::mismatch( a + i, a + i + m, b + i );
+
+                    return compare_elements( *d.first, *d.second );
+                }
+            }
+
+            return compare_lengths( na, nb );
+        }
+
+        template <typename T>
+        inline int compare( const T *a, size_t na, const T *b, size_t nb, bool_tag<false> ) {
+            return compare( a, a + na, b, b + nb );
+        }
+
+        template <typename T>
+        inline int compare( const T *a, size_t na, const T *b, size_t nb ) {
+            return compare( a, na, b, nb, bool_tag<da::is_trivially_comparable<T>::value>() );
+        }
+
+        template <typename T>
+        inline bool equal( const T *a, const T *b, size_t n, bool_tag<true> ) {
+            return n == 0 || std::memcmp( a, b, n * sizeof( T ) ) == 0;
+        }
+
+        template <typename T>
+        inline bool equal( const T *a, const T *b, size_t n, bool_tag<false> ) {
+            return std::equal( a, a + n, b );
+        }
+
+        template <typename T>
+        inline bool equal( const T *a, size_t na, const T *b, size_t nb ) {
+            return na == nb && equal( a, b, na, bool_tag<da::is_trivially_comparable<T>::value>() );
+        }
+    }
+}
+
+#endif // DATA_ADAPTER_DETAIL_COMPARE_HPP_INCLUDED
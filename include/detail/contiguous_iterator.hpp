@@ -0,0 +1,169 @@
+#ifndef DATA_ADAPTER_DETAIL_CONTIGUOUS_ITERATOR_HPP_INCLUDED
+#define DATA_ADAPTER_DETAIL_CONTIGUOUS_ITERATOR_HPP_INCLUDED
+
+#include <cstddef>
+#include <iterator>
+
+namespace da {
+    namespace detail {
+
+        template <typename T>
+        struct remove_const {
+            typedef T type;
+        };
+
+        template <typename T>
+        struct remove_const<const T> {
+            typedef T type;
+        };
+
+        /*
+            Common implementation of the iterators of adapters that keep their elements
+            in one contiguous block, exposed through a data() member on the parent.
+
+            The iterator holds a plain element pointer, so dereferencing and arithmetic compile
+            down to pointer operations, and base() hands that pointer to code that wants to use
+            std::copy, std::fill and friends on raw memory. The parent is only kept for the
+            offset based operations (adding two iterators together and offset()).
+
+            _Derived is the actual DataApapterIterator specialization, so that arithmetic returns
+            that type and not this one, and E is the (possibly const) element type.
+        */
+        template <typename _Derived, typename _Parent, typename E>
+        class contiguous_iterator {
+            public:
+                typedef std::random_access_iterator_tag                 iterator_category;
+                typedef typename remove_const<E>::type                  value_type;
+                typedef std::ptrdiff_t                                  difference_type;
+                typedef E                                              *pointer;
+                typedef E                                              &reference;
+
+#if __cplusplus >= 202002L
+                typedef std::contiguous_iterator_tag                    iterator_concept;
+#endif
+
+                typedef _Parent                                         parent_type;
+
+            protected:
+                parent_type *parent;
+                pointer ptr;
+
+                inline _Derived &self() {
+                    return *static_cast<_Derived *>( this );
+                }
+
+                inline const _Derived &self() const {
+                    return *static_cast<const _Derived *>( this );
+                }
+
+            public:
+                contiguous_iterator() : parent( NULL ), ptr( NULL ) {}
+
+                contiguous_iterator( parent_type *x, difference_type ioff )
+                    : parent( x ), ptr( x != NULL ? x->data() + ioff : NULL ) {}
+
+                //The raw element pointer
+                inline pointer base() const {
+                    return this->ptr;
+                }
+
+                //Position of the iterator within its parent
+                inline difference_type offset() const {
+                    return this->ptr - this->parent->data();
+                }
+
+                inline bool operator==( const _Derived &it ) const {
+                    return this->ptr == it.ptr;
+                }
+
+                inline bool operator!=( const _Derived &it ) const {
+                    return this->ptr != it.ptr;
+                }
+
+                inline reference operator*() const {
+                    return *this->ptr;
+                }
+
+                inline reference operator[]( difference_type n ) const {
+                    return this->ptr[n];
+                }
+
+                inline pointer operator->() const {
+                    return this->ptr;
+                }
+
+                inline _Derived &operator++() {
+                    ++this->ptr;
+                    return self();
+                }
+
+                inline _Derived operator++( int ) {
+                    _Derived tmp( self() );
+                    ++this->ptr;
+                    return tmp;
+                }
+
+                inline _Derived &operator--() {
+                    --this->ptr;
+                    return self();
+                }
+
+                inline _Derived operator--( int ) {
+                    _Derived tmp( self() );
+                    --this->ptr;
+                    return tmp;
+                }
+
+                inline _Derived operator+( const _Derived &it ) const {
+                    _Derived tmp( self() );
+                    tmp.ptr += it.offset();
+                    return tmp;
+                }
+                inline _Derived operator+( difference_type n ) const {
+                    _Derived tmp( self() );
+                    tmp.ptr += n;
+                    return tmp;
+                }
+                inline _Derived &operator +=( const _Derived &it ) {
+                    this->ptr += it.offset();
+                    return self();
+                }
+                inline _Derived &operator +=( difference_type n ) {
+                    this->ptr += n;
+                    return self();
+                }
+
+                inline difference_type operator-( const _Derived &it ) const {
+                    return this->ptr - it.ptr;
+                }
+                inline _Derived operator-( difference_type n ) const {
+                    _Derived tmp( self() );
+                    tmp.ptr -= n;
+                    return tmp;
+                }
+                inline _Derived &operator -=( const _Derived &it ) {
+                    this->ptr -= it.offset();
+                    return self();
+                }
+                inline _Derived &operator -=( difference_type n ) {
+                    this->ptr -= n;
+                    return self();
+                }
+
+                inline bool operator<( const _Derived &it ) const {
+                    return this->ptr < it.ptr;
+                }
+                inline bool operator>( const _Derived &it ) const {
+                    return this->ptr > it.ptr;
+                }
+                inline bool operator<=( const _Derived &it ) const {
+                    return this->ptr <= it.ptr;
+                }
+                inline bool operator>=( const _Derived &it ) const {
+                    return this->ptr >= it.ptr;
+                }
+        };
+    }
+}
+
+#endif // DATA_ADAPTER_DETAIL_CONTIGUOUS_ITERATOR_HPP_INCLUDED
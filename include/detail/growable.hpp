@@ -0,0 +1,1123 @@
+#ifndef DATA_ADAPTER_DETAIL_GROWABLE_HPP_INCLUDED
+#define DATA_ADAPTER_DETAIL_GROWABLE_HPP_INCLUDED
+
+#include <memory>
+#include <vector>
+
+#include "../data_adapter.hpp"
+#include "./allocator.hpp"
+#include "./radix_sort.hpp"
+#include "./simd.hpp"
+#include "./storage.hpp"
+
+namespace da {
+    namespace detail {
+
+        /*
+            Common implementation of the adapters that grow on the heap, da::dynamic and da::small.
+
+            The elements are in one contiguous block, storage, which holds used_length live elements and room
+            for allocated of them. Up to N of them are kept in inline_storage inside the object itself, and past
+            that they spill over to a heap block from the allocator, which grows by half its capacity at a time.
+            N is 0 for da::dynamic, which is then always on the heap, or on nothing at all while empty.
+
+            Everything that shifts elements is the same as the array adapter, with the room made first.
+
+            _Tag is the tag of the DataAdapter specialization this is the base of, which provides the
+            constructors and whatever else is specific to it.
+        */
+        template <typename _Tag, typename T, typename Alloc, size_t N>
+        class growable : public DataAdapterBase<_Tag, T, DataAdapter<_Tag> > {
+            public:
+                typedef DataAdapterBase<_Tag, T, DataAdapter<_Tag> > _Base;
+
+                typedef typename _Base::value_type              value_type;
+                typedef typename _Base::element_type            element_type;
+                typedef typename _Base::pointer_type            pointer_type;
+                typedef typename _Base::size_type               size_type;
+
+                typedef typename _Base::iterator                iterator;
+                typedef typename _Base::const_iterator          const_iterator;
+                typedef typename _Base::reverse_iterator        reverse_iterator;
+                typedef typename _Base::const_reverse_iterator  const_reverse_iterator;
+
+                typedef typename _Base::derived_type            derived_type;
+
+                typedef Alloc                                   allocator_type;
+
+            private:
+                allocator_type alloc;
+                raw_storage<T, N> inline_storage;
+                element_type *storage;
+                size_type used_length;
+                size_type allocated;
+
+                typedef bool_tag<da::is_trivially_relocatable<T>::value> relocatable_tag;
+                typedef bool_tag<N != 0> inline_tag;
+
+                //Whether the heap block can be grown with the allocator's reallocate
+                typedef bool_tag<da::is_trivially_relocatable<T>::value && da::allocator_reallocates<Alloc>::value> realloc_tag;
+
+                inline bool on_heap() const {
+                    return this->storage != this->inline_storage.data();
+                }
+
+                //Destroys everything from n on
+                void truncate( size_type n ) {
+                    element_type *d = this->data();
+
+                    destroy( d + n, d + this->length() );
+
+                    this->used_length = n;
+                }
+
+                //memcpy
+                void transfer( element_type *to, bool_tag<true> ) {
+                    if ( this->length() != 0 ) {
+                        std::memcpy( static_cast<void *>( to ), static_cast<const void *>( this->storage ), this->length() * sizeof( element_type ) );
+                    }
+                }
+
+                //Move or copy one element at a time, then destroy the originals
+                void transfer( element_type *to, bool_tag<false> ) {
+                    uninitialized_relocate( this->storage, this->storage + this->length(), to );
+
+                    destroy( this->storage, this->storage + this->length() );
+                }
+
+                //Moves the elements to the raw memory at to. If that throws, they are all still where they were.
+                void transfer( element_type *to ) {
+                    DATA_ADAPTER_STAT_ADD( relocated, this->length() )
+
+                    this->transfer( to, relocatable_tag() );
+                }
+
+                //Moves the elements into the inline storage of to, which may be this
+                void transfer_inline( growable &to, bool_tag<true> ) {
+                    this->transfer( to.inline_storage.data() );
+                }
+
+                //Without inline storage, there can't be any elements to move when this is called
+                void transfer_inline( growable &, bool_tag<false> ) {}
+
+                //realloc the heap block
+                void relocate( size_type n, bool_tag<true> ) {
+                    DATA_ADAPTER_STAT_ADD( relocated, this->length() )
+
+                    this->storage = this->alloc.reallocate( this->storage, this->allocated, n );
+                }
+
+                //Transfer to a new heap block
+                void relocate( size_type n, bool_tag<false> ) {
+                    element_type *p = this->alloc.allocate( n );
+
+                    try {
+                        this->transfer( p );
+
+                    } catch ( ... ) {
+                        this->alloc.deallocate( p, n );
+                        throw;
+                    }
+
+                    this->alloc.deallocate( this->storage, this->allocated );
+                    this->storage = p;
+                }
+
+                /*
+                    Moves the elements to a block of exactly n slots, n being at least length(). Anything up to N
+                    is the inline storage, so shrinking to N or less moves the elements back in and frees the heap block.
+                    Being on the inline storage means allocated is N, so past the first check that is a heap block to allocate.
+                */
+                void reallocate( size_type n ) {
+                    if ( n < N ) {
+                        n = N;
+                    }
+
+                    if ( n == this->allocated ) {
+                        return;
+
+                    } else if ( !this->on_heap() ) {
+                        element_type *p = this->alloc.allocate( n );
+
+                        try {
+                            this->transfer( p );
+
+                        } catch ( ... ) {
+                            this->alloc.deallocate( p, n );
+                            throw;
+                        }
+
+                        this->storage = p;
+
+                    } else if ( n == N ) {
+                        element_type *heap = this->storage;
+
+                        this->transfer_inline( *this, inline_tag() );
+
+                        this->alloc.deallocate( heap, this->allocated );
+                        this->storage = this->inline_storage.data();
+
+                    } else {
+                        this->relocate( n, realloc_tag() );
+                    }
+
+                    this->allocated = n;
+                }
+
+                //Frees the heap block, if any, once there are no elements left in it
+                void release() {
+                    if ( this->on_heap() ) {
+                        this->alloc.deallocate( this->storage, this->allocated );
+
+                        this->storage = this->inline_storage.data();
+                        this->allocated = N;
+                    }
+                }
+
+                //Takes all of a's elements, leaving a empty and on its inline storage. This has to be the same already.
+                void steal_from( growable &a ) {
+                    if ( a.on_heap() ) {
+                        this->storage = a.storage;
+                        this->allocated = a.allocated;
+
+                        a.storage = a.inline_storage.data();
+                        a.allocated = N;
+
+                    } else {
+                        a.transfer_inline( *this, inline_tag() );
+                    }
+
+                    this->used_length = a.used_length;
+                    a.used_length = 0;
+                }
+
+                //Makes sure there is room for n more elements, growing geometrically
+                void grow( size_type n ) {
+                    size_type len = this->length();
+
+                    if ( n > this->allocated - len ) {
+                        if ( n > this->max_size() - len ) {
+                            DATA_ADAPTER_STAT_ADD( thrown, 1 )
+                            throw std::out_of_range( "DataAdapter::grow: Out of Range" );
+                        }
+
+                        size_type c = this->allocated + this->allocated / 2;
+
+                        if ( c < len + n || c > this->max_size() ) {
+                            c = len + n;
+                        }
+
+                        if ( c < 8 && this->max_size() >= 8 ) {
+                            c = 8;
+                        }
+
+                        this->reallocate( c );
+                    }
+                }
+
+                /*
+                    Inserts one element at off, which must be at most length() with room to spare.
+                    Like std::vector, the last element is moved into the first unused slot and the rest are moved up by
+                    assignment, so no slot is ever left unconstructed if something throws halfway through.
+                */
+                template <typename V>
+                element_type *insert_one( size_type off, V &val ) {
+                    size_type len = this->length();
+
+                    element_type *d = this->data();
+
+                    if ( off < len ) {
+                        DATA_ADAPTER_STAT_ADD( shifted, len - off )
+
+                        element_type *last = d + len - 1;
+
+                        ::new( static_cast<void *>( last + 1 ) ) element_type( DATA_ADAPTER_MOVE( *last ) );
+
+                        ++this->used_length;
+
+                        DATA_ADAPTER_MOVE_BACKWARD( d + off, last, last + 1 );
+
+                        d[off] = DATA_ADAPTER_MOVE( val );
+
+                    } else {
+                        ::new( static_cast<void *>( d + len ) ) element_type( DATA_ADAPTER_MOVE( val ) );
+
+                        ++this->used_length;
+                    }
+
+                    return d + off;
+                }
+
+                //Inserts [first, last), which is n elements, at off the same way, with room for them already there
+                template <typename _ForwardIterator>
+                element_type *insert_n( size_type off, _ForwardIterator first, _ForwardIterator last, size_type n ) {
+                    size_type len = this->length();
+                    size_type after = len - off;
+
+                    element_type *d = this->data();
+
+                    DATA_ADAPTER_STAT_ADD( shifted, after )
+
+                    if ( after > n ) {
+                        DATA_ADAPTER_UNINITIALIZED_MOVE( d + len - n, d + len, d + len );
+                        this->used_length = len + n;
+
+                        DATA_ADAPTER_MOVE_BACKWARD( d + off, d + len - n, d + len );
+
+                        std::copy( first, last, d + off );
+
+                    } else {
+                        _ForwardIterator mid = first;
+                        std::advance( mid, after );
+
+                        std::uninitialized_copy( mid, last, d + len );
+                        this->used_length = off + n;
+
+                        DATA_ADAPTER_UNINITIALIZED_MOVE( d + off, d + len, d + off + n );
+                        this->used_length = len + n;
+
+                        std::copy( first, mid, d + off );
+                    }
+
+                    return d + off;
+                }
+
+                //Fill version of insert_n
+                element_type *insert_fill_n( size_type off, size_type n, const element_type &val ) {
+                    size_type len = this->length();
+                    size_type after = len - off;
+
+                    element_type *d = this->data();
+
+                    DATA_ADAPTER_STAT_ADD( shifted, after )
+                    DATA_ADAPTER_STAT_ADD( filled, n )
+
+                    if ( after > n ) {
+                        DATA_ADAPTER_UNINITIALIZED_MOVE( d + len - n, d + len, d + len );
+                        this->used_length = len + n;
+
+                        DATA_ADAPTER_MOVE_BACKWARD( d + off, d + len - n, d + len );
+
+                        std::fill( d + off, d + off + n, val );
+
+                    } else {
+                        std::uninitialized_fill( d + len, d + off + n, val );
+                        this->used_length = off + n;
+
+                        DATA_ADAPTER_UNINITIALIZED_MOVE( d + off, d + len, d + off + n );
+                        this->used_length = len + n;
+
+                        std::fill( d + off, d + len, val );
+                    }
+
+                    return d + off;
+                }
+
+                //Closes [f, l) by moving the tail down, then destroys what is left over at the end
+                void close_gap( size_type f, size_type l ) {
+                    size_type len = this->length();
+
+                    element_type *d = this->data();
+
+                    DATA_ADAPTER_STAT_ADD( shifted, len - l )
+
+                    DATA_ADAPTER_MOVE_RANGE( d + l, d + len, d + f );
+
+                    this->truncate( len - ( l - f ) );
+                }
+
+                /*
+                    The range versions of insert and assign, like the array adapter's. Forward ranges are counted
+                    first, so growing happens at most once, and input ranges are constructed at the end as they
+                    come, growing like push_back, and rotated into place once.
+                */
+                template <typename _Integer>
+                iterator insert_range( iterator pos, _Integer n, _Integer val, da::detail::integral_range_tag ) {
+                    return this->insert( pos, static_cast<size_type>( n ), static_cast<element_type>( val ) );
+                }
+
+                template <typename _ForwardIterator>
+                iterator insert_range( iterator pos, _ForwardIterator first, _ForwardIterator last, std::forward_iterator_tag ) {
+                    DATA_ADAPTER_STAT_SCOPE( insert_range )
+
+                    size_type off = pos.offset();
+                    size_type n = std::distance( first, last );
+
+                    if ( n == 0 ) {
+                        return this->end();
+                    }
+
+                    if ( off > this->length() ) {
+                        DATA_ADAPTER_STAT_ADD( thrown, 1 )
+                        throw std::out_of_range( "DataAdapter::insert(range): Out of Range" );
+                    }
+
+                    //Growing or shifting would move our own elements around under first and last
+                    if ( da::detail::points_into( first, this->data(), this->data() + this->length() ) ) {
+                        std::vector<element_type> tmp( first, last );
+
+                        this->grow( n );
+                        this->insert_n( off, tmp.begin(), tmp.end(), n );
+
+                    } else {
+                        this->grow( n );
+                        this->insert_n( off, first, last, n );
+                    }
+
+                    return this->begin() + off;
+                }
+
+                template <typename _InputIterator>
+                iterator insert_range( iterator pos, _InputIterator first, _InputIterator last, std::input_iterator_tag ) {
+                    DATA_ADAPTER_STAT_SCOPE( insert_range )
+
+                    size_type off = pos.offset();
+                    size_type len = this->length();
+
+                    if ( off > len ) {
+                        DATA_ADAPTER_STAT_ADD( thrown, 1 )
+                        throw std::out_of_range( "DataAdapter::insert(range): Out of Range" );
+                    }
+
+                    try {
+                        for ( ; first != last; ++first ) {
+                            this->grow( 1 );
+
+                            ::new( static_cast<void *>( this->data() + this->used_length ) ) element_type( *first );
+                            ++this->used_length;
+                        }
+
+                    } catch ( ... ) {
+                        this->truncate( len );
+                        throw;
+                    }
+
+                    element_type *d = this->data();
+
+                    DATA_ADAPTER_STAT_ADD( shifted, len - off )
+
+                    std::rotate( d + off, d + len, d + this->used_length );
+
+                    return this->begin() + off;
+                }
+
+                template <typename _Integer>
+                void assign_range( _Integer n, _Integer val, da::detail::integral_range_tag ) {
+                    this->assign( static_cast<size_type>( n ), static_cast<element_type>( val ) );
+                }
+
+                template <typename _ForwardIterator>
+                void assign_range( _ForwardIterator first, _ForwardIterator last, std::forward_iterator_tag ) {
+                    size_type n = std::distance( first, last );
+                    size_type len = this->length();
+
+                    if ( n > this->allocated ) {
+                        if ( n > this->max_size() ) {
+                            DATA_ADAPTER_STAT_ADD( thrown, 1 )
+                            throw std::out_of_range( "DataAdapter::assign: Out of Range" );
+                        }
+
+                        //Nothing to keep, so the old elements don't need relocating
+                        this->truncate( 0 );
+                        this->release();
+                        this->reallocate( n );
+
+                        std::uninitialized_copy( first, last, this->data() );
+                        this->used_length = n;
+
+                    } else if ( n <= len ) {
+                        std::copy( first, last, this->data() );
+                        this->truncate( n );
+
+                    } else {
+                        _ForwardIterator mid = first;
+                        std::advance( mid, len );
+
+                        std::copy( first, mid, this->data() );
+                        std::uninitialized_copy( mid, last, this->data() + len );
+                        this->used_length = n;
+                    }
+                }
+
+                template <typename _InputIterator>
+                void assign_range( _InputIterator first, _InputIterator last, std::input_iterator_tag ) {
+                    this->truncate( 0 );
+                    this->insert_range( this->begin(), first, last, std::input_iterator_tag() );
+                }
+
+                /*
+                    Merges the sorted elements of [first, last) into the sorted contents, the same way as the array
+                    adapter. There has to be room for them after length() already. If something throws, the slots
+                    constructed past the old end are destroyed again, and the length stays what it was.
+                */
+                template <typename _BidirectionalIterator>
+                iterator merge_back( _BidirectionalIterator first, _BidirectionalIterator last ) {
+                    element_type *d = this->data();
+
+                    size_type len = this->length();
+                    size_type i = len;
+                    size_type w = i + std::distance( first, last );
+                    size_type n = w;
+
+                    //Slots from here to n have been constructed
+                    size_type built = n;
+
+                    try {
+                        while ( last != first ) {
+                            --last;
+
+                            while ( i != 0 && *last < d[i - 1] ) {
+                                if ( --w >= len ) {
+                                    ::new( static_cast<void *>( d + w ) ) element_type( DATA_ADAPTER_MOVE( d[--i] ) );
+                                    built = w;
+
+                                } else {
+                                    d[w] = DATA_ADAPTER_MOVE( d[--i] );
+                                }
+                            }
+
+                            if ( --w >= len ) {
+                                ::new( static_cast<void *>( d + w ) ) element_type( DATA_ADAPTER_MOVE( *last ) );
+                                built = w;
+
+                            } else {
+                                d[w] = DATA_ADAPTER_MOVE( *last );
+                            }
+                        }
+
+                    } catch ( ... ) {
+                        da::detail::destroy( d + built, d + n );
+                        throw;
+                    }
+
+                    this->used_length = n;
+
+                    DATA_ADAPTER_STAT_ADD( shifted, len - i )
+
+                    return this->begin() + w;
+                }
+
+            protected:
+                /*
+                    Takes over a heap block of cap slots from the allocator, with len live elements at its start,
+                    for an adapter whose allocator hands out blocks that already hold elements, like a mapped file.
+                    This has to be empty and have nothing on the heap.
+                */
+                void adopt( element_type *block, size_type len, size_type cap ) {
+                    this->storage = block;
+                    this->used_length = len;
+                    this->allocated = cap;
+                }
+
+            public:
+                growable() : storage( NULL ), used_length( 0 ), allocated( N ) {
+                    this->storage = this->inline_storage.data();
+                }
+
+                explicit growable( const allocator_type &a )
+                    : alloc( a ), storage( NULL ), used_length( 0 ), allocated( N ) {
+                    this->storage = this->inline_storage.data();
+                }
+
+                growable( size_type n, const element_type &val, const allocator_type &a )
+                    : alloc( a ), storage( NULL ), used_length( 0 ), allocated( N ) {
+                    this->storage = this->inline_storage.data();
+
+                    this->insert( this->begin(), n, val );
+                }
+
+                growable( const growable &a )
+                    : _Base(), alloc( a.alloc ), storage( NULL ), used_length( 0 ), allocated( N ) {
+                    this->storage = this->inline_storage.data();
+
+                    this->assign( a.data(), a.data() + a.length() );
+                }
+
+                growable &operator=( const growable &a ) {
+                    if ( this != &a ) {
+                        this->assign( a.data(), a.data() + a.length() );
+                    }
+
+                    return *this;
+                }
+
+#if DATA_ADAPTER_CXX11
+                //Takes over a heap block as it is, but elements in the inline storage have to be moved one by one
+                growable( growable &&a )
+                    : _Base(), alloc( a.alloc ), storage( NULL ), used_length( 0 ), allocated( N ) {
+                    this->storage = this->inline_storage.data();
+
+                    this->steal_from( a );
+                }
+
+                growable &operator=( growable &&a ) {
+                    if ( this != &a ) {
+                        this->truncate( 0 );
+                        this->release();
+
+                        this->alloc = a.alloc;
+                        this->steal_from( a );
+                    }
+
+                    return *this;
+                }
+#endif // DATA_ADAPTER_CXX11
+
+                ~growable() {
+                    this->truncate( 0 );
+                    this->release();
+                }
+
+                //Swaps heap blocks as they are, and goes through a temporary for inline storage
+                void swap( growable &a ) {
+                    derived_type tmp( this->alloc );
+
+                    tmp.steal_from( *this );
+
+                    this->alloc = a.alloc;
+                    this->steal_from( a );
+
+                    a.alloc = tmp.alloc;
+                    a.steal_from( tmp );
+                }
+
+                inline allocator_type get_allocator() const {
+                    return this->alloc;
+                }
+
+                //Replaces the contents with [first, last), growing to exactly their size if there isn't room
+                template <typename _InputIterator>
+                void assign( _InputIterator first, _InputIterator last ) {
+                    this->assign_range( first, last, typename da::detail::range_kind<_InputIterator>::type() );
+                }
+
+                //Replaces the contents with n copies of val, the same way
+                void assign( size_type n, const element_type &val ) {
+                    //val could be one of our own elements
+                    element_type tmp( val );
+
+                    size_type len = this->length();
+
+                    DATA_ADAPTER_STAT_ADD( filled, n )
+
+                    if ( n > this->allocated ) {
+                        if ( n > this->max_size() ) {
+                            DATA_ADAPTER_STAT_ADD( thrown, 1 )
+                            throw std::out_of_range( "DataAdapter::assign: Out of Range" );
+                        }
+
+                        this->truncate( 0 );
+                        this->release();
+                        this->reallocate( n );
+
+                        std::uninitialized_fill( this->data(), this->data() + n, tmp );
+                        this->used_length = n;
+
+                    } else if ( n <= len ) {
+                        std::fill( this->data(), this->data() + n, tmp );
+                        this->truncate( n );
+
+                    } else {
+                        std::fill( this->data(), this->data() + len, tmp );
+                        std::uninitialized_fill( this->data() + len, this->data() + n, tmp );
+                        this->used_length = n;
+                    }
+                }
+
+                inline bool operator==( const derived_type &da ) const {
+                    return da::detail::equal( this->data(), this->length(), da.data(), da.length() );
+                }
+
+                inline int compare( const derived_type &da ) const {
+                    return da::detail::compare( this->data(), this->length(), da.data(), da.length() );
+                }
+
+                inline bool operator<( const derived_type &da ) const {
+                    return this->compare( da ) < 0;
+                }
+
+                inline size_type hash() const {
+                    return da::detail::hash( this->data(), this->length() );
+                }
+
+                inline size_type capacity() const {
+                    return this->allocated;
+                }
+
+                inline size_type length() const {
+                    return this->used_length;
+                }
+
+                inline size_type max_size() const {
+#if DATA_ADAPTER_CXX11
+                    return std::allocator_traits<allocator_type>::max_size( this->alloc );
+#else
+                    return this->alloc.max_size();
+#endif // DATA_ADAPTER_CXX11
+                }
+
+                //Grows the capacity to at least n, never shrinks it
+                void reserve( size_type n ) {
+                    if ( n > this->allocated ) {
+                        if ( n > this->max_size() ) {
+                            DATA_ADAPTER_STAT_ADD( thrown, 1 )
+                            throw std::out_of_range( "DataAdapter::reserve: Out of Range" );
+                        }
+
+                        this->reallocate( n );
+                    }
+                }
+
+                //Shrinks the capacity to length(), or to the inline storage if they fit in it
+                void shrink_to_fit() {
+                    this->reallocate( this->length() );
+                }
+
+                void push_back( const element_type &n = element_type() ) {
+                    DATA_ADAPTER_STAT_SCOPE( push_back )
+
+                    if ( this->length() == this->allocated ) {
+                        //n could be one of our own elements, which growing would move out from under it
+                        element_type tmp( n );
+
+                        this->grow( 1 );
+
+                        ::new( static_cast<void *>( this->data() + this->length() ) ) element_type( DATA_ADAPTER_MOVE( tmp ) );
+
+                    } else {
+                        ::new( static_cast<void *>( this->data() + this->length() ) ) element_type( n );
+                    }
+
+                    ++this->used_length;
+                }
+
+                void push_front( const element_type &val = element_type() ) {
+                    DATA_ADAPTER_STAT_SCOPE( push_front )
+
+                    element_type tmp( val );
+
+                    this->grow( 1 );
+                    this->insert_one( 0, tmp );
+                }
+
+#if DATA_ADAPTER_CXX11
+                void push_back( element_type &&n ) {
+                    DATA_ADAPTER_STAT_SCOPE( push_back )
+
+                    if ( this->length() == this->allocated ) {
+                        element_type tmp( std::move( n ) );
+
+                        this->grow( 1 );
+
+                        ::new( static_cast<void *>( this->data() + this->length() ) ) element_type( std::move( tmp ) );
+
+                    } else {
+                        ::new( static_cast<void *>( this->data() + this->length() ) ) element_type( std::move( n ) );
+                    }
+
+                    ++this->used_length;
+                }
+
+                void push_front( element_type &&val ) {
+                    DATA_ADAPTER_STAT_SCOPE( push_front )
+
+                    element_type tmp( std::move( val ) );
+
+                    this->grow( 1 );
+                    this->insert_one( 0, tmp );
+                }
+
+                template <typename... Args>
+                element_type &emplace_back( Args &&... args ) {
+                    DATA_ADAPTER_STAT_SCOPE( emplace )
+
+                    element_type *p;
+
+                    if ( this->length() == this->allocated ) {
+                        //Constructed before growing, in case args refer to our own elements
+                        element_type tmp( std::forward<Args>( args )... );
+
+                        this->grow( 1 );
+
+                        p = ::new( static_cast<void *>( this->data() + this->length() ) ) element_type( std::move( tmp ) );
+
+                    } else {
+                        p = ::new( static_cast<void *>( this->data() + this->length() ) ) element_type( std::forward<Args>( args )... );
+                    }
+
+                    ++this->used_length;
+
+                    return *p;
+                }
+
+                template <typename... Args>
+                iterator emplace( iterator pos, Args &&... args ) {
+                    DATA_ADAPTER_STAT_SCOPE( emplace )
+
+                    size_type off = pos.offset();
+
+                    if ( off <= this->length() ) {
+                        element_type tmp( std::forward<Args>( args )... );
+
+                        this->grow( 1 );
+                        this->insert_one( off, tmp );
+
+                        return this->begin() + off;
+
+                    } else {
+                        DATA_ADAPTER_STAT_ADD( thrown, 1 )
+                        throw std::out_of_range( "DataAdapter::emplace: Out of Range" );
+                    }
+                }
+#endif // DATA_ADAPTER_CXX11
+
+                element_type pop_back() {
+                    DATA_ADAPTER_STAT_SCOPE( pop_back )
+
+                    if ( !this->empty() ) {
+                        element_type ret = DATA_ADAPTER_MOVE( this->back() );
+
+                        this->truncate( this->length() - 1 );
+
+                        return ret;
+
+                    } else {
+                        return element_type();
+                    }
+                }
+
+                element_type pop_front() {
+                    DATA_ADAPTER_STAT_SCOPE( pop_front )
+
+                    if ( !this->empty() ) {
+                        element_type ret = DATA_ADAPTER_MOVE( this->front() );
+
+                        this->close_gap( 0, 1 );
+
+                        return ret;
+
+                    } else {
+                        return element_type();
+                    }
+                }
+
+                inline element_type *data() {
+                    return this->storage;
+                }
+
+                inline const element_type *data() const {
+                    return this->storage;
+                }
+
+                inline element_type &at( size_type n ) {
+                    return this->data()[n];
+                }
+
+                inline const element_type at( size_type n ) const {
+                    return this->data()[n];
+                }
+
+                inline element_type &at( iterator it ) {
+                    return this->at( it.offset() );
+                }
+
+                inline const element_type at( const_iterator it ) const {
+                    return this->at( it.offset() );
+                }
+
+                inline element_type front() const {
+                    return this->at( 0 );
+                }
+
+                inline element_type &front() {
+                    return this->at( 0 );
+                }
+
+                inline element_type back() const {
+                    return this->at( this->length() - 1 );
+                }
+
+                inline element_type &back() {
+                    return this->at( this->length() - 1 );
+                }
+
+#if DATA_ADAPTER_CXX11
+                using _Base::sort;
+#endif // DATA_ADAPTER_CXX11
+
+                //Radix sort where it can, like the array adapter's
+                void sort() {
+                    DATA_ADAPTER_STAT_SCOPE( sort )
+
+                    da::detail::sort( this->data(), this->data() + this->length() );
+                }
+
+                //Searches over data(), with the SIMD kernels from detail/simd.hpp, like the array adapter's
+                inline iterator find( const element_type &n ) {
+                    DATA_ADAPTER_STAT_SCOPE( find )
+
+                    return this->begin() + ( da::detail::find( this->data(), this->data() + this->length(), n ) - this->data() );
+                }
+
+                iterator find_sorted( const element_type &n ) {
+                    DATA_ADAPTER_STAT_SCOPE( find_sorted )
+
+                    const element_type *last = this->data() + this->length();
+                    const element_type *p = da::detail::lower_bound( this->data(), last, n );
+
+                    if ( p != last && *p == n ) {
+                        return this->begin() + ( p - this->data() );
+
+                    } else {
+                        return this->end();
+                    }
+                }
+
+                inline size_type count( const element_type &n ) const {
+                    return da::detail::count( this->data(), this->data() + this->length(), n );
+                }
+
+                inline bool contains( const element_type &n ) const {
+                    return da::detail::find( this->data(), this->data() + this->length(), n ) != this->data() + this->length();
+                }
+
+                inline iterator min_element() {
+                    return this->begin() + ( da::detail::min_element( this->data(), this->data() + this->length() ) - this->data() );
+                }
+
+                inline iterator max_element() {
+                    return this->begin() + ( da::detail::max_element( this->data(), this->data() + this->length() ) - this->data() );
+                }
+
+                iterator sorted_insert( const element_type &n ) {
+                    DATA_ADAPTER_STAT_SCOPE( sorted_insert )
+
+                    return this->insert( this->begin() + ( std::upper_bound( this->data(), this->data() + this->length(), n ) - this->data() ), n );
+                }
+
+#if DATA_ADAPTER_CXX11
+                iterator sorted_insert( element_type &&n ) {
+                    DATA_ADAPTER_STAT_SCOPE( sorted_insert )
+
+                    return this->emplace( this->begin() + ( std::upper_bound( this->data(), this->data() + this->length(), n ) - this->data() ), std::move( n ) );
+                }
+#endif // DATA_ADAPTER_CXX11
+
+                //Same as the array adapter's, with the room made first
+                template <typename _InputIterator>
+                iterator sorted_insert( _InputIterator first, _InputIterator last ) {
+                    DATA_ADAPTER_STAT_SCOPE( sorted_insert )
+
+                    std::vector<element_type> batch( first, last );
+
+                    if ( batch.empty() ) {
+                        return this->end();
+
+                    } else {
+                        std::stable_sort( batch.begin(), batch.end() );
+
+                        this->grow( batch.size() );
+
+                        return this->merge_back( batch.begin(), batch.end() );
+                    }
+                }
+
+                //single element
+                iterator insert( iterator pos, const element_type &val ) {
+                    DATA_ADAPTER_STAT_SCOPE( insert )
+
+                    size_type off = pos.offset();
+
+                    if ( off <= this->length() ) {
+                        element_type tmp( val );
+
+                        this->grow( 1 );
+                        this->insert_one( off, tmp );
+
+                        return this->begin() + off;
+
+                    } else {
+                        DATA_ADAPTER_STAT_ADD( thrown, 1 )
+                        throw std::out_of_range( "DataAdapter::insert: Out of Range" );
+                    }
+                }
+
+#if DATA_ADAPTER_CXX11
+                iterator insert( iterator pos, element_type &&val ) {
+                    DATA_ADAPTER_STAT_SCOPE( insert )
+
+                    return this->emplace( pos, std::move( val ) );
+                }
+#endif // DATA_ADAPTER_CXX11
+
+                //fill
+                iterator insert( iterator pos, size_type n, const element_type &val ) {
+                    DATA_ADAPTER_STAT_SCOPE( insert_fill )
+
+                    if ( n != 0 ) {
+                        size_type off = pos.offset();
+
+                        if ( off <= this->length() ) {
+                            element_type tmp( val );
+
+                            this->grow( n );
+                            this->insert_fill_n( off, n, tmp );
+
+                            return this->begin() + off;
+
+                        } else {
+                            DATA_ADAPTER_STAT_ADD( thrown, 1 )
+                            throw std::out_of_range( "DataAdapter::insert(fill): Out of Range" );
+                        }
+                    } else {
+                        return this->end();
+                    }
+                }
+
+                //range
+                iterator insert( iterator pos, const_iterator first, const_iterator last ) {
+                    DATA_ADAPTER_STAT_SCOPE( insert_range )
+
+                    if ( first != last && first < last ) {
+                        size_type off = pos.offset();
+                        size_type diff = last - first;
+
+                        if ( off <= this->length() ) {
+                            const element_type *d = this->data();
+
+                            //Growing or shifting would move our own elements around under first and last
+                            if ( first.base() >= d && first.base() < d + this->length() ) {
+                                std::vector<element_type> tmp( first.base(), last.base() );
+
+                                this->grow( diff );
+                                this->insert_n( off, tmp.begin(), tmp.end(), diff );
+
+                            } else {
+                                this->grow( diff );
+                                this->insert_n( off, first.base(), last.base(), diff );
+                            }
+
+                            return this->begin() + off;
+
+                        } else {
+                            DATA_ADAPTER_STAT_ADD( thrown, 1 )
+                            throw std::out_of_range( "DataAdapter::insert(range): Out of Range" );
+                        }
+                    } else {
+                        return this->end();
+                    }
+                }
+
+                //Any other range, from any kind of iterator, or a count and a value
+                template <typename _InputIterator>
+                iterator insert( iterator pos, _InputIterator first, _InputIterator last ) {
+                    return this->insert_range( pos, first, last, typename da::detail::range_kind<_InputIterator>::type() );
+                }
+
+                //Destroys the elements but keeps the capacity, like std::vector
+                void clear() {
+                    DATA_ADAPTER_STAT_SCOPE( clear )
+
+                    this->truncate( 0 );
+                }
+
+                inline size_type resize( size_type n ) {
+                    return this->resize( n, element_type() );
+                }
+
+                size_type resize( size_type n, const element_type &v ) {
+                    DATA_ADAPTER_STAT_SCOPE( resize )
+
+                    size_type ret = this->length();
+
+                    if ( n > ret ) {
+                        element_type tmp( v );
+
+                        this->grow( n - ret );
+
+                        DATA_ADAPTER_STAT_ADD( filled, n - ret )
+
+                        std::uninitialized_fill( this->data() + ret, this->data() + n, tmp );
+
+                        this->used_length = n;
+
+                    } else {
+                        this->truncate( n );
+                    }
+
+                    return ret;
+                }
+
+                inline iterator erase( iterator pos ) {
+                    return this->erase( pos, pos + 1 );
+                }
+
+                iterator erase( iterator first, iterator last ) {
+                    DATA_ADAPTER_STAT_SCOPE( erase )
+
+                    size_type f = first.offset();
+                    size_type l = last.offset();
+
+                    if ( f <= l && l <= this->length() ) {
+
+                        this->close_gap( f, l );
+
+                        return this->begin() + f;
+
+                    } else {
+                        DATA_ADAPTER_STAT_ADD( thrown, 1 )
+                        throw std::out_of_range( "DataAdapter::erase(range): Out of Range" );
+                    }
+                }
+
+                /*
+                    Erases every element pred( element ) is true for and returns how many there were. The elements kept
+                    are moved down over the gaps in one pass, instead of shifting the whole tail once per erase.
+                */
+                template <typename _Predicate>
+                size_type erase_if( _Predicate pred ) {
+                    DATA_ADAPTER_STAT_SCOPE( erase_if )
+
+                    element_type *d = this->data();
+                    size_type len = this->length();
+
+                    element_type *first;
+                    element_type *last = da::detail::remove_if( d, d + len, pred, first );
+
+                    DATA_ADAPTER_STAT_ADD( shifted, last - first )
+
+                    this->truncate( last - d );
+
+                    return len - this->length();
+                }
+
+                //Moves the last element into pos instead of shifting everything after it down
+                iterator unordered_erase( iterator pos ) {
+                    DATA_ADAPTER_STAT_SCOPE( unordered_erase )
+
+                    size_type off = pos.offset();
+                    size_type len = this->length();
+
+                    if ( off < len ) {
+                        element_type *d = this->data();
+
+                        if ( off + 1 != len ) {
+                            DATA_ADAPTER_STAT_ADD( shifted, 1 )
+
+                            d[off] = DATA_ADAPTER_MOVE( d[len - 1] );
+                        }
+
+                        this->truncate( len - 1 );
+
+                        return this->begin() + off;
+
+                    } else {
+                        DATA_ADAPTER_STAT_ADD( thrown, 1 )
+                        throw std::out_of_range( "DataAdapter::unordered_erase: Out of Range" );
+                    }
+                }
+        };
+    }
+}
+
+#endif // DATA_ADAPTER_DETAIL_GROWABLE_HPP_INCLUDED
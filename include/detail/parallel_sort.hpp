@@ -0,0 +1,274 @@
+#ifndef DATA_ADAPTER_DETAIL_PARALLEL_SORT_HPP_INCLUDED
+#define DATA_ADAPTER_DETAIL_PARALLEL_SORT_HPP_INCLUDED
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "./storage.hpp"
+
+/*
+    Parallel sort, for sort( threads ) and stable_sort( threads ).
+
+    The range is cut into one chunk per thread, and every thread sorts its chunk and moves it out into a
+    buffer of the same size. Then the sorted runs are merged pairwise, back and forth between the buffer and
+    the range, until there is only one left. Every merge of two runs is cut into pieces that can be done
+    independently: the longer run is split evenly, and the shorter one where its elements fall between those
+    split points, found by binary search. So each round keeps every thread busy, down to the last one, which
+    is a single merge of two halves.
+
+    std::merge takes from the first run on ties, and the split points keep that order, so the merges are
+    stable, and with std::stable_sort for the chunks so is the whole sort.
+
+    Ranges shorter than parallel_sort_min_chunk per thread use fewer threads, down to the plain
+    sequential std::sort or std::stable_sort.
+
+    An exception from comparing, moving or starting a thread is rethrown from the calling thread once every
+    thread is done, and the buffer is freed. That is only the basic guarantee: every element of the range is
+    still alive and can be assigned to or destroyed, but once the chunks have been moved out into the buffer,
+    some of them may be moved-from values, and the values of those are lost.
+*/
+
+namespace da {
+    namespace detail {
+
+        static const size_t parallel_sort_min_chunk = 1 << 14;
+
+        /*
+            Calls f( i ) for every i in [0, tasks), from up to threads threads, one of which is the calling one.
+            The first exception thrown is rethrown once they are all done.
+        */
+        template <typename F>
+        void run_parallel( size_t tasks, unsigned threads, F f ) {
+            std::atomic<size_t> next( 0 );
+            std::exception_ptr error;
+            std::mutex error_lock;
+
+            auto work = [&] {
+                for ( size_t i; ( i = next.fetch_add( 1 ) ) < tasks; ) {
+                    try {
+                        f( i );
+
+                    } catch ( ... ) {
+                        std::lock_guard<std::mutex> lock( error_lock );
+
+                        if ( !error ) {
+                            error = std::current_exception();
+                        }
+                    }
+                }
+            };
+
+            std::vector<std::thread> pool;
+
+            try {
+                for ( size_t t = 1; t < threads && t < tasks; ++t ) {
+                    pool.push_back( std::thread( work ) );
+                }
+
+            } catch ( ... ) {
+                //Couldn't start another thread, so the ones there are do the rest
+                std::lock_guard<std::mutex> lock( error_lock );
+
+                if ( !error ) {
+                    error = std::current_exception();
+                }
+            }
+
+            work();
+
+            for ( std::thread &t : pool ) {
+                t.join();
+            }
+
+            if ( error ) {
+                std::rethrow_exception( error );
+            }
+        }
+
+        //One independent piece of a merge, as offsets from the start of the source and the destination
+        struct merge_piece {
+            size_t a0, a1, b0, b1, out;
+        };
+
+        /*
+            Cuts the merge of runs [a0, a1) and [b0, b1) of src into parts pieces. Elements of the first run
+            go before equal ones of the second, so a split in the first run at x lines up with the first
+            element of the second that isn't less than x, and a split in the second at y with the first
+            element of the first that is greater than y.
+        */
+        template <typename _RandomAccessIterator>
+        void split_merge( _RandomAccessIterator src, size_t a0, size_t a1, size_t b0, size_t b1,
+                          size_t parts, std::vector<merge_piece> &pieces ) {
+            size_t pa = a0, pb = b0;
+
+            for ( size_t j = 1; j <= parts; ++j ) {
+                size_t na, nb;
+
+                if ( j == parts ) {
+                    na = a1;
+                    nb = b1;
+
+                } else if ( a1 - a0 >= b1 - b0 ) {
+                    na = a0 + ( a1 - a0 ) * j / parts;
+                    nb = std::lower_bound( src + b0, src + b1, *( src + na ) ) - src;
+
+                } else {
+                    nb = b0 + ( b1 - b0 ) * j / parts;
+                    na = std::upper_bound( src + a0, src + a1, *( src + nb ) ) - src;
+                }
+
+                merge_piece p = { pa, na, pb, nb, a0 + ( pa - a0 ) + ( pb - b0 ) };
+                pieces.push_back( p );
+
+                pa = na;
+                pb = nb;
+            }
+        }
+
+        /*
+            One round: merges the runs of src, which start at runs[i], pairwise into dst, and returns the
+            runs of dst. A run without a partner is just moved over.
+        */
+        template <typename _SrcIterator, typename _DstIterator>
+        std::vector<size_t> merge_round( _SrcIterator src, _DstIterator dst, const std::vector<size_t> &runs, unsigned threads ) {
+            size_t count = runs.size() - 1;
+            size_t pairs = count / 2;
+            size_t parts = std::max<size_t>( 1, threads / pairs );
+
+            std::vector<merge_piece> pieces;
+            std::vector<size_t> next;
+
+            for ( size_t r = 0; r + 1 < count; r += 2 ) {
+                split_merge( src, runs[r], runs[r + 1], runs[r + 1], runs[r + 2], parts, pieces );
+                next.push_back( runs[r] );
+            }
+
+            if ( count % 2 != 0 ) {
+                merge_piece p = { runs[count - 1], runs[count], runs[count], runs[count], runs[count - 1] };
+                pieces.push_back( p );
+                next.push_back( runs[count - 1] );
+            }
+
+            next.push_back( runs[count] );
+
+            run_parallel( pieces.size(), threads, [&]( size_t i ) {
+                const merge_piece &p = pieces[i];
+
+                std::merge( std::make_move_iterator( src + p.a0 ), std::make_move_iterator( src + p.a1 ),
+                            std::make_move_iterator( src + p.b0 ), std::make_move_iterator( src + p.b1 ),
+                            dst + p.out );
+            } );
+
+            return next;
+        }
+
+        template <typename _RandomAccessIterator>
+        void parallel_sort( _RandomAccessIterator first, _RandomAccessIterator last, unsigned threads, bool stable ) {
+            typedef typename std::iterator_traits<_RandomAccessIterator>::value_type value_type;
+
+            size_t n = last - first;
+
+            if ( threads == 0 ) {
+                threads = std::max( 1u, std::thread::hardware_concurrency() );
+            }
+
+            threads = static_cast<unsigned>( std::min<size_t>( threads, n / parallel_sort_min_chunk ) );
+
+            if ( threads <= 1 ) {
+                if ( stable ) {
+                    std::stable_sort( first, last );
+
+                } else {
+                    std::sort( first, last );
+                }
+
+                return;
+            }
+
+            std::vector<size_t> runs;
+
+            for ( unsigned i = 0; i <= threads; ++i ) {
+                runs.push_back( n * i / threads );
+            }
+
+            std::allocator<value_type> alloc;
+            value_type *buffer = alloc.allocate( n );
+
+            //Which chunks made it into the buffer, to destroy exactly those if something throws on the way
+            std::unique_ptr<bool[]> moved( new bool[threads]() );
+
+            try {
+                run_parallel( threads, threads, [&]( size_t i ) {
+                    if ( stable ) {
+                        std::stable_sort( first + runs[i], first + runs[i + 1] );
+
+                    } else {
+                        std::sort( first + runs[i], first + runs[i + 1] );
+                    }
+
+                    DATA_ADAPTER_UNINITIALIZED_MOVE( first + runs[i], first + runs[i + 1], buffer + runs[i] );
+                    moved[i] = true;
+                } );
+
+                //Every round halves the runs, and an odd number of rounds leaves them in the range
+                bool in_buffer = true;
+
+                while ( runs.size() > 2 ) {
+                    if ( in_buffer ) {
+                        runs = merge_round( buffer, first, runs, threads );
+
+                    } else {
+                        runs = merge_round( first, buffer, runs, threads );
+                    }
+
+                    in_buffer = !in_buffer;
+                }
+
+                if ( in_buffer ) {
+                    run_parallel( threads, threads, [&]( size_t i ) {
+                        size_t f = n * i / threads, l = n * ( i + 1 ) / threads;
+
+                        std::move( buffer + f, buffer + l, first + f );
+                    } );
+                }
+
+            } catch ( ... ) {
+                for ( unsigned i = 0; i < threads; ++i ) {
+                    if ( moved[i] ) {
+                        da::detail::destroy( buffer + n * i / threads, buffer + n * ( i + 1 ) / threads );
+                    }
+                }
+
+                alloc.deallocate( buffer, n );
+                throw;
+            }
+
+            da::detail::destroy( buffer, buffer + n );
+            alloc.deallocate( buffer, n );
+        }
+
+        template <typename _ForwardIterator>
+        inline void parallel_sort( _ForwardIterator first, _ForwardIterator last, unsigned, bool stable, std::forward_iterator_tag ) {
+            if ( stable ) {
+                da::detail::stable_sort( first, last, std::forward_iterator_tag() );
+
+            } else {
+                da::detail::sort( first, last, std::forward_iterator_tag() );
+            }
+        }
+
+        template <typename _RandomAccessIterator>
+        inline void parallel_sort( _RandomAccessIterator first, _RandomAccessIterator last, unsigned threads, bool stable, std::random_access_iterator_tag ) {
+            parallel_sort( first, last, threads, stable );
+        }
+    }
+}
+
+#endif // DATA_ADAPTER_DETAIL_PARALLEL_SORT_HPP_INCLUDED
@@ -0,0 +1,216 @@
+#ifndef DATA_ADAPTER_DETAIL_RADIX_SORT_HPP_INCLUDED
+#define DATA_ADAPTER_DETAIL_RADIX_SORT_HPP_INCLUDED
+
+#include <cstddef>
+#include <cstring>
+#include <algorithm>
+#include <limits>
+#include <new>
+
+#include "./storage.hpp"
+
+/*
+    Radix sort, for sort() on the adapters that keep their elements in one block.
+
+    Integers and IEEE floats are sorted with an LSD radix sort instead of std::sort: one pass over the
+    elements counts every byte of every key, then each byte from the lowest up scatters the elements
+    into a scratch buffer and back, in the order of that byte. A byte that is the same in every key
+    (like the high bytes of small integers) would leave the order as it is, so its pass is skipped.
+    That makes sorting O(n), with at most one pass per byte of the key and no comparison to mispredict.
+
+    Every pass also has to go over all 256 counts, so below radix_sort_min_per_byte elements for each byte
+    of the key that costs more than it saves, and std::sort is used as before.
+*/
+
+namespace da {
+    namespace detail {
+
+        template <bool B, typename T, typename F>
+        struct select_type {
+            typedef T type;
+        };
+
+        template <typename T, typename F>
+        struct select_type<false, T, F> {
+            typedef F type;
+        };
+
+        //The unsigned integer of exactly Size bytes, or void if there is none
+        template <size_t Size>
+        struct uint_of_size {
+            typedef typename select_type < sizeof( unsigned char ) == Size, unsigned char,
+                    typename select_type < sizeof( unsigned short ) == Size, unsigned short,
+                    typename select_type < sizeof( unsigned int ) == Size, unsigned int,
+                    typename select_type < sizeof( unsigned long ) == Size, unsigned long,
+#if DATA_ADAPTER_CXX11
+                    typename select_type < sizeof( unsigned long long ) == Size, unsigned long long, void >::type
+#else
+                    void
+#endif // DATA_ADAPTER_CXX11
+                    >::type >::type >::type >::type type;
+        };
+
+        //Signed integers get their sign bit flipped, so negative ones come first as unsigned
+        template <typename T>
+        struct radix_int_key {
+            typedef typename uint_of_size<sizeof( T )>::type type;
+
+            static const bool value = true;
+
+            static inline type get( const T &x ) {
+                const bool is_signed = static_cast<T>( -1 ) < static_cast<T>( 0 );
+
+                return static_cast<type>( static_cast<type>( x ) ^ ( is_signed ? static_cast<type>( 1 ) << ( sizeof( type ) * 8 - 1 ) : 0 ) );
+            }
+        };
+
+        /*
+            IEEE floats compare like their bits as sign and magnitude, so positive ones only need the sign
+            bit set to go after the negative ones, and negative ones need all of their bits flipped to go
+            in reverse. -0.0 ends up before 0.0, and NaNs before or after everything, by their sign.
+        */
+        template <typename T>
+        struct radix_float_key {
+            typedef typename uint_of_size<sizeof( T )>::type type;
+
+            static const bool value = std::numeric_limits<T>::is_iec559 && sizeof( type ) == sizeof( T );
+
+            static inline type get( const T &x ) {
+                const type sign = static_cast<type>( 1 ) << ( sizeof( type ) * 8 - 1 );
+
+                type u;
+                std::memcpy( &u, &x, sizeof( T ) );
+
+                return static_cast<type>( u ^ ( static_cast<type>( 0 - ( u >> ( sizeof( type ) * 8 - 1 ) ) ) | sign ) );
+            }
+        };
+    }
+
+    /*
+        How sort() gets an unsigned integer key out of a T for radix sorting it, if it can.
+
+        The built in integer and floating point types have one. Any other type can get one by specializing
+        this with value = true, an unsigned integer type, and a static get( const T & ) returning it,
+        so that a struct is sorted by one of its fields:
+
+            template <>
+            struct da::radix_key<order> {
+                static const bool value = true;
+                typedef unsigned type;
+
+                static type get( const order &o ) {
+                    return o.id;
+                }
+            };
+
+        sort() then orders by the key rather than by operator<, so the two should agree. The elements are
+        moved around by copying their bytes, so T also has to be trivially relocatable (see detail/storage.hpp).
+    */
+    template <typename T>
+    struct radix_key {
+        static const bool value = false;
+    };
+
+#define DATA_ADAPTER_RADIX_KEY(type_, kind_)                    \
+    template <>                                                 \
+    struct radix_key<type_> : da::detail::kind_<type_> {};
+
+    DATA_ADAPTER_RADIX_KEY( char, radix_int_key )
+    DATA_ADAPTER_RADIX_KEY( signed char, radix_int_key )
+    DATA_ADAPTER_RADIX_KEY( unsigned char, radix_int_key )
+    DATA_ADAPTER_RADIX_KEY( wchar_t, radix_int_key )
+    DATA_ADAPTER_RADIX_KEY( short, radix_int_key )
+    DATA_ADAPTER_RADIX_KEY( unsigned short, radix_int_key )
+    DATA_ADAPTER_RADIX_KEY( int, radix_int_key )
+    DATA_ADAPTER_RADIX_KEY( unsigned int, radix_int_key )
+    DATA_ADAPTER_RADIX_KEY( long, radix_int_key )
+    DATA_ADAPTER_RADIX_KEY( unsigned long, radix_int_key )
+#if DATA_ADAPTER_CXX11
+    DATA_ADAPTER_RADIX_KEY( long long, radix_int_key )
+    DATA_ADAPTER_RADIX_KEY( unsigned long long, radix_int_key )
+#endif // DATA_ADAPTER_CXX11
+    DATA_ADAPTER_RADIX_KEY( float, radix_float_key )
+    DATA_ADAPTER_RADIX_KEY( double, radix_float_key )
+
+#undef DATA_ADAPTER_RADIX_KEY
+
+    namespace detail {
+
+        static const size_t radix_sort_min_per_byte = 128;
+
+        template <typename T>
+        void radix_sort( T *first, T *last ) {
+            typedef da::radix_key<T> key;
+            typedef typename key::type key_type;
+
+            static const size_t passes = sizeof( key_type );
+
+            size_t n = static_cast<size_t>( last - first );
+            size_t counts[passes][256] = {};
+
+            for ( T *it = first; it != last; ++it ) {
+                key_type k = key::get( *it );
+
+                for ( size_t p = 0; p < passes; ++p ) {
+                    ++counts[p][( k >> ( p * 8 ) ) & 0xff];
+                }
+            }
+
+            //Raw memory, since the elements only ever pass through it as bytes
+            T *buffer = static_cast<T *>( ::operator new( n * sizeof( T ) ) );
+            T *src = first, *dst = buffer;
+
+            const key_type k0 = key::get( *first );
+
+            for ( size_t p = 0; p < passes; ++p ) {
+                size_t *c = counts[p];
+
+                if ( c[( k0 >> ( p * 8 ) ) & 0xff] == n ) {
+                    continue;
+                }
+
+                for ( size_t b = 0, sum = 0; b < 256; ++b ) {
+                    size_t t = c[b];
+                    c[b] = sum;
+                    sum += t;
+                }
+
+                for ( size_t i = 0; i < n; ++i ) {
+                    std::memcpy( static_cast<void *>( dst + c[( key::get( src[i] ) >> ( p * 8 ) ) & 0xff]++ ),
+                                 static_cast<const void *>( src + i ), sizeof( T ) );
+                }
+
+                std::swap( src, dst );
+            }
+
+            if ( src != first ) {
+                std::memcpy( static_cast<void *>( first ), static_cast<const void *>( src ), n * sizeof( T ) );
+            }
+
+            ::operator delete( buffer );
+        }
+
+        template <typename T>
+        inline void sort( T *first, T *last, bool_tag<true> ) {
+            if ( static_cast<size_t>( last - first ) >= radix_sort_min_per_byte * sizeof( typename da::radix_key<T>::type ) ) {
+                radix_sort( first, last );
+
+            } else {
+                std::sort( first, last );
+            }
+        }
+
+        template <typename T>
+        inline void sort( T *first, T *last, bool_tag<false> ) {
+            std::sort( first, last );
+        }
+
+        //sort() on a block of elements, which is a radix sort if T has a radix_key
+        template <typename T>
+        inline void sort( T *first, T *last ) {
+            sort( first, last, bool_tag < da::radix_key<T>::value && da::is_trivially_relocatable<T>::value > () );
+        }
+    }
+}
+
+#endif // DATA_ADAPTER_DETAIL_RADIX_SORT_HPP_INCLUDED
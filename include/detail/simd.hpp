@@ -0,0 +1,922 @@
+#ifndef DATA_ADAPTER_DETAIL_SIMD_HPP_INCLUDED
+#define DATA_ADAPTER_DETAIL_SIMD_HPP_INCLUDED
+
+#include <cstddef>
+#include <algorithm>
+
+#include "./storage.hpp"
+
+/*
+    Search kernels.
+
+    find, count, min_element and max_element over a raw block of arithmetic elements are done 16 bytes
+    at a time with SSE2, or 32 bytes at a time with AVX2 when the CPU running the program has it. That is
+    checked once at runtime, so the library doesn't need to be compiled with -mavx2 for it. lower_bound
+    is the branchless version, where the only thing that depends on a comparison is which half to keep,
+    which compiles to a conditional move instead of a mispredicted branch half of the time.
+
+    Every kernel gives exactly what the std algorithm of the same name would, down to which of several
+    equal elements is found and what happens with NaNs, and anything that isn't an arithmetic type just
+    goes to the std algorithm. Defining DATA_ADAPTER_NO_SIMD before including any DataAdapter header
+    turns the vector kernels off, leaving only the branchless lower_bound.
+*/
+#if !defined(DATA_ADAPTER_NO_SIMD) && ( defined(__SSE2__) || defined(_M_X64) || ( defined(_M_IX86_FP) && _M_IX86_FP >= 2 ) )
+#   define DATA_ADAPTER_SIMD 1
+#   include <emmintrin.h>
+#else
+#   define DATA_ADAPTER_SIMD 0
+#endif
+
+#if DATA_ADAPTER_SIMD && ( defined(__GNUC__) || defined(__clang__) )
+#   define DATA_ADAPTER_SIMD_AVX2 1
+#   define DATA_ADAPTER_TARGET_AVX2 __attribute__(( target( "avx2" ) ))
+#   include <immintrin.h>
+#elif DATA_ADAPTER_SIMD && defined(_MSC_VER)
+#   define DATA_ADAPTER_SIMD_AVX2 1
+#   define DATA_ADAPTER_TARGET_AVX2
+#   include <immintrin.h>
+#   include <intrin.h>
+#else
+#   define DATA_ADAPTER_SIMD_AVX2 0
+#endif
+
+namespace da {
+    namespace detail {
+
+        /*
+            Which kernel, if any, handles a T. Integers only need their size and signedness,
+            so every integer type maps to one of the int_lane ones.
+        */
+        struct no_lane {};
+
+        template <size_t Size, bool Signed>
+        struct int_lane {};
+
+        struct float_lane {};
+        struct double_lane {};
+
+        template <typename T>
+        struct simd_lane {
+            typedef no_lane type;
+        };
+
+#define DATA_ADAPTER_SIMD_INT_LANE(type_)                                               \
+        template <>                                                                     \
+        struct simd_lane<type_> {                                                       \
+            typedef int_lane<sizeof( type_ ), ( static_cast<type_>( -1 ) < static_cast<type_>( 0 ) )> type; \
+        };
+
+        DATA_ADAPTER_SIMD_INT_LANE( bool )
+        DATA_ADAPTER_SIMD_INT_LANE( char )
+        DATA_ADAPTER_SIMD_INT_LANE( signed char )
+        DATA_ADAPTER_SIMD_INT_LANE( unsigned char )
+        DATA_ADAPTER_SIMD_INT_LANE( wchar_t )
+        DATA_ADAPTER_SIMD_INT_LANE( short )
+        DATA_ADAPTER_SIMD_INT_LANE( unsigned short )
+        DATA_ADAPTER_SIMD_INT_LANE( int )
+        DATA_ADAPTER_SIMD_INT_LANE( unsigned int )
+        DATA_ADAPTER_SIMD_INT_LANE( long )
+        DATA_ADAPTER_SIMD_INT_LANE( unsigned long )
+#if DATA_ADAPTER_CXX11
+        DATA_ADAPTER_SIMD_INT_LANE( long long )
+        DATA_ADAPTER_SIMD_INT_LANE( unsigned long long )
+        DATA_ADAPTER_SIMD_INT_LANE( char16_t )
+        DATA_ADAPTER_SIMD_INT_LANE( char32_t )
+#endif // DATA_ADAPTER_CXX11
+
+#undef DATA_ADAPTER_SIMD_INT_LANE
+
+        template <>
+        struct simd_lane<float> {
+            typedef float_lane type;
+        };
+
+        template <>
+        struct simd_lane<double> {
+            typedef double_lane type;
+        };
+
+        template <typename T>
+        inline bool is_nan( const T & ) {
+            return false;
+        }
+
+        inline bool is_nan( float v ) {
+            return v != v;
+        }
+
+        inline bool is_nan( double v ) {
+            return v != v;
+        }
+
+        template <typename T>
+        inline const T *branchless_lower_bound( const T *first, const T *last, const T &val ) {
+            size_t n = static_cast<size_t>( last - first );
+
+            if ( n == 0 ) {
+                return first;
+            }
+
+            while ( n > 1 ) {
+                size_t half = n / 2;
+
+                first = first[half] < val ? first + half : first;
+                n -= half;
+            }
+
+            return first + ( *first < val ? 1 : 0 );
+        }
+
+#if DATA_ADAPTER_SIMD
+        inline unsigned ctz( unsigned m ) {
+#   if defined(__GNUC__) || defined(__clang__)
+            return static_cast<unsigned>( __builtin_ctz( m ) );
+#   else
+            unsigned long i;
+            _BitScanForward( &i, m );
+            return static_cast<unsigned>( i );
+#   endif
+        }
+
+        inline unsigned popcount( unsigned m ) {
+#   if defined(__GNUC__) || defined(__clang__)
+            return static_cast<unsigned>( __builtin_popcount( m ) );
+#   else
+            m = m - ( ( m >> 1 ) & 0x55555555u );
+            m = ( m & 0x33333333u ) + ( ( m >> 2 ) & 0x33333333u );
+            return ( ( ( m + ( m >> 4 ) ) & 0x0F0F0F0Fu ) * 0x01010101u ) >> 24;
+#   endif
+        }
+
+        /*
+            Each ops<Lane> has the few operations the kernels need on one vector of lanes: load, store,
+            splat, eq, which gives a byte mask like _mm_movemask_epi8 (so sizeof( T ) bits per matching
+            element), and min and max where the instruction set allows it (ordered). Like the instructions,
+            min( a, b ) and max( a, b ) give b if either one is NaN.
+        */
+        namespace sse2 {
+            inline __m128i select( __m128i m, __m128i a, __m128i b ) {
+                return _mm_or_si128( _mm_and_si128( m, a ), _mm_andnot_si128( m, b ) );
+            }
+
+            template <typename Lane>
+            struct ops {};
+
+            template <bool Signed>
+            struct ops<int_lane<1, Signed> > {
+                typedef __m128i vec;
+                static const bool ordered = true;
+
+                static inline vec load( const void *p ) {
+                    return _mm_loadu_si128( static_cast<const __m128i *>( p ) );
+                }
+
+                static inline void store( void *p, vec v ) {
+                    _mm_storeu_si128( static_cast<__m128i *>( p ), v );
+                }
+
+                template <typename T>
+                static inline vec splat( T v ) {
+                    return _mm_set1_epi8( static_cast<char>( v ) );
+                }
+
+                static inline int eq( vec a, vec b ) {
+                    return _mm_movemask_epi8( _mm_cmpeq_epi8( a, b ) );
+                }
+
+                static inline vec gt( vec a, vec b ) {
+                    const vec bias = _mm_set1_epi8( Signed ? 0 : static_cast<char>( 0x80 ) );
+
+                    return _mm_cmpgt_epi8( _mm_xor_si128( a, bias ), _mm_xor_si128( b, bias ) );
+                }
+
+                static inline vec min( vec a, vec b ) {
+                    return select( gt( a, b ), b, a );
+                }
+
+                static inline vec max( vec a, vec b ) {
+                    return select( gt( a, b ), a, b );
+                }
+            };
+
+            template <bool Signed>
+            struct ops<int_lane<2, Signed> > {
+                typedef __m128i vec;
+                static const bool ordered = true;
+
+                static inline vec load( const void *p ) {
+                    return _mm_loadu_si128( static_cast<const __m128i *>( p ) );
+                }
+
+                static inline void store( void *p, vec v ) {
+                    _mm_storeu_si128( static_cast<__m128i *>( p ), v );
+                }
+
+                template <typename T>
+                static inline vec splat( T v ) {
+                    return _mm_set1_epi16( static_cast<short>( v ) );
+                }
+
+                static inline int eq( vec a, vec b ) {
+                    return _mm_movemask_epi8( _mm_cmpeq_epi16( a, b ) );
+                }
+
+                static inline vec gt( vec a, vec b ) {
+                    const vec bias = _mm_set1_epi16( Signed ? 0 : static_cast<short>( 0x8000 ) );
+
+                    return _mm_cmpgt_epi16( _mm_xor_si128( a, bias ), _mm_xor_si128( b, bias ) );
+                }
+
+                static inline vec min( vec a, vec b ) {
+                    return select( gt( a, b ), b, a );
+                }
+
+                static inline vec max( vec a, vec b ) {
+                    return select( gt( a, b ), a, b );
+                }
+            };
+
+            template <bool Signed>
+            struct ops<int_lane<4, Signed> > {
+                typedef __m128i vec;
+                static const bool ordered = true;
+
+                static inline vec load( const void *p ) {
+                    return _mm_loadu_si128( static_cast<const __m128i *>( p ) );
+                }
+
+                static inline void store( void *p, vec v ) {
+                    _mm_storeu_si128( static_cast<__m128i *>( p ), v );
+                }
+
+                template <typename T>
+                static inline vec splat( T v ) {
+                    return _mm_set1_epi32( static_cast<int>( v ) );
+                }
+
+                static inline int eq( vec a, vec b ) {
+                    return _mm_movemask_epi8( _mm_cmpeq_epi32( a, b ) );
+                }
+
+                static inline vec gt( vec a, vec b ) {
+                    const vec bias = _mm_set1_epi32( Signed ? 0 : static_cast<int>( 0x80000000u ) );
+
+                    return _mm_cmpgt_epi32( _mm_xor_si128( a, bias ), _mm_xor_si128( b, bias ) );
+                }
+
+                static inline vec min( vec a, vec b ) {
+                    return select( gt( a, b ), b, a );
+                }
+
+                static inline vec max( vec a, vec b ) {
+                    return select( gt( a, b ), a, b );
+                }
+            };
+
+            //SSE2 can't compare 64 bit integers for order, so only find and count use this one
+            template <bool Signed>
+            struct ops<int_lane<8, Signed> > {
+                typedef __m128i vec;
+                static const bool ordered = false;
+
+                static inline vec load( const void *p ) {
+                    return _mm_loadu_si128( static_cast<const __m128i *>( p ) );
+                }
+
+                template <typename T>
+                static inline vec splat( T v ) {
+                    //Both halves of v, without a 64 bit set1, which 32 bit MSVC doesn't have
+                    vec lo = _mm_cvtsi32_si128( static_cast<int>( v ) );
+                    vec hi = _mm_cvtsi32_si128( static_cast<int>( v >> 16 >> 16 ) );
+
+                    return _mm_unpacklo_epi64( _mm_unpacklo_epi32( lo, hi ), _mm_unpacklo_epi32( lo, hi ) );
+                }
+
+                static inline int eq( vec a, vec b ) {
+                    //Both 32 bit halves have to match
+                    vec c = _mm_cmpeq_epi32( a, b );
+
+                    return _mm_movemask_epi8( _mm_and_si128( c, _mm_shuffle_epi32( c, _MM_SHUFFLE( 2, 3, 0, 1 ) ) ) );
+                }
+            };
+
+            template <>
+            struct ops<float_lane> {
+                typedef __m128 vec;
+                static const bool ordered = true;
+
+                static inline vec load( const void *p ) {
+                    return _mm_loadu_ps( static_cast<const float *>( p ) );
+                }
+
+                static inline void store( void *p, vec v ) {
+                    _mm_storeu_ps( static_cast<float *>( p ), v );
+                }
+
+                static inline vec splat( float v ) {
+                    return _mm_set1_ps( v );
+                }
+
+                static inline int eq( vec a, vec b ) {
+                    return _mm_movemask_epi8( _mm_castps_si128( _mm_cmpeq_ps( a, b ) ) );
+                }
+
+                static inline vec min( vec a, vec b ) {
+                    return _mm_min_ps( a, b );
+                }
+
+                static inline vec max( vec a, vec b ) {
+                    return _mm_max_ps( a, b );
+                }
+            };
+
+            template <>
+            struct ops<double_lane> {
+                typedef __m128d vec;
+                static const bool ordered = true;
+
+                static inline vec load( const void *p ) {
+                    return _mm_loadu_pd( static_cast<const double *>( p ) );
+                }
+
+                static inline void store( void *p, vec v ) {
+                    _mm_storeu_pd( static_cast<double *>( p ), v );
+                }
+
+                static inline vec splat( double v ) {
+                    return _mm_set1_pd( v );
+                }
+
+                static inline int eq( vec a, vec b ) {
+                    return _mm_movemask_epi8( _mm_castpd_si128( _mm_cmpeq_pd( a, b ) ) );
+                }
+
+                static inline vec min( vec a, vec b ) {
+                    return _mm_min_pd( a, b );
+                }
+
+                static inline vec max( vec a, vec b ) {
+                    return _mm_max_pd( a, b );
+                }
+            };
+
+            template <typename Ops, typename T>
+            inline const T *find( const T *first, const T *last, const T &val ) {
+                const size_t W = sizeof( typename Ops::vec ) / sizeof( T );
+                const typename Ops::vec s = Ops::splat( val );
+
+                for ( ; static_cast<size_t>( last - first ) >= W; first += W ) {
+                    unsigned m = static_cast<unsigned>( Ops::eq( Ops::load( first ), s ) );
+
+                    if ( m != 0 ) {
+                        return first + ctz( m ) / sizeof( T );
+                    }
+                }
+
+                return std::find( first, last, val );
+            }
+
+            template <typename Ops, typename T>
+            inline size_t count( const T *first, const T *last, const T &val ) {
+                const size_t W = sizeof( typename Ops::vec ) / sizeof( T );
+                const typename Ops::vec s = Ops::splat( val );
+
+                size_t bits = 0;
+
+                for ( ; static_cast<size_t>( last - first ) >= W; first += W ) {
+                    bits += popcount( static_cast<unsigned>( Ops::eq( Ops::load( first ), s ) ) );
+                }
+
+                return bits / sizeof( T ) + static_cast<size_t>( std::count( first, last, val ) );
+            }
+
+            /*
+                The smallest value is found first, a vector at a time, and then its first occurrence with find(),
+                which is the element std::min_element gives. The accumulator starts as copies of *first, so with
+                min( x, acc ) NaNs never get into it, and std::min_element never picks one either, unless it's *first.
+            */
+            template <typename Ops, typename T>
+            inline const T *min_element( const T *first, const T *last ) {
+                const size_t W = sizeof( typename Ops::vec ) / sizeof( T );
+
+                if ( static_cast<size_t>( last - first ) < 2 * W || is_nan( *first ) ) {
+                    return std::min_element( first, last );
+                }
+
+                typename Ops::vec acc = Ops::splat( *first );
+                const T *p = first;
+
+                for ( ; static_cast<size_t>( last - p ) >= W; p += W ) {
+                    acc = Ops::min( Ops::load( p ), acc );
+                }
+
+                T lanes[W];
+                Ops::store( lanes, acc );
+
+                T m = *std::min_element( lanes, lanes + W );
+
+                for ( ; p != last; ++p ) {
+                    if ( *p < m ) {
+                        m = *p;
+                    }
+                }
+
+                return find<Ops>( first, last, m );
+            }
+
+            template <typename Ops, typename T>
+            inline const T *max_element( const T *first, const T *last ) {
+                const size_t W = sizeof( typename Ops::vec ) / sizeof( T );
+
+                if ( static_cast<size_t>( last - first ) < 2 * W || is_nan( *first ) ) {
+                    return std::max_element( first, last );
+                }
+
+                typename Ops::vec acc = Ops::splat( *first );
+                const T *p = first;
+
+                for ( ; static_cast<size_t>( last - p ) >= W; p += W ) {
+                    acc = Ops::max( Ops::load( p ), acc );
+                }
+
+                T lanes[W];
+                Ops::store( lanes, acc );
+
+                T m = *std::max_element( lanes, lanes + W );
+
+                for ( ; p != last; ++p ) {
+                    if ( m < *p ) {
+                        m = *p;
+                    }
+                }
+
+                return find<Ops>( first, last, m );
+            }
+        }
+
+#   if DATA_ADAPTER_SIMD_AVX2
+        //Everything in here is compiled for AVX2 regardless of the compiler flags, and only called after has_avx2()
+        namespace avx2 {
+            template <typename Lane>
+            struct ops {};
+
+            template <bool Signed>
+            struct ops<int_lane<1, Signed> > {
+                typedef __m256i vec;
+                static const bool ordered = true;
+
+                static inline DATA_ADAPTER_TARGET_AVX2 vec load( const void *p ) {
+                    return _mm256_loadu_si256( static_cast<const __m256i *>( p ) );
+                }
+
+                static inline DATA_ADAPTER_TARGET_AVX2 void store( void *p, vec v ) {
+                    _mm256_storeu_si256( static_cast<__m256i *>( p ), v );
+                }
+
+                template <typename T>
+                static inline DATA_ADAPTER_TARGET_AVX2 vec splat( T v ) {
+                    return _mm256_set1_epi8( static_cast<char>( v ) );
+                }
+
+                static inline DATA_ADAPTER_TARGET_AVX2 int eq( vec a, vec b ) {
+                    return _mm256_movemask_epi8( _mm256_cmpeq_epi8( a, b ) );
+                }
+
+                static inline DATA_ADAPTER_TARGET_AVX2 vec min( vec a, vec b ) {
+                    return Signed ? _mm256_min_epi8( a, b ) : _mm256_min_epu8( a, b );
+                }
+
+                static inline DATA_ADAPTER_TARGET_AVX2 vec max( vec a, vec b ) {
+                    return Signed ? _mm256_max_epi8( a, b ) : _mm256_max_epu8( a, b );
+                }
+            };
+
+            template <bool Signed>
+            struct ops<int_lane<2, Signed> > {
+                typedef __m256i vec;
+                static const bool ordered = true;
+
+                static inline DATA_ADAPTER_TARGET_AVX2 vec load( const void *p ) {
+                    return _mm256_loadu_si256( static_cast<const __m256i *>( p ) );
+                }
+
+                static inline DATA_ADAPTER_TARGET_AVX2 void store( void *p, vec v ) {
+                    _mm256_storeu_si256( static_cast<__m256i *>( p ), v );
+                }
+
+                template <typename T>
+                static inline DATA_ADAPTER_TARGET_AVX2 vec splat( T v ) {
+                    return _mm256_set1_epi16( static_cast<short>( v ) );
+                }
+
+                static inline DATA_ADAPTER_TARGET_AVX2 int eq( vec a, vec b ) {
+                    return _mm256_movemask_epi8( _mm256_cmpeq_epi16( a, b ) );
+                }
+
+                static inline DATA_ADAPTER_TARGET_AVX2 vec min( vec a, vec b ) {
+                    return Signed ? _mm256_min_epi16( a, b ) : _mm256_min_epu16( a, b );
+                }
+
+                static inline DATA_ADAPTER_TARGET_AVX2 vec max( vec a, vec b ) {
+                    return Signed ? _mm256_max_epi16( a, b ) : _mm256_max_epu16( a, b );
+                }
+            };
+
+            template <bool Signed>
+            struct ops<int_lane<4, Signed> > {
+                typedef __m256i vec;
+                static const bool ordered = true;
+
+                static inline DATA_ADAPTER_TARGET_AVX2 vec load( const void *p ) {
+                    return _mm256_loadu_si256( static_cast<const __m256i *>( p ) );
+                }
+
+                static inline DATA_ADAPTER_TARGET_AVX2 void store( void *p, vec v ) {
+                    _mm256_storeu_si256( static_cast<__m256i *>( p ), v );
+                }
+
+                template <typename T>
+                static inline DATA_ADAPTER_TARGET_AVX2 vec splat( T v ) {
+                    return _mm256_set1_epi32( static_cast<int>( v ) );
+                }
+
+                static inline DATA_ADAPTER_TARGET_AVX2 int eq( vec a, vec b ) {
+                    return _mm256_movemask_epi8( _mm256_cmpeq_epi32( a, b ) );
+                }
+
+                static inline DATA_ADAPTER_TARGET_AVX2 vec min( vec a, vec b ) {
+                    return Signed ? _mm256_min_epi32( a, b ) : _mm256_min_epu32( a, b );
+                }
+
+                static inline DATA_ADAPTER_TARGET_AVX2 vec max( vec a, vec b ) {
+                    return Signed ? _mm256_max_epi32( a, b ) : _mm256_max_epu32( a, b );
+                }
+            };
+
+            template <bool Signed>
+            struct ops<int_lane<8, Signed> > {
+                typedef __m256i vec;
+                static const bool ordered = true;
+
+                static inline DATA_ADAPTER_TARGET_AVX2 vec load( const void *p ) {
+                    return _mm256_loadu_si256( static_cast<const __m256i *>( p ) );
+                }
+
+                static inline DATA_ADAPTER_TARGET_AVX2 void store( void *p, vec v ) {
+                    _mm256_storeu_si256( static_cast<__m256i *>( p ), v );
+                }
+
+                template <typename T>
+                static inline DATA_ADAPTER_TARGET_AVX2 vec splat( T v ) {
+                    __m128i lo = _mm_cvtsi32_si128( static_cast<int>( v ) );
+                    __m128i hi = _mm_cvtsi32_si128( static_cast<int>( v >> 16 >> 16 ) );
+
+                    return _mm256_broadcastq_epi64( _mm_unpacklo_epi32( lo, hi ) );
+                }
+
+                static inline DATA_ADAPTER_TARGET_AVX2 int eq( vec a, vec b ) {
+                    return _mm256_movemask_epi8( _mm256_cmpeq_epi64( a, b ) );
+                }
+
+                static inline DATA_ADAPTER_TARGET_AVX2 vec gt( vec a, vec b ) {
+                    const vec bias = _mm256_set1_epi32( Signed ? 0 : static_cast<int>( 0x80000000u ) );
+                    const vec high = _mm256_and_si256( bias, _mm256_set_epi32( -1, 0, -1, 0, -1, 0, -1, 0 ) );
+
+                    return _mm256_cmpgt_epi64( _mm256_xor_si256( a, high ), _mm256_xor_si256( b, high ) );
+                }
+
+                static inline DATA_ADAPTER_TARGET_AVX2 vec min( vec a, vec b ) {
+                    return _mm256_blendv_epi8( a, b, gt( a, b ) );
+                }
+
+                static inline DATA_ADAPTER_TARGET_AVX2 vec max( vec a, vec b ) {
+                    return _mm256_blendv_epi8( b, a, gt( a, b ) );
+                }
+            };
+
+            template <>
+            struct ops<float_lane> {
+                typedef __m256 vec;
+                static const bool ordered = true;
+
+                static inline DATA_ADAPTER_TARGET_AVX2 vec load( const void *p ) {
+                    return _mm256_loadu_ps( static_cast<const float *>( p ) );
+                }
+
+                static inline DATA_ADAPTER_TARGET_AVX2 void store( void *p, vec v ) {
+                    _mm256_storeu_ps( static_cast<float *>( p ), v );
+                }
+
+                static inline DATA_ADAPTER_TARGET_AVX2 vec splat( float v ) {
+                    return _mm256_set1_ps( v );
+                }
+
+                static inline DATA_ADAPTER_TARGET_AVX2 int eq( vec a, vec b ) {
+                    return _mm256_movemask_epi8( _mm256_castps_si256( _mm256_cmp_ps( a, b, _CMP_EQ_OQ ) ) );
+                }
+
+                static inline DATA_ADAPTER_TARGET_AVX2 vec min( vec a, vec b ) {
+                    return _mm256_min_ps( a, b );
+                }
+
+                static inline DATA_ADAPTER_TARGET_AVX2 vec max( vec a, vec b ) {
+                    return _mm256_max_ps( a, b );
+                }
+            };
+
+            template <>
+            struct ops<double_lane> {
+                typedef __m256d vec;
+                static const bool ordered = true;
+
+                static inline DATA_ADAPTER_TARGET_AVX2 vec load( const void *p ) {
+                    return _mm256_loadu_pd( static_cast<const double *>( p ) );
+                }
+
+                static inline DATA_ADAPTER_TARGET_AVX2 void store( void *p, vec v ) {
+                    _mm256_storeu_pd( static_cast<double *>( p ), v );
+                }
+
+                static inline DATA_ADAPTER_TARGET_AVX2 vec splat( double v ) {
+                    return _mm256_set1_pd( v );
+                }
+
+                static inline DATA_ADAPTER_TARGET_AVX2 int eq( vec a, vec b ) {
+                    return _mm256_movemask_epi8( _mm256_castpd_si256( _mm256_cmp_pd( a, b, _CMP_EQ_OQ ) ) );
+                }
+
+                static inline DATA_ADAPTER_TARGET_AVX2 vec min( vec a, vec b ) {
+                    return _mm256_min_pd( a, b );
+                }
+
+                static inline DATA_ADAPTER_TARGET_AVX2 vec max( vec a, vec b ) {
+                    return _mm256_max_pd( a, b );
+                }
+            };
+
+            //The same kernels as the SSE2 ones above, see those
+            template <typename Ops, typename T>
+            DATA_ADAPTER_TARGET_AVX2 const T *find( const T *first, const T *last, const T &val ) {
+                const size_t W = sizeof( typename Ops::vec ) / sizeof( T );
+                const typename Ops::vec s = Ops::splat( val );
+
+                for ( ; static_cast<size_t>( last - first ) >= W; first += W ) {
+                    unsigned m = static_cast<unsigned>( Ops::eq( Ops::load( first ), s ) );
+
+                    if ( m != 0 ) {
+                        return first + ctz( m ) / sizeof( T );
+                    }
+                }
+
+                return std::find( first, last, val );
+            }
+
+            template <typename Ops, typename T>
+            DATA_ADAPTER_TARGET_AVX2 size_t count( const T *first, const T *last, const T &val ) {
+                const size_t W = sizeof( typename Ops::vec ) / sizeof( T );
+                const typename Ops::vec s = Ops::splat( val );
+
+                size_t bits = 0;
+
+                for ( ; static_cast<size_t>( last - first ) >= W; first += W ) {
+                    bits += popcount( static_cast<unsigned>( Ops::eq( Ops::load( first ), s ) ) );
+                }
+
+                return bits / sizeof( T ) + static_cast<size_t>( std::count( first, last, val ) );
+            }
+
+            template <typename Ops, typename T>
+            DATA_ADAPTER_TARGET_AVX2 const T *min_element( const T *first, const T *last ) {
+                const size_t W = sizeof( typename Ops::vec ) / sizeof( T );
+
+                if ( static_cast<size_t>( last - first ) < 2 * W || is_nan( *first ) ) {
+                    return std::min_element( first, last );
+                }
+
+                typename Ops::vec acc = Ops::splat( *first );
+                const T *p = first;
+
+                for ( ; static_cast<size_t>( last - p ) >= W; p += W ) {
+                    acc = Ops::min( Ops::load( p ), acc );
+                }
+
+                T lanes[W];
+                Ops::store( lanes, acc );
+
+                T m = *std::min_element( lanes, lanes + W );
+
+                for ( ; p != last; ++p ) {
+                    if ( *p < m ) {
+                        m = *p;
+                    }
+                }
+
+                return find<Ops>( first, last, m );
+            }
+
+            template <typename Ops, typename T>
+            DATA_ADAPTER_TARGET_AVX2 const T *max_element( const T *first, const T *last ) {
+                const size_t W = sizeof( typename Ops::vec ) / sizeof( T );
+
+                if ( static_cast<size_t>( last - first ) < 2 * W || is_nan( *first ) ) {
+                    return std::max_element( first, last );
+                }
+
+                typename Ops::vec acc = Ops::splat( *first );
+                const T *p = first;
+
+                for ( ; static_cast<size_t>( last - p ) >= W; p += W ) {
+                    acc = Ops::max( Ops::load( p ), acc );
+                }
+
+                T lanes[W];
+                Ops::store( lanes, acc );
+
+                T m = *std::max_element( lanes, lanes + W );
+
+                for ( ; p != last; ++p ) {
+                    if ( m < *p ) {
+                        m = *p;
+                    }
+                }
+
+                return find<Ops>( first, last, m );
+            }
+        }
+
+        inline bool cpu_has_avx2() {
+#       if defined(__AVX2__)
+            return true;
+#       elif defined(__GNUC__) || defined(__clang__)
+            return __builtin_cpu_supports( "avx2" ) != 0;
+#       else
+            int r[4];
+
+            __cpuid( r, 0 );
+
+            if ( r[0] < 7 ) {
+                return false;
+            }
+
+            //AVX2 also needs the OS to save the YMM registers
+            __cpuid( r, 1 );
+
+            if ( ( r[2] & ( 1 << 27 ) ) == 0 || ( r[2] & ( 1 << 28 ) ) == 0 || ( _xgetbv( 0 ) & 6 ) != 6 ) {
+                return false;
+            }
+
+            __cpuidex( r, 7, 0 );
+
+            return ( r[1] & ( 1 << 5 ) ) != 0;
+#       endif
+        }
+
+        inline bool has_avx2() {
+            static const bool avx2 = cpu_has_avx2();
+            return avx2;
+        }
+#   endif // DATA_ADAPTER_SIMD_AVX2
+#endif // DATA_ADAPTER_SIMD
+
+        /*
+            The dispatch from a T to its kernel, or to the std algorithm for no_lane.
+        */
+        template <typename T>
+        inline const T *find( const T *first, const T *last, const T &val, no_lane ) {
+            return std::find( first, last, val );
+        }
+
+        template <typename T, typename Lane>
+        inline const T *find( const T *first, const T *last, const T &val, Lane ) {
+#if DATA_ADAPTER_SIMD_AVX2
+            if ( has_avx2() ) {
+                return avx2::find<avx2::ops<Lane> >( first, last, val );
+            }
+#endif
+#if DATA_ADAPTER_SIMD
+            return sse2::find<sse2::ops<Lane> >( first, last, val );
+#else
+            return std::find( first, last, val );
+#endif
+        }
+
+        template <typename T>
+        inline size_t count( const T *first, const T *last, const T &val, no_lane ) {
+            return static_cast<size_t>( std::count( first, last, val ) );
+        }
+
+        template <typename T, typename Lane>
+        inline size_t count( const T *first, const T *last, const T &val, Lane ) {
+#if DATA_ADAPTER_SIMD_AVX2
+            if ( has_avx2() ) {
+                return avx2::count<avx2::ops<Lane> >( first, last, val );
+            }
+#endif
+#if DATA_ADAPTER_SIMD
+            return sse2::count<sse2::ops<Lane> >( first, last, val );
+#else
+            return static_cast<size_t>( std::count( first, last, val ) );
+#endif
+        }
+
+#if DATA_ADAPTER_SIMD
+        template <typename Ops, typename T>
+        inline const T *sse2_min_element( const T *first, const T *last, bool_tag<true> ) {
+            return sse2::min_element<Ops>( first, last );
+        }
+
+        template <typename Ops, typename T>
+        inline const T *sse2_min_element( const T *first, const T *last, bool_tag<false> ) {
+            return std::min_element( first, last );
+        }
+
+        template <typename Ops, typename T>
+        inline const T *sse2_max_element( const T *first, const T *last, bool_tag<true> ) {
+            return sse2::max_element<Ops>( first, last );
+        }
+
+        template <typename Ops, typename T>
+        inline const T *sse2_max_element( const T *first, const T *last, bool_tag<false> ) {
+            return std::max_element( first, last );
+        }
+#endif // DATA_ADAPTER_SIMD
+
+        template <typename T>
+        inline const T *min_element( const T *first, const T *last, no_lane ) {
+            return std::min_element( first, last );
+        }
+
+        template <typename T, typename Lane>
+        inline const T *min_element( const T *first, const T *last, Lane ) {
+#if DATA_ADAPTER_SIMD_AVX2
+            if ( has_avx2() ) {
+                return avx2::min_element<avx2::ops<Lane> >( first, last );
+            }
+#endif
+#if DATA_ADAPTER_SIMD
+            return sse2_min_element<sse2::ops<Lane> >( first, last, bool_tag<sse2::ops<Lane>::ordered>() );
+#else
+            return std::min_element( first, last );
+#endif
+        }
+
+        template <typename T>
+        inline const T *max_element( const T *first, const T *last, no_lane ) {
+            return std::max_element( first, last );
+        }
+
+        template <typename T, typename Lane>
+        inline const T *max_element( const T *first, const T *last, Lane ) {
+#if DATA_ADAPTER_SIMD_AVX2
+            if ( has_avx2() ) {
+                return avx2::max_element<avx2::ops<Lane> >( first, last );
+            }
+#endif
+#if DATA_ADAPTER_SIMD
+            return sse2_max_element<sse2::ops<Lane> >( first, last, bool_tag<sse2::ops<Lane>::ordered>() );
+#else
+            return std::max_element( first, last );
+#endif
+        }
+
+        template <typename T>
+        inline const T *lower_bound( const T *first, const T *last, const T &val, no_lane ) {
+            return std::lower_bound( first, last, val );
+        }
+
+        template <typename T, typename Lane>
+        inline const T *lower_bound( const T *first, const T *last, const T &val, Lane ) {
+            return branchless_lower_bound( first, last, val );
+        }
+
+        /*
+            What the contiguous adapters search their data() with. Same results as the std algorithms.
+        */
+        template <typename T>
+        inline const T *find( const T *first, const T *last, const T &val ) {
+            return find( first, last, val, typename simd_lane<T>::type() );
+        }
+
+        template <typename T>
+        inline size_t count( const T *first, const T *last, const T &val ) {
+            return count( first, last, val, typename simd_lane<T>::type() );
+        }
+
+        template <typename T>
+        inline const T *min_element( const T *first, const T *last ) {
+            return min_element( first, last, typename simd_lane<T>::type() );
+        }
+
+        template <typename T>
+        inline const T *max_element( const T *first, const T *last ) {
+            return max_element( first, last, typename simd_lane<T>::type() );
+        }
+
+        template <typename T>
+        inline const T *lower_bound( const T *first, const T *last, const T &val ) {
+            return lower_bound( first, last, val, typename simd_lane<T>::type() );
+        }
+    }
+}
+
+#endif // DATA_ADAPTER_DETAIL_SIMD_HPP_INCLUDED
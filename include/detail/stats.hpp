@@ -0,0 +1,289 @@
+#ifndef DATA_ADAPTER_DETAIL_STATS_HPP_INCLUDED
+#define DATA_ADAPTER_DETAIL_STATS_HPP_INCLUDED
+
+#include <cstddef>
+#include <ostream>
+
+#if DATA_ADAPTER_CXX11
+#   include <atomic>
+#endif
+
+#ifdef DATA_ADAPTER_INSTRUMENTATION_CYCLES
+#   if defined(_MSC_VER) && ( defined(_M_X64) || defined(_M_IX86) )
+#       include <intrin.h>
+#   elif defined(__x86_64__) || defined(__i386__)
+#       include <x86intrin.h>
+#   elif DATA_ADAPTER_CXX11
+#       include <chrono>
+#   else
+#       include <ctime>
+#   endif
+#endif
+
+/*
+    Instrumentation.
+
+    Defining DATA_ADAPTER_INSTRUMENTATION before including any DataAdapter header makes the adapters count
+    what they do into a da::stats object per adapter type, reachable through DataAdapter<...>::stats().
+    That is how many times each operation was called, how many elements were moved to open or close gaps,
+    how many were filled in, how many were moved when a growable adapter reallocated, and how many
+    exceptions were thrown, which is enough to spot an O(N)
+    shifting pattern from a trace of a running program.
+
+    Defining DATA_ADAPTER_INSTRUMENTATION_CYCLES as well also records a histogram of how long each call took,
+    in powers of two of the timestamp counter (or nanoseconds where there isn't one).
+
+    Operations that are implemented through other ones count as each of them, so a sorted_insert
+    is also an insert, and the time it took is in both histograms.
+
+    Without DATA_ADAPTER_INSTRUMENTATION, the DATA_ADAPTER_STAT_* macros expand to nothing, so the adapters
+    compile exactly as if they weren't there. stats() still exists, it just always reads zero.
+
+    With C++11 the counters are relaxed atomics, so adapters of the same type can be used from several
+    threads. In C++98 they are plain integers.
+*/
+#ifdef DATA_ADAPTER_INSTRUMENTATION
+#   define DATA_ADAPTER_STAT_SCOPE(op)          da::detail::stat_scope _da_stat_scope( this->stats(), da::stats::op );
+#   define DATA_ADAPTER_STAT_ADD(counter, n)    this->stats().add( da::stats::counter, ( n ) );
+#else
+#   define DATA_ADAPTER_STAT_SCOPE(op)
+#   define DATA_ADAPTER_STAT_ADD(counter, n)
+#endif // DATA_ADAPTER_INSTRUMENTATION
+
+namespace da {
+
+    class stats {
+        public:
+#if DATA_ADAPTER_CXX11
+            typedef unsigned long long value_type;
+#else
+            typedef unsigned long value_type;
+#endif
+
+            enum operation {
+                push_back,
+                push_front,
+                pop_back,
+                pop_front,
+                insert,
+                insert_fill,
+                insert_range,
+                emplace,
+                erase,
+                erase_if,
+                unordered_erase,
+                sorted_insert,
+                resize,
+                clear,
+                sort,
+                stable_sort,
+                find,
+                find_sorted,
+                operation_count
+            };
+
+            enum counter {
+                //Elements moved to open or close a gap, or to make room while merging
+                shifted,
+                //Elements assigned a fill value, by resize, clear and fill inserts
+                filled,
+                //std::out_of_range exceptions thrown
+                thrown,
+                //Elements moved to a new block by growable adapters
+                relocated,
+                counter_count
+            };
+
+            //Bucket i counts calls that took [2^i, 2^(i+1)) cycles
+            static const int histogram_buckets = 40;
+
+        private:
+#if DATA_ADAPTER_CXX11
+            typedef std::atomic<value_type> cell_type;
+
+            static inline void bump( cell_type &c, value_type n ) {
+                c.fetch_add( n, std::memory_order_relaxed );
+            }
+
+            static inline value_type read( const cell_type &c ) {
+                return c.load( std::memory_order_relaxed );
+            }
+#else
+            typedef value_type cell_type;
+
+            static inline void bump( cell_type &c, value_type n ) {
+                c += n;
+            }
+
+            static inline value_type read( const cell_type &c ) {
+                return c;
+            }
+#endif // DATA_ADAPTER_CXX11
+
+            cell_type call_counts[operation_count];
+            cell_type counters[counter_count];
+            cell_type cycle_histogram[operation_count][histogram_buckets];
+
+            //Not copyable, since the atomics aren't
+            stats( const stats & );
+            stats &operator=( const stats & );
+
+        public:
+            stats() {
+                this->reset();
+            }
+
+            static const char *name( operation op ) {
+                static const char *names[operation_count] = {
+                    "push_back", "push_front", "pop_back", "pop_front", "insert", "insert_fill", "insert_range",
+                    "emplace", "erase", "erase_if", "unordered_erase", "sorted_insert", "resize", "clear", "sort",
+                    "stable_sort", "find", "find_sorted"
+                };
+
+                return names[op];
+            }
+
+            static const char *name( counter c ) {
+                static const char *names[counter_count] = { "shifted", "filled", "thrown", "relocated" };
+
+                return names[c];
+            }
+
+            inline void call( operation op ) {
+                bump( this->call_counts[op], 1 );
+            }
+
+            inline void add( counter c, value_type n ) {
+                bump( this->counters[c], n );
+            }
+
+            void record_cycles( operation op, value_type cycles ) {
+                int b = 0;
+
+                while ( cycles > 1 && b < histogram_buckets - 1 ) {
+                    cycles >>= 1;
+                    ++b;
+                }
+
+                bump( this->cycle_histogram[op][b], 1 );
+            }
+
+            inline value_type calls( operation op ) const {
+                return read( this->call_counts[op] );
+            }
+
+            inline value_type count( counter c ) const {
+                return read( this->counters[c] );
+            }
+
+            inline value_type histogram( operation op, int bucket ) const {
+                return read( this->cycle_histogram[op][bucket] );
+            }
+
+            //Average number of elements shifted per call of any operation, the quickest sign of O(N) behavior
+            double shifted_per_call() const {
+                value_type total = 0;
+
+                for ( int i = 0; i < operation_count; ++i ) {
+                    total += this->calls( static_cast<operation>( i ) );
+                }
+
+                return total != 0 ? static_cast<double>( this->count( shifted ) ) / static_cast<double>( total ) : 0.0;
+            }
+
+            void reset() {
+                for ( int i = 0; i < operation_count; ++i ) {
+                    this->call_counts[i] = 0;
+
+                    for ( int b = 0; b < histogram_buckets; ++b ) {
+                        this->cycle_histogram[i][b] = 0;
+                    }
+                }
+
+                for ( int i = 0; i < counter_count; ++i ) {
+                    this->counters[i] = 0;
+                }
+            }
+
+            //Writes every nonzero counter, one per line, and a histogram line per operation if there is one
+            void dump( std::ostream &out, const char *title = "DataAdapter" ) const {
+                out << title << " stats:\n";
+
+                for ( int i = 0; i < operation_count; ++i ) {
+                    operation op = static_cast<operation>( i );
+
+                    if ( this->calls( op ) != 0 ) {
+                        out << "  " << name( op ) << ": " << this->calls( op ) << " calls\n";
+
+                        bool any = false;
+
+                        for ( int b = 0; b < histogram_buckets; ++b ) {
+                            if ( this->histogram( op, b ) != 0 ) {
+                                out << ( any ? " " : "    cycles (log2: calls):" ) << ' ' << b << ": " << this->histogram( op, b );
+                                any = true;
+                            }
+                        }
+
+                        if ( any ) {
+                            out << '\n';
+                        }
+                    }
+                }
+
+                for ( int i = 0; i < counter_count; ++i ) {
+                    counter c = static_cast<counter>( i );
+
+                    if ( this->count( c ) != 0 ) {
+                        out << "  " << name( c ) << ": " << this->count( c ) << '\n';
+                    }
+                }
+            }
+    };
+
+    namespace detail {
+
+#ifdef DATA_ADAPTER_INSTRUMENTATION_CYCLES
+        inline stats::value_type cycles() {
+#   if defined(_MSC_VER) && ( defined(_M_X64) || defined(_M_IX86) )
+            return static_cast<stats::value_type>( __rdtsc() );
+#   elif defined(__x86_64__) || defined(__i386__)
+            return static_cast<stats::value_type>( __rdtsc() );
+#   elif DATA_ADAPTER_CXX11
+            return static_cast<stats::value_type>( std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    std::chrono::steady_clock::now().time_since_epoch() ).count() );
+#   else
+            return static_cast<stats::value_type>( std::clock() );
+#   endif
+        }
+#endif // DATA_ADAPTER_INSTRUMENTATION_CYCLES
+
+        //Counts one call of an operation, and with DATA_ADAPTER_INSTRUMENTATION_CYCLES, how long it took
+        class stat_scope {
+#ifdef DATA_ADAPTER_INSTRUMENTATION_CYCLES
+            private:
+                stats &s;
+                stats::operation op;
+                stats::value_type start;
+
+            public:
+                stat_scope( stats &st, stats::operation o ) : s( st ), op( o ) {
+                    st.call( o );
+                    this->start = cycles();
+                }
+#else
+            public:
+                stat_scope( stats &st, stats::operation o ) {
+                    st.call( o );
+                }
+#endif
+
+#ifdef DATA_ADAPTER_INSTRUMENTATION_CYCLES
+                ~stat_scope() {
+                    this->s.record_cycles( this->op, cycles() - this->start );
+                }
+#endif
+        };
+    }
+}
+
+#endif // DATA_ADAPTER_DETAIL_STATS_HPP_INCLUDED
@@ -0,0 +1,193 @@
+#ifndef DATA_ADAPTER_DETAIL_STORAGE_HPP_INCLUDED
+#define DATA_ADAPTER_DETAIL_STORAGE_HPP_INCLUDED
+
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <new>
+
+#if DATA_ADAPTER_CXX11
+#   include <type_traits>
+#   define DATA_ADAPTER_UNINITIALIZED_MOVE(first, last, dest) \
+        std::uninitialized_copy( std::make_move_iterator( first ), std::make_move_iterator( last ), dest )
+#else
+#   define DATA_ADAPTER_UNINITIALIZED_MOVE(first, last, dest) \
+        std::uninitialized_copy( first, last, dest )
+#endif // DATA_ADAPTER_CXX11
+
+namespace da {
+
+    /*
+        Whether a T can be moved to another address by copying its bytes, without running any constructor
+        or destructor. Growable adapters use this to relocate their elements with memcpy or realloc.
+
+        With C++11 that is every trivially copyable type. C++98 has no way to tell, so only the fundamental
+        types and pointers are. Either way it can be specialized for types known to be safe, which is
+        most types that don't point into themselves, like a std::string with no small buffer.
+    */
+#if DATA_ADAPTER_CXX11
+    template <typename T>
+    struct is_trivially_relocatable {
+        static const bool value = std::is_trivially_copyable<T>::value;
+    };
+#else
+    template <typename T>
+    struct is_trivially_relocatable {
+        static const bool value = false;
+    };
+
+    template <typename T>
+    struct is_trivially_relocatable<T *> {
+        static const bool value = true;
+    };
+
+#   define DATA_ADAPTER_TRIVIALLY_RELOCATABLE(type)     \
+        template <>                                     \
+        struct is_trivially_relocatable<type> {         \
+            static const bool value = true;             \
+        };
+
+    DATA_ADAPTER_TRIVIALLY_RELOCATABLE( bool )
+    DATA_ADAPTER_TRIVIALLY_RELOCATABLE( char )
+    DATA_ADAPTER_TRIVIALLY_RELOCATABLE( signed char )
+    DATA_ADAPTER_TRIVIALLY_RELOCATABLE( unsigned char )
+    DATA_ADAPTER_TRIVIALLY_RELOCATABLE( wchar_t )
+    DATA_ADAPTER_TRIVIALLY_RELOCATABLE( short )
+    DATA_ADAPTER_TRIVIALLY_RELOCATABLE( unsigned short )
+    DATA_ADAPTER_TRIVIALLY_RELOCATABLE( int )
+    DATA_ADAPTER_TRIVIALLY_RELOCATABLE( unsigned int )
+    DATA_ADAPTER_TRIVIALLY_RELOCATABLE( long )
+    DATA_ADAPTER_TRIVIALLY_RELOCATABLE( unsigned long )
+    DATA_ADAPTER_TRIVIALLY_RELOCATABLE( float )
+    DATA_ADAPTER_TRIVIALLY_RELOCATABLE( double )
+    DATA_ADAPTER_TRIVIALLY_RELOCATABLE( long double )
+
+#   undef DATA_ADAPTER_TRIVIALLY_RELOCATABLE
+#endif // DATA_ADAPTER_CXX11
+
+    namespace detail {
+
+        //What shared state is padded to, so that what one thread writes doesn't evict what another one reads
+        static const size_t cache_line_size = 64;
+
+        /*
+            Raw, suitably aligned room for N elements of type T, none of which are constructed.
+            Whoever owns it decides which slots hold live elements, and constructs and destroys them
+            with placement new and destroy().
+        */
+        template <typename T, size_t N>
+        class raw_storage {
+            private:
+#if DATA_ADAPTER_CXX11
+                alignas( T ) unsigned char bytes[sizeof( T ) * N];
+#else
+                //Without alignas, the union is aligned for anything a fundamental type could need
+                union {
+                    unsigned char bytes[sizeof( T ) * N];
+                    long double ld;
+                    double d;
+                    long l;
+                    void *p;
+                    void ( *fp )();
+                } u;
+#endif // DATA_ADAPTER_CXX11
+
+            public:
+                inline T *data() {
+#if DATA_ADAPTER_CXX11
+                    return reinterpret_cast<T *>( this->bytes );
+#else
+                    return reinterpret_cast<T *>( this->u.bytes );
+#endif
+                }
+
+                inline const T *data() const {
+#if DATA_ADAPTER_CXX11
+                    return reinterpret_cast<const T *>( this->bytes );
+#else
+                    return reinterpret_cast<const T *>( this->u.bytes );
+#endif
+                }
+        };
+
+        //No storage at all, for adapters that may or may not have some inline
+        template <typename T>
+        class raw_storage<T, 0> {
+            public:
+                inline T *data() {
+                    return NULL;
+                }
+
+                inline const T *data() const {
+                    return NULL;
+                }
+        };
+
+#if DATA_ADAPTER_CXX11
+        template <typename T>
+        inline void destroy( T *, T *, std::true_type ) {}
+
+        template <typename T>
+        inline void destroy( T *first, T *last, std::false_type ) {
+            for ( ; first != last; ++first ) {
+                first->~T();
+            }
+        }
+
+        //Ends the lifetime of [first, last), which is nothing at all for trivially destructible types
+        template <typename T>
+        inline void destroy( T *first, T *last ) {
+            destroy( first, last, typename std::is_trivially_destructible<T>::type() );
+        }
+#else
+        template <typename T>
+        inline void destroy( T *first, T *last ) {
+            for ( ; first != last; ++first ) {
+                first->~T();
+            }
+        }
+#endif // DATA_ADAPTER_CXX11
+
+        template <bool B>
+        struct bool_tag {};
+
+#if DATA_ADAPTER_CXX11
+        template <typename T>
+        inline T *uninitialized_relocate( T *first, T *last, T *dest, bool_tag<true> ) {
+            return std::uninitialized_copy( std::make_move_iterator( first ), std::make_move_iterator( last ), dest );
+        }
+
+        template <typename T>
+        inline T *uninitialized_relocate( T *first, T *last, T *dest, bool_tag<false> ) {
+            return std::uninitialized_copy( first, last, dest );
+        }
+
+        /*
+            Moves [first, last) into the raw memory at dest, for when the old block is about to be freed.
+            Like std::vector, elements are only moved if that can't throw (or they can't be copied),
+            so that a throwing copy leaves the source untouched.
+        */
+        template <typename T>
+        inline T *uninitialized_relocate( T *first, T *last, T *dest ) {
+            return uninitialized_relocate( first, last, dest, bool_tag < std::is_nothrow_move_constructible<T>::value ||
+                                                                         !std::is_copy_constructible<T>::value > () );
+        }
+#else
+        template <typename T>
+        inline T *uninitialized_relocate( T *first, T *last, T *dest ) {
+            return std::uninitialized_copy( first, last, dest );
+        }
+#endif // DATA_ADAPTER_CXX11
+
+        //Zeros n bytes in a way the compiler can't drop as a dead store
+        inline void secure_zero( void *p, size_t n ) {
+            volatile unsigned char *b = static_cast<volatile unsigned char *>( p );
+
+            while ( n-- != 0 ) {
+                *b++ = 0;
+            }
+        }
+    }
+}
+
+#endif // DATA_ADAPTER_DETAIL_STORAGE_HPP_INCLUDED
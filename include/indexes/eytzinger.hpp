@@ -0,0 +1,270 @@
+#ifndef DATA_ADAPTER_EYTZINGER_HPP_INCLUDED
+#define DATA_ADAPTER_EYTZINGER_HPP_INCLUDED
+
+#include <cstddef>
+#include <iterator>
+#include <vector>
+
+#include "../data_adapter.hpp"
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#   include <intrin.h>
+#   include <xmmintrin.h>
+#endif
+
+/**
+ *              Notes on the implementation of this:
+ *
+ *      This is a read only search index over a sorted sequence, for lookup tables that are built once and
+ * searched many times. A binary search over the sorted elements themselves jumps around the whole array,
+ * so for large N every probe past the first few is a cache miss, and which half comes next is a coin
+ * flip the branch predictor always loses half of.
+ *
+ *      Here the keys are copied into Eytzinger order instead: the implicit binary search tree stored in
+ * breadth first order, like a binary heap, where the children of k are 2k and 2k + 1. The search walks
+ * down from the root with k = 2k + ( key < x ), which has no branch to mispredict. The first few levels
+ * are shared by every search and stay in cache, and since the 16 great great grandchildren of k are next to
+ * each other at 16k (for 4 byte keys), the cache line four levels down is prefetched while the levels
+ * in between are searched, so the misses overlap instead of adding up.
+ *
+ *      The walk always goes all the way down, and the lower bound is the last node where it went left,
+ * found by shifting off the trailing ones of k. Where that node's key was in the original sequence
+ * follows from k and the shape of the tree with a few shifts, so lookups answer with positions without
+ * another array to miss in: A.begin() + index.find( x ) for an index built from A, and size() (end())
+ * for nothing found.
+ *
+ *      The keys are copies, so the index doesn't change with the original. Anything that changes the
+ * original (sorted_insert, erase, ...) needs a new build().
+ */
+
+#if defined(__GNUC__) || defined(__clang__)
+#   define DATA_ADAPTER_PREFETCH(p) __builtin_prefetch( p )
+#elif defined(_MSC_VER) && ( defined(_M_X64) || defined(_M_IX86) )
+#   define DATA_ADAPTER_PREFETCH(p) _mm_prefetch( static_cast<const char *>( p ), _MM_HINT_T0 )
+#else
+#   define DATA_ADAPTER_PREFETCH(p)
+#endif
+
+namespace da {
+    namespace detail {
+
+        //Number of trailing 1 bits of k
+        inline unsigned trailing_ones( size_t k ) {
+#if defined(__GNUC__) || defined(__clang__)
+            if ( sizeof( size_t ) <= sizeof( unsigned long ) ) {
+                return static_cast<unsigned>( __builtin_ctzl( ~static_cast<unsigned long>( k ) ) );
+            }
+#elif defined(_MSC_VER) && defined(_M_X64)
+            unsigned long i;
+            _BitScanForward64( &i, ~k );
+            return static_cast<unsigned>( i );
+#elif defined(_MSC_VER)
+            unsigned long i;
+            _BitScanForward( &i, ~k );
+            return static_cast<unsigned>( i );
+#endif
+#if !defined(_MSC_VER) || defined(__clang__)
+            unsigned n = 0;
+
+            while ( ( k & 1 ) != 0 ) {
+                k >>= 1;
+                ++n;
+            }
+
+            return n;
+#endif
+        }
+
+        //Index of the highest 1 bit of k, which can't be 0
+        inline unsigned log2_floor( size_t k ) {
+#if defined(__GNUC__) || defined(__clang__)
+            if ( sizeof( size_t ) <= sizeof( unsigned long ) ) {
+                return static_cast<unsigned>( sizeof( unsigned long ) * 8 - 1 - __builtin_clzl( static_cast<unsigned long>( k ) ) );
+            }
+#elif defined(_MSC_VER) && defined(_M_X64)
+            unsigned long i;
+            _BitScanReverse64( &i, k );
+            return static_cast<unsigned>( i );
+#elif defined(_MSC_VER)
+            unsigned long i;
+            _BitScanReverse( &i, k );
+            return static_cast<unsigned>( i );
+#endif
+#if !defined(_MSC_VER) || defined(__clang__)
+            unsigned n = 0;
+
+            while ( ( k >>= 1 ) != 0 ) {
+                ++n;
+            }
+
+            return n;
+#endif
+        }
+    }
+
+    template <typename T>
+    class eytzinger_index {
+        public:
+            typedef T           key_type;
+            typedef size_t      size_type;
+
+        private:
+            //The cache line the search prefetches, and how many keys fit in it
+            static const size_type line_bytes = 64;
+            static const size_type line_keys = sizeof( T ) < line_bytes ? line_bytes / sizeof( T ) : 1;
+
+            /*
+                keys[base + k] is node k, for k in [1, n]. base is picked so that node line_keys is at the start
+                of a cache line, which puts every group of siblings the search prefetches in one line.
+            */
+            std::vector<key_type> keys;
+            size_type base;
+            size_type n;
+
+            //Depth of the last level of the tree, and how many nodes are on it
+            size_type height;
+            size_type last_level;
+
+            //Fills the subtree under k in order, taking keys from it
+            template <typename _InputIterator>
+            void fill( size_type k, _InputIterator &it ) {
+                if ( k <= this->n ) {
+                    this->fill( 2 * k, it );
+
+                    this->keys[this->base + k] = *it;
+                    ++it;
+
+                    this->fill( 2 * k + 1, it );
+                }
+            }
+
+            /*
+                Position of node k's key in the sorted order. In a perfect tree of the same height, node k on
+                level d would be at p below, and the only nodes missing from this one are at the right end
+                of the last level, at every other position from 2 * last_level on, so p just loses those before it.
+            */
+            inline size_type position( size_type k ) const {
+                size_type d = da::detail::log2_floor( k );
+                size_type p = ( ( 2 * ( k - ( static_cast<size_type>( 1 ) << d ) ) + 1 ) << ( this->height - d ) ) - 1;
+
+                return p + 1 > 2 * this->last_level ? p - ( p + 1 - 2 * this->last_level ) / 2 : p;
+            }
+
+            inline const key_type *nodes() const {
+                return this->n != 0 ? &this->keys[this->base] : NULL;
+            }
+
+            //Node of the first key that isn't less than x, or 0 if there is none
+            size_type lower_node( const key_type &x ) const {
+                const key_type *b = this->nodes();
+                size_type k = 1;
+
+                while ( k <= this->n ) {
+                    //Through an integer, since the node 4 levels down is usually past the end near the bottom
+                    DATA_ADAPTER_PREFETCH( reinterpret_cast<const void *>( reinterpret_cast<size_t>( b ) + k * line_keys * sizeof( T ) ) );
+
+                    k = 2 * k + ( b[k] < x ? 1 : 0 );
+                }
+
+                return k >> ( da::detail::trailing_ones( k ) + 1 );
+            }
+
+            //Node of the first key greater than x, or 0 if there is none
+            size_type upper_node( const key_type &x ) const {
+                const key_type *b = this->nodes();
+                size_type k = 1;
+
+                while ( k <= this->n ) {
+                    DATA_ADAPTER_PREFETCH( reinterpret_cast<const void *>( reinterpret_cast<size_t>( b ) + k * line_keys * sizeof( T ) ) );
+
+                    k = 2 * k + ( x < b[k] ? 0 : 1 );
+                }
+
+                return k >> ( da::detail::trailing_ones( k ) + 1 );
+            }
+
+        public:
+            eytzinger_index() : base( 0 ), n( 0 ), height( 0 ), last_level( 0 ) {}
+
+            //The range has to be sorted, like for std::lower_bound
+            template <typename _ForwardIterator>
+            eytzinger_index( _ForwardIterator first, _ForwardIterator last ) : base( 0 ), n( 0 ), height( 0 ), last_level( 0 ) {
+                this->build( first, last );
+            }
+
+            //Any sorted adapter, like a DataAdapter<T[N]> after sort()
+            template <typename _Adapter>
+            explicit eytzinger_index( const _Adapter &sorted ) : base( 0 ), n( 0 ), height( 0 ), last_level( 0 ) {
+                this->build( sorted.begin(), sorted.end() );
+            }
+
+            template <typename _ForwardIterator>
+            void build( _ForwardIterator first, _ForwardIterator last ) {
+                this->keys.clear();
+
+                this->base = 0;
+                this->n = static_cast<size_type>( std::distance( first, last ) );
+
+                if ( this->n == 0 ) {
+                    return;
+                }
+
+                this->height = da::detail::log2_floor( this->n );
+                this->last_level = this->n - ( ( static_cast<size_type>( 1 ) << this->height ) - 1 );
+
+                //Room for the nodes, the unused node 0, and moving them all up to line_keys - 1 slots for alignment
+                this->keys.assign( this->n + line_keys, *first );
+
+                size_t at = reinterpret_cast<size_t>( &this->keys[0] ) + line_keys * sizeof( T );
+                size_t misaligned = at % line_bytes;
+
+                if ( misaligned != 0 && ( line_bytes - misaligned ) % sizeof( T ) == 0 ) {
+                    this->base = ( line_bytes - misaligned ) / sizeof( T );
+                }
+
+                this->fill( 1, first );
+            }
+
+            template <typename _Adapter>
+            inline void build( const _Adapter &sorted ) {
+                this->build( sorted.begin(), sorted.end() );
+            }
+
+            inline size_type size() const {
+                return this->n;
+            }
+
+            inline bool empty() const {
+                return this->n == 0;
+            }
+
+            //Position of the first key that isn't less than x, or size()
+            inline size_type lower_bound( const key_type &x ) const {
+                size_type k = this->lower_node( x );
+
+                return k != 0 ? this->position( k ) : this->n;
+            }
+
+            //Position of the first key greater than x, or size()
+            inline size_type upper_bound( const key_type &x ) const {
+                size_type k = this->upper_node( x );
+
+                return k != 0 ? this->position( k ) : this->n;
+            }
+
+            //Position of the first key equal to x, or size()
+            inline size_type find( const key_type &x ) const {
+                size_type k = this->lower_node( x );
+
+                return k != 0 && !( x < this->nodes()[k] ) ? this->position( k ) : this->n;
+            }
+
+            inline bool contains( const key_type &x ) const {
+                size_type k = this->lower_node( x );
+
+                return k != 0 && !( x < this->nodes()[k] );
+            }
+    };
+}
+
+#endif // DATA_ADAPTER_EYTZINGER_HPP_INCLUDED
@@ -0,0 +1,364 @@
+#ifndef DATA_ADAPTER_SNAPSHOT_HPP_INCLUDED
+#define DATA_ADAPTER_SNAPSHOT_HPP_INCLUDED
+
+#include "../adapters/array.hpp"
+
+#if !DATA_ADAPTER_CXX11
+#error "DataAdapter snapshots require C++11"
+#endif // DATA_ADAPTER_CXX11
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+
+#if defined(__unix__) || defined(__APPLE__)
+#   include <fcntl.h>
+#   include <sys/mman.h>
+#   include <sys/stat.h>
+#   include <unistd.h>
+#   define DATA_ADAPTER_HAS_MMAP 1
+#else
+#   define DATA_ADAPTER_HAS_MMAP 0
+#endif
+
+/**
+ *              Notes on the implementation of this:
+ *
+ *      A snapshot is the raw bytes of a DataAdapter<T[N]>'s elements behind a 64 byte header, so it can only
+ * hold trivially copyable elements. The header says what the file is (the magic and format version), what it
+ * holds (the element size, the length and the capacity of the adapter it was saved from), in which byte order,
+ * and has a checksum of the elements. Since the elements are 64 bytes into the file, they are aligned for any
+ * T once the file is mapped, which is always at the start of a page.
+ *
+ *      da::save writes the header and then all the elements with a single write, to a temporary file next to
+ * the destination, which is renamed over it once it is complete. So anybody opening the file, or who has it
+ * mapped, sees either the old snapshot or the new one, never half of one.
+ *
+ *      da::load reads a snapshot back into an adapter, checking the header and the checksum, and throws a
+ * da::snapshot_error if either doesn't match, or std::out_of_range if there are more elements than fit.
+ * The checksum is skipped if the header says it is stale, which only files of mapped adapters can be.
+ *
+ *      da::load_mapped<T> maps the file read only instead, and returns a da::mapped_snapshot<T> with the
+ * elements in place, without copying or parsing anything, so opening a snapshot of any size takes about as
+ * long as opening the file. Pages are only read in from the page cache or the disk as they are touched, and
+ * processes mapping the same file share them. It only checks the header, since the checksum would read
+ * every page, but verify() does that on request. It is only there with mmap, on Unix like systems.
+ *
+ *      The byte order is only checked, not converted, since converting would mean copying. A snapshot from a
+ * machine with the other byte order throws, as does one from a different element size. The element type
+ * itself is not recorded, so loading a snapshot as the wrong type of the same size is up to the caller.
+ */
+
+namespace da {
+
+    class snapshot_error : public std::runtime_error {
+        public:
+            explicit snapshot_error( const std::string &what ) : std::runtime_error( what ) {}
+    };
+
+    struct snapshot_header {
+        char            magic[8];
+        std::uint32_t   version;
+        std::uint32_t   byte_order;
+        std::uint32_t   element_size;
+        std::uint32_t   header_size;
+        std::uint64_t   length;
+        std::uint64_t   capacity;
+        std::uint64_t   checksum;
+        std::uint32_t   flags;
+        char            reserved[12];
+
+        static const std::uint32_t current_version = 1;
+
+        //In flags, when the elements changed after the checksum was taken, see adapters/mapped.hpp
+        static const std::uint32_t stale_checksum = 1;
+
+        //Written as is, so it reads back as something else on a machine with the other byte order
+        static const std::uint32_t native_byte_order = 0x01020304;
+    };
+
+    static_assert( sizeof( snapshot_header ) == 64, "da::snapshot_header must be 64 bytes" );
+
+    namespace detail {
+
+        static const char snapshot_magic[8] = { 'D', 'A', 'S', 'N', 'A', 'P', '\r', '\n' };
+
+        //A 64 bit checksum of n bytes, eight at a time with a multiply and a rotate each
+        inline std::uint64_t checksum( const void *p, size_t n ) {
+            const unsigned char *bytes = static_cast<const unsigned char *>( p );
+            std::uint64_t h = 0x9E3779B97F4A7C15ULL ^ n;
+            std::uint64_t w;
+
+            for ( ; n >= 8; n -= 8, bytes += 8 ) {
+                std::memcpy( &w, bytes, 8 );
+
+                h ^= w * 0x87C37B91114253D5ULL;
+                h = ( ( h << 31 ) | ( h >> 33 ) ) * 0x4CF5AD432745937FULL;
+            }
+
+            if ( n != 0 ) {
+                w = 0;
+                std::memcpy( &w, bytes, n );
+
+                h ^= w * 0x87C37B91114253D5ULL;
+                h = ( ( h << 31 ) | ( h >> 33 ) ) * 0x4CF5AD432745937FULL;
+            }
+
+            h ^= h >> 29;
+
+            return h;
+        }
+
+        //Checks everything but the checksum, for a file of file_size bytes, and throws what is wrong for op
+        template <typename T>
+        void check_snapshot_header( const snapshot_header &h, std::uint64_t file_size, const char *op ) {
+            std::string where = std::string( "DataAdapter::" ) + op + ": ";
+
+            if ( file_size < sizeof( snapshot_header ) || std::memcmp( h.magic, snapshot_magic, sizeof( snapshot_magic ) ) != 0 ) {
+                throw snapshot_error( where + "Not a snapshot" );
+            }
+
+            if ( h.byte_order != snapshot_header::native_byte_order ) {
+                throw snapshot_error( where + "Wrong byte order" );
+            }
+
+            if ( h.version != snapshot_header::current_version || h.header_size < sizeof( snapshot_header ) ) {
+                throw snapshot_error( where + "Unsupported version" );
+            }
+
+            if ( h.element_size != sizeof( T ) ) {
+                throw snapshot_error( where + "Wrong element size" );
+            }
+
+            //The elements start header_size bytes into a page aligned mapping, so that has to keep them aligned
+            if ( h.header_size % alignof( T ) != 0 ) {
+                throw snapshot_error( where + "Misaligned elements" );
+            }
+
+            if ( h.header_size > file_size || h.length > ( file_size - h.header_size ) / sizeof( T ) ) {
+                throw snapshot_error( where + "Truncated" );
+            }
+        }
+    }
+
+    //Writes a snapshot of a to path, replacing whatever was there once it is complete
+    template <typename T, size_t N>
+    void save( const DataAdapter<T[N]> &a, const char *path ) {
+        static_assert( std::is_trivially_copyable<T>::value, "DataAdapter snapshots need trivially copyable elements" );
+
+        snapshot_header h;
+
+        std::memset( &h, 0, sizeof( h ) );
+        std::memcpy( h.magic, da::detail::snapshot_magic, sizeof( h.magic ) );
+
+        h.version = snapshot_header::current_version;
+        h.byte_order = snapshot_header::native_byte_order;
+        h.element_size = sizeof( T );
+        h.header_size = sizeof( snapshot_header );
+        h.length = a.length();
+        h.capacity = N;
+        h.checksum = da::detail::checksum( a.data(), a.length() * sizeof( T ) );
+
+        std::string tmp = std::string( path ) + ".tmp";
+        std::FILE *f = std::fopen( tmp.c_str(), "wb" );
+
+        if ( f == NULL ) {
+            throw snapshot_error( "DataAdapter::save: Can't open " + tmp );
+        }
+
+        bool ok = std::fwrite( &h, sizeof( h ), 1, f ) == 1
+                  && std::fwrite( a.data(), sizeof( T ), a.length(), f ) == a.length();
+
+        ok = std::fclose( f ) == 0 && ok;
+
+        if ( !ok || std::rename( tmp.c_str(), path ) != 0 ) {
+            std::remove( tmp.c_str() );
+            throw snapshot_error( std::string( "DataAdapter::save: Can't write " ) + path );
+        }
+    }
+
+    /*
+        Replaces the contents of a with the snapshot at path, read straight into its storage. A bad header or
+        too many elements leave a as it was, a failed read or a checksum mismatch leave it empty.
+    */
+    template <typename T, size_t N>
+    void load( DataAdapter<T[N]> &a, const char *path ) {
+        static_assert( std::is_trivially_copyable<T>::value, "DataAdapter snapshots need trivially copyable elements" );
+
+        std::FILE *f = std::fopen( path, "rb" );
+
+        if ( f == NULL ) {
+            throw snapshot_error( std::string( "DataAdapter::load: Can't open " ) + path );
+        }
+
+        snapshot_header h;
+        std::uint64_t file_size = 0;
+
+        //The size, to tell a truncated file from a short read
+        if ( std::fseek( f, 0, SEEK_END ) == 0 ) {
+            long end = std::ftell( f );
+            file_size = end > 0 ? static_cast<std::uint64_t>( end ) : 0;
+        }
+
+        if ( std::fseek( f, 0, SEEK_SET ) != 0 || std::fread( &h, sizeof( h ), 1, f ) != 1 ) {
+            std::memset( &h, 0, sizeof( h ) );
+        }
+
+        try {
+            da::detail::check_snapshot_header<T>( h, file_size, "load" );
+
+            if ( h.length > N ) {
+                throw std::out_of_range( "DataAdapter::load: Out of Range" );
+            }
+
+            size_t n = static_cast<size_t>( h.length );
+
+            //The elements are only counted once the checksum matches
+            a.clear();
+
+            if ( std::fseek( f, static_cast<long>( h.header_size ), SEEK_SET ) != 0 || std::fread( a.data(), sizeof( T ), n, f ) != n ) {
+                throw snapshot_error( std::string( "DataAdapter::load: Can't read " ) + path );
+            }
+
+            if ( ( h.flags & snapshot_header::stale_checksum ) == 0 && da::detail::checksum( a.data(), n * sizeof( T ) ) != h.checksum ) {
+                throw snapshot_error( "DataAdapter::load: Checksum mismatch" );
+            }
+
+            a.used_length = n;
+
+        } catch ( ... ) {
+            std::fclose( f );
+            throw;
+        }
+
+        std::fclose( f );
+    }
+
+#if DATA_ADAPTER_HAS_MMAP
+    /*
+        The elements of a snapshot file, mapped read only where they are. It can be moved but not copied,
+        and unmaps the file when it goes away, which ends the lifetime of every pointer into it.
+    */
+    template <typename T>
+    class mapped_snapshot {
+        public:
+            typedef T               element_type;
+            typedef size_t          size_type;
+            typedef const T        *const_iterator;
+
+        private:
+            void *base;
+            size_t bytes;
+            snapshot_header h;
+
+            template <typename U>
+            friend mapped_snapshot<U> load_mapped( const char *path );
+
+            mapped_snapshot( void *b, size_t n ) : base( b ), bytes( n ) {
+                std::memcpy( &this->h, b, sizeof( this->h ) );
+            }
+
+        public:
+            mapped_snapshot( mapped_snapshot &&m ) : base( m.base ), bytes( m.bytes ), h( m.h ) {
+                m.base = NULL;
+            }
+
+            mapped_snapshot( const mapped_snapshot & ) = delete;
+            mapped_snapshot &operator=( const mapped_snapshot & ) = delete;
+
+            ~mapped_snapshot() {
+                if ( this->base != NULL ) {
+                    ::munmap( this->base, this->bytes );
+                }
+            }
+
+            inline const element_type *data() const {
+                return reinterpret_cast<const element_type *>( static_cast<const char *>( this->base ) + this->h.header_size );
+            }
+
+            inline size_type length() const {
+                return static_cast<size_type>( this->h.length );
+            }
+
+            inline bool empty() const {
+                return this->h.length == 0;
+            }
+
+            //Of the adapter it was saved from
+            inline size_type capacity() const {
+                return static_cast<size_type>( this->h.capacity );
+            }
+
+            inline const_iterator begin() const {
+                return this->data();
+            }
+
+            inline const_iterator end() const {
+                return this->data() + this->length();
+            }
+
+            inline const element_type &operator[]( size_type i ) const {
+                return this->data()[i];
+            }
+
+            const element_type &at( size_type i ) const {
+                if ( i >= this->length() ) {
+                    throw std::out_of_range( "DataAdapter::at: Out of Range" );
+                }
+
+                return this->data()[i];
+            }
+
+            inline const snapshot_header &header() const {
+                return this->h;
+            }
+
+            //Whether the elements match the checksum, which reads every one of them. Never with a stale one
+            bool verify() const {
+                return ( this->h.flags & snapshot_header::stale_checksum ) == 0
+                       && da::detail::checksum( this->data(), this->length() * sizeof( T ) ) == this->h.checksum;
+            }
+    };
+
+    //Maps the snapshot at path, checking only its header
+    template <typename T>
+    mapped_snapshot<T> load_mapped( const char *path ) {
+        static_assert( std::is_trivially_copyable<T>::value, "DataAdapter snapshots need trivially copyable elements" );
+
+        int fd = ::open( path, O_RDONLY );
+
+        if ( fd < 0 ) {
+            throw snapshot_error( std::string( "DataAdapter::load_mapped: Can't open " ) + path );
+        }
+
+        struct stat st;
+
+        if ( ::fstat( fd, &st ) != 0 || st.st_size < static_cast<off_t>( sizeof( snapshot_header ) ) ) {
+            ::close( fd );
+            throw snapshot_error( "DataAdapter::load_mapped: Not a snapshot" );
+        }
+
+        size_t bytes = static_cast<size_t>( st.st_size );
+        void *base = ::mmap( NULL, bytes, PROT_READ, MAP_SHARED, fd, 0 );
+
+        //The mapping keeps the file open by itself
+        ::close( fd );
+
+        if ( base == MAP_FAILED ) {
+            throw snapshot_error( std::string( "DataAdapter::load_mapped: Can't map " ) + path );
+        }
+
+        mapped_snapshot<T> m( base, bytes );
+
+        da::detail::check_snapshot_header<T>( m.header(), bytes, "load_mapped" );
+
+        return m;
+    }
+#endif // DATA_ADAPTER_HAS_MMAP
+}
+
+#endif // DATA_ADAPTER_SNAPSHOT_HPP_INCLUDED
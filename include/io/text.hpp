@@ -0,0 +1,488 @@
+#ifndef DATA_ADAPTER_TEXT_HPP_INCLUDED
+#define DATA_ADAPTER_TEXT_HPP_INCLUDED
+
+#include "../data_adapter.hpp"
+
+#if !DATA_ADAPTER_CXX11
+#error "DataAdapter text formatting requires C++11"
+#endif // DATA_ADAPTER_CXX11
+
+#include <cerrno>
+#include <cmath>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iterator>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#if __cplusplus >= 201703L && defined(__has_include)
+#   if __has_include(<charconv>)
+#       include <charconv>
+#   endif
+#endif
+
+#if defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L
+#   define DATA_ADAPTER_FLOAT_CHARCONV 1
+#else
+#   define DATA_ADAPTER_FLOAT_CHARCONV 0
+#endif
+
+#if defined(__unix__) || defined(__APPLE__)
+#   include <unistd.h>
+#   define DATA_ADAPTER_HAS_FD_IO 1
+#else
+#   define DATA_ADAPTER_HAS_FD_IO 0
+#endif
+
+/**
+ *              Notes on the implementation of this:
+ *
+ *      Bulk text conversion for adapters of arithmetic elements, for when operator<< element by element
+ * through a stream is too slow. There are no streams, locales or format flags here. Integers are written
+ * two digits at a time from a table and read back with a plain loop, and floating point numbers go through
+ * std::to_chars and std::from_chars where the library has them for floating point, which gives the shortest
+ * text that reads back as the same number. Elsewhere they are written with snprintf and as many digits as it
+ * takes to read them back exactly (max_digits10), and read with strtod.
+ *
+ *      da::format_to fills a caller's buffer with as many elements as are sure to fit, and says where to go on
+ * from, so a buffer of any size from da::text_max_chars<T> up can take an adapter of any length a chunk at
+ * a time. Elements are separated by a separator string, a space by default, with none at the end.
+ *
+ *      da::parse_from reads numbers separated by any run of separator characters (whitespace and commas by
+ * default) and appends them to an adapter. It stops at the end of the text, and given incomplete text, leaves
+ * a number that runs up to the end for the next chunk, since the rest of it may be there. Anything that
+ * isn't a number throws std::invalid_argument, and numbers that don't fit in the element type throw
+ * std::out_of_range, with the elements before them already appended.
+ *
+ *      da::write_text and da::read_text do the same to and from a file descriptor, in chunks of a fixed size.
+ */
+
+namespace da {
+
+    //The most characters da::format_to writes for one element of type T, without the separator
+    template <typename T>
+    struct text_max_chars {
+        static const size_t value = std::is_floating_point<T>::value ? 48 : std::numeric_limits<T>::digits10 + 3;
+    };
+
+    namespace detail {
+
+        static const char digit_pairs[201] =
+            "00010203040506070809"
+            "10111213141516171819"
+            "20212223242526272829"
+            "30313233343536373839"
+            "40414243444546474849"
+            "50515253545556575859"
+            "60616263646566676869"
+            "70717273747576777879"
+            "80818283848586878889"
+            "90919293949596979899";
+
+        template <typename U>
+        inline unsigned count_digits( U v ) {
+            unsigned n = 1;
+
+            for ( ;; ) {
+                if ( v < 10 ) return n;
+                if ( v < 100 ) return n + 1;
+                if ( v < 1000 ) return n + 2;
+                if ( v < 10000 ) return n + 3;
+
+                v /= 10000;
+                n += 4;
+            }
+        }
+
+        //Writes v at out, back to front since the length is known, and returns the end of it
+        template <typename U>
+        inline char *format_unsigned( char *out, U v ) {
+            char *end = out + count_digits( v );
+            char *p = end;
+
+            while ( v >= 100 ) {
+                unsigned d = static_cast<unsigned>( v % 100 ) * 2;
+                v /= 100;
+
+                *--p = digit_pairs[d + 1];
+                *--p = digit_pairs[d];
+            }
+
+            if ( v >= 10 ) {
+                unsigned d = static_cast<unsigned>( v ) * 2;
+
+                *--p = digit_pairs[d + 1];
+                *--p = digit_pairs[d];
+
+            } else {
+                *--p = static_cast<char>( '0' + v );
+            }
+
+            return end;
+        }
+
+        //32 bit division is a lot cheaper, and most numbers fit
+        inline char *format_unsigned( char *out, unsigned long long v ) {
+            if ( v <= 0xffffffffULL ) {
+                return format_unsigned<unsigned>( out, static_cast<unsigned>( v ) );
+            }
+
+            return format_unsigned<unsigned long long>( out, v );
+        }
+
+        template <typename T>
+        inline char *format_number( char *out, T v, std::true_type /*integral*/ ) {
+            if ( std::is_signed<T>::value && v < 0 ) {
+                *out++ = '-';
+
+                //Negated as unsigned, which is fine for the most negative value too
+                return format_unsigned( out, 0ULL - static_cast<unsigned long long>( v ) );
+            }
+
+            return format_unsigned( out, static_cast<unsigned long long>( v ) );
+        }
+
+        template <typename T>
+        inline char *format_number( char *out, T v, std::false_type /*floating point*/ ) {
+#if DATA_ADAPTER_FLOAT_CHARCONV
+            return std::to_chars( out, out + text_max_chars<T>::value, v ).ptr;
+#else
+            int n = std::snprintf( out, text_max_chars<T>::value, "%.*Lg", std::numeric_limits<T>::max_digits10, static_cast<long double>( v ) );
+
+            return out + n;
+#endif
+        }
+
+        template <typename T>
+        inline char *format_number( char *out, T v ) {
+            return format_number( out, v, typename std::is_integral<T>::type() );
+        }
+
+        //bool is written as 0 or 1
+        inline char *format_number( char *out, bool v ) {
+            *out = v ? '1' : '0';
+            return out + 1;
+        }
+
+        /*
+            Reads the integer in [first, last), which is a whole token, into v. Returns false if it isn't an
+            integer, and throws std::out_of_range if it doesn't fit.
+        */
+        template <typename T>
+        bool parse_number( const char *first, const char *last, T &v, std::true_type /*integral*/ ) {
+            bool negative = false;
+
+            if ( first != last && ( *first == '-' || *first == '+' ) ) {
+                negative = *first == '-';
+                ++first;
+            }
+
+            if ( first == last ) {
+                return false;
+            }
+
+            typedef typename std::make_unsigned<T>::type U;
+
+            //How far the magnitude can go in that direction
+            U limit = negative ? ( std::is_signed<T>::value ? static_cast<U>( static_cast<U>( std::numeric_limits<T>::max() ) + 1 ) : 0 )
+                               : static_cast<U>( std::numeric_limits<T>::max() );
+            U limit_tens = static_cast<U>( limit / 10 );
+            unsigned limit_units = static_cast<unsigned>( limit % 10 );
+            U m = 0;
+
+            for ( ; first != last; ++first ) {
+                unsigned d = static_cast<unsigned>( *first - '0' );
+
+                if ( d > 9 ) {
+                    return false;
+                }
+
+                if ( m > limit_tens || ( m == limit_tens && d > limit_units ) ) {
+                    throw std::out_of_range( "DataAdapter::parse_from: Out of Range" );
+                }
+
+                m = static_cast<U>( m * 10 + d );
+            }
+
+            v = negative ? static_cast<T>( 0 - m ) : static_cast<T>( m );
+
+            return true;
+        }
+
+        //Floating point numbers through strtold, which needs a terminated string
+        template <typename T>
+        bool parse_float( const char *first, const char *last, T &v ) {
+            char tmp[64];
+            size_t n = static_cast<size_t>( last - first );
+
+            if ( n == 0 || n >= sizeof( tmp ) ) {
+                return false;
+            }
+
+            std::memcpy( tmp, first, n );
+            tmp[n] = '\0';
+
+            char *end;
+            long double x = std::strtold( tmp, &end );
+
+            if ( end != tmp + n ) {
+                return false;
+            }
+
+            //Infinities are numbers too, only finite ones that would round to one are out of range
+            long double max = std::numeric_limits<T>::max();
+            long double limit = max + ( max - std::nextafter( static_cast<T>( max ), static_cast<T>( 0 ) ) ) / 2;
+
+            if ( std::isfinite( x ) && std::fabs( x ) >= limit ) {
+                throw std::out_of_range( "DataAdapter::parse_from: Out of Range" );
+            }
+
+            v = static_cast<T>( x );
+
+            return true;
+        }
+
+        template <typename T>
+        bool parse_number( const char *first, const char *last, T &v, std::false_type /*floating point*/ ) {
+#if DATA_ADAPTER_FLOAT_CHARCONV
+            //from_chars doesn't take a plus sign, which format_to never writes, but other programs might.
+            //A minus sign after it stays, for from_chars to turn down
+            if ( last - first > 1 && *first == '+' && first[1] != '-' ) {
+                ++first;
+            }
+
+            std::from_chars_result r = std::from_chars( first, last, v );
+
+            /*
+                Some versions of libstdc++ say subnormal numbers are out of range too, though they are
+                written like any other, so strtold decides
+            */
+            if ( r.ec == std::errc::result_out_of_range ) {
+                return parse_float( first, last, v );
+            }
+
+            return r.ec == std::errc() && r.ptr == last;
+#else
+            return parse_float( first, last, v );
+#endif
+        }
+
+        template <typename T>
+        inline bool parse_number( const char *first, const char *last, T &v ) {
+            return parse_number( first, last, v, typename std::is_integral<T>::type() );
+        }
+
+        inline bool parse_number( const char *first, const char *last, bool &v ) {
+            if ( last - first == 1 && ( *first == '0' || *first == '1' ) ) {
+                v = *first == '1';
+                return true;
+            }
+
+            return false;
+        }
+
+        //A table of which characters separate numbers
+        struct separator_set {
+            bool is[256];
+
+            explicit separator_set( const char *separators ) {
+                std::memset( this->is, 0, sizeof( this->is ) );
+
+                for ( ; *separators != '\0'; ++separators ) {
+                    this->is[static_cast<unsigned char>( *separators )] = true;
+                }
+            }
+
+            inline bool operator()( char c ) const {
+                return this->is[static_cast<unsigned char>( c )];
+            }
+        };
+    }
+
+    /*
+        Writes the elements of a from index from on into [buffer, buffer + size), as many as are sure to fit,
+        each but the first one of all preceded by separator. Moves from past them, and returns how many
+        characters that was. The buffer has to be big enough for at least one element and a separator.
+    */
+    template <typename _Adapter>
+    size_t format_to( const _Adapter &a, char *buffer, size_t size, size_t &from, const char *separator = " " ) {
+        typedef typename _Adapter::element_type T;
+
+        static_assert( std::is_arithmetic<T>::value, "da::format_to needs arithmetic elements" );
+
+        size_t sep_len = std::strlen( separator );
+        size_t need = text_max_chars<T>::value + sep_len;
+
+        if ( size < need ) {
+            throw std::out_of_range( "DataAdapter::format_to: Out of Range" );
+        }
+
+        size_t len = a.length();
+
+        if ( from >= len ) {
+            return 0;
+        }
+
+        typename _Adapter::const_iterator it = a.cbegin();
+        std::advance( it, from );
+
+        char *out = buffer;
+        char *stop = buffer + size - need;
+        size_t i = from;
+
+        for ( ; i < len && out <= stop; ++i, ++it ) {
+            if ( i != 0 ) {
+                //Separators are short, a call to memcpy would cost more than the copy
+                for ( size_t c = 0; c < sep_len; ++c ) {
+                    *out++ = separator[c];
+                }
+            }
+
+            out = da::detail::format_number( out, static_cast<T>( *it ) );
+        }
+
+        from = i;
+
+        return static_cast<size_t>( out - buffer );
+    }
+
+    //The whole adapter as one string
+    template <typename _Adapter>
+    std::string format( const _Adapter &a, const char *separator = " " ) {
+        typedef typename _Adapter::element_type T;
+
+        size_t chunk = 64 * 1024 + text_max_chars<T>::value + std::strlen( separator );
+        std::string s;
+
+        //Formatted straight into the end of the string, a chunk at a time
+        for ( size_t from = 0; from < a.length(); ) {
+            size_t used = s.size();
+
+            s.resize( used + chunk );
+            s.resize( used + format_to( a, &s[used], chunk, from, separator ) );
+        }
+
+        return s;
+    }
+
+    /*
+        Appends the numbers in [first, last), separated by any of the characters in separators, to a, and
+        returns where it stopped. That is last, unless the text is not complete, in which case a number
+        that runs up to last is left there for the next chunk.
+    */
+    template <typename _Adapter>
+    const char *parse_from( _Adapter &a, const char *first, const char *last, const char *separators = " \t\r\n,", bool complete = true ) {
+        typedef typename _Adapter::element_type T;
+
+        static_assert( std::is_arithmetic<T>::value, "da::parse_from needs arithmetic elements" );
+
+        da::detail::separator_set is_separator( separators );
+
+        for ( ;; ) {
+            while ( first != last && is_separator( *first ) ) {
+                ++first;
+            }
+
+            const char *token = first;
+
+            while ( first != last && !is_separator( *first ) ) {
+                ++first;
+            }
+
+            if ( token == first || ( first == last && !complete ) ) {
+                return token;
+            }
+
+            T v;
+
+            if ( !da::detail::parse_number( token, first, v ) ) {
+                throw std::invalid_argument( "DataAdapter::parse_from: Not a number: " + std::string( token, first ) );
+            }
+
+            a.push_back( v );
+        }
+    }
+
+    template <typename _Adapter>
+    inline const char *parse_from( _Adapter &a, const std::string &s, const char *separators = " \t\r\n," ) {
+        return parse_from( a, s.data(), s.data() + s.size(), separators );
+    }
+
+#if DATA_ADAPTER_HAS_FD_IO
+    namespace detail {
+
+        //All n bytes, however many write calls that takes
+        inline void write_all( int fd, const char *p, size_t n ) {
+            while ( n != 0 ) {
+                ssize_t w = ::write( fd, p, n );
+
+                if ( w < 0 ) {
+                    if ( errno == EINTR ) {
+                        continue;
+                    }
+
+                    throw std::runtime_error( "DataAdapter::write_text: Can't write" );
+                }
+
+                p += w;
+                n -= static_cast<size_t>( w );
+            }
+        }
+    }
+
+    //Writes the whole adapter to fd as text, chunk_size characters at most at a time
+    template <typename _Adapter>
+    void write_text( const _Adapter &a, int fd, const char *separator = " ", size_t chunk_size = 64 * 1024 ) {
+        typedef typename _Adapter::element_type T;
+
+        size_t need = text_max_chars<T>::value + std::strlen( separator );
+        std::vector<char> buffer( chunk_size > need ? chunk_size : need );
+
+        for ( size_t from = 0; from < a.length(); ) {
+            da::detail::write_all( fd, &buffer[0], format_to( a, &buffer[0], buffer.size(), from, separator ) );
+        }
+    }
+
+    //Appends all the numbers from fd to a, reading chunk_size characters at a time
+    template <typename _Adapter>
+    void read_text( _Adapter &a, int fd, const char *separators = " \t\r\n,", size_t chunk_size = 64 * 1024 ) {
+        std::vector<char> buffer( chunk_size );
+        size_t kept = 0;
+
+        for ( ;; ) {
+            //A number can be longer than a chunk, if it is all zeros in front
+            if ( kept == buffer.size() ) {
+                buffer.resize( buffer.size() * 2 );
+            }
+
+            ssize_t r = ::read( fd, &buffer[kept], buffer.size() - kept );
+
+            if ( r < 0 ) {
+                if ( errno == EINTR ) {
+                    continue;
+                }
+
+                throw std::runtime_error( "DataAdapter::read_text: Can't read" );
+            }
+
+            const char *first = &buffer[0];
+            const char *last = first + kept + r;
+            const char *rest = parse_from( a, first, last, separators, r == 0 );
+
+            if ( r == 0 ) {
+                return;
+            }
+
+            kept = static_cast<size_t>( last - rest );
+            std::memmove( &buffer[0], rest, kept );
+        }
+    }
+#endif // DATA_ADAPTER_HAS_FD_IO
+}
+
+#endif // DATA_ADAPTER_TEXT_HPP_INCLUDED
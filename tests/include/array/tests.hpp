@@ -1,6 +1,14 @@
 #ifndef DATA_ADAPTER_ARRAY_TESTS_HPP_INCLUDED
 #define DATA_ADAPTER_ARRAY_TESTS_HPP_INCLUDED
 
+#include <algorithm>
+#include <iterator>
+#include <limits>
+#include <list>
+#include <sstream>
+#include <string>
+#include <vector>
+
 #include "fixtures.hpp"
 
 namespace DataAdapter_Tests {
@@ -86,6 +94,20 @@ namespace DataAdapter_Tests {
         ASSERT_EQ( A.cbegin(), A.begin() );
     }
 
+    TEST_F( DataAdapter_StaticArray_TestFixture, IteratorsContiguous ) {
+        A.assign( k, k + STATIC_TEST_ARRAY_SIZE );
+
+        //Iterators are plain pointers into data()
+        ASSERT_EQ( A.data(),                           A.begin().base() );
+        ASSERT_EQ( A.data() + A.length(),              A.end().base() );
+        ASSERT_EQ( &A[4],                              &*( A.begin() + 4 ) );
+        ASSERT_EQ( 4,                                  ( A.begin() + 4 ).offset() );
+
+        std::iterator_traits<DataAdapter_StaticArray_TestFixture::adapter_t::const_iterator>::pointer p = A.cbegin().base();
+
+        ASSERT_EQ( A.data(), p );
+    }
+
     TEST_F( DataAdapter_StaticArray_TestFixture, InsertionBasic ) {
         DataAdapter_StaticArray_TestFixture::adapter_t::iterator it;
 
@@ -235,6 +257,97 @@ namespace DataAdapter_Tests {
         }
     }
 
+    TEST_F( DataAdapter_StaticArray_TestFixture, InsertionRanges ) {
+        DataAdapter_StaticArray_TestFixture::adapter_t::iterator it;
+
+        {
+            SCOPED_TRACE( "bidirectional range" );
+
+            std::list<int> l( k, k + 4 );
+
+            A.push_back( 0x100 );
+            A.push_back( 0x200 );
+
+            it = A.insert( A.begin() + 1, l.begin(), l.end() );
+
+            int expected[] = {0x100, 0x1, 0x2, 0x3, 0x4, 0x200};
+
+            ASSERT_EQ( A.begin() + 1, it );
+            ASSERT_EQ( 6, A.length() );
+            ASSERT_TRUE( std::equal( A.begin(), A.end(), expected ) );
+        }
+
+        {
+            SCOPED_TRACE( "input range" );
+
+            std::istringstream in( "7 8 9" );
+
+            it = A.insert( A.begin() + 2, std::istream_iterator<int>( in ), std::istream_iterator<int>() );
+
+            int expected[] = {0x100, 0x1, 7, 8, 9, 0x2, 0x3, 0x4, 0x200};
+
+            ASSERT_EQ( A.begin() + 2, it );
+            ASSERT_EQ( 9, A.length() );
+            ASSERT_TRUE( std::equal( A.begin(), A.end(), expected ) );
+        }
+
+        {
+            SCOPED_TRACE( "too long ranges throw and change nothing" );
+
+            std::list<int> l( 2, 0 );
+            std::istringstream in( "1 2" );
+
+            ASSERT_THROW( A.insert( A.begin(), l.begin(), l.end() ), std::out_of_range );
+            ASSERT_THROW( A.insert( A.begin(), std::istream_iterator<int>( in ), std::istream_iterator<int>() ),
+                          std::out_of_range );
+
+            int expected[] = {0x100, 0x1, 7, 8, 9, 0x2, 0x3, 0x4, 0x200};
+
+            ASSERT_EQ( 9, A.length() );
+            ASSERT_TRUE( std::equal( A.begin(), A.end(), expected ) );
+        }
+
+        {
+            SCOPED_TRACE( "own elements" );
+
+            A.resize( 4 );
+
+            it = A.insert( A.begin(), A.begin() + 1, A.begin() + 4 );
+
+            int expected[] = {0x1, 7, 8, 0x100, 0x1, 7, 8};
+
+            ASSERT_EQ( A.begin(), it );
+            ASSERT_EQ( 7, A.length() );
+            ASSERT_TRUE( std::equal( A.begin(), A.end(), expected ) );
+        }
+
+        {
+            SCOPED_TRACE( "count and value" );
+
+            B.insert( B.begin(), 3, 5 );
+            B.append( k, k + 2 );
+
+            int expected[] = {5, 5, 5, 0x1, 0x2};
+
+            ASSERT_EQ( 5, B.length() );
+            ASSERT_TRUE( std::equal( B.begin(), B.end(), expected ) );
+
+            B.assign( 2, 7 );
+
+            ASSERT_EQ( 2, B.length() );
+            ASSERT_EQ( 7, B[0] );
+            ASSERT_EQ( 7, B[1] );
+
+            std::istringstream in( "4 5 6" );
+
+            B.assign( std::istream_iterator<int>( in ), std::istream_iterator<int>() );
+
+            ASSERT_EQ( 3, B.length() );
+            ASSERT_EQ( 4, B[0] );
+            ASSERT_EQ( 6, B[2] );
+        }
+    }
+
     TEST_F( DataAdapter_StaticArray_TestFixture, ManipulationBasic ) {
         typedef typename DataAdapter_StaticArray_TestFixture::adapter_t::element_type element;
 
@@ -266,6 +379,29 @@ namespace DataAdapter_Tests {
             ASSERT_EQ( 10,   A.length() );
             ASSERT_EQ( 0x5,  A.at( 5 ) );
         }
+
+        {
+            SCOPED_TRACE( "pop_front" );
+
+            element i = A.pop_front();
+
+            ASSERT_EQ( 0x10, i );
+            ASSERT_EQ( 9,    A.length() );
+            ASSERT_EQ( 0x1,  A.front() );
+            ASSERT_EQ( 0x9,  A.back() );
+        }
+
+        {
+            SCOPED_TRACE( "resize" );
+
+            A.resize( 2 );
+            A.resize( 4, 0x42 );
+
+            ASSERT_EQ( 4,    A.length() );
+            ASSERT_EQ( 0x2,  A[1] );
+            ASSERT_EQ( 0x42, A[2] );
+            ASSERT_EQ( 0x42, A[3] );
+        }
     }
 
     TEST_F( DataAdapter_StaticArray_TestFixture, ManipulationAdvanced ) {
@@ -319,6 +455,139 @@ namespace DataAdapter_Tests {
         }
     }
 
+    TEST_F( DataAdapter_StaticArray_TestFixture, ManipulationErasing ) {
+        DataAdapter_StaticArray_TestFixture::adapter_t::iterator it;
+
+        A.assign( k, k + STATIC_TEST_ARRAY_SIZE );
+
+        {
+            SCOPED_TRACE( "erase_if" );
+
+            ASSERT_EQ( 5, A.erase_if( []( int e ) {
+                return e % 2 == 0;
+            } ) );
+
+            int expected[] = {0x1, 0x3, 0x5, 0x7, 0x9};
+
+            ASSERT_EQ( 5, A.length() );
+            ASSERT_TRUE( std::equal( A.begin(), A.end(), expected ) );
+
+            ASSERT_EQ( 0, A.erase_if( []( int e ) {
+                return e > 0x100;
+            } ) );
+
+            ASSERT_EQ( 5, A.length() );
+        }
+
+        {
+            SCOPED_TRACE( "unordered_erase" );
+
+            it = A.unordered_erase( A.begin() + 1 );
+
+            int expected[] = {0x1, 0x9, 0x5, 0x7};
+
+            ASSERT_EQ( A.begin() + 1, it );
+            ASSERT_EQ( 4, A.length() );
+            ASSERT_TRUE( std::equal( A.begin(), A.end(), expected ) );
+
+            it = A.unordered_erase( A.end() - 1 );
+
+            ASSERT_EQ( A.end(), it );
+            ASSERT_EQ( 3, A.length() );
+            ASSERT_EQ( 0x5, A.back() );
+
+            ASSERT_THROW( A.unordered_erase( A.end() ), std::out_of_range );
+        }
+
+        {
+            SCOPED_TRACE( "erase_if all" );
+
+            ASSERT_EQ( 3, A.erase_if( []( int ) {
+                return true;
+            } ) );
+
+            ASSERT_TRUE( A.empty() );
+        }
+    }
+
+    TEST( DataAdapter_StaticArray_Move, NoCopies ) {
+        typedef DataAdapter<copy_counter[8]> adapter_t;
+
+        adapter_t A;
+
+        copy_counter::copies() = 0;
+
+        {
+            SCOPED_TRACE( "rvalue push and insert" );
+
+            A.push_back( copy_counter( 2 ) );
+            A.push_front( copy_counter( 0 ) );
+            A.insert( A.begin() + 1, copy_counter( 1 ) );
+            A.sorted_insert( copy_counter( 3 ) );
+
+            ASSERT_EQ( 4, A.length() );
+
+            for ( int i = 0; i < 4; ++i ) {
+                ASSERT_EQ( i, A[i].value );
+            }
+        }
+
+        {
+            SCOPED_TRACE( "emplace" );
+
+            A.emplace_back( 5 );
+            adapter_t::iterator it = A.emplace( A.begin() + 4, 4 );
+
+            ASSERT_EQ( A.begin() + 4, it );
+            ASSERT_EQ( 4, it->value );
+            ASSERT_EQ( 5, A.back().value );
+        }
+
+        {
+            SCOPED_TRACE( "pop and erase" );
+
+            ASSERT_EQ( 0, A.pop_front().value );
+            ASSERT_EQ( 5, A.pop_back().value );
+
+            A.erase( A.begin() + 1 );
+
+            ASSERT_EQ( 3, A.length() );
+            ASSERT_EQ( 1, A[0].value );
+            ASSERT_EQ( 3, A[1].value );
+            ASSERT_EQ( 4, A[2].value );
+        }
+
+        ASSERT_EQ( 0, copy_counter::copies() );
+
+        {
+            SCOPED_TRACE( "move construction" );
+
+            adapter_t B( std::move( A ) );
+
+            ASSERT_EQ( 0, copy_counter::copies() );
+            ASSERT_EQ( 3, B.length() );
+            ASSERT_EQ( 4, B.back().value );
+            ASSERT_TRUE( A.empty() );
+        }
+    }
+
+    TEST( DataAdapter_StaticArray_Move, SelfReference ) {
+        DataAdapter<std::string[4]> A;
+
+        A.push_back( "a" );
+        A.push_back( "b" );
+
+        //The argument is one of the elements being shifted
+        A.push_front( A.back() );
+        A.insert( A.begin() + 1, A.front() );
+
+        ASSERT_EQ( 4,   A.length() );
+        ASSERT_EQ( "b", A[0] );
+        ASSERT_EQ( "b", A[1] );
+        ASSERT_EQ( "a", A[2] );
+        ASSERT_EQ( "b", A[3] );
+    }
+
     TEST_F( DataAdapter_StaticArray_TestFixture, BinarySearch ) {
         DataAdapter_StaticArray_TestFixture::adapter_t::iterator it;
 
@@ -328,12 +597,12 @@ namespace DataAdapter_Tests {
             A.assign( k, k + STATIC_TEST_ARRAY_SIZE );
 
             ASSERT_EQ( A.length(), STATIC_TEST_ARRAY_SIZE );
-            ASSERT_TRUE( is_sorted( A.begin(), A.end() ) );
+            ASSERT_TRUE( DataAdapter_Tests::is_sorted( A.begin(), A.end() ) );
 
             A.resize( 5 );
 
             ASSERT_EQ( A.length(), 5 );
-            ASSERT_TRUE( is_sorted( A.begin(), A.end() ) );
+            ASSERT_TRUE( DataAdapter_Tests::is_sorted( A.begin(), A.end() ) );
         }
 
         {
@@ -352,10 +621,634 @@ namespace DataAdapter_Tests {
 
             ASSERT_EQ( 6, A.length() );
             ASSERT_EQ( A.begin() + 3, it );
-            ASSERT_TRUE( is_sorted( A.begin(), A.end() ) );
+            ASSERT_TRUE( DataAdapter_Tests::is_sorted( A.begin(), A.end() ) );
+        }
+
+    }
+
+    TEST_F( DataAdapter_StaticArray_TestFixture, SortedInsertBatch ) {
+        DataAdapter_StaticArray_TestFixture::adapter_t::iterator it;
+
+        {
+            SCOPED_TRACE( "single" );
+
+            A.sorted_insert( 0x5 );
+            A.sorted_insert( 0x1 );
+            it = A.sorted_insert( 0x3 );
+
+            ASSERT_EQ( A.begin() + 1, it );
+            ASSERT_EQ( 3, A.length() );
+            ASSERT_TRUE( DataAdapter_Tests::is_sorted( A.begin(), A.end() ) );
+        }
+
+        {
+            SCOPED_TRACE( "batch" );
+
+            const int batch[] = { 0x6, 0x0, 0x3, 0x9, 0x2 };
+
+            it = A.sorted_insert( batch, batch + 5 );
+
+            const int expected[] = { 0x0, 0x1, 0x2, 0x3, 0x3, 0x5, 0x6, 0x9 };
+
+            ASSERT_EQ( A.begin(), it );
+            ASSERT_EQ( 8, A.length() );
+            ASSERT_TRUE( std::equal( A.begin(), A.end(), expected ) );
+        }
+
+        {
+            SCOPED_TRACE( "batch past the end only" );
+
+            const int batch[] = { 0x11, 0x10 };
+
+            it = A.sorted_insert( batch, batch + 2 );
+
+            ASSERT_EQ( A.begin() + 8, it );
+            ASSERT_EQ( 0x10, A[8] );
+            ASSERT_EQ( 0x11, A[9] );
+        }
+
+        {
+            SCOPED_TRACE( "overflow and empty batches" );
+
+            const int batch[] = { 0x0 };
+
+            ASSERT_THROW( A.sorted_insert( batch, batch + 1 ), std::out_of_range );
+            ASSERT_EQ( 10, A.length() );
+            ASSERT_EQ( A.end(), A.sorted_insert( batch, batch ) );
+        }
+
+        {
+            SCOPED_TRACE( "generic version through the base" );
+
+            DataAdapter_StaticArray_TestFixture::adapter_t::_Base &base = B;
+
+            const int batch[] = { 0x3, 0x1, 0x2 };
+
+            B.sorted_insert( 0x2 );
+            it = base.sorted_insert( batch, batch + 3 );
+
+            ASSERT_EQ( B.begin(), it );
+            ASSERT_EQ( 4, B.length() );
+            ASSERT_TRUE( DataAdapter_Tests::is_sorted( B.begin(), B.end() ) );
+        }
+
+        {
+            SCOPED_TRACE( "against one by one" );
+
+            unsigned state = 0x1234567;
+
+            for ( int round = 0; round < 100; ++round ) {
+                A.clear();
+                B.clear();
+
+                int batch[STATIC_TEST_ARRAY_SIZE];
+                size_t pre = round % STATIC_TEST_ARRAY_SIZE;
+                size_t n = STATIC_TEST_ARRAY_SIZE - pre;
+
+                for ( size_t i = 0; i < STATIC_TEST_ARRAY_SIZE; ++i ) {
+                    state = state * 1103515245 + 12345;
+                    batch[i] = ( state >> 16 ) % 8;
+                }
+
+                for ( size_t i = 0; i < pre; ++i ) {
+                    A.sorted_insert( batch[i] );
+                    B.sorted_insert( batch[i] );
+                }
+
+                A.sorted_insert( batch + pre, batch + pre + n );
+
+                for ( size_t i = pre; i < STATIC_TEST_ARRAY_SIZE; ++i ) {
+                    B.sorted_insert( batch[i] );
+                }
+
+                ASSERT_EQ( B.length(), A.length() );
+                ASSERT_EQUAL_RANGE( DataAdapter_StaticArray_TestFixture::adapter_t::iterator, A.begin(), A.end(), B.begin() );
+            }
+        }
+    }
+
+    TEST_F( DataAdapter_StaticArray_TestFixture, Comparison ) {
+        ASSERT_TRUE( A == B );
+        ASSERT_EQ( 0, A.compare( B ) );
+        ASSERT_EQ( A.hash(), B.hash() );
+
+        A.push_back( 2 );
+        B.push_back( 1 );
+
+        //Equality used to be !( A < B ), which said these were equal
+        ASSERT_FALSE( A == B );
+        ASSERT_TRUE( A != B );
+        ASSERT_TRUE( B < A );
+        ASSERT_TRUE( A > B );
+        ASSERT_TRUE( B <= A );
+        ASSERT_TRUE( A >= B );
+        ASSERT_GT( A.compare( B ), 0 );
+        ASSERT_LT( B.compare( A ), 0 );
+
+        //A prefix orders first
+        A.assign( k, k + 5 );
+        B.assign( k, k + 6 );
+
+        ASSERT_TRUE( A != B );
+        ASSERT_TRUE( A < B );
+        ASSERT_LT( A.compare( B ), 0 );
+
+        B.pop_back();
+
+        ASSERT_TRUE( A == B );
+        ASSERT_TRUE( A <= B && A >= B );
+        ASSERT_FALSE( A < B || A > B );
+        ASSERT_EQ( A.hash(), B.hash() );
+
+        //By value, not by the bytes, which would put -1 after 1
+        A.clear();
+        B.clear();
+        A.push_back( -1 );
+        B.push_back( 1 );
+
+        ASSERT_TRUE( A < B );
+        ASSERT_NE( A.hash(), B.hash() );
+
+        //The same elements hash the same in any adapter
+        DataAdapter<da::dynamic<int> > D;
+        DataAdapter<da::ring<int, STATIC_TEST_ARRAY_SIZE> > R;
+
+        A.assign( k, k + STATIC_TEST_ARRAY_SIZE );
+        D.assign( k, k + STATIC_TEST_ARRAY_SIZE );
+
+        //Wrapped around, so that it hashes two pieces
+        for ( int i = 0; i < 5; ++i ) {
+            R.push_back( 0 );
+            R.pop_front();
+        }
+
+        R.assign( k, k + STATIC_TEST_ARRAY_SIZE );
+
+        ASSERT_EQ( A.hash(), D.hash() );
+        ASSERT_EQ( A.hash(), R.hash() );
+        ASSERT_EQ( A.hash(), std::hash<DataAdapter_StaticArray_TestFixture::adapter_t>()( A ) );
+    }
+
+    //Every adapter tells equality by the elements' operator==, so a NaN is never equal, even to itself
+    TEST( DataAdapter_Comparison, NaN ) {
+        double nan = std::numeric_limits<double>::quiet_NaN();
+
+        DataAdapter<double[4]> A, B;
+        DataAdapter<da::dynamic<double> > D, E;
+        DataAdapter<da::ring<double, 4> > R, S;
+
+        A.push_back( nan );
+        B.push_back( nan );
+        D.push_back( nan );
+        E.push_back( nan );
+        R.push_back( nan );
+        S.push_back( nan );
+
+        ASSERT_FALSE( A == B );
+        ASSERT_FALSE( D == E );
+        ASSERT_FALSE( R == S );
+        ASSERT_TRUE( R != S );
+
+        //While neither orders before the other
+        ASSERT_EQ( 0, R.compare( S ) );
+    }
+
+#ifndef DATA_ADAPTER_DYNAMIC_DISPATCH
+    //Virtual functions are always instantiated, and pop_back and resize need a default constructor
+    TEST( DataAdapter_StaticArray_Storage, Lifetimes ) {
+        typedef DataAdapter<lifetime_counter[8]> adapter_t;
+
+        lifetime_counter::alive() = 0;
+
+        {
+            lifetime_counter batch[] = { lifetime_counter( 3 ), lifetime_counter( 0 ) };
+
+            //Nothing is constructed until it is inserted
+            adapter_t A;
+
+            ASSERT_EQ( 2, lifetime_counter::alive() );
+
+            {
+                SCOPED_TRACE( "insert and erase" );
+
+                A.push_back( lifetime_counter( 2 ) );
+                A.push_front( lifetime_counter( 0 ) );
+                A.insert( A.begin() + 1, lifetime_counter( 1 ) );
+                A.insert( A.begin() + 1, 3, lifetime_counter( 9 ) );
+
+                ASSERT_EQ( 6, A.length() );
+                ASSERT_EQ( 6 + 2, lifetime_counter::alive() );
+
+                A.erase( A.begin() + 1, A.begin() + 4 );
+
+                ASSERT_EQ( 3 + 2, lifetime_counter::alive() );
+
+                for ( int i = 0; i < 3; ++i ) {
+                    ASSERT_EQ( i, A[i].value );
+                }
+
+                A.erase( A.begin() );
+                A.erase( A.end() - 1 );
+
+                ASSERT_EQ( 1 + 2, lifetime_counter::alive() );
+                ASSERT_EQ( 1, A.front().value );
+            }
+
+            {
+                SCOPED_TRACE( "range insert and sorted_insert" );
+
+                //Both of the ways a range insert can shift the tail, past the old end and within it
+                A.insert( A.begin(), A.begin(), A.end() );
+                A.insert( A.begin(), A.begin(), A.begin() + 1 );
+                A.push_back( lifetime_counter( 1 ) );
+
+                ASSERT_EQ( 4 + 2, lifetime_counter::alive() );
+
+                A.sorted_insert( batch, batch + 2 );
+
+                ASSERT_EQ( 6 + 2, lifetime_counter::alive() );
+                ASSERT_TRUE( is_sorted( A.begin(), A.end() ) );
+                ASSERT_EQ( 0, A.front().value );
+                ASSERT_EQ( 3, A.back().value );
+            }
+
+            {
+                SCOPED_TRACE( "copy, assign and resize" );
+
+                adapter_t B( A );
+
+                ASSERT_EQ( 12 + 2, lifetime_counter::alive() );
+
+                B.resize( 2, lifetime_counter( 0 ) );
+
+                ASSERT_EQ( 8 + 2, lifetime_counter::alive() );
+
+                B = A;
+
+                ASSERT_EQ( 12 + 2, lifetime_counter::alive() );
+                ASSERT_TRUE( std::equal( A.begin(), A.end(), B.begin() ) );
+
+                A.assign( batch, batch + 2 );
+
+                ASSERT_EQ( 8 + 2, lifetime_counter::alive() );
+                ASSERT_EQ( 2, A.length() );
+                ASSERT_EQ( 3, A.front().value );
+
+                B.clear();
+
+                ASSERT_EQ( 2 + 2, lifetime_counter::alive() );
+
+                ASSERT_THROW( B.assign( A.begin(), A.end() + 7 ), std::out_of_range );
+            }
+        }
+
+        //Only the live elements are destroyed with the adapter
+        ASSERT_EQ( 0, lifetime_counter::alive() );
+    }
+
+    TEST( DataAdapter_StaticArray_Storage, SortedInsertThrows ) {
+        typedef DataAdapter<throwing_counter[20]> adapter_t;
+
+        throwing_counter::alive() = 0;
+
+        std::vector<throwing_counter> odd;
+
+        for ( int i = 0; i < 10; ++i ) {
+            odd.push_back( throwing_counter( 2 * i + 1 ) );
+        }
+
+        //Every copy along the way throws once, the later ones from the merge past the old end
+        for ( int k = 0; k < 60; ++k ) {
+            adapter_t A;
+
+            for ( int i = 0; i < 10; ++i ) {
+                A.push_back( throwing_counter( 2 * i ) );
+            }
+
+            throwing_counter::copies_left() = k;
+
+            try {
+                A.sorted_insert( odd.begin(), odd.end() );
+
+            } catch ( const std::runtime_error & ) {
+                ASSERT_EQ( 10, A.length() );
+            }
+
+            throwing_counter::copies_left() = -1;
+
+            ASSERT_EQ( static_cast<int>( A.length() + odd.size() ), throwing_counter::alive() );
+        }
+
+        odd.clear();
+
+        ASSERT_EQ( 0, throwing_counter::alive() );
+    }
+#endif // DATA_ADAPTER_DYNAMIC_DISPATCH
+
+    TEST( DataAdapter_StaticArray_Storage, SecureClear ) {
+        DataAdapter<unsigned char[16]> A;
+
+        for ( int i = 0; i < 16; ++i ) {
+            A.push_back( 0xAB );
+        }
+
+        A.resize( 4 );
+        A.secure_clear();
+
+        ASSERT_TRUE( A.empty() );
+
+        //Past the end, but still inside the storage
+        for ( int i = 0; i < 16; ++i ) {
+            ASSERT_EQ( 0, A.data()[i] );
+        }
+    }
+
+    template <typename T>
+    bool is_nan( const T &v ) {
+        return !( v == v );
+    }
+
+    inline std::string to_string_gen( int i ) {
+        return std::string( 1, static_cast<char>( 'a' + ( i * 37 ) % 11 ) );
+    }
+
+    /*
+        Every search on a full adapter against the std algorithm on the same elements, for one element
+        type per kernel. gen( i ) gives few distinct values, so there are repeats to tell apart.
+    */
+    template <typename T, size_t N>
+    void check_searches( T( *gen )( int ) ) {
+        DataAdapter<T[N]> A;
+
+        for ( size_t len = 0; len <= N; len += ( len < 40 ? 1 : 23 ) ) {
+            A.clear();
+
+            for ( size_t i = 0; i < len; ++i ) {
+                A.push_back( gen( static_cast<int>( i * 7 + len ) ) );
+            }
+
+            const T *first = A.data(), *last = A.data() + len;
+
+            for ( int v = 0; v < 12; ++v ) {
+                T x = gen( v );
+
+                ASSERT_EQ( std::find( first, last, x ) - first, A.find( x ) - A.begin() ) << "len " << len;
+                ASSERT_EQ( std::count( first, last, x ), static_cast<std::ptrdiff_t>( A.count( x ) ) ) << "len " << len;
+                ASSERT_EQ( std::find( first, last, x ) != last, A.contains( x ) ) << "len " << len;
+            }
+
+            ASSERT_EQ( std::min_element( first, last ) - first, A.min_element() - A.begin() ) << "len " << len;
+            ASSERT_EQ( std::max_element( first, last ) - first, A.max_element() - A.begin() ) << "len " << len;
+
+            //NaNs don't sort, so those are left out of the sorted part
+            A.erase( std::remove_if( A.begin(), A.end(), is_nan<T> ), A.end() );
+            A.sort();
+
+            first = A.data();
+            last = A.data() + A.length();
+
+            for ( int v = 0; v < 12; ++v ) {
+                T x = gen( v );
+                const T *lb = std::lower_bound( first, last, x );
+
+                ASSERT_EQ( lb != last && *lb == x ? lb - first : last - first, A.find_sorted( x ) - A.begin() ) << "len " << len;
+            }
+        }
+    }
+
+    template <typename T>
+    T search_gen( int i ) {
+        return static_cast<T>( ( i * 37 ) % 11 - 5 );
+    }
+
+    template <typename T>
+    T search_gen_float( int i ) {
+        switch ( ( i * 37 ) % 13 ) {
+            case 0:
+                return std::numeric_limits<T>::quiet_NaN();
+
+            case 1:
+                return -T( 0 );
+
+            default:
+                return static_cast<T>( ( i * 37 ) % 13 ) - T( 6 );
+        }
+    }
+
+    TEST( DataAdapter_StaticArray_Search, Kernels ) {
+        check_searches<signed char, 100>( search_gen<signed char> );
+        check_searches<unsigned char, 100>( search_gen<unsigned char> );
+        check_searches<short, 100>( search_gen<short> );
+        check_searches<unsigned short, 100>( search_gen<unsigned short> );
+        check_searches<int, 100>( search_gen<int> );
+        check_searches<unsigned int, 100>( search_gen<unsigned int> );
+        check_searches<long, 100>( search_gen<long> );
+        check_searches<unsigned long, 100>( search_gen<unsigned long> );
+        check_searches<float, 100>( search_gen_float<float> );
+        check_searches<double, 100>( search_gen_float<double> );
+        check_searches<std::string, 40>( to_string_gen );
+    }
+
+    /*
+        sort() against std::sort, at lengths on both sides of where it switches to the radix sort,
+        with keys all over the range and keys that only differ in the low bytes, whose passes are skipped.
+    */
+    template <typename T, size_t N>
+    void check_radix_sort() {
+        DataAdapter<T[N]> A;
+        std::vector<T> M;
+
+        unsigned long long state = 0x9E3779B97F4A7C15ULL;
+
+        for ( size_t len = 0; len <= N; len = len * 3 + 1 ) {
+            for ( int narrow = 0; narrow < 2; ++narrow ) {
+                A.clear();
+
+                for ( size_t i = 0; i < len; ++i ) {
+                    state ^= state << 13;
+                    state ^= state >> 7;
+                    state ^= state << 17;
+
+                    T x = narrow ? static_cast<T>( static_cast<int>( state % 200 ) - 100 ) : static_cast<T>( state );
+
+                    A.push_back( x );
+                }
+
+                M.assign( A.begin(), A.end() );
+                std::sort( M.begin(), M.end() );
+
+                A.sort();
+
+                ASSERT_TRUE( std::equal( M.begin(), M.end(), A.begin() ) ) << "len " << len << " narrow " << narrow;
+            }
+        }
+    }
+
+    //Sorted by id alone, through the radix_key below
+    struct radix_record {
+        unsigned id;
+        int order;
+
+        bool operator==( const radix_record &r ) const {
+            return id == r.id;
+        }
+
+        bool operator<( const radix_record &r ) const {
+            return id < r.id;
+        }
+    };
+}
+
+namespace da {
+    template <>
+    struct radix_key<DataAdapter_Tests::radix_record> {
+        static const bool value = true;
+        typedef unsigned type;
+
+        static type get( const DataAdapter_Tests::radix_record &r ) {
+            return r.id;
+        }
+    };
+}
+
+namespace DataAdapter_Tests {
+
+    TEST( DataAdapter_StaticArray_Sort, Radix ) {
+        check_radix_sort<signed char, 1000>();
+        check_radix_sort<unsigned char, 1000>();
+        check_radix_sort<short, 1000>();
+        check_radix_sort<unsigned short, 1000>();
+        check_radix_sort<int, 3000>();
+        check_radix_sort<unsigned int, 3000>();
+        check_radix_sort<long, 3000>();
+        check_radix_sort<unsigned long, 3000>();
+        check_radix_sort<float, 3000>();
+        check_radix_sort<double, 3000>();
+    }
+
+    TEST( DataAdapter_StaticArray_Sort, RadixFloats ) {
+        typedef std::numeric_limits<double> limits;
+
+        const double special[] = { -0.0, 0.0, 1.5, -1.5, limits::infinity(), -limits::infinity(),
+                                   limits::denorm_min(), -limits::denorm_min(), limits::max(), -limits::max()
+                                 };
+
+        DataAdapter<double[1000]> A;
+
+        for ( int i = 0; i < 1000; ++i ) {
+            A.push_back( special[( i * 7 ) % 10] );
+        }
+
+        A.sort();
+
+        ASSERT_TRUE( DataAdapter_Tests::is_sorted( A.begin(), A.end() ) );
+        ASSERT_EQ( -limits::infinity(), A.front() );
+        ASSERT_EQ( limits::infinity(), A.back() );
+    }
+
+    TEST( DataAdapter_StaticArray_Sort, RadixKey ) {
+        DataAdapter<radix_record[2000]> A;
+
+        for ( int i = 0; i < 2000; ++i ) {
+            radix_record r = { ( i * 7919u ) % 100, i };
+
+            A.push_back( r );
+        }
+
+        A.sort();
+
+        for ( size_t i = 1; i < A.length(); ++i ) {
+            ASSERT_LE( A[i - 1].id, A[i].id );
+
+            //LSD radix sorting is stable
+            if ( A[i - 1].id == A[i].id ) {
+                ASSERT_LT( A[i - 1].order, A[i].order );
+            }
+        }
+    }
+
+#ifdef DATA_ADAPTER_INSTRUMENTATION
+    TEST( DataAdapter_StaticArray_Stats, Counters ) {
+        //A type no other test uses, since the counters are per type
+        typedef DataAdapter<long[8]> adapter_t;
+
+        adapter_t A;
+
+        da::stats &s = adapter_t::stats();
+
+        s.reset();
+
+        {
+            SCOPED_TRACE( "shifting" );
+
+            A.push_back( 1 );
+            A.push_back( 2 );
+            A.push_back( 3 );
+
+            ASSERT_EQ( 0, s.count( da::stats::shifted ) );
+
+            A.push_front( 0 );
+
+            ASSERT_EQ( 3, s.count( da::stats::shifted ) );
+
+            A.insert( A.begin() + 1, 5 );
+
+            ASSERT_EQ( 3 + 3, s.count( da::stats::shifted ) );
+
+            A.erase( A.begin() );
+
+            ASSERT_EQ( 3 + 3 + 4, s.count( da::stats::shifted ) );
+
+            ASSERT_EQ( 3, s.calls( da::stats::push_back ) );
+            ASSERT_EQ( 1, s.calls( da::stats::push_front ) );
+            ASSERT_EQ( 1, s.calls( da::stats::insert ) );
+            ASSERT_EQ( 1, s.calls( da::stats::erase ) );
+        }
+
+        {
+            SCOPED_TRACE( "filling and throwing" );
+
+            A.resize( 8, 7 );
+
+            ASSERT_EQ( 4, s.count( da::stats::filled ) );
+
+            ASSERT_THROW( A.push_back( 8 ), std::out_of_range );
+            ASSERT_THROW( A.insert( A.begin(), 2, 8 ), std::out_of_range );
+
+            ASSERT_EQ( 2, s.count( da::stats::thrown ) );
         }
 
+#ifdef DATA_ADAPTER_INSTRUMENTATION_CYCLES
+        {
+            SCOPED_TRACE( "histogram" );
+
+            da::stats::value_type total = 0;
+
+            for ( int b = 0; b < da::stats::histogram_buckets; ++b ) {
+                total += s.histogram( da::stats::push_back, b );
+            }
+
+            ASSERT_EQ( s.calls( da::stats::push_back ), total );
+        }
+#endif // DATA_ADAPTER_INSTRUMENTATION_CYCLES
+
+        {
+            SCOPED_TRACE( "dump and reset" );
+
+            std::ostringstream out;
+
+            s.dump( out, "long[8]" );
+
+            ASSERT_NE( std::string::npos, out.str().find( "push_front: 1 calls" ) );
+            ASSERT_NE( std::string::npos, out.str().find( "thrown: 2" ) );
+
+            s.reset();
+
+            ASSERT_EQ( 0, s.calls( da::stats::push_back ) );
+            ASSERT_EQ( 0, s.count( da::stats::shifted ) );
+        }
     }
+#endif // DATA_ADAPTER_INSTRUMENTATION
 }
 
 #endif // DATA_ADAPTER_ARRAY_TESTS_HPP_INCLUDED
@@ -0,0 +1,200 @@
+#ifndef DATA_ADAPTER_BENCH_TOOLS_HPP_INCLUDED
+#define DATA_ADAPTER_BENCH_TOOLS_HPP_INCLUDED
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+namespace DataAdapter_Bench {
+
+    typedef std::chrono::steady_clock clock_type;
+
+    //Keeps the compiler from discarding a computed value, or from assuming memory is unchanged
+#if defined(__GNUC__) || defined(__clang__)
+    template <typename T>
+    inline void do_not_optimize( const T &value ) {
+        asm volatile( "" : : "r,m"( value ) : "memory" );
+    }
+
+    inline void clobber() {
+        asm volatile( "" : : : "memory" );
+    }
+#else
+    template <typename T>
+    inline void do_not_optimize( const T &value ) {
+        static volatile const void *sink;
+        sink = &value;
+    }
+
+    inline void clobber() {}
+#endif
+
+    enum output_format {
+        FORMAT_TABLE,
+        FORMAT_CSV,
+        FORMAT_JSON
+    };
+
+    //Settings shared by every benchmark, set from the command line by parse_args()
+    struct options {
+        output_format format;
+
+        //Minimum wall time spent on each measurement, in milliseconds
+        long min_measure_ms;
+
+        //Rows whose suite, benchmark or variant doesn't contain this are skipped
+        const char *filter;
+
+        //Whether a JSON row has been written yet, for the commas
+        bool first_row;
+
+        options() : format( FORMAT_TABLE ), min_measure_ms( 50 ), filter( "" ), first_row( true ) {}
+    };
+
+    inline options &settings() {
+        static options o;
+        return o;
+    }
+
+    /*
+        Every benchmark takes the same arguments:
+
+            --format=table|csv|json     how results are written to stdout, table by default
+            --min-ms=N                  minimum time spent on each measurement
+            --filter=TEXT               only run rows with TEXT in their suite, benchmark or variant name
+    */
+    inline void parse_args( int argc, char **argv ) {
+        options &o = settings();
+
+        for ( int i = 1; i < argc; ++i ) {
+            const char *a = argv[i];
+
+            if ( std::strcmp( a, "--format=table" ) == 0 ) {
+                o.format = FORMAT_TABLE;
+
+            } else if ( std::strcmp( a, "--format=csv" ) == 0 ) {
+                o.format = FORMAT_CSV;
+
+            } else if ( std::strcmp( a, "--format=json" ) == 0 ) {
+                o.format = FORMAT_JSON;
+
+            } else if ( std::strncmp( a, "--min-ms=", 9 ) == 0 ) {
+                o.min_measure_ms = std::atol( a + 9 );
+
+            } else if ( std::strncmp( a, "--filter=", 9 ) == 0 ) {
+                o.filter = a + 9;
+
+            } else {
+                std::fprintf( stderr, "usage: %s [--format=table|csv|json] [--min-ms=N] [--filter=TEXT]\n", argv[0] );
+                std::exit( 1 );
+            }
+        }
+    }
+
+    inline bool selected( const char *suite, const char *name, const char *variant ) {
+        const char *f = settings().filter;
+
+        return *f == '\0' || std::strstr( suite, f ) != NULL || std::strstr( name, f ) != NULL || std::strstr( variant, f ) != NULL;
+    }
+
+    /*
+        Calls f() in growing batches until at least the minimum measuring time has passed,
+        and returns the average time per operation in nanoseconds.
+
+        ops_per_call is how many operations one call of f() performs,
+        so loops inside f() are reported per element.
+    */
+    template <typename F>
+    double measure( F f, size_t ops_per_call = 1 ) {
+        f();
+
+        size_t batch = 1;
+
+        for ( ;; ) {
+            clock_type::time_point start = clock_type::now();
+
+            for ( size_t i = 0; i < batch; ++i ) {
+                f();
+            }
+
+            clock_type::duration elapsed = clock_type::now() - start;
+
+            if ( elapsed >= std::chrono::milliseconds( settings().min_measure_ms ) ) {
+                double ns = static_cast<double>( std::chrono::duration_cast<std::chrono::nanoseconds>( elapsed ).count() );
+                return ns / ( static_cast<double>( batch ) * static_cast<double>( ops_per_call ) );
+            }
+
+            batch *= 2;
+        }
+    }
+
+    inline void report_header() {
+        switch ( settings().format ) {
+            case FORMAT_TABLE:
+                std::printf( "%-16s %-24s %-12s %10s %14s\n", "suite", "benchmark", "variant", "n", "ns/op" );
+                break;
+
+            case FORMAT_CSV:
+                std::printf( "suite,benchmark,variant,n,ns_per_op\n" );
+                break;
+
+            case FORMAT_JSON:
+                std::printf( "[" );
+                break;
+        }
+    }
+
+    //Names are never quoted or escaped, so they must not contain commas or quotes
+    inline void report( const char *suite, const char *name, const char *variant, size_t n, double ns ) {
+        options &o = settings();
+
+        switch ( o.format ) {
+            case FORMAT_TABLE:
+                std::printf( "%-16s %-24s %-12s %10lu %14.3f\n", suite, name, variant, static_cast<unsigned long>( n ), ns );
+                break;
+
+            case FORMAT_CSV:
+                std::printf( "%s,%s,%s,%lu,%.3f\n", suite, name, variant, static_cast<unsigned long>( n ), ns );
+                break;
+
+            case FORMAT_JSON:
+                std::printf( "%s\n  {\"suite\": \"%s\", \"benchmark\": \"%s\", \"variant\": \"%s\", \"n\": %lu, \"ns_per_op\": %.3f}",
+                             o.first_row ? "" : ",", suite, name, variant, static_cast<unsigned long>( n ), ns );
+                o.first_row = false;
+                break;
+        }
+
+        std::fflush( stdout );
+    }
+
+    inline void report_footer() {
+        if ( settings().format == FORMAT_JSON ) {
+            std::printf( "\n]\n" );
+        }
+    }
+
+    //Only measures and reports when the row passes --filter
+    template <typename F>
+    inline void run( const char *suite, const char *name, const char *variant, size_t n, F f, size_t ops_per_call = 1 ) {
+        if ( selected( suite, name, variant ) ) {
+            report( suite, name, variant, n, measure( f, ops_per_call ) );
+        }
+    }
+
+    //Small deterministic generator so every run and variant sees the same data
+    struct xorshift {
+        unsigned long long state;
+
+        explicit xorshift( unsigned long long seed = 0x9E3779B97F4A7C15ULL ) : state( seed ) {}
+
+        inline unsigned long long operator()() {
+            state ^= state << 13;
+            state ^= state >> 7;
+            state ^= state << 17;
+            return state;
+        }
+    };
+}
+
+#endif // DATA_ADAPTER_BENCH_TOOLS_HPP_INCLUDED
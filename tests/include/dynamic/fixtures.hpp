@@ -0,0 +1,23 @@
+#ifndef DATA_ADAPTER_DYNAMIC_TEST_FIXTURES_HPP_INCLUDED
+#define DATA_ADAPTER_DYNAMIC_TEST_FIXTURES_HPP_INCLUDED
+
+#include <gtest/gtest.h>
+
+#include <tools.hpp>
+#include <data_adapter>
+
+namespace DataAdapter_Tests {
+
+    template <typename T, typename Alloc = std::allocator<T> >
+    class DataAdapter_Dynamic_TestFixtureTemplate : public ::testing::Test {
+        public:
+            typedef DataAdapter<da::dynamic<T, Alloc> > adapter_t;
+
+            const T k[10] = {0x1, 0x2, 0x3, 0x4, 0x5, 0x6, 0x7, 0x8, 0x9, 0x10};
+
+            adapter_t A, B;
+    };
+
+}
+
+#endif // DATA_ADAPTER_DYNAMIC_TEST_FIXTURES_HPP_INCLUDED
@@ -0,0 +1,741 @@
+#ifndef DATA_ADAPTER_DYNAMIC_TESTS_HPP_INCLUDED
+#define DATA_ADAPTER_DYNAMIC_TESTS_HPP_INCLUDED
+
+#include <algorithm>
+#include <iterator>
+#include <list>
+#include <sstream>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#include "fixtures.hpp"
+
+namespace DataAdapter_Tests {
+
+    typedef DataAdapter_Dynamic_TestFixtureTemplate<int>
+    DataAdapter_Dynamic_TestFixture;
+
+    typedef DataAdapter_Dynamic_TestFixtureTemplate<int, da::malloc_allocator<int> >
+    DataAdapter_Dynamic_Malloc_TestFixture;
+
+    TEST_F( DataAdapter_Dynamic_TestFixture, Construction ) {
+        ASSERT_EQ( 0, A.length() );
+        ASSERT_EQ( 0, A.capacity() );
+        ASSERT_TRUE( A.begin() == A.end() );
+
+        A.assign( k, k + 10 );
+
+        ASSERT_EQ( 10, A.length() );
+        ASSERT_EQ( 10, A.capacity() );
+        ASSERT_TRUE( std::equal( k, k + 10, A.begin() ) );
+
+        DataAdapter_Dynamic_TestFixture::adapter_t C( 3, 0x4 );
+
+        ASSERT_EQ( 3,   C.length() );
+        ASSERT_EQ( 0x4, C[0] );
+        ASSERT_EQ( 0x4, C[2] );
+
+        {
+            SCOPED_TRACE( "copy and move" );
+
+            DataAdapter_Dynamic_TestFixture::adapter_t D( A );
+
+            ASSERT_TRUE( D == A );
+            ASSERT_FALSE( D == C );
+            ASSERT_TRUE( D < C );
+
+            C = A;
+
+            ASSERT_TRUE( C == A );
+
+            //Moving hands over the block itself
+            const int *p = D.data();
+
+            B = std::move( D );
+
+            ASSERT_EQ( p, B.data() );
+            ASSERT_TRUE( B == A );
+            ASSERT_EQ( 0, D.length() );
+            ASSERT_EQ( 0, D.capacity() );
+        }
+    }
+
+    TEST_F( DataAdapter_Dynamic_TestFixture, Growth ) {
+        {
+            SCOPED_TRACE( "geometric growth" );
+
+            int reallocations = 0;
+            size_t last = A.capacity();
+
+            for ( int i = 0; i < 100000; ++i ) {
+                A.push_back( i );
+
+                if ( A.capacity() != last ) {
+                    ++reallocations;
+                    last = A.capacity();
+                }
+            }
+
+            ASSERT_EQ( 100000, A.length() );
+            ASSERT_LT( reallocations, 40 );
+
+            for ( int i = 0; i < 100000; ++i ) {
+                ASSERT_EQ( i, A[i] );
+            }
+        }
+
+        {
+            SCOPED_TRACE( "reserve" );
+
+            B.reserve( 5000 );
+
+            ASSERT_EQ( 5000, B.capacity() );
+
+            const int *p = B.data();
+
+            for ( int i = 0; i < 5000; ++i ) {
+                B.push_back( i );
+            }
+
+            ASSERT_EQ( p, B.data() );
+
+            //Never shrinks
+            B.reserve( 10 );
+
+            ASSERT_EQ( 5000, B.capacity() );
+        }
+
+        {
+            SCOPED_TRACE( "shrink_to_fit and clear" );
+
+            A.resize( 10 );
+            A.shrink_to_fit();
+
+            ASSERT_EQ( 10, A.capacity() );
+            ASSERT_EQ( 9, A.back() );
+
+            A.clear();
+
+            ASSERT_EQ( 10, A.capacity() );
+
+            A.shrink_to_fit();
+
+            ASSERT_EQ( 0, A.capacity() );
+            ASSERT_TRUE( A.data() == NULL );
+
+            A.push_front( 1 );
+
+            ASSERT_EQ( 1, A.front() );
+        }
+    }
+
+    TEST_F( DataAdapter_Dynamic_TestFixture, Manipulation ) {
+        typedef std::vector<int> model_t;
+
+        model_t M;
+
+        //Random inserts and erases anywhere, checked against std::vector
+        unsigned state = 0x2545F491;
+
+        for ( int i = 0; i < 5000; ++i ) {
+            state ^= state << 13;
+            state ^= state >> 17;
+            state ^= state << 5;
+
+            size_t pos = M.empty() ? 0 : state % ( M.size() + 1 );
+            size_t n = ( state >> 12 ) % 3 + 1;
+
+            switch ( ( state >> 8 ) % 6 ) {
+                case 0:
+                case 1:
+                    A.insert( A.begin() + pos, n, i );
+                    M.insert( M.begin() + pos, n, i );
+                    break;
+
+                case 2:
+                    A.insert( A.begin() + pos, i );
+                    M.insert( M.begin() + pos, i );
+                    break;
+
+                case 3: {
+                    //From itself, which may grow the block the range is in
+                    size_t f = M.empty() ? 0 : ( state >> 16 ) % M.size();
+                    size_t l = std::min( f + n, M.size() );
+
+                    model_t tmp( M.begin() + f, M.begin() + l );
+
+                    A.insert( A.begin() + pos, A.cbegin() + f, A.cbegin() + l );
+                    M.insert( M.begin() + pos, tmp.begin(), tmp.end() );
+                    break;
+                }
+
+                default:
+                    if ( !M.empty() ) {
+                        pos = std::min( pos, M.size() - 1 );
+                        n = std::min( n, M.size() - pos );
+
+                        A.erase( A.begin() + pos, A.begin() + pos + n );
+                        M.erase( M.begin() + pos, M.begin() + pos + n );
+                    }
+            }
+
+            ASSERT_EQ( M.size(), A.length() );
+            ASSERT_TRUE( std::equal( M.begin(), M.end(), A.begin() ) );
+        }
+    }
+
+    TEST_F( DataAdapter_Dynamic_TestFixture, InsertionRanges ) {
+        typedef std::vector<int> model_t;
+
+        model_t M;
+
+        //Every kind of range at random places, checked against std::vector, growing as it goes
+        unsigned state = 0x2545F491;
+
+        for ( int i = 0; i < 300; ++i ) {
+            state ^= state << 13;
+            state ^= state >> 17;
+            state ^= state << 5;
+
+            size_t pos = state % ( M.size() + 1 );
+            int n = static_cast<int>( ( state >> 12 ) % 9 );
+
+            switch ( ( state >> 8 ) % 4 ) {
+                case 0: {
+                    std::list<int> l( n, i );
+
+                    A.insert( A.begin() + pos, l.begin(), l.end() );
+                    M.insert( M.begin() + pos, l.begin(), l.end() );
+                    break;
+                }
+
+                case 1: {
+                    std::ostringstream out;
+
+                    for ( int j = 0; j < n; ++j ) {
+                        out << i + j << ' ';
+                    }
+
+                    std::istringstream in( out.str() );
+
+                    A.insert( A.begin() + pos, std::istream_iterator<int>( in ), std::istream_iterator<int>() );
+
+                    for ( int j = 0; j < n; ++j ) {
+                        M.insert( M.begin() + pos + j, i + j );
+                    }
+                    break;
+                }
+
+                case 2: {
+                    //Own elements, which growing would free from under the range
+                    size_t f = M.empty() ? 0 : state % M.size();
+                    size_t l = std::min( M.size(), f + n );
+
+                    A.insert( A.begin() + pos, A.begin() + f, A.begin() + l );
+
+                    model_t tmp( M.begin() + f, M.begin() + l );
+                    M.insert( M.begin() + pos, tmp.begin(), tmp.end() );
+                    break;
+                }
+
+                default:
+                    A.insert( A.begin() + pos, n, i );
+                    M.insert( M.begin() + pos, n, i );
+                    break;
+            }
+
+            ASSERT_EQ( M.size(), A.length() );
+            ASSERT_TRUE( std::equal( M.begin(), M.end(), A.begin() ) );
+
+            if ( M.size() > 200 ) {
+                A.resize( 20 );
+                M.resize( 20 );
+            }
+        }
+
+        {
+            SCOPED_TRACE( "append and assign" );
+
+            std::list<int> l( k, k + 5 );
+
+            B.append( l.begin(), l.end() );
+            B.append( k + 5, k + 10 );
+
+            ASSERT_EQ( 10, B.length() );
+            ASSERT_TRUE( std::equal( k, k + 10, B.begin() ) );
+
+            B.assign( 20, 3 );
+
+            ASSERT_EQ( 20, B.length() );
+            ASSERT_EQ( 20, std::count( B.begin(), B.end(), 3 ) );
+
+            std::istringstream in( "1 2 3" );
+
+            B.assign( std::istream_iterator<int>( in ), std::istream_iterator<int>() );
+
+            ASSERT_EQ( 3, B.length() );
+            ASSERT_EQ( 1, B[0] );
+            ASSERT_EQ( 3, B[2] );
+        }
+    }
+
+    TEST( DataAdapter_Dynamic_Erasing, Strings ) {
+        typedef DataAdapter<da::dynamic<std::string> > adapter_t;
+
+        adapter_t A;
+        std::vector<std::string> M;
+
+        for ( int i = 0; i < 1000; ++i ) {
+            //Long enough not to fit in the small string buffer
+            std::string s = std::to_string( i * 7919 % 1000 ) + std::string( 32, 'x' );
+
+            A.push_back( s );
+            M.push_back( s );
+        }
+
+        {
+            SCOPED_TRACE( "erase_if" );
+
+            auto odd = []( const std::string & s ) {
+                return ( s[s.find( 'x' ) - 1] - '0' ) % 2 == 1;
+            };
+
+            ASSERT_EQ( 500, A.erase_if( odd ) );
+
+            M.erase( std::remove_if( M.begin(), M.end(), odd ), M.end() );
+
+            ASSERT_EQ( M.size(), A.length() );
+            ASSERT_TRUE( std::equal( M.begin(), M.end(), A.begin() ) );
+        }
+
+        {
+            SCOPED_TRACE( "unordered_erase" );
+
+            std::unordered_multiset<std::string> left( M.begin(), M.end() );
+
+            while ( !A.empty() ) {
+                size_t pos = A.length() * 5 / 7;
+
+                left.erase( left.find( A[pos] ) );
+                A.unordered_erase( A.begin() + pos );
+
+                ASSERT_EQ( left.size(), A.length() );
+            }
+
+            ASSERT_TRUE( left.empty() );
+        }
+    }
+
+    TEST_F( DataAdapter_Dynamic_TestFixture, Sorting ) {
+        for ( int i = 0; i < 100; ++i ) {
+            A.push_back( ( i * 37 ) % 100 );
+        }
+
+        A.sort();
+
+        ASSERT_TRUE( DataAdapter_Tests::is_sorted( A.begin(), A.end() ) );
+
+        int batch[] = { 50, 200, -1, 50, 7 };
+
+        A.shrink_to_fit();
+
+        //The batch has to grow the block first
+        DataAdapter_Dynamic_TestFixture::adapter_t::iterator it = A.sorted_insert( batch, batch + 5 );
+
+        ASSERT_EQ( 105, A.length() );
+        ASSERT_EQ( -1, *it );
+        ASSERT_TRUE( DataAdapter_Tests::is_sorted( A.begin(), A.end() ) );
+        ASSERT_EQ( 200, A.back() );
+
+        DataAdapter_Dynamic_TestFixture::adapter_t::_Base &base = A;
+
+        ASSERT_EQ( A.begin() + 52, base.find_sorted( 50 ) );
+        ASSERT_EQ( A.end(), base.find( 1000 ) );
+    }
+
+    //Ordered by key alone, so the order each key's elements end up in shows whether a sort was stable
+    struct keyed {
+        int key, order;
+
+        bool operator==( const keyed &k ) const {
+            return key == k.key;
+        }
+
+        bool operator<( const keyed &k ) const {
+            return key < k.key;
+        }
+    };
+
+    TEST_F( DataAdapter_Dynamic_TestFixture, ParallelSorting ) {
+        std::vector<int> M;
+
+        //Enough for several chunks, and an odd count of them for 3 threads
+        for ( int i = 0; i < 200000; ++i ) {
+            int x = static_cast<int>( ( i * 2654435761u ) % 100003 );
+
+            A.push_back( x );
+            M.push_back( x );
+        }
+
+        std::sort( M.begin(), M.end() );
+
+        const unsigned threads[] = { 0, 1, 2, 3, 4, 7 };
+
+        for ( size_t t = 0; t < 6; ++t ) {
+            SCOPED_TRACE( threads[t] );
+
+            B = A;
+            B.sort( threads[t] );
+
+            ASSERT_EQ( M.size(), B.length() );
+            ASSERT_TRUE( std::equal( M.begin(), M.end(), B.begin() ) );
+
+            B = A;
+            B.stable_sort( threads[t] );
+
+            ASSERT_TRUE( std::equal( M.begin(), M.end(), B.begin() ) );
+        }
+
+        //Too short to split, but still sorted
+        B.clear();
+        B.push_back( 3 );
+        B.push_back( 1 );
+        B.sort( 4 );
+
+        ASSERT_EQ( 1, B.front() );
+
+        B.clear();
+        B.stable_sort( 4 );
+
+        ASSERT_TRUE( B.empty() );
+    }
+
+    TEST( DataAdapter_Dynamic_Sorting, ParallelStable ) {
+        DataAdapter<da::dynamic<keyed> > A;
+
+        //Few keys, so every merge has long runs of equal ones to keep in order
+        for ( int i = 0; i < 150000; ++i ) {
+            keyed k = { static_cast<int>( ( i * 7919u ) % 13 ), i };
+
+            A.push_back( k );
+        }
+
+        A.stable_sort( 5 );
+
+        for ( size_t i = 1; i < A.length(); ++i ) {
+            ASSERT_FALSE( A[i] < A[i - 1] );
+
+            if ( !( A[i - 1] < A[i] ) ) {
+                ASSERT_LT( A[i - 1].order, A[i].order );
+            }
+        }
+    }
+
+    TEST_F( DataAdapter_Dynamic_TestFixture, Searching ) {
+        //Each of 0 to 99 ten times, 99 first at 27
+        for ( int i = 0; i < 1000; ++i ) {
+            A.push_back( ( i * 37 ) % 100 );
+        }
+
+        ASSERT_EQ( A.begin() + 27, A.find( 99 ) );
+        ASSERT_EQ( A.end(), A.find( 100 ) );
+        ASSERT_EQ( 10, A.count( 99 ) );
+        ASSERT_TRUE( A.contains( 0 ) );
+        ASSERT_FALSE( A.contains( -1 ) );
+        ASSERT_EQ( A.begin(), A.min_element() );
+        ASSERT_EQ( A.begin() + 27, A.max_element() );
+
+        DataAdapter_Dynamic_TestFixture::adapter_t::_Base &base = A;
+
+        ASSERT_EQ( 10, base.count( 42 ) );
+        ASSERT_EQ( A.begin() + 27, base.max_element() );
+
+        A.clear();
+
+        ASSERT_EQ( A.end(), A.min_element() );
+        ASSERT_EQ( A.end(), A.find_sorted( 1 ) );
+        ASSERT_EQ( 0, A.count( 1 ) );
+    }
+
+    TEST_F( DataAdapter_Dynamic_Malloc_TestFixture, Relocation ) {
+        {
+            SCOPED_TRACE( "trivially relocatable, realloc" );
+
+            for ( int i = 0; i < 10000; ++i ) {
+                A.push_back( i );
+                A.insert( A.begin() + A.length() / 2, -i );
+            }
+
+            A.shrink_to_fit();
+
+            ASSERT_EQ( 20000, A.capacity() );
+
+            std::vector<int> M;
+
+            for ( int i = 0; i < 10000; ++i ) {
+                M.push_back( i );
+                M.insert( M.begin() + M.size() / 2, -i );
+            }
+
+            ASSERT_TRUE( std::equal( M.begin(), M.end(), A.begin() ) );
+        }
+
+        {
+            SCOPED_TRACE( "not trivially relocatable, moved one by one" );
+
+            DataAdapter<da::dynamic<std::string, da::malloc_allocator<std::string> > > S;
+
+            //Short enough that libstdc++ keeps them inside the string object itself
+            for ( int i = 0; i < 1000; ++i ) {
+                S.push_back( std::string( 1, static_cast<char>( 'a' + i % 26 ) ) );
+            }
+
+            S.shrink_to_fit();
+            S.reserve( 5000 );
+
+            for ( int i = 0; i < 1000; ++i ) {
+                ASSERT_EQ( std::string( 1, static_cast<char>( 'a' + i % 26 ) ), S[i] );
+            }
+        }
+    }
+
+    TEST( DataAdapter_Dynamic_Allocator, Stateful ) {
+        typedef counting_allocator<int> allocator_t;
+        typedef DataAdapter<da::dynamic<int, allocator_t> > adapter_t;
+
+        int blocks = 0;
+        size_t elements = 0;
+
+        {
+            adapter_t A( ( allocator_t( &blocks, &elements ) ) );
+
+            ASSERT_EQ( 0, blocks );
+
+            for ( int i = 0; i < 100; ++i ) {
+                A.push_back( i );
+            }
+
+            ASSERT_EQ( 1, blocks );
+            ASSERT_EQ( A.capacity(), elements );
+
+            {
+                SCOPED_TRACE( "copies share the allocator" );
+
+                adapter_t B( A );
+
+                ASSERT_EQ( 2, blocks );
+                ASSERT_EQ( A.capacity() + B.capacity(), elements );
+            }
+
+            ASSERT_EQ( 1, blocks );
+
+            {
+                SCOPED_TRACE( "over max_size" );
+
+                ASSERT_THROW( A.reserve( 1001 ), std::out_of_range );
+                ASSERT_THROW( A.insert( A.begin(), 901, 0 ), std::out_of_range );
+
+                ASSERT_EQ( 100, A.length() );
+
+                A.resize( 1000 );
+
+                ASSERT_THROW( A.push_back( 0 ), std::out_of_range );
+                ASSERT_EQ( 1000, A.capacity() );
+            }
+        }
+
+        ASSERT_EQ( 0, blocks );
+        ASSERT_EQ( 0, elements );
+    }
+
+#ifndef DATA_ADAPTER_DYNAMIC_DISPATCH
+    TEST( DataAdapter_Dynamic_Storage, Lifetimes ) {
+        typedef DataAdapter<da::dynamic<lifetime_counter> > adapter_t;
+
+        lifetime_counter::alive() = 0;
+
+        {
+            adapter_t A;
+
+            A.reserve( 100 );
+
+            ASSERT_EQ( 0, lifetime_counter::alive() );
+
+            for ( int i = 0; i < 50; ++i ) {
+                A.push_back( lifetime_counter( i ) );
+                A.insert( A.begin(), lifetime_counter( i ) );
+            }
+
+            ASSERT_EQ( 100, lifetime_counter::alive() );
+
+            A.shrink_to_fit();
+            A.insert( A.begin() + 3, 20, lifetime_counter( 0 ) );
+
+            ASSERT_EQ( 120, lifetime_counter::alive() );
+
+            A.erase( A.begin(), A.begin() + 60 );
+
+            ASSERT_EQ( 60, lifetime_counter::alive() );
+
+            adapter_t B( A );
+
+            ASSERT_EQ( 120, lifetime_counter::alive() );
+
+            B.clear();
+
+            ASSERT_EQ( 60, lifetime_counter::alive() );
+        }
+
+        ASSERT_EQ( 0, lifetime_counter::alive() );
+    }
+
+    TEST( DataAdapter_Dynamic_Storage, SortedInsertThrows ) {
+        typedef DataAdapter<da::dynamic<throwing_counter> > adapter_t;
+
+        throwing_counter::alive() = 0;
+
+        std::vector<throwing_counter> odd;
+
+        for ( int i = 0; i < 10; ++i ) {
+            odd.push_back( throwing_counter( 2 * i + 1 ) );
+        }
+
+        //Every copy along the way throws once, the later ones from the merge past the old end
+        for ( int k = 0; k < 60; ++k ) {
+            adapter_t A;
+
+            A.reserve( 20 );
+
+            for ( int i = 0; i < 10; ++i ) {
+                A.push_back( throwing_counter( 2 * i ) );
+            }
+
+            throwing_counter::copies_left() = k;
+
+            try {
+                A.sorted_insert( odd.begin(), odd.end() );
+
+            } catch ( const std::runtime_error & ) {
+                ASSERT_EQ( 10, A.length() );
+            }
+
+            throwing_counter::copies_left() = -1;
+
+            ASSERT_EQ( static_cast<int>( A.length() + odd.size() ), throwing_counter::alive() );
+        }
+
+        odd.clear();
+
+        ASSERT_EQ( 0, throwing_counter::alive() );
+    }
+#endif // DATA_ADAPTER_DYNAMIC_DISPATCH
+
+    TEST_F( DataAdapter_Dynamic_TestFixture, Comparison ) {
+        for ( int i = 0; i < 1000; ++i ) {
+            A.push_back( i - 500 );
+        }
+
+        B = A;
+
+        ASSERT_TRUE( A == B );
+        ASSERT_EQ( A.hash(), B.hash() );
+
+        //Differences before, at and after the boundaries of the blocks memcmp compares
+        const int at[] = { 0, 63, 64, 65, 700, 999 };
+
+        for ( size_t i = 0; i < 6; ++i ) {
+            SCOPED_TRACE( at[i] );
+
+            B = A;
+            B[at[i]] += 1;
+
+            ASSERT_TRUE( A != B );
+            ASSERT_TRUE( A < B );
+            ASSERT_LT( A.compare( B ), 0 );
+            ASSERT_GT( B.compare( A ), 0 );
+            ASSERT_NE( A.hash(), B.hash() );
+
+            B[at[i]] -= 2;
+
+            ASSERT_TRUE( A > B );
+        }
+
+        //Through the base, the generic versions agree with these
+        DataAdapter_Dynamic_TestFixture::adapter_t::_Base &base = A;
+
+        B = A;
+
+        ASSERT_TRUE( base == B );
+        ASSERT_EQ( A.hash(), base.hash() );
+
+        B.push_back( 0 );
+
+        ASSERT_LT( base.compare( B ), 0 );
+
+        //As keys of a hash table
+        std::unordered_set<DataAdapter_Dynamic_TestFixture::adapter_t> keys;
+
+        keys.insert( A );
+        keys.insert( B );
+        keys.insert( A );
+
+        ASSERT_EQ( 2u, keys.size() );
+        ASSERT_EQ( 1u, keys.count( B ) );
+    }
+
+    //Elements that aren't compared by their bytes, nor hashed by them
+    TEST( DataAdapter_Dynamic_Comparison, Generic ) {
+        DataAdapter<da::dynamic<keyed> > A, B;
+
+        for ( int i = 0; i < 100; ++i ) {
+            keyed x = { i, i };
+            keyed y = { i, -i };
+
+            A.push_back( x );
+            B.push_back( y );
+        }
+
+        //keyed only compares keys
+        ASSERT_TRUE( A == B );
+        ASSERT_EQ( 0, A.compare( B ) );
+
+        B[50].key = 0;
+
+        ASSERT_TRUE( B < A );
+
+        DataAdapter<da::dynamic<double> > C, D;
+
+        C.push_back( 0.0 );
+        D.push_back( -0.0 );
+
+        //Equal, so they hash the same, though their bytes differ
+        ASSERT_TRUE( C == D );
+        ASSERT_EQ( C.hash(), D.hash() );
+    }
+
+    TEST( DataAdapter_Dynamic_Move, NoCopies ) {
+        typedef DataAdapter<da::dynamic<copy_counter> > adapter_t;
+
+        adapter_t A;
+
+        copy_counter::copies() = 0;
+
+        //Growing moves the elements, since copy_counter can't throw while moving
+        for ( int i = 0; i < 1000; ++i ) {
+            A.push_back( copy_counter( i ) );
+            A.emplace_back( i );
+        }
+
+        A.emplace( A.begin(), -1 );
+        A.sorted_insert( copy_counter( 2000 ) );
+        A.shrink_to_fit();
+
+        ASSERT_EQ( 0, copy_counter::copies() );
+        ASSERT_EQ( 2002, A.length() );
+        ASSERT_EQ( -1, A.front().value );
+        ASSERT_EQ( 2000, A.back().value );
+    }
+}
+
+#endif // DATA_ADAPTER_DYNAMIC_TESTS_HPP_INCLUDED
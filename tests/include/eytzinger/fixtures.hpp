@@ -0,0 +1,23 @@
+#ifndef DATA_ADAPTER_EYTZINGER_TEST_FIXTURES_HPP_INCLUDED
+#define DATA_ADAPTER_EYTZINGER_TEST_FIXTURES_HPP_INCLUDED
+
+#include <gtest/gtest.h>
+
+#include <tools.hpp>
+#include <data_adapter>
+
+namespace DataAdapter_Tests {
+
+    template <typename T, size_t N>
+    class DataAdapter_Eytzinger_TestFixtureTemplate : public ::testing::Test {
+        public:
+            typedef DataAdapter<T[N]> adapter_t;
+            typedef da::eytzinger_index<T> index_t;
+
+            adapter_t A;
+            index_t I;
+    };
+
+}
+
+#endif // DATA_ADAPTER_EYTZINGER_TEST_FIXTURES_HPP_INCLUDED
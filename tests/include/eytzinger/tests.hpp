@@ -0,0 +1,74 @@
+#ifndef DATA_ADAPTER_EYTZINGER_TESTS_HPP_INCLUDED
+#define DATA_ADAPTER_EYTZINGER_TESTS_HPP_INCLUDED
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include "fixtures.hpp"
+
+namespace DataAdapter_Tests {
+
+    static const int EYTZINGER_TEST_SIZE = 300;
+
+    typedef DataAdapter_Eytzinger_TestFixtureTemplate<int, EYTZINGER_TEST_SIZE>
+    DataAdapter_Eytzinger_TestFixture;
+
+    TEST_F( DataAdapter_Eytzinger_TestFixture, Empty ) {
+        I.build( A );
+
+        ASSERT_TRUE( I.empty() );
+        ASSERT_EQ( 0, I.lower_bound( 1 ) );
+        ASSERT_EQ( 0, I.find( 1 ) );
+        ASSERT_FALSE( I.contains( 1 ) );
+    }
+
+    TEST_F( DataAdapter_Eytzinger_TestFixture, Positions ) {
+        //Every size up to the capacity, so every shape of the last level of the tree comes up
+        for ( int n = 1; n <= EYTZINGER_TEST_SIZE; ++n ) {
+            A.clear();
+
+            //Even numbers with repeats, so there are misses between and outside the keys
+            for ( int i = 0; i < n; ++i ) {
+                A.push_back( ( i / 3 ) * 2 );
+            }
+
+            I.build( A );
+
+            ASSERT_EQ( A.length(), I.size() );
+
+            for ( int x = -1; x <= ( n / 3 ) * 2 + 2; ++x ) {
+                ASSERT_EQ( std::lower_bound( A.begin(), A.end(), x ), A.begin() + I.lower_bound( x ) ) << n << ' ' << x;
+                ASSERT_EQ( std::upper_bound( A.begin(), A.end(), x ), A.begin() + I.upper_bound( x ) ) << n << ' ' << x;
+                ASSERT_EQ( A.find_sorted( x ), A.begin() + I.find( x ) ) << n << ' ' << x;
+                ASSERT_EQ( A.find_sorted( x ) != A.end(), I.contains( x ) ) << n << ' ' << x;
+            }
+        }
+    }
+
+    TEST( DataAdapter_Eytzinger_Strings, Positions ) {
+        std::vector<std::string> keys;
+
+        for ( int i = 0; i < 100; ++i ) {
+            keys.push_back( std::string( 1 + i % 4, static_cast<char>( 'a' + i % 26 ) ) );
+        }
+
+        std::sort( keys.begin(), keys.end() );
+
+        da::eytzinger_index<std::string> I( keys.begin(), keys.end() );
+
+        for ( size_t i = 0; i < keys.size(); ++i ) {
+            ASSERT_EQ( std::lower_bound( keys.begin(), keys.end(), keys[i] ) - keys.begin(), I.find( keys[i] ) );
+        }
+
+        ASSERT_EQ( keys.size(), I.find( "zzzzz" ) );
+        ASSERT_EQ( 0, I.lower_bound( "" ) );
+
+        //The index keeps its own copies
+        keys.clear();
+
+        ASSERT_TRUE( I.contains( "a" ) );
+    }
+}
+
+#endif // DATA_ADAPTER_EYTZINGER_TESTS_HPP_INCLUDED
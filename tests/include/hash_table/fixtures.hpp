@@ -0,0 +1,22 @@
+#ifndef DATA_ADAPTER_HASH_TABLE_TEST_FIXTURES_HPP_INCLUDED
+#define DATA_ADAPTER_HASH_TABLE_TEST_FIXTURES_HPP_INCLUDED
+
+#include <gtest/gtest.h>
+
+#include <tools.hpp>
+#include <data_adapter>
+
+namespace DataAdapter_Tests {
+
+    template <typename K, typename V>
+    class DataAdapter_HashTable_TestFixtureTemplate : public ::testing::Test {
+        public:
+            typedef DataAdapter<da::hash_table<K, V> > adapter_t;
+            typedef typename adapter_t::element_type element_t;
+
+            adapter_t A, B;
+    };
+
+}
+
+#endif // DATA_ADAPTER_HASH_TABLE_TEST_FIXTURES_HPP_INCLUDED
@@ -0,0 +1,446 @@
+#ifndef DATA_ADAPTER_HASH_TABLE_TESTS_HPP_INCLUDED
+#define DATA_ADAPTER_HASH_TABLE_TESTS_HPP_INCLUDED
+
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "fixtures.hpp"
+
+namespace DataAdapter_Tests {
+
+    typedef DataAdapter_HashTable_TestFixtureTemplate<int, int>
+    DataAdapter_HashTable_TestFixture;
+
+    typedef DataAdapter_HashTable_TestFixtureTemplate<std::string, int>
+    DataAdapter_HashTable_StringTestFixture;
+
+    TEST_F( DataAdapter_HashTable_TestFixture, Construction ) {
+        ASSERT_EQ( 0, A.length() );
+        ASSERT_TRUE( A.empty() );
+        ASSERT_EQ( A.begin(), A.end() );
+        ASSERT_EQ( A.end(), A.find( 0x1 ) );
+        ASSERT_FALSE( A.contains( 0x1 ) );
+
+        DataAdapter_HashTable_TestFixture::adapter_t C = { {0x1, 0x10}, {0x2, 0x20}, {0x3, 0x30} };
+
+        ASSERT_EQ( 3, C.length() );
+        ASSERT_EQ( 0x20, C.find( 0x2 )->second );
+
+        {
+            SCOPED_TRACE( "copying" );
+
+            A = C;
+
+            ASSERT_EQ( 3, A.length() );
+            ASSERT_TRUE( A == C );
+
+            DataAdapter_HashTable_TestFixture::adapter_t D( C );
+
+            ASSERT_TRUE( D == C );
+        }
+
+        {
+            SCOPED_TRACE( "moving" );
+
+            DataAdapter_HashTable_TestFixture::adapter_t D( std::move( C ) );
+
+            ASSERT_EQ( 3, D.length() );
+            ASSERT_TRUE( C.empty() );
+            ASSERT_TRUE( D == A );
+        }
+    }
+
+    TEST_F( DataAdapter_HashTable_TestFixture, InsertionBasic ) {
+        {
+            SCOPED_TRACE( "insert" );
+
+            std::pair<DataAdapter_HashTable_TestFixture::adapter_t::iterator, bool> r = A.insert( element_t( 0x1, 0x10 ) );
+
+            ASSERT_TRUE( r.second );
+            ASSERT_EQ( 0x1,  r.first->first );
+            ASSERT_EQ( 0x10, r.first->second );
+
+            //Same key again, nothing changes
+            r = A.insert( element_t( 0x1, 0x11 ) );
+
+            ASSERT_FALSE( r.second );
+            ASSERT_EQ( 0x10, r.first->second );
+            ASSERT_EQ( 1,    A.length() );
+        }
+
+        {
+            SCOPED_TRACE( "operator[]" );
+
+            A[0x2] = 0x20;
+            A[0x2] += 1;
+
+            ASSERT_EQ( 2,    A.length() );
+            ASSERT_EQ( 0x21, A[0x2] );
+        }
+
+        {
+            SCOPED_TRACE( "try_emplace and insert_or_assign" );
+
+            ASSERT_TRUE( A.try_emplace( 0x3, 0x30 ).second );
+            ASSERT_FALSE( A.try_emplace( 0x3, 0x31 ).second );
+            ASSERT_EQ( 0x30, A[0x3] );
+
+            ASSERT_FALSE( A.insert_or_assign( 0x3, 0x32 ).second );
+            ASSERT_EQ( 0x32, A[0x3] );
+        }
+
+        {
+            SCOPED_TRACE( "common interface" );
+
+            A.push_back( element_t( 0x4, 0x40 ) );
+            A.push_front( element_t( 0x5, 0x50 ) );
+            A.sorted_insert( element_t( 0x6, 0x60 ) );
+
+            ASSERT_EQ( 6, A.length() );
+            ASSERT_EQ( 0x40, A.find( element_t( 0x4, 0 ) )->second );
+            ASSERT_EQ( 0x60, A.find_sorted( element_t( 0x6, 0 ) )->second );
+        }
+
+        {
+            SCOPED_TRACE( "assign from our own elements" );
+
+            A.assign( A.cbegin(), A.cend() );
+
+            ASSERT_EQ( 6, A.length() );
+            ASSERT_EQ( 0x32, A[0x3] );
+            ASSERT_EQ( 0x60, A[0x6] );
+        }
+    }
+
+    TEST_F( DataAdapter_HashTable_TestFixture, Growth ) {
+        static const int COUNT = 100000;
+
+        for ( int i = 0; i < COUNT; ++i ) {
+            A[i * 7] = i;
+        }
+
+        ASSERT_EQ( COUNT, A.length() );
+        ASSERT_LE( A.load_factor(), A.max_load_factor() );
+
+        for ( int i = 0; i < COUNT; ++i ) {
+            DataAdapter_HashTable_TestFixture::adapter_t::iterator it = A.find( i * 7 );
+
+            ASSERT_NE( A.end(), it );
+            ASSERT_EQ( i, it->second );
+            ASSERT_FALSE( A.contains( i * 7 + 1 ) );
+        }
+
+        {
+            SCOPED_TRACE( "iteration visits everything once" );
+
+            std::vector<bool> seen( COUNT, false );
+            size_t visited = 0;
+
+            for ( DataAdapter_HashTable_TestFixture::adapter_t::const_iterator it = A.cbegin(); it != A.cend(); ++it ) {
+                ASSERT_FALSE( seen[it->second] );
+                seen[it->second] = true;
+                ++visited;
+            }
+
+            ASSERT_EQ( COUNT, visited );
+        }
+    }
+
+    //Tables smaller than a probe group have to keep an empty slot, or a miss never ends
+    TEST_F( DataAdapter_HashTable_TestFixture, SmallTables ) {
+        for ( int n = 1; n <= 40; ++n ) {
+            DataAdapter_HashTable_TestFixture::adapter_t C;
+
+            for ( int i = 0; i < n; ++i ) {
+                C[i] = i;
+            }
+
+            ASSERT_EQ( n, C.length() );
+            ASSERT_LT( C.length(), C.bucket_count() );
+
+            for ( int i = 0; i < n; ++i ) {
+                ASSERT_EQ( i, C.find( i )->second );
+            }
+
+            ASSERT_EQ( C.end(), C.find( -1 ) );
+            ASSERT_FALSE( C.contains( n ) );
+
+            //Tombstones take no room from the empty slot either
+            for ( int i = 0; i < n; ++i ) {
+                C.erase( i );
+                C[n + i] = i;
+            }
+
+            ASSERT_EQ( n, C.length() );
+            ASSERT_FALSE( C.contains( 0 ) );
+        }
+    }
+
+    struct hash_table_throwing_value {
+        static bool fail;
+
+        int v;
+
+        hash_table_throwing_value( int x = 0 ) : v( x ) {
+            if ( fail ) {
+                throw std::runtime_error( "hash_table_throwing_value" );
+            }
+        }
+
+        bool operator==( const hash_table_throwing_value &o ) const {
+            return this->v == o.v;
+        }
+
+        bool operator<( const hash_table_throwing_value &o ) const {
+            return this->v < o.v;
+        }
+    };
+
+    bool hash_table_throwing_value::fail = false;
+
+    TEST( DataAdapter_HashTable_Exceptions, ThrowingConstructors ) {
+        DataAdapter<da::hash_table<int, hash_table_throwing_value> > C;
+
+        for ( int i = 0; i < 6; ++i ) {
+            C.try_emplace( i, i );
+        }
+
+        hash_table_throwing_value::fail = true;
+
+        ASSERT_THROW( C.try_emplace( 6, 6 ), std::runtime_error );
+        ASSERT_THROW( C.try_emplace( 7, 7 ), std::runtime_error );
+
+        hash_table_throwing_value::fail = false;
+
+        ASSERT_EQ( 6, C.length() );
+        ASSERT_EQ( C.end(), C.find( 6 ) );
+        ASSERT_EQ( 6, std::distance( C.begin(), C.end() ) );
+
+        //The slots given up on are free again
+        for ( int i = 6; i < 100; ++i ) {
+            C.try_emplace( i, i );
+        }
+
+        ASSERT_EQ( 100, C.length() );
+        ASSERT_EQ( 7, C.find( 7 )->second.v );
+    }
+
+    struct hash_table_throwing_hash {
+        //Throws on the call after this many more, if not negative
+        static int countdown;
+
+        size_t operator()( int x ) const {
+            if ( countdown >= 0 && countdown-- == 0 ) {
+                throw std::runtime_error( "hash_table_throwing_hash" );
+            }
+
+            return std::hash<int>()( x );
+        }
+    };
+
+    int hash_table_throwing_hash::countdown = -1;
+
+    TEST( DataAdapter_HashTable_Exceptions, ThrowingHashDuringGrowth ) {
+        //The 15th element grows the table, hashing every element again
+        for ( int k = 0; k < 20; ++k ) {
+            DataAdapter<da::hash_table<int, int, hash_table_throwing_hash> > C;
+
+            for ( int i = 0; i < 14; ++i ) {
+                C.try_emplace( i, i );
+            }
+
+            hash_table_throwing_hash::countdown = k;
+
+            bool threw = false;
+
+            try {
+                C.try_emplace( 14, 14 );
+
+            } catch ( const std::runtime_error & ) {
+                threw = true;
+            }
+
+            hash_table_throwing_hash::countdown = -1;
+
+            size_t n = threw ? 14 : 15;
+
+            ASSERT_EQ( n, C.length() );
+            ASSERT_EQ( n, static_cast<size_t>( std::distance( C.begin(), C.end() ) ) );
+
+            for ( int i = 0; i < static_cast<int>( n ); ++i ) {
+                ASSERT_EQ( i, C.find( i )->second );
+            }
+
+            ASSERT_EQ( threw, C.end() == C.find( 14 ) );
+        }
+    }
+
+    TEST_F( DataAdapter_HashTable_TestFixture, Erasure ) {
+        for ( int i = 0; i < 1000; ++i ) {
+            A[i] = i;
+        }
+
+        {
+            SCOPED_TRACE( "erase by key" );
+
+            for ( int i = 0; i < 1000; i += 2 ) {
+                ASSERT_EQ( 1, A.erase( i ) );
+            }
+
+            ASSERT_EQ( 0,   A.erase( 0 ) );
+            ASSERT_EQ( 500, A.length() );
+
+            for ( int i = 0; i < 1000; ++i ) {
+                ASSERT_EQ( i % 2 == 1, A.contains( i ) );
+            }
+        }
+
+        {
+            SCOPED_TRACE( "churn through tombstones" );
+
+            size_t buckets = A.bucket_count();
+
+            for ( int round = 0; round < 50; ++round ) {
+                for ( int i = 0; i < 100; ++i ) {
+                    A[10000 + i] = i;
+                }
+
+                for ( int i = 0; i < 100; ++i ) {
+                    ASSERT_EQ( 1, A.erase( 10000 + i ) );
+                }
+            }
+
+            ASSERT_EQ( 500, A.length() );
+            ASSERT_EQ( buckets, A.bucket_count() );
+        }
+
+        {
+            SCOPED_TRACE( "erase by iterator" );
+
+            size_t n = 0;
+
+            for ( DataAdapter_HashTable_TestFixture::adapter_t::iterator it = A.begin(); it != A.end(); ) {
+                if ( it->first < 500 ) {
+                    it = A.erase( it );
+                    ++n;
+
+                } else {
+                    ++it;
+                }
+            }
+
+            ASSERT_EQ( 250, n );
+            ASSERT_EQ( 250, A.length() );
+        }
+
+        {
+            SCOPED_TRACE( "erase_if and unordered_erase" );
+
+            ASSERT_EQ( 50, A.erase_if( []( const element_t & e ) {
+                return e.first % 10 == 1;
+            } ) );
+
+            ASSERT_EQ( 200, A.length() );
+            ASSERT_FALSE( A.contains( 501 ) );
+            ASSERT_TRUE( A.contains( 503 ) );
+
+            A.unordered_erase( A.find( 503 ) );
+
+            ASSERT_EQ( 199, A.length() );
+            ASSERT_FALSE( A.contains( 503 ) );
+
+            A[501] = 501;
+            A[503] = 503;
+        }
+
+        {
+            SCOPED_TRACE( "pop and clear" );
+
+            element_t e = A.pop_front();
+
+            ASSERT_FALSE( A.contains( e.first ) );
+            ASSERT_EQ( 200, A.length() );
+
+            A.resize( 10 );
+
+            ASSERT_EQ( 10, A.length() );
+
+            A.clear();
+
+            ASSERT_TRUE( A.empty() );
+            ASSERT_EQ( A.begin(), A.end() );
+        }
+    }
+
+    TEST_F( DataAdapter_HashTable_StringTestFixture, StringKeys ) {
+        A["one"] = 1;
+        A["two"] = 2;
+        A.emplace( "three", 3 );
+
+        ASSERT_EQ( 3, A.length() );
+        ASSERT_EQ( 2, A.find( "two" )->second );
+        ASSERT_EQ( A.end(), A.find( "four" ) );
+
+        A.reserve( 1000 );
+
+        ASSERT_GE( A.capacity(), 1000 );
+        ASSERT_EQ( 3, A.find( "three" )->second );
+
+        for ( int i = 0; i < 1000; ++i ) {
+            A[std::to_string( i )] = i;
+        }
+
+        ASSERT_EQ( 1003, A.length() );
+        ASSERT_EQ( 999, A["999"] );
+    }
+
+    TEST_F( DataAdapter_HashTable_TestFixture, Hashing ) {
+        for ( int i = 0; i < 100; ++i ) {
+            A.push_back( element_t( i, i * 10 ) );
+            B.push_back( element_t( 99 - i, ( 99 - i ) * 10 ) );
+        }
+
+        //Equal whatever order the entries went in, and hashed the same
+        ASSERT_TRUE( A == B );
+        ASSERT_EQ( A.hash(), B.hash() );
+        ASSERT_EQ( 0, A.compare( B ) );
+
+        B[5] = 0;
+
+        ASSERT_TRUE( A != B );
+        ASSERT_NE( A.hash(), B.hash() );
+    }
+
+    TEST_F( DataAdapter_HashTable_TestFixture, CommonInterface ) {
+        typedef DataAdapter_HashTable_TestFixture::adapter_t::_Base base_t;
+
+        A.push_back( element_t( 0x3, 0x30 ) );
+        A.push_back( element_t( 0x1, 0x10 ) );
+        A.push_back( element_t( 0x2, 0x20 ) );
+
+        //sort() has nothing to do, and find_sorted is still a key lookup
+        A.sort();
+
+        ASSERT_EQ( 0x20, A.find_sorted( element_t( 0x2, 0 ) )->second );
+
+        base_t &base = A;
+
+        base_t::iterator it = base.find( element_t( 0x2, 0x20 ) );
+
+        ASSERT_NE( base.end(), it );
+        ASSERT_EQ( 0x20, it->second );
+
+#ifdef DATA_ADAPTER_DYNAMIC_DISPATCH
+        base.sort();
+#else
+        //Without virtual dispatch the base only knows the generic sort, which needs random access
+        ASSERT_THROW( base.sort(), std::logic_error );
+#endif
+
+        ASSERT_EQ( 3, A.length() );
+    }
+}
+
+#endif // DATA_ADAPTER_HASH_TABLE_TESTS_HPP_INCLUDED
@@ -0,0 +1,37 @@
+#ifndef DATA_ADAPTER_MAPPED_TEST_FIXTURES_HPP_INCLUDED
+#define DATA_ADAPTER_MAPPED_TEST_FIXTURES_HPP_INCLUDED
+
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <string>
+
+#include <tools.hpp>
+#include <data_adapter>
+
+namespace DataAdapter_Tests {
+
+    template <typename T>
+    class DataAdapter_Mapped_TestFixtureTemplate : public ::testing::Test {
+        public:
+            typedef DataAdapter<da::mapped<T> > adapter_t;
+
+            std::string path;
+
+            //Starts out without a file
+            virtual void SetUp() {
+                const ::testing::TestInfo *info = ::testing::UnitTest::GetInstance()->current_test_info();
+
+                path = ::testing::TempDir() + "data_adapter_mapped_" + info->name() + ".snap";
+
+                std::remove( path.c_str() );
+            }
+
+            virtual void TearDown() {
+                std::remove( path.c_str() );
+            }
+    };
+
+}
+
+#endif // DATA_ADAPTER_MAPPED_TEST_FIXTURES_HPP_INCLUDED
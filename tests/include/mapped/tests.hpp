@@ -0,0 +1,166 @@
+#ifndef DATA_ADAPTER_MAPPED_TESTS_HPP_INCLUDED
+#define DATA_ADAPTER_MAPPED_TESTS_HPP_INCLUDED
+
+#include <algorithm>
+#include <stdexcept>
+
+#include "fixtures.hpp"
+
+namespace DataAdapter_Tests {
+
+    typedef DataAdapter_Mapped_TestFixtureTemplate<int>
+    DataAdapter_Mapped_TestFixture;
+
+    //Without a file, it is just another growable adapter
+    TEST_F( DataAdapter_Mapped_TestFixture, Anonymous ) {
+        adapter_t A;
+
+        for ( int i = 0; i < 10000; ++i ) {
+            A.push_back( ( i * 7919 ) % 10000 );
+        }
+
+        ASSERT_EQ( 10000, A.length() );
+
+        A.sort();
+
+        ASSERT_TRUE( is_sorted( A.begin(), A.end() ) );
+        ASSERT_EQ( 1234, *A.find_sorted( 1234 ) );
+
+        A.erase( A.begin(), A.begin() + 5000 );
+        A.insert( A.begin(), 3, -1 );
+
+        ASSERT_EQ( 5003, A.length() );
+        ASSERT_EQ( -1, A[2] );
+        ASSERT_EQ( 5000, A[3] );
+
+        A.shrink_to_fit();
+
+        ASSERT_EQ( 5003, A.capacity() );
+        ASSERT_EQ( 9999, A.back() );
+
+        //Flushing without a file does nothing
+        A.flush();
+    }
+
+    TEST_F( DataAdapter_Mapped_TestFixture, Persistence ) {
+        {
+            adapter_t A( path.c_str() );
+
+            ASSERT_TRUE( A.empty() );
+
+            //Through several remaps
+            for ( int i = 0; i < 100000; ++i ) {
+                A.push_back( i * 2 );
+            }
+        }
+
+        {
+            //Closed without a flush, so there is nothing to check the elements against
+            da::mapped_snapshot<int> M = da::load_mapped<int>( path.c_str() );
+
+            ASSERT_EQ( 100000, M.length() );
+            ASSERT_FALSE( M.verify() );
+        }
+
+        {
+            adapter_t A( path.c_str() );
+
+            ASSERT_EQ( 100000, A.length() );
+            ASSERT_LE( 100000u, A.capacity() );
+            ASSERT_EQ( 199998, A.back() );
+            ASSERT_EQ( 5000, *A.find_sorted( 5000 ) );
+            ASSERT_EQ( A.end(), A.find_sorted( 5001 ) );
+
+            A.erase( A.begin() + 10, A.end() );
+            A.sorted_insert( 3 );
+
+            A.flush();
+
+            //A snapshot like any other, and readable while the adapter still has it open
+            DataAdapter<int[16]> B;
+
+            da::load( B, path.c_str() );
+
+            ASSERT_EQ( 11, B.length() );
+            ASSERT_TRUE( std::equal( A.begin(), A.end(), B.begin() ) );
+
+            da::mapped_snapshot<int> M = da::load_mapped<int>( path.c_str() );
+
+            ASSERT_EQ( 11, M.length() );
+            ASSERT_EQ( 3, M[2] );
+            ASSERT_TRUE( M.verify() );
+        }
+
+        {
+            //Closing marks the checksum stale again, flushed or not
+            da::mapped_snapshot<int> M = da::load_mapped<int>( path.c_str() );
+
+            ASSERT_EQ( 11, M.length() );
+            ASSERT_FALSE( M.verify() );
+
+            DataAdapter<int[16]> B;
+
+            da::load( B, path.c_str() );
+
+            ASSERT_EQ( 11, B.length() );
+        }
+
+        adapter_t A( path.c_str() );
+
+        ASSERT_EQ( 11, A.length() );
+        ASSERT_EQ( 4, A[3] );
+    }
+
+    TEST_F( DataAdapter_Mapped_TestFixture, Snapshots ) {
+        DataAdapter<int[64]> S;
+
+        for ( int i = 0; i < 50; ++i ) {
+            S.push_back( 50 - i );
+        }
+
+        da::save( S, path.c_str() );
+
+        {
+            //The capacity is what the file holds, so the first push has to grow it
+            adapter_t A( path.c_str() );
+
+            ASSERT_EQ( 50, A.length() );
+            ASSERT_EQ( 50, A.capacity() );
+            ASSERT_TRUE( std::equal( S.begin(), S.end(), A.begin() ) );
+
+            A.advise( da::advice::willneed );
+            A.push_back( 0 );
+            A.advise( da::advice::random );
+            A.sort();
+            A.advise( da::advice::sequential );
+
+            for ( int i = 0; i <= 50; ++i ) {
+                ASSERT_EQ( i, A[i] );
+            }
+
+            A.advise( da::advice::normal );
+        }
+
+        da::load( S, path.c_str() );
+
+        ASSERT_EQ( 51, S.length() );
+        ASSERT_EQ( 50, S.back() );
+    }
+
+    TEST_F( DataAdapter_Mapped_TestFixture, Errors ) {
+        DataAdapter<short[4]> S;
+
+        S.push_back( 1 );
+        da::save( S, path.c_str() );
+
+        ASSERT_THROW( adapter_t A( path.c_str() ), da::snapshot_error );
+        ASSERT_THROW( adapter_t A( ( path + ".missing/x" ).c_str() ), da::snapshot_error );
+
+        //Positions out of bounds throw like any other adapter's
+        adapter_t A;
+
+        ASSERT_THROW( A.erase( A.begin(), A.begin() + 1 ), std::out_of_range );
+    }
+}
+
+#endif // DATA_ADAPTER_MAPPED_TESTS_HPP_INCLUDED
@@ -0,0 +1,175 @@
+#ifndef DATA_ADAPTER_MPMC_QUEUE_TESTS_HPP_INCLUDED
+#define DATA_ADAPTER_MPMC_QUEUE_TESTS_HPP_INCLUDED
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "fixtures.hpp"
+
+namespace DataAdapter_Tests {
+
+    static const int MPMC_TEST_SIZE = 10;
+
+    typedef DataAdapter_MPMC_TestFixtureTemplate<int, MPMC_TEST_SIZE>
+    DataAdapter_MPMC_TestFixture;
+
+    TEST_F( DataAdapter_MPMC_TestFixture, Bounded ) {
+        int x = -1;
+
+        //Rounded up to a power of two
+        ASSERT_EQ( 16, Q.capacity() );
+        ASSERT_TRUE( Q.empty() );
+        ASSERT_FALSE( Q.try_pop( x ) );
+        ASSERT_EQ( -1, x );
+
+        for ( int i = 0; i < 16; ++i ) {
+            ASSERT_TRUE( Q.try_push( i ) );
+        }
+
+        ASSERT_EQ( 16, Q.size() );
+        ASSERT_FALSE( Q.try_push( 100 ) );
+
+        //Around the buffer a few times
+        for ( int i = 16; i < 100; ++i ) {
+            ASSERT_TRUE( Q.try_pop( x ) );
+            ASSERT_EQ( i - 16, x );
+            ASSERT_TRUE( Q.try_emplace( i ) );
+        }
+
+        for ( int i = 84; i < 100; ++i ) {
+            Q.pop( x );
+            ASSERT_EQ( i, x );
+        }
+
+        ASSERT_TRUE( Q.empty() );
+
+        Q.push( 7 );
+        Q.pop( x );
+
+        ASSERT_EQ( 7, x );
+    }
+
+    TEST( DataAdapter_MPMC_Storage, Lifetimes ) {
+        std::shared_ptr<int> p( new int( 5 ) );
+
+        {
+            da::mpmc_queue<std::shared_ptr<int>, 4> Q;
+
+            for ( int i = 0; i < 3; ++i ) {
+                Q.push( p );
+            }
+
+            ASSERT_EQ( 4, p.use_count() );
+
+            std::shared_ptr<int> x;
+
+            ASSERT_TRUE( Q.try_pop( x ) );
+            ASSERT_EQ( p, x );
+            ASSERT_EQ( 4, p.use_count() );
+        }
+
+        //The two still in the queue went with it
+        ASSERT_EQ( 1, p.use_count() );
+    }
+
+    TEST( DataAdapter_MPMC_Move, NoCopies ) {
+        da::mpmc_queue<copy_counter, 8> Q;
+        copy_counter x( 0 );
+
+        copy_counter::copies() = 0;
+
+        for ( int i = 0; i < 100; ++i ) {
+            Q.push( copy_counter( i ) );
+            Q.try_emplace( i );
+
+            Q.pop( x );
+            ASSERT_EQ( i, x.value );
+            Q.pop( x );
+        }
+
+        ASSERT_EQ( 0, copy_counter::copies() );
+
+        std::string s( 100, 'x' );
+        da::mpmc_queue<std::string, 2> S;
+
+        //A copy, which is made before the element's slot is claimed
+        ASSERT_TRUE( S.try_push( s ) );
+        ASSERT_TRUE( S.try_push( s ) );
+        ASSERT_FALSE( S.try_push( s ) );
+        ASSERT_EQ( 100, s.size() );
+    }
+
+    /*
+        Several producers and consumers at once. Every value has to come out exactly once, and since each
+        consumer pops in queue order, the values of each producer have to come out in the order it pushed them.
+    */
+    TEST( DataAdapter_MPMC_Stress, Transfer ) {
+        static const int PRODUCERS = 4, CONSUMERS = 3, COUNT = 100000;
+
+        da::mpmc_queue<int, 64> Q;
+        std::vector<std::thread> threads;
+        std::vector<std::vector<int> > popped( CONSUMERS );
+
+        for ( int p = 0; p < PRODUCERS; ++p ) {
+            threads.push_back( std::thread( [&Q, p] {
+                for ( int i = 0; i < COUNT; ++i ) {
+                    //Values are the producer times COUNT plus the index
+                    if ( i % 2 == 0 ) {
+                        Q.push( p * COUNT + i );
+
+                    } else {
+                        while ( !Q.try_push( p * COUNT + i ) ) {
+                            std::this_thread::yield();
+                        }
+                    }
+                }
+            } ) );
+        }
+
+        for ( int c = 0; c < CONSUMERS; ++c ) {
+            threads.push_back( std::thread( [&Q, &popped, c] {
+                //Consumers take turns at a share each, the last one with what is left over
+                int share = c + 1 < CONSUMERS ? PRODUCERS * COUNT / CONSUMERS : PRODUCERS * COUNT - ( CONSUMERS - 1 ) * ( PRODUCERS * COUNT / CONSUMERS );
+
+                for ( int i = 0, x; i < share; ++i ) {
+                    Q.pop( x );
+                    popped[c].push_back( x );
+                }
+            } ) );
+        }
+
+        for ( size_t t = 0; t < threads.size(); ++t ) {
+            threads[t].join();
+        }
+
+        std::vector<int> all;
+
+        for ( int c = 0; c < CONSUMERS; ++c ) {
+            std::vector<int> last( PRODUCERS, -1 );
+
+            for ( size_t i = 0; i < popped[c].size(); ++i ) {
+                int x = popped[c][i];
+
+                ASSERT_LT( last[x / COUNT], x );
+                last[x / COUNT] = x;
+            }
+
+            all.insert( all.end(), popped[c].begin(), popped[c].end() );
+        }
+
+        std::sort( all.begin(), all.end() );
+
+        ASSERT_EQ( static_cast<size_t>( PRODUCERS * COUNT ), all.size() );
+
+        for ( int i = 0; i < PRODUCERS * COUNT; ++i ) {
+            ASSERT_EQ( i, all[i] );
+        }
+
+        ASSERT_TRUE( Q.empty() );
+    }
+}
+
+#endif // DATA_ADAPTER_MPMC_QUEUE_TESTS_HPP_INCLUDED
@@ -0,0 +1,22 @@
+#ifndef DATA_ADAPTER_READ_MOSTLY_TEST_FIXTURES_HPP_INCLUDED
+#define DATA_ADAPTER_READ_MOSTLY_TEST_FIXTURES_HPP_INCLUDED
+
+#include <gtest/gtest.h>
+
+#include <tools.hpp>
+#include <data_adapter>
+
+namespace DataAdapter_Tests {
+
+    template <typename T, size_t N>
+    class DataAdapter_Read_Mostly_TestFixtureTemplate : public ::testing::Test {
+        public:
+            typedef DataAdapter<T[N]> adapter_t;
+            typedef da::read_mostly<adapter_t> read_mostly_t;
+
+            read_mostly_t R;
+    };
+
+}
+
+#endif // DATA_ADAPTER_READ_MOSTLY_TEST_FIXTURES_HPP_INCLUDED
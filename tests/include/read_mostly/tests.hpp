@@ -0,0 +1,171 @@
+#ifndef DATA_ADAPTER_READ_MOSTLY_TESTS_HPP_INCLUDED
+#define DATA_ADAPTER_READ_MOSTLY_TESTS_HPP_INCLUDED
+
+#include <atomic>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "fixtures.hpp"
+
+namespace DataAdapter_Tests {
+
+    static const int READ_MOSTLY_TEST_SIZE = 20;
+
+    typedef DataAdapter_Read_Mostly_TestFixtureTemplate<int, READ_MOSTLY_TEST_SIZE>
+    DataAdapter_Read_Mostly_TestFixture;
+
+    TEST_F( DataAdapter_Read_Mostly_TestFixture, Versions ) {
+        ASSERT_TRUE( R.read().empty() );
+
+        R.update( []( adapter_t &a ) {
+            for ( int i = 1; i <= 10; ++i ) {
+                a.push_back( i * 2 );
+            }
+        } );
+
+        read_mostly_t::snapshot s = R.read();
+
+        ASSERT_EQ( 10, s.length() );
+        ASSERT_EQ( 10, *s.find_sorted( 10 ) );
+        ASSERT_EQ( s.end(), s.find_sorted( 11 ) );
+        ASSERT_EQ( 6, *s.find( 6 ) );
+        ASSERT_TRUE( s.contains( 20 ) );
+        ASSERT_EQ( 1, s->count( 4 ) );
+
+        int sum = 0;
+
+        for ( read_mostly_t::const_iterator it = s.begin(); it != s.end(); ++it ) {
+            sum += *it;
+        }
+
+        ASSERT_EQ( 110, sum );
+
+        //The writer has to wait for s to go away, so it goes on another thread
+        std::thread writer( [this] {
+            R.update( []( adapter_t &a ) {
+                a.sorted_insert( 11 );
+            } );
+        } );
+
+        while ( !R.read().contains( 11 ) ) {
+            std::this_thread::yield();
+        }
+
+        //The new version is published, and s still has the old one
+        ASSERT_EQ( 11, R.read().length() );
+        ASSERT_EQ( 10, s.length() );
+        ASSERT_FALSE( s.contains( 11 ) );
+
+        {
+            read_mostly_t::snapshot gone( std::move( s ) );
+        }
+
+        writer.join();
+
+        ASSERT_EQ( 11, *R.read().find_sorted( 11 ) );
+
+        adapter_t A;
+        A.push_back( 5 );
+
+        R.store( A );
+
+        ASSERT_EQ( 1, R.read().length() );
+        ASSERT_EQ( 5, R.read()->front() );
+    }
+
+    TEST_F( DataAdapter_Read_Mostly_TestFixture, Throwing ) {
+        R.update( []( adapter_t &a ) {
+            a.push_back( 1 );
+        } );
+
+        //Nothing of a change that throws is published
+        ASSERT_THROW( R.update( []( adapter_t &a ) {
+            a.push_back( 2 );
+            throw std::runtime_error( "Not this one" );
+        } ), std::runtime_error );
+
+        ASSERT_EQ( 1, R.read().length() );
+        ASSERT_EQ( 1, R.read()->back() );
+    }
+
+    TEST( DataAdapter_Read_Mostly_Storage, Lifetimes ) {
+        typedef DataAdapter<std::shared_ptr<int>[8]> adapter_t;
+
+        std::shared_ptr<int> p( new int( 5 ) );
+
+        {
+            da::read_mostly<adapter_t, 4> R;
+
+            for ( int i = 1; i <= 8; ++i ) {
+                R.update( [&p]( adapter_t &a ) {
+                    a.push_back( p );
+                } );
+
+                //Every version before is gone
+                ASSERT_EQ( i + 1, p.use_count() );
+            }
+
+            ASSERT_EQ( p, R.read()->back() );
+        }
+
+        ASSERT_EQ( 1, p.use_count() );
+    }
+
+    /*
+        Readers check that every version they see is whole while a writer publishes new ones as fast as it
+        can. Version v holds v % 16 + 1 copies of v, so a version changed under a reader, or read after
+        being deleted, would show up as a wrong length or mixed values.
+    */
+    TEST( DataAdapter_Read_Mostly_Stress, Readers ) {
+        static const int READERS = 4, VERSIONS = 500;
+
+        typedef DataAdapter<int[16]> adapter_t;
+
+        da::read_mostly<adapter_t, 2> R;
+        std::atomic<bool> done( false );
+        std::vector<std::thread> threads;
+        std::atomic<int> errors( 0 );
+
+        R.update( []( adapter_t &a ) {
+            a.push_back( 0 );
+        } );
+
+        for ( int r = 0; r < READERS; ++r ) {
+            threads.push_back( std::thread( [&R, &done, &errors] {
+                int last = 0;
+
+                while ( !done.load() ) {
+                    da::read_mostly<adapter_t, 2>::snapshot s = R.read();
+                    int v = s->front();
+
+                    //Versions only go forwards
+                    if ( v < last || static_cast<int>( s.length() ) != v % 16 + 1 || s.count( v ) != s.length() ) {
+                        ++errors;
+                    }
+
+                    last = v;
+                }
+            } ) );
+        }
+
+        for ( int v = 1; v < VERSIONS; ++v ) {
+            R.update( [v]( adapter_t &a ) {
+                a.clear();
+                a.insert( a.begin(), v % 16 + 1, v );
+            } );
+        }
+
+        done.store( true );
+
+        for ( size_t t = 0; t < threads.size(); ++t ) {
+            threads[t].join();
+        }
+
+        ASSERT_EQ( 0, errors.load() );
+        ASSERT_EQ( VERSIONS - 1, R.read()->front() );
+    }
+}
+
+#endif // DATA_ADAPTER_READ_MOSTLY_TESTS_HPP_INCLUDED
@@ -0,0 +1,31 @@
+#ifndef DATA_ADAPTER_RING_TEST_FIXTURES_HPP_INCLUDED
+#define DATA_ADAPTER_RING_TEST_FIXTURES_HPP_INCLUDED
+
+#include <gtest/gtest.h>
+
+#include <tools.hpp>
+#include <data_adapter>
+
+namespace DataAdapter_Tests {
+
+    template <typename T, size_t N>
+    class DataAdapter_Ring_TestFixtureTemplate : public ::testing::Test {
+        public:
+            typedef DataAdapter<da::ring<T, N> > adapter_t;
+
+            const T k[N] = {0x1, 0x2, 0x3, 0x4, 0x5, 0x6, 0x7, 0x8, 0x9, 0x10};
+
+            adapter_t A, B;
+
+            //Moves head to the middle of the storage, so everything after this wraps around
+            void rotate( adapter_t &a, size_t n ) {
+                for ( size_t i = 0; i < n; ++i ) {
+                    a.push_back( 0 );
+                    a.pop_front();
+                }
+            }
+    };
+
+}
+
+#endif // DATA_ADAPTER_RING_TEST_FIXTURES_HPP_INCLUDED
@@ -0,0 +1,381 @@
+#ifndef DATA_ADAPTER_RING_TESTS_HPP_INCLUDED
+#define DATA_ADAPTER_RING_TESTS_HPP_INCLUDED
+
+#include <deque>
+#include <iterator>
+#include <list>
+#include <memory>
+#include <sstream>
+
+#include "fixtures.hpp"
+
+namespace DataAdapter_Tests {
+
+    static const int RING_TEST_SIZE = 10;
+
+    typedef DataAdapter_Ring_TestFixtureTemplate<int, RING_TEST_SIZE>
+    DataAdapter_Ring_TestFixture;
+
+    TEST_F( DataAdapter_Ring_TestFixture, Construction ) {
+        ASSERT_EQ( 0, A.length() );
+        ASSERT_EQ( RING_TEST_SIZE, A.capacity() );
+
+        ASSERT_NO_THROW(
+            A.assign( k, k + A.capacity() )
+        );
+
+        ASSERT_TRUE( A.full() );
+        ASSERT_THROW( A.push_back( 0x11 ), std::out_of_range );
+        ASSERT_THROW( A.push_front( 0x11 ), std::out_of_range );
+
+        DataAdapter_Ring_TestFixture::adapter_t C( 3, 0x4 );
+
+        ASSERT_EQ( 3,   C.length() );
+        ASSERT_EQ( 0x4, C[0] );
+        ASSERT_EQ( 0x4, C[2] );
+
+        {
+            SCOPED_TRACE( "copying a wrapped buffer" );
+
+            rotate( B, 7 );
+            B.assign( k, k + RING_TEST_SIZE );
+
+            DataAdapter_Ring_TestFixture::adapter_t D( B );
+
+            ASSERT_TRUE( D == A );
+            ASSERT_TRUE( D == B );
+
+            C = B;
+
+            ASSERT_EQUAL_RANGE( DataAdapter_Ring_TestFixture::adapter_t::iterator,
+                                C.begin(), C.end(), B.begin() );
+        }
+    }
+
+    TEST_F( DataAdapter_Ring_TestFixture, Queue ) {
+        //Push and pop far more than the capacity, so the indices go around many times
+        int next_in = 0, next_out = 0;
+
+        for ( int round = 0; round < 100; ++round ) {
+            while ( !A.full() ) {
+                A.push_back( next_in++ );
+            }
+
+            for ( int i = 0; i < 3; ++i ) {
+                ASSERT_EQ( next_out++, A.pop_front() );
+            }
+
+            ASSERT_EQ( next_out, A.front() );
+            ASSERT_EQ( next_in - 1, A.back() );
+        }
+
+        {
+            SCOPED_TRACE( "the other way around" );
+
+            A.clear();
+
+            for ( int i = 0; i < 25; ++i ) {
+                A.push_front( i );
+
+                if ( A.full() ) {
+                    ASSERT_EQ( i - RING_TEST_SIZE + 1, A.pop_back() );
+                }
+            }
+
+            ASSERT_EQ( 24, A.front() );
+            ASSERT_EQ( 16, A.back() );
+        }
+
+        ASSERT_EQ( 0, B.pop_front() );
+        ASSERT_EQ( 0, B.pop_back() );
+    }
+
+    TEST_F( DataAdapter_Ring_TestFixture, IteratorsWrap ) {
+        rotate( A, 6 );
+        A.assign( k, k + RING_TEST_SIZE );
+
+        ASSERT_EQ( RING_TEST_SIZE, A.end() - A.begin() );
+        ASSERT_EQ( 0x1,  *A.begin() );
+        ASSERT_EQ( 0x10, *( A.end() - 1 ) );
+        ASSERT_EQ( 0x5,  A.begin()[4] );
+        ASSERT_EQ( A.cbegin(), A.begin() );
+
+        ASSERT_TRUE( std::equal( A.begin(), A.end(), k ) );
+
+        int n = RING_TEST_SIZE;
+
+        for ( DataAdapter_Ring_TestFixture::adapter_t::reverse_iterator it = A.rbegin(); it != A.rend(); ++it ) {
+            ASSERT_EQ( k[--n], *it );
+        }
+
+        ASSERT_EQ( A.begin() + 4, A.find( 0x5 ) );
+        ASSERT_EQ( A.begin() + 4, A.find_sorted( 0x5 ) );
+    }
+
+    TEST_F( DataAdapter_Ring_TestFixture, Manipulation ) {
+        typedef std::deque<int> model_t;
+
+        model_t M;
+
+        //Random inserts and erases anywhere, checked against std::deque
+        unsigned state = 0x2545F491;
+
+        for ( int i = 0; i < 5000; ++i ) {
+            state ^= state << 13;
+            state ^= state >> 17;
+            state ^= state << 5;
+
+            size_t pos = M.empty() ? 0 : state % ( M.size() + 1 );
+
+            if ( ( state >> 8 ) % 3 != 0 && !A.full() ) {
+                size_t n = std::min<size_t>( ( state >> 12 ) % 3 + 1, A.capacity() - A.length() );
+
+                A.insert( A.begin() + pos, n, i );
+                M.insert( M.begin() + pos, n, i );
+
+            } else if ( !M.empty() ) {
+                size_t n = std::min<size_t>( ( state >> 12 ) % 3 + 1, M.size() - std::min( pos, M.size() - 1 ) );
+
+                pos = std::min( pos, M.size() - 1 );
+
+                A.erase( A.begin() + pos, A.begin() + pos + n );
+                M.erase( M.begin() + pos, M.begin() + pos + n );
+            }
+
+            ASSERT_EQ( M.size(), A.length() );
+            ASSERT_TRUE( std::equal( M.begin(), M.end(), A.begin() ) );
+        }
+    }
+
+    TEST_F( DataAdapter_Ring_TestFixture, InsertionRanges ) {
+        rotate( A, 7 );
+
+        A.push_back( 0x100 );
+        A.push_back( 0x200 );
+
+        {
+            SCOPED_TRACE( "bidirectional range, wrapping" );
+
+            std::list<int> l( k, k + 4 );
+
+            A.insert( A.begin() + 1, l.begin(), l.end() );
+
+            int expected[] = {0x100, 0x1, 0x2, 0x3, 0x4, 0x200};
+
+            ASSERT_EQ( 6, A.length() );
+            ASSERT_TRUE( std::equal( A.begin(), A.end(), expected ) );
+        }
+
+        {
+            SCOPED_TRACE( "input range, wrapping" );
+
+            std::istringstream in( "7 8 9" );
+
+            A.insert( A.begin() + 5, std::istream_iterator<int>( in ), std::istream_iterator<int>() );
+
+            int expected[] = {0x100, 0x1, 0x2, 0x3, 0x4, 7, 8, 9, 0x200};
+
+            ASSERT_EQ( 9, A.length() );
+            ASSERT_TRUE( std::equal( A.begin(), A.end(), expected ) );
+        }
+
+        {
+            SCOPED_TRACE( "too long ranges throw and change nothing" );
+
+            std::list<int> l( 2, 0 );
+            std::istringstream in( "1 2" );
+
+            ASSERT_THROW( A.insert( A.begin(), l.begin(), l.end() ), std::out_of_range );
+            ASSERT_THROW( A.insert( A.begin(), std::istream_iterator<int>( in ), std::istream_iterator<int>() ),
+                          std::out_of_range );
+
+            int expected[] = {0x100, 0x1, 0x2, 0x3, 0x4, 7, 8, 9, 0x200};
+
+            ASSERT_EQ( 9, A.length() );
+            ASSERT_TRUE( std::equal( A.begin(), A.end(), expected ) );
+        }
+
+        {
+            SCOPED_TRACE( "count and value, append and assign" );
+
+            B.insert( B.begin(), 3, 5 );
+            B.append( k, k + 2 );
+
+            int expected[] = {5, 5, 5, 0x1, 0x2};
+
+            ASSERT_EQ( 5, B.length() );
+            ASSERT_TRUE( std::equal( B.begin(), B.end(), expected ) );
+
+            std::list<int> l( k + 2, k + 5 );
+
+            B.assign( l.begin(), l.end() );
+
+            ASSERT_EQ( 3, B.length() );
+            ASSERT_TRUE( std::equal( k + 2, k + 5, B.begin() ) );
+
+            B.assign( 4, 7 );
+
+            ASSERT_EQ( 4, B.length() );
+            ASSERT_EQ( 4, std::count( B.begin(), B.end(), 7 ) );
+        }
+
+        {
+            SCOPED_TRACE( "assign from our own elements, wrapping" );
+
+            A.assign( A.begin() + 1, A.end() - 1 );
+
+            int expected[] = {0x1, 0x2, 0x3, 0x4, 7, 8, 9};
+
+            ASSERT_EQ( 7, A.length() );
+            ASSERT_TRUE( std::equal( A.begin(), A.end(), expected ) );
+        }
+    }
+
+    TEST_F( DataAdapter_Ring_TestFixture, Erasing ) {
+        rotate( A, 6 );
+
+        A.assign( k, k + RING_TEST_SIZE );
+
+        {
+            SCOPED_TRACE( "erase_if, wrapping" );
+
+            ASSERT_EQ( 5, A.erase_if( []( int e ) {
+                return e % 2 == 0;
+            } ) );
+
+            int expected[] = {0x1, 0x3, 0x5, 0x7, 0x9};
+
+            ASSERT_EQ( 5, A.length() );
+            ASSERT_TRUE( std::equal( A.begin(), A.end(), expected ) );
+        }
+
+        {
+            SCOPED_TRACE( "unordered_erase" );
+
+            ASSERT_EQ( A.begin(), A.unordered_erase( A.begin() ) );
+
+            int expected[] = {0x9, 0x3, 0x5, 0x7};
+
+            ASSERT_EQ( 4, A.length() );
+            ASSERT_TRUE( std::equal( A.begin(), A.end(), expected ) );
+
+            ASSERT_EQ( A.end(), A.unordered_erase( A.end() - 1 ) );
+            ASSERT_EQ( 3, A.length() );
+
+            ASSERT_THROW( A.unordered_erase( A.end() ), std::out_of_range );
+        }
+    }
+
+    TEST_F( DataAdapter_Ring_TestFixture, Sorting ) {
+        rotate( A, 5 );
+
+        for ( int i = 0; i < RING_TEST_SIZE; ++i ) {
+            A.push_back( ( i * 7 ) % RING_TEST_SIZE );
+        }
+
+        A.sort();
+
+        ASSERT_TRUE( DataAdapter_Tests::is_sorted( A.begin(), A.end() ) );
+        ASSERT_EQ( 0, A.front() );
+        ASSERT_EQ( RING_TEST_SIZE - 1, A.back() );
+
+        {
+            SCOPED_TRACE( "sorted_insert" );
+
+            A.erase( A.begin() + 3 );
+            A.erase( A.begin() + 7 );
+
+            rotate( A, 3 );
+            A.pop_back();
+            A.pop_back();
+            A.pop_back();
+
+            A.sorted_insert( 5 );
+            A.sorted_insert( 0 );
+            A.sorted_insert( 100 );
+
+            ASSERT_TRUE( DataAdapter_Tests::is_sorted( A.begin(), A.end() ) );
+            ASSERT_EQ( 100, A.back() );
+        }
+
+        {
+            SCOPED_TRACE( "batch" );
+
+            A.clear();
+            rotate( A, 8 );
+
+            A.push_back( 0x2 );
+            A.push_back( 0x8 );
+
+            const int batch[] = { 0x9, 0x1, 0x5, 0x2 };
+            const int expected[] = { 0x1, 0x2, 0x2, 0x5, 0x8, 0x9 };
+
+            ASSERT_EQ( A.begin(), A.sorted_insert( batch, batch + 4 ) );
+            ASSERT_TRUE( std::equal( A.begin(), A.end(), expected ) );
+        }
+
+        {
+            SCOPED_TRACE( "linearize" );
+
+            int *d = A.linearize();
+
+            ASSERT_TRUE( std::equal( A.begin(), A.end(), d ) );
+        }
+    }
+
+    TEST( DataAdapter_Ring_Sorting, Parallel ) {
+        typedef DataAdapter<da::ring<int, 1 << 16> > adapter_t;
+
+        //Too big for the stack
+        std::unique_ptr<adapter_t> A( new adapter_t() );
+
+        for ( int i = 0; i < 1000; ++i ) {
+            A->push_back( 0 );
+            A->pop_front();
+        }
+
+        //Wrapped around, so sorting has to linearize first
+        for ( int i = 0; i < ( 1 << 16 ); ++i ) {
+            A->push_back( static_cast<int>( ( i * 40503u ) & 0xffff ) );
+        }
+
+        A->sort( 4 );
+
+        for ( int i = 0; i < ( 1 << 16 ); ++i ) {
+            ASSERT_EQ( i, ( *A )[i] );
+        }
+    }
+
+    TEST( DataAdapter_Ring_Move, NoCopies ) {
+        typedef DataAdapter<da::ring<copy_counter, 8> > adapter_t;
+
+        adapter_t A;
+
+        copy_counter::copies() = 0;
+
+        A.push_back( copy_counter( 2 ) );
+        A.push_front( copy_counter( 0 ) );
+        A.insert( A.begin() + 1, copy_counter( 1 ) );
+        A.sorted_insert( copy_counter( 3 ) );
+        A.emplace_back( 5 );
+        A.emplace( A.begin() + 4, 4 );
+
+        ASSERT_EQ( 6, A.length() );
+
+        for ( int i = 0; i < 6; ++i ) {
+            ASSERT_EQ( i, A[i].value );
+        }
+
+        ASSERT_EQ( 0, A.pop_front().value );
+        ASSERT_EQ( 5, A.pop_back().value );
+
+        A.erase( A.begin() + 1 );
+
+        adapter_t B( std::move( A ) );
+
+        ASSERT_EQ( 3, B.length() );
+        ASSERT_EQ( 0, copy_counter::copies() );
+    }
+}
+
+#endif // DATA_ADAPTER_RING_TESTS_HPP_INCLUDED
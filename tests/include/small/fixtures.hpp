@@ -0,0 +1,35 @@
+#ifndef DATA_ADAPTER_SMALL_TEST_FIXTURES_HPP_INCLUDED
+#define DATA_ADAPTER_SMALL_TEST_FIXTURES_HPP_INCLUDED
+
+#include <gtest/gtest.h>
+
+#include <tools.hpp>
+#include <data_adapter>
+
+namespace DataAdapter_Tests {
+
+    template <typename T, size_t N>
+    class DataAdapter_Small_TestFixtureTemplate : public ::testing::Test {
+        public:
+            typedef counting_allocator<T> allocator_t;
+            typedef DataAdapter<da::small<T, N, allocator_t> > adapter_t;
+
+            int blocks;
+            size_t elements;
+
+            adapter_t A, B;
+
+            DataAdapter_Small_TestFixtureTemplate()
+                : blocks( 0 ), elements( 0 ), A( allocator_t( &blocks, &elements ) ), B( allocator_t( &blocks, &elements ) ) {}
+
+            //Whether the elements are in the object itself
+            static bool is_inline( const adapter_t &a ) {
+                const char *p = reinterpret_cast<const char *>( a.data() );
+
+                return p >= reinterpret_cast<const char *>( &a ) && p < reinterpret_cast<const char *>( &a + 1 );
+            }
+    };
+
+}
+
+#endif // DATA_ADAPTER_SMALL_TEST_FIXTURES_HPP_INCLUDED
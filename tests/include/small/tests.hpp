@@ -0,0 +1,290 @@
+#ifndef DATA_ADAPTER_SMALL_TESTS_HPP_INCLUDED
+#define DATA_ADAPTER_SMALL_TESTS_HPP_INCLUDED
+
+#include <vector>
+
+#include "fixtures.hpp"
+
+namespace DataAdapter_Tests {
+
+    static const int SMALL_TEST_SIZE = 16;
+
+    typedef DataAdapter_Small_TestFixtureTemplate<int, SMALL_TEST_SIZE>
+    DataAdapter_Small_TestFixture;
+
+    TEST_F( DataAdapter_Small_TestFixture, Spilling ) {
+        ASSERT_EQ( 0, A.length() );
+        ASSERT_EQ( SMALL_TEST_SIZE, A.capacity() );
+        ASSERT_TRUE( is_inline( A ) );
+
+        {
+            SCOPED_TRACE( "inline" );
+
+            for ( int i = 0; i < SMALL_TEST_SIZE; ++i ) {
+                A.push_back( i );
+            }
+
+            ASSERT_TRUE( A.full() );
+            ASSERT_TRUE( is_inline( A ) );
+            ASSERT_EQ( 0, blocks );
+        }
+
+        {
+            SCOPED_TRACE( "heap" );
+
+            A.push_front( -1 );
+
+            ASSERT_FALSE( is_inline( A ) );
+            ASSERT_EQ( 1, blocks );
+            ASSERT_LT( SMALL_TEST_SIZE, A.capacity() );
+            ASSERT_EQ( A.capacity(), elements );
+
+            for ( int i = 0; i < 500; ++i ) {
+                A.push_back( i );
+            }
+
+            ASSERT_EQ( 1, blocks );
+            ASSERT_EQ( -1, A.front() );
+            ASSERT_EQ( SMALL_TEST_SIZE - 1, A[SMALL_TEST_SIZE] );
+        }
+
+        {
+            SCOPED_TRACE( "back inline" );
+
+            A.erase( A.begin() + 10, A.end() );
+            A.shrink_to_fit();
+
+            ASSERT_TRUE( is_inline( A ) );
+            ASSERT_EQ( SMALL_TEST_SIZE, A.capacity() );
+            ASSERT_EQ( 0, blocks );
+            ASSERT_EQ( 10, A.length() );
+
+            for ( int i = 0; i < 10; ++i ) {
+                ASSERT_EQ( i - 1, A[i] );
+            }
+        }
+
+        {
+            SCOPED_TRACE( "reserve" );
+
+            //Within the inline storage there is nothing to do
+            A.reserve( SMALL_TEST_SIZE );
+
+            ASSERT_TRUE( is_inline( A ) );
+
+            A.reserve( 100 );
+
+            ASSERT_FALSE( is_inline( A ) );
+            ASSERT_EQ( 100, A.capacity() );
+            ASSERT_EQ( 8, A[9] );
+        }
+    }
+
+    TEST_F( DataAdapter_Small_TestFixture, Manipulation ) {
+        typedef std::vector<int> model_t;
+
+        model_t M;
+
+        //Random inserts and erases that go back and forth over the inline capacity
+        unsigned state = 0x2545F491;
+
+        for ( int i = 0; i < 5000; ++i ) {
+            state ^= state << 13;
+            state ^= state >> 17;
+            state ^= state << 5;
+
+            size_t pos = M.empty() ? 0 : state % ( M.size() + 1 );
+            size_t n = ( state >> 12 ) % 4 + 1;
+
+            switch ( ( state >> 8 ) % 5 ) {
+                case 0:
+                    A.insert( A.begin() + pos, n, i );
+                    M.insert( M.begin() + pos, n, i );
+                    break;
+
+                case 1:
+                    A.push_front( i );
+                    M.insert( M.begin(), i );
+                    break;
+
+                case 2:
+                    A.shrink_to_fit();
+                    ASSERT_EQ( M.size() <= SMALL_TEST_SIZE, is_inline( A ) );
+                    break;
+
+                default:
+                    if ( !M.empty() ) {
+                        pos = std::min( pos, M.size() - 1 );
+                        n = std::min( n, M.size() - pos );
+
+                        A.erase( A.begin() + pos, A.begin() + pos + n );
+                        M.erase( M.begin() + pos, M.begin() + pos + n );
+                    }
+            }
+
+            ASSERT_EQ( M.size(), A.length() );
+            ASSERT_TRUE( std::equal( M.begin(), M.end(), A.begin() ) );
+        }
+    }
+
+    TEST_F( DataAdapter_Small_TestFixture, CopyAndSwap ) {
+        for ( int i = 0; i < 5; ++i ) {
+            A.push_back( i );
+        }
+
+        for ( int i = 0; i < 50; ++i ) {
+            B.push_back( 100 + i );
+        }
+
+        {
+            SCOPED_TRACE( "copies" );
+
+            DataAdapter_Small_TestFixture::adapter_t C( A ), D( B );
+
+            ASSERT_TRUE( is_inline( C ) );
+            ASSERT_FALSE( is_inline( D ) );
+            ASSERT_TRUE( C == A );
+            ASSERT_TRUE( D == B );
+            ASSERT_EQ( 2, blocks );
+
+            //Shrinking by assignment keeps the heap block, like std::vector
+            D = C;
+
+            ASSERT_TRUE( D == A );
+            ASSERT_FALSE( is_inline( D ) );
+        }
+
+        ASSERT_EQ( 1, blocks );
+
+        {
+            SCOPED_TRACE( "swap" );
+
+            const int *heap = B.data();
+
+            A.swap( B );
+
+            ASSERT_EQ( heap, A.data() );
+            ASSERT_TRUE( is_inline( B ) );
+            ASSERT_EQ( 50, A.length() );
+            ASSERT_EQ( 5,  B.length() );
+            ASSERT_EQ( 149, A.back() );
+            ASSERT_EQ( 4, B.back() );
+
+            //Both inline
+            A.erase( A.begin() + 3, A.end() );
+            A.shrink_to_fit();
+            A.swap( B );
+
+            ASSERT_EQ( 5, A.length() );
+            ASSERT_EQ( 3, B.length() );
+            ASSERT_EQ( 102, B.back() );
+            ASSERT_EQ( 0, blocks );
+        }
+
+        {
+            SCOPED_TRACE( "move" );
+
+            B.resize( 40, 7 );
+
+            const int *heap = B.data();
+
+            DataAdapter_Small_TestFixture::adapter_t C( std::move( B ) ), D( std::move( A ) );
+
+            ASSERT_EQ( heap, C.data() );
+            ASSERT_TRUE( is_inline( D ) );
+            ASSERT_EQ( 40, C.length() );
+            ASSERT_EQ( 5,  D.length() );
+            ASSERT_EQ( 0,  A.length() );
+            ASSERT_EQ( 0,  B.length() );
+            ASSERT_TRUE( is_inline( B ) );
+
+            A = std::move( C );
+
+            ASSERT_EQ( heap, A.data() );
+            ASSERT_EQ( 7, A.back() );
+        }
+    }
+
+#ifndef DATA_ADAPTER_DYNAMIC_DISPATCH
+    TEST( DataAdapter_Small_Storage, Lifetimes ) {
+        typedef DataAdapter<da::small<lifetime_counter, 4> > adapter_t;
+
+        lifetime_counter::alive() = 0;
+
+        {
+            adapter_t A;
+
+            A.push_back( lifetime_counter( 1 ) );
+            A.push_back( lifetime_counter( 2 ) );
+
+            ASSERT_EQ( 2, lifetime_counter::alive() );
+
+            A.insert( A.begin() + 1, 10, lifetime_counter( 0 ) );
+
+            ASSERT_EQ( 12, lifetime_counter::alive() );
+
+            A.erase( A.begin() + 1, A.end() - 1 );
+            A.shrink_to_fit();
+
+            ASSERT_EQ( 2, lifetime_counter::alive() );
+
+            adapter_t B( A );
+
+            B.swap( A );
+
+            ASSERT_EQ( 4, lifetime_counter::alive() );
+            ASSERT_EQ( 2, B.back().value );
+        }
+
+        ASSERT_EQ( 0, lifetime_counter::alive() );
+    }
+#endif // DATA_ADAPTER_DYNAMIC_DISPATCH
+
+    TEST( DataAdapter_Small_Move, NoCopies ) {
+        typedef DataAdapter<da::small<copy_counter, 8> > adapter_t;
+
+        adapter_t A;
+
+        copy_counter::copies() = 0;
+
+        for ( int i = 0; i < 100; ++i ) {
+            A.emplace_back( i );
+        }
+
+        A.erase( A.begin() + 4, A.end() );
+        A.shrink_to_fit();
+
+        adapter_t B( std::move( A ) );
+
+        A.push_back( copy_counter( 1 ) );
+        A.swap( B );
+
+        ASSERT_EQ( 0, copy_counter::copies() );
+        ASSERT_EQ( 4, A.length() );
+        ASSERT_EQ( 3, A.back().value );
+        ASSERT_EQ( 1, B.front().value );
+    }
+
+    TEST_F( DataAdapter_Small_TestFixture, CommonInterface ) {
+        for ( int i = 0; i < 40; ++i ) {
+            A.push_back( ( i * 7 ) % 40 );
+        }
+
+        DataAdapter_Small_TestFixture::adapter_t::_Base &base = A;
+
+        base.sort();
+
+        ASSERT_TRUE( DataAdapter_Tests::is_sorted( A.begin(), A.end() ) );
+        ASSERT_EQ( A.begin() + 20, base.find_sorted( 20 ) );
+
+        int batch[] = { 5, -5, 50 };
+
+        A.sorted_insert( batch, batch + 3 );
+
+        ASSERT_EQ( -5, A.front() );
+        ASSERT_EQ( 50, A.back() );
+        ASSERT_TRUE( DataAdapter_Tests::is_sorted( A.begin(), A.end() ) );
+    }
+}
+
+#endif // DATA_ADAPTER_SMALL_TESTS_HPP_INCLUDED
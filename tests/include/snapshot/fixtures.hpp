@@ -0,0 +1,35 @@
+#ifndef DATA_ADAPTER_SNAPSHOT_TEST_FIXTURES_HPP_INCLUDED
+#define DATA_ADAPTER_SNAPSHOT_TEST_FIXTURES_HPP_INCLUDED
+
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <string>
+
+#include <tools.hpp>
+#include <data_adapter>
+
+namespace DataAdapter_Tests {
+
+    template <typename T, size_t N>
+    class DataAdapter_Snapshot_TestFixtureTemplate : public ::testing::Test {
+        public:
+            typedef DataAdapter<T[N]> adapter_t;
+
+            adapter_t A, B;
+            std::string path;
+
+            virtual void SetUp() {
+                const ::testing::TestInfo *info = ::testing::UnitTest::GetInstance()->current_test_info();
+
+                path = ::testing::TempDir() + "data_adapter_" + info->test_case_name() + "_" + info->name() + ".snap";
+            }
+
+            virtual void TearDown() {
+                std::remove( path.c_str() );
+            }
+    };
+
+}
+
+#endif // DATA_ADAPTER_SNAPSHOT_TEST_FIXTURES_HPP_INCLUDED
@@ -0,0 +1,199 @@
+#ifndef DATA_ADAPTER_SNAPSHOT_TESTS_HPP_INCLUDED
+#define DATA_ADAPTER_SNAPSHOT_TESTS_HPP_INCLUDED
+
+#include <algorithm>
+#include <cstdio>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#include "fixtures.hpp"
+
+namespace DataAdapter_Tests {
+
+    static const int SNAPSHOT_TEST_SIZE = 128;
+
+    typedef DataAdapter_Snapshot_TestFixtureTemplate<int, SNAPSHOT_TEST_SIZE>
+    DataAdapter_Snapshot_TestFixture;
+
+    //Overwrites size bytes at offset of the file at path
+    static inline void patch_file( const std::string &path, long offset, const void *bytes, size_t size ) {
+        std::FILE *f = std::fopen( path.c_str(), "r+b" );
+
+        ASSERT_TRUE( f != NULL );
+        ASSERT_EQ( 0, std::fseek( f, offset, SEEK_SET ) );
+        ASSERT_EQ( 1u, std::fwrite( bytes, size, 1, f ) );
+
+        std::fclose( f );
+    }
+
+    TEST_F( DataAdapter_Snapshot_TestFixture, RoundTrip ) {
+        for ( int i = 0; i < 100; ++i ) {
+            A.push_back( i * 7 - 300 );
+        }
+
+        B.push_back( 1 );
+
+        da::save( A, path.c_str() );
+        da::load( B, path.c_str() );
+
+        ASSERT_EQ( A.length(), B.length() );
+        ASSERT_TRUE( std::equal( A.begin(), A.end(), B.begin() ) );
+
+        //Saving over it, and an empty one
+        A.clear();
+
+        da::save( A, path.c_str() );
+        da::load( B, path.c_str() );
+
+        ASSERT_TRUE( B.empty() );
+    }
+
+#if DATA_ADAPTER_HAS_MMAP
+    TEST_F( DataAdapter_Snapshot_TestFixture, Mapped ) {
+        for ( int i = 0; i < 100; ++i ) {
+            A.push_back( i * i );
+        }
+
+        da::save( A, path.c_str() );
+
+        da::mapped_snapshot<int> M = da::load_mapped<int>( path.c_str() );
+
+        ASSERT_EQ( 100, M.length() );
+        ASSERT_EQ( SNAPSHOT_TEST_SIZE, M.capacity() );
+        ASSERT_TRUE( std::equal( A.begin(), A.end(), M.begin() ) );
+        ASSERT_EQ( 99 * 99, M[99] );
+        ASSERT_THROW( M.at( 100 ), std::out_of_range );
+        ASSERT_TRUE( M.verify() );
+
+        //The elements are where the header says, aligned for anything
+        ASSERT_EQ( 0u, reinterpret_cast<size_t>( M.data() ) % 64 );
+
+        da::mapped_snapshot<int> N( std::move( M ) );
+
+        ASSERT_EQ( 81, N[9] );
+    }
+#endif // DATA_ADAPTER_HAS_MMAP
+
+    struct snapshot_record {
+        int key;
+        double value;
+        char tag;
+
+        bool operator==( const snapshot_record &r ) const {
+            return key == r.key;
+        }
+
+        bool operator<( const snapshot_record &r ) const {
+            return key < r.key;
+        }
+    };
+
+    TEST( DataAdapter_Snapshot_Structs, RoundTrip ) {
+        typedef DataAdapter<snapshot_record[16]> adapter_t;
+
+        std::string path = ::testing::TempDir() + "data_adapter_snapshot_structs.snap";
+        adapter_t A, B;
+
+        for ( int i = 0; i < 10; ++i ) {
+            snapshot_record r = { i, i * 0.5, static_cast<char>( 'a' + i ) };
+            A.push_back( r );
+        }
+
+        da::save( A, path.c_str() );
+        da::load( B, path.c_str() );
+
+        ASSERT_EQ( 10, B.length() );
+
+        for ( int i = 0; i < 10; ++i ) {
+            ASSERT_EQ( i, B[i].key );
+            ASSERT_EQ( i * 0.5, B[i].value );
+            ASSERT_EQ( 'a' + i, B[i].tag );
+        }
+
+        std::remove( path.c_str() );
+    }
+
+    TEST_F( DataAdapter_Snapshot_TestFixture, Errors ) {
+        ASSERT_THROW( da::load( B, path.c_str() ), da::snapshot_error );
+
+        for ( int i = 0; i < 100; ++i ) {
+            A.push_back( i );
+        }
+
+        da::save( A, path.c_str() );
+
+        //Too many elements, or the wrong size of them
+        DataAdapter<int[50]> C;
+        DataAdapter<short[200]> S;
+
+        ASSERT_THROW( da::load( C, path.c_str() ), std::out_of_range );
+        ASSERT_THROW( da::load( S, path.c_str() ), da::snapshot_error );
+
+        //A flipped bit in the elements
+        unsigned char bad = 0xff;
+        patch_file( path, sizeof( da::snapshot_header ) + 4 * 10, &bad, 1 );
+
+        ASSERT_THROW( da::load( B, path.c_str() ), da::snapshot_error );
+        ASSERT_TRUE( B.empty() );
+
+#if DATA_ADAPTER_HAS_MMAP
+        ASSERT_FALSE( da::load_mapped<int>( path.c_str() ).verify() );
+        ASSERT_THROW( da::load_mapped<short>( path.c_str() ), da::snapshot_error );
+#endif // DATA_ADAPTER_HAS_MMAP
+
+        //The byte order marker as another machine would have written it
+        da::save( A, path.c_str() );
+
+        unsigned char swapped[4] = { 1, 2, 3, 4 };
+
+        if ( da::snapshot_header::native_byte_order == 0x04030201 ) {
+            std::reverse( swapped, swapped + 4 );
+        }
+
+        patch_file( path, 12, swapped, 4 );
+
+        ASSERT_THROW( da::load( B, path.c_str() ), da::snapshot_error );
+
+        //Elements that would start at a position they can't be at
+        da::save( A, path.c_str() );
+
+        std::uint32_t odd_header = sizeof( da::snapshot_header ) + 2;
+        patch_file( path, 20, &odd_header, sizeof( odd_header ) );
+
+        ASSERT_THROW( da::load( B, path.c_str() ), da::snapshot_error );
+#if DATA_ADAPTER_HAS_MMAP
+        ASSERT_THROW( da::load_mapped<int>( path.c_str() ), da::snapshot_error );
+#endif // DATA_ADAPTER_HAS_MMAP
+
+        //Cut short
+        da::save( A, path.c_str() );
+
+        {
+            DataAdapter<int[1]> D;
+            std::FILE *f = std::fopen( path.c_str(), "rb" );
+            char head[80];
+
+            ASSERT_EQ( 1u, std::fread( head, sizeof( head ), 1, f ) );
+            std::fclose( f );
+
+            f = std::fopen( path.c_str(), "wb" );
+            std::fwrite( head, sizeof( head ), 1, f );
+            std::fclose( f );
+
+            ASSERT_THROW( da::load( D, path.c_str() ), da::snapshot_error );
+#if DATA_ADAPTER_HAS_MMAP
+            ASSERT_THROW( da::load_mapped<int>( path.c_str() ), da::snapshot_error );
+#endif // DATA_ADAPTER_HAS_MMAP
+        }
+
+        //Not a snapshot at all
+        std::FILE *f = std::fopen( path.c_str(), "wb" );
+        std::fputs( "0 1 2 3 4 5 6 7 8 9", f );
+        std::fclose( f );
+
+        ASSERT_THROW( da::load( B, path.c_str() ), da::snapshot_error );
+    }
+}
+
+#endif // DATA_ADAPTER_SNAPSHOT_TESTS_HPP_INCLUDED
@@ -0,0 +1,22 @@
+#ifndef DATA_ADAPTER_SOA_TEST_FIXTURES_HPP_INCLUDED
+#define DATA_ADAPTER_SOA_TEST_FIXTURES_HPP_INCLUDED
+
+#include <gtest/gtest.h>
+
+#include <tools.hpp>
+#include <data_adapter>
+
+namespace DataAdapter_Tests {
+
+    template <typename _Tuple, size_t N>
+    class DataAdapter_Soa_TestFixtureTemplate : public ::testing::Test {
+        public:
+            typedef DataAdapter<da::soa<_Tuple, N> > adapter_t;
+            typedef typename adapter_t::element_type element_t;
+
+            adapter_t A, B;
+    };
+
+}
+
+#endif // DATA_ADAPTER_SOA_TEST_FIXTURES_HPP_INCLUDED
@@ -0,0 +1,417 @@
+#ifndef DATA_ADAPTER_SOA_TESTS_HPP_INCLUDED
+#define DATA_ADAPTER_SOA_TESTS_HPP_INCLUDED
+
+#include <algorithm>
+#include <list>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "fixtures.hpp"
+
+namespace DataAdapter_Tests {
+
+    static const int SOA_TEST_SIZE = 64;
+
+    typedef DataAdapter_Soa_TestFixtureTemplate<std::tuple<int, double, std::string>, SOA_TEST_SIZE>
+    DataAdapter_Soa_TestFixture;
+
+    typedef DataAdapter_Soa_TestFixture::element_t soa_row_t;
+
+    static soa_row_t soa_row( int i ) {
+        //Long enough not to fit in the small string buffer
+        return soa_row_t( i, i * 0.5, std::to_string( i ) + std::string( 32, 'x' ) );
+    }
+
+    TEST_F( DataAdapter_Soa_TestFixture, Construction ) {
+        ASSERT_EQ( 0, A.length() );
+        ASSERT_EQ( SOA_TEST_SIZE, A.capacity() );
+        ASSERT_TRUE( A.begin() == A.end() );
+
+        DataAdapter_Soa_TestFixture::adapter_t C( 3, soa_row( 4 ) );
+
+        ASSERT_EQ( 3, C.length() );
+        ASSERT_TRUE( C[2] == soa_row( 4 ) );
+
+        DataAdapter_Soa_TestFixture::adapter_t D = { soa_row( 1 ), soa_row( 2 ) };
+
+        ASSERT_EQ( 2, D.length() );
+        ASSERT_EQ( 2, std::get<0>( soa_row_t( D.back() ) ) );
+
+        {
+            SCOPED_TRACE( "copy and move" );
+
+            DataAdapter_Soa_TestFixture::adapter_t E( D );
+
+            ASSERT_TRUE( E == D );
+
+            DataAdapter_Soa_TestFixture::adapter_t F( std::move( E ) );
+
+            ASSERT_TRUE( F == D );
+            ASSERT_TRUE( E.empty() );
+
+            E = F;
+            F = std::move( C );
+
+            ASSERT_TRUE( E == D );
+            ASSERT_EQ( 3, F.length() );
+            ASSERT_TRUE( F[0] == soa_row( 4 ) );
+        }
+    }
+
+    TEST_F( DataAdapter_Soa_TestFixture, Columns ) {
+        for ( int i = 0; i < 10; ++i ) {
+            A.push_back( soa_row( i ) );
+        }
+
+        {
+            SCOPED_TRACE( "each field in a column of its own" );
+
+            DataAdapter_Soa_TestFixture::adapter_t::column_view<0> ids = A.column<0>();
+            DataAdapter_Soa_TestFixture::adapter_t::column_view<1> values = A.column<1>();
+
+            ASSERT_EQ( 10, ids.size() );
+            ASSERT_EQ( ids.data() + 10, ids.end() );
+            ASSERT_EQ( 0, reinterpret_cast<uintptr_t>( ids.data() ) % da::detail::cache_line_size );
+            ASSERT_EQ( 0, reinterpret_cast<uintptr_t>( values.data() ) % da::detail::cache_line_size );
+
+            for ( int i = 0; i < 10; ++i ) {
+                ASSERT_EQ( i,       ids[i] );
+                ASSERT_EQ( i * 0.5, values[i] );
+            }
+        }
+
+        {
+            SCOPED_TRACE( "writes go to the rows" );
+
+            for ( double &v : A.column<1>() ) {
+                v *= 2;
+            }
+
+            A[3].get<2>() = "three";
+
+            ASSERT_EQ( 3.0, A[3].get<1>() );
+            ASSERT_EQ( "three", std::get<2>( soa_row_t( A.at( 3 ) ) ) );
+
+            const DataAdapter_Soa_TestFixture::adapter_t &C = A;
+
+            ASSERT_EQ( 9.0, C.column<1>()[9] );
+            ASSERT_EQ( 45, std::accumulate( C.column<0>().begin(), C.column<0>().end(), 0 ) );
+        }
+
+        {
+            SCOPED_TRACE( "find_by" );
+
+            ASSERT_EQ( A.begin() + 3, A.find_by<2>( "three" ) );
+            ASSERT_EQ( A.begin() + 7, A.find_by<0>( 7 ) );
+            ASSERT_EQ( A.end(),       A.find_by<0>( 70 ) );
+        }
+    }
+
+    TEST_F( DataAdapter_Soa_TestFixture, Manipulation ) {
+        typedef std::vector<soa_row_t> model_t;
+
+        model_t M;
+
+        //Random inserts and erases anywhere, checked against std::vector
+        unsigned state = 0x2545F491;
+
+        for ( int i = 0; i < 3000; ++i ) {
+            state ^= state << 13;
+            state ^= state >> 17;
+            state ^= state << 5;
+
+            size_t pos = state % ( M.size() + 1 );
+
+            switch ( ( state >> 8 ) % 5 ) {
+                case 0:
+                case 1:
+                    if ( !A.full() ) {
+                        A.insert( A.begin() + pos, soa_row( i ) );
+                        M.insert( M.begin() + pos, soa_row( i ) );
+                    }
+                    break;
+
+                case 2: {
+                    size_t n = std::min<size_t>( ( state >> 12 ) % 4, A.capacity() - A.length() );
+                    std::list<soa_row_t> l( n, soa_row( i ) );
+
+                    A.insert( A.begin() + pos, l.begin(), l.end() );
+                    M.insert( M.begin() + pos, l.begin(), l.end() );
+                    break;
+                }
+
+                case 3:
+                    if ( !M.empty() ) {
+                        size_t n = std::min<size_t>( ( state >> 12 ) % 4, M.size() - std::min( pos, M.size() - 1 ) );
+
+                        pos = std::min( pos, M.size() - 1 );
+
+                        A.erase( A.begin() + pos, A.begin() + pos + n );
+                        M.erase( M.begin() + pos, M.begin() + pos + n );
+                    }
+                    break;
+
+                default:
+                    if ( !M.empty() ) {
+                        ASSERT_TRUE( A.pop_front() == M.front() );
+                        M.erase( M.begin() );
+                    }
+
+                    if ( !M.empty() ) {
+                        ASSERT_TRUE( A.pop_back() == M.back() );
+                        M.pop_back();
+                    }
+                    break;
+            }
+
+            ASSERT_EQ( M.size(), A.length() );
+            ASSERT_TRUE( std::equal( M.begin(), M.end(), A.begin() ) );
+        }
+
+        {
+            SCOPED_TRACE( "own rows, full and out of range" );
+
+            A.clear();
+            A.resize( 4, soa_row( 1 ) );
+            A.insert( A.begin(), A.begin() + 2, A.end() );
+
+            ASSERT_EQ( 6, A.length() );
+            ASSERT_TRUE( A[0] == soa_row( 1 ) );
+
+            //Through reverse iterators as well
+            A.clear();
+
+            for ( int i = 0; i < 4; ++i ) {
+                A.push_back( soa_row( i ) );
+            }
+
+            A.insert( A.begin(), A.rbegin(), A.rend() );
+
+            int expected[] = { 3, 2, 1, 0, 0, 1, 2, 3 };
+
+            ASSERT_EQ( 8, A.length() );
+
+            for ( int i = 0; i < 8; ++i ) {
+                ASSERT_TRUE( A[i] == soa_row( expected[i] ) );
+            }
+
+            A.resize( SOA_TEST_SIZE );
+
+            ASSERT_THROW( A.push_back( soa_row( 0 ) ), std::out_of_range );
+            ASSERT_THROW( A.insert( A.begin(), soa_row( 0 ) ), std::out_of_range );
+            ASSERT_THROW( A.erase( A.end(), A.end() + 1 ), std::out_of_range );
+            ASSERT_THROW( A.resize( SOA_TEST_SIZE + 1 ), std::out_of_range );
+
+            A.clear();
+
+            ASSERT_TRUE( A.empty() );
+            ASSERT_TRUE( A.pop_back() == soa_row_t() );
+        }
+    }
+
+    TEST_F( DataAdapter_Soa_TestFixture, Sorting ) {
+        std::vector<soa_row_t> M;
+
+        for ( int i = 0; i < SOA_TEST_SIZE; ++i ) {
+            //Few distinct keys in the first field, so there are ties to keep in order
+            soa_row_t r( ( i * 7919 ) % 5, ( i * 104729 ) % 61 * 0.25, std::to_string( i ) );
+
+            A.push_back( r );
+            M.push_back( r );
+        }
+
+        {
+            SCOPED_TRACE( "sort_by, stable" );
+
+            A.sort_by<0>();
+
+            std::stable_sort( M.begin(), M.end(), []( const soa_row_t & a, const soa_row_t & b ) {
+                return std::get<0>( a ) < std::get<0>( b );
+            } );
+
+            ASSERT_TRUE( std::equal( M.begin(), M.end(), A.begin() ) );
+
+            A.sort_by<1>();
+
+            std::stable_sort( M.begin(), M.end(), []( const soa_row_t & a, const soa_row_t & b ) {
+                return std::get<1>( a ) < std::get<1>( b );
+            } );
+
+            ASSERT_TRUE( std::equal( M.begin(), M.end(), A.begin() ) );
+        }
+
+        {
+            SCOPED_TRACE( "whole rows" );
+
+            A.sort();
+            std::sort( M.begin(), M.end() );
+
+            ASSERT_TRUE( std::equal( M.begin(), M.end(), A.begin() ) );
+
+            std::reverse( A.begin(), A.end() );
+            A.stable_sort();
+
+            ASSERT_TRUE( std::equal( M.begin(), M.end(), A.begin() ) );
+        }
+
+        {
+            SCOPED_TRACE( "standard algorithms through row references" );
+
+            std::reverse( A.begin(), A.end() );
+            std::sort( A.begin(), A.end() );
+
+            ASSERT_TRUE( std::equal( M.begin(), M.end(), A.begin() ) );
+            ASSERT_TRUE( std::is_sorted( A.cbegin(), A.cend() ) );
+        }
+
+        {
+            SCOPED_TRACE( "sorted_insert" );
+
+            A.resize( 10 );
+            M.resize( 10 );
+
+            soa_row_t r( 2, 0.0, "2" );
+
+            A.sorted_insert( r );
+            M.insert( std::upper_bound( M.begin(), M.end(), r ), r );
+
+            std::vector<soa_row_t> batch = { soa_row_t( 4, 1.0, "a" ), soa_row_t( 0, 1.0, "b" ) };
+
+            A.sorted_insert( batch.begin(), batch.end() );
+            M.insert( std::upper_bound( M.begin(), M.end(), batch[0] ), batch[0] );
+            M.insert( std::upper_bound( M.begin(), M.end(), batch[1] ), batch[1] );
+
+            ASSERT_EQ( M.size(), A.length() );
+            ASSERT_TRUE( std::equal( M.begin(), M.end(), A.begin() ) );
+        }
+    }
+
+    //Large enough for sort_by to radix sort, where -0.0 and 0.0 have different bits but have to tie
+    TEST( DataAdapter_Soa_Sorting, SignedZeros ) {
+        typedef DataAdapter<da::soa<std::tuple<double, int>, 2048> > adapter_t;
+
+        static const int sizes[] = { 10, 2048 };
+
+        for ( size_t s = 0; s < 2; ++s ) {
+            adapter_t C;
+
+            for ( int i = 0; i < sizes[s]; ++i ) {
+                C.push_back( std::tuple<double, int>( i % 3 == 0 ? 1.0 : ( i % 2 ? -0.0 : 0.0 ), i ) );
+            }
+
+            C.sort_by<0>();
+
+            adapter_t::column_view<0> keys = C.column<0>();
+            adapter_t::column_view<1> rows = C.column<1>();
+            int last = -1;
+
+            for ( size_t i = 0; i < keys.size() && keys[i] == 0.0; ++i ) {
+                ASSERT_LT( last, rows[i] );
+                last = rows[i];
+            }
+
+            ASSERT_NE( -1, last );
+        }
+    }
+
+    TEST_F( DataAdapter_Soa_TestFixture, Erasing ) {
+        for ( int i = 0; i < 10; ++i ) {
+            A.push_back( soa_row( i ) );
+        }
+
+        {
+            SCOPED_TRACE( "erase_if" );
+
+            ASSERT_EQ( 5, A.erase_if( []( DataAdapter_Soa_TestFixture::adapter_t::const_reference r ) {
+                return r.get<0>() % 2 == 0;
+            } ) );
+
+            ASSERT_EQ( 5, A.length() );
+
+            for ( int i = 0; i < 5; ++i ) {
+                ASSERT_TRUE( A[i] == soa_row( 2 * i + 1 ) );
+            }
+
+            ASSERT_EQ( 0, A.erase_if( []( const soa_row_t & r ) {
+                return std::get<0>( r ) > 100;
+            } ) );
+        }
+
+        {
+            SCOPED_TRACE( "unordered_erase" );
+
+            ASSERT_EQ( A.begin() + 1, A.unordered_erase( A.begin() + 1 ) );
+
+            ASSERT_EQ( 4, A.length() );
+            ASSERT_TRUE( A[1] == soa_row( 9 ) );
+            ASSERT_TRUE( A[3] == soa_row( 7 ) );
+
+            ASSERT_EQ( A.end(), A.unordered_erase( A.end() - 1 ) );
+            ASSERT_EQ( 3, A.length() );
+
+            ASSERT_THROW( A.unordered_erase( A.end() ), std::out_of_range );
+        }
+    }
+
+    TEST_F( DataAdapter_Soa_TestFixture, CommonInterface ) {
+        for ( int i = 0; i < 10; ++i ) {
+            A.push_back( soa_row( i ) );
+        }
+
+        {
+            SCOPED_TRACE( "searching" );
+
+            ASSERT_EQ( A.begin() + 4, A.find( soa_row( 4 ) ) );
+            ASSERT_EQ( A.begin() + 4, A.find_sorted( soa_row( 4 ) ) );
+            ASSERT_EQ( A.end(),       A.find( soa_row( 40 ) ) );
+            ASSERT_TRUE( A.contains( soa_row( 9 ) ) );
+            ASSERT_EQ( 1, A.count( soa_row( 9 ) ) );
+            ASSERT_EQ( A.begin(),     A.min_element() );
+            ASSERT_EQ( A.end() - 1,   A.max_element() );
+        }
+
+        {
+            SCOPED_TRACE( "comparing and hashing" );
+
+            B.assign( A.begin(), A.end() );
+
+            ASSERT_TRUE( A == B );
+            ASSERT_EQ( 0, A.compare( B ) );
+            ASSERT_EQ( A.hash(), B.hash() );
+
+            B.back().get<1>() = 100.0;
+
+            ASSERT_FALSE( A == B );
+            ASSERT_TRUE( A < B );
+            ASSERT_NE( A.hash(), B.hash() );
+
+            B.pop_back();
+
+            ASSERT_TRUE( B < A );
+
+            B.assign( B.begin() + 1, B.end() );
+
+            ASSERT_EQ( 8, B.length() );
+            ASSERT_TRUE( std::equal( B.begin(), B.end(), A.begin() + 1 ) );
+        }
+
+        {
+            SCOPED_TRACE( "through the base" );
+
+            DataAdapter_Soa_TestFixture::adapter_t::_Base &base = A;
+
+            A.push_front( soa_row( -1 ) );
+            base.append( B.cbegin(), B.cend() );
+
+            ASSERT_EQ( 19, A.length() );
+            ASSERT_TRUE( A.front() == soa_row( -1 ) );
+            ASSERT_TRUE( soa_row_t( A.back() ) == soa_row( 8 ) );
+        }
+    }
+
+}
+
+#endif // DATA_ADAPTER_SOA_TESTS_HPP_INCLUDED
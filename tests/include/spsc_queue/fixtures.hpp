@@ -0,0 +1,21 @@
+#ifndef DATA_ADAPTER_SPSC_QUEUE_TEST_FIXTURES_HPP_INCLUDED
+#define DATA_ADAPTER_SPSC_QUEUE_TEST_FIXTURES_HPP_INCLUDED
+
+#include <gtest/gtest.h>
+
+#include <tools.hpp>
+#include <data_adapter>
+
+namespace DataAdapter_Tests {
+
+    template <typename T, size_t N>
+    class DataAdapter_SPSC_TestFixtureTemplate : public ::testing::Test {
+        public:
+            typedef da::spsc_queue<T, N> queue_t;
+
+            queue_t Q;
+    };
+
+}
+
+#endif // DATA_ADAPTER_SPSC_QUEUE_TEST_FIXTURES_HPP_INCLUDED
@@ -0,0 +1,170 @@
+#ifndef DATA_ADAPTER_SPSC_QUEUE_TESTS_HPP_INCLUDED
+#define DATA_ADAPTER_SPSC_QUEUE_TESTS_HPP_INCLUDED
+
+#include <algorithm>
+#include <iterator>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "fixtures.hpp"
+
+namespace DataAdapter_Tests {
+
+    static const int SPSC_TEST_SIZE = 10;
+
+    typedef DataAdapter_SPSC_TestFixtureTemplate<int, SPSC_TEST_SIZE>
+    DataAdapter_SPSC_TestFixture;
+
+    TEST_F( DataAdapter_SPSC_TestFixture, Bounded ) {
+        int x = -1;
+
+        ASSERT_TRUE( Q.empty() );
+        ASSERT_EQ( SPSC_TEST_SIZE, Q.capacity() );
+        ASSERT_FALSE( Q.try_pop( x ) );
+        ASSERT_EQ( -1, x );
+
+        for ( int i = 0; i < SPSC_TEST_SIZE; ++i ) {
+            ASSERT_TRUE( Q.try_push( i ) );
+        }
+
+        ASSERT_TRUE( Q.full() );
+        ASSERT_FALSE( Q.try_push( 100 ) );
+
+        ASSERT_TRUE( Q.try_pop( x ) );
+        ASSERT_EQ( 0, x );
+
+        //The freed slot is at the start of the storage, so this wraps around
+        ASSERT_TRUE( Q.try_emplace( 100 ) );
+        ASSERT_FALSE( Q.try_push( 101 ) );
+
+        for ( int i = 1; i < SPSC_TEST_SIZE; ++i ) {
+            ASSERT_TRUE( Q.try_pop( x ) );
+            ASSERT_EQ( i, x );
+        }
+
+        ASSERT_TRUE( Q.try_pop( x ) );
+        ASSERT_EQ( 100, x );
+        ASSERT_TRUE( Q.empty() );
+    }
+
+    TEST_F( DataAdapter_SPSC_TestFixture, Batches ) {
+        const int in[] = { 1, 2, 3, 4, 5, 6, 7, 8 };
+        int out[8] = {};
+
+        ASSERT_EQ( 0, Q.pop_n( out, 8 ) );
+
+        //Only as many as fit
+        ASSERT_EQ( 8, Q.push_n( in, 8 ) );
+        ASSERT_EQ( 2, Q.push_n( in, 8 ) );
+        ASSERT_EQ( 0, Q.push_n( in, 8 ) );
+
+        ASSERT_EQ( 8, Q.pop_n( out, 8 ) );
+        ASSERT_TRUE( std::equal( in, in + 8, out ) );
+
+        ASSERT_EQ( 5, Q.push_n( in + 3, 5 ) );
+        ASSERT_EQ( 7, Q.size() );
+
+        std::vector<int> rest;
+
+        ASSERT_EQ( 7, Q.pop_n( std::back_inserter( rest ), 100 ) );
+
+        const int expected[] = { 1, 2, 4, 5, 6, 7, 8 };
+
+        ASSERT_TRUE( std::equal( expected, expected + 7, rest.begin() ) );
+        ASSERT_TRUE( Q.empty() );
+    }
+
+    TEST( DataAdapter_SPSC_Storage, Lifetimes ) {
+        lifetime_counter::alive() = 0;
+
+        {
+            da::spsc_queue<lifetime_counter, 4> Q;
+
+            ASSERT_EQ( 0, lifetime_counter::alive() );
+
+            for ( int i = 0; i < 3; ++i ) {
+                Q.try_emplace( i );
+            }
+
+            ASSERT_EQ( 3, lifetime_counter::alive() );
+
+            lifetime_counter x( -1 );
+
+            Q.try_pop( x );
+
+            ASSERT_EQ( 0, x.value );
+            ASSERT_EQ( 3, lifetime_counter::alive() );
+        }
+
+        //The two still in the queue went with it
+        ASSERT_EQ( 0, lifetime_counter::alive() );
+    }
+
+    TEST( DataAdapter_SPSC_Storage, Strings ) {
+        da::spsc_queue<std::string, 3> Q;
+        std::string s;
+
+        for ( int i = 0; i < 100; ++i ) {
+            ASSERT_TRUE( Q.try_push( std::string( static_cast<size_t>( i ), 'x' ) ) );
+            ASSERT_TRUE( Q.try_pop( s ) );
+            ASSERT_EQ( static_cast<size_t>( i ), s.size() );
+        }
+    }
+
+    /*
+        A producer and a consumer thread going as fast as they can, with a capacity that isn't a power of two
+        so the indices wrap unevenly, and single and batched operations mixed on both sides. Every element
+        has to come out exactly once, in order.
+    */
+    TEST( DataAdapter_SPSC_Stress, Transfer ) {
+        static const unsigned long COUNT = 500000;
+
+        da::spsc_queue<unsigned long, 1000> Q;
+
+        std::thread producer( [&Q] {
+            unsigned long next = 0, batch[37];
+
+            while ( next < COUNT ) {
+                if ( next % 3 == 0 ) {
+                    size_t n = 0;
+
+                    while ( n < 37 && next + n < COUNT ) {
+                        batch[n] = next + n;
+                        ++n;
+                    }
+
+                    next += Q.push_n( batch, n );
+
+                } else if ( Q.try_push( next ) ) {
+                    ++next;
+
+                } else {
+                    std::this_thread::yield();
+                }
+            }
+        } );
+
+        unsigned long expected = 0, batch[29];
+        bool ordered = true;
+
+        while ( expected < COUNT ) {
+            size_t n = expected % 2 == 0 ? Q.pop_n( batch, 29 ) : Q.try_pop( batch[0] ) ? 1 : 0;
+
+            if ( n == 0 ) {
+                std::this_thread::yield();
+            }
+
+            for ( size_t i = 0; i < n; ++i, ++expected ) {
+                ordered = ordered && batch[i] == expected;
+            }
+        }
+
+        producer.join();
+
+        ASSERT_TRUE( ordered );
+        ASSERT_TRUE( Q.empty() );
+    }
+}
+
+#endif // DATA_ADAPTER_SPSC_QUEUE_TESTS_HPP_INCLUDED
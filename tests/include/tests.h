@@ -2,5 +2,26 @@
 #define DATA_ADAPTER_TESTS_H_INCLUDED
 
 #include "array/tests.hpp"
+#include "ring/tests.hpp"
+#include "dynamic/tests.hpp"
+#include "small/tests.hpp"
+#include "eytzinger/tests.hpp"
+
+#if DATA_ADAPTER_CXX11
+#include "hash_table/tests.hpp"
+#include "spsc_queue/tests.hpp"
+#include "mpmc_queue/tests.hpp"
+#include "read_mostly/tests.hpp"
+#include "snapshot/tests.hpp"
+#include "text/tests.hpp"
+
+#ifndef DATA_ADAPTER_DYNAMIC_DISPATCH
+#include "soa/tests.hpp"
+#endif // DATA_ADAPTER_DYNAMIC_DISPATCH
+
+#if DATA_ADAPTER_HAS_MMAP
+#include "mapped/tests.hpp"
+#endif // DATA_ADAPTER_HAS_MMAP
+#endif
 
 #endif // DATA_ADAPTER_TESTS_H_INCLUDED
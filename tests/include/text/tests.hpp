@@ -0,0 +1,270 @@
+#ifndef DATA_ADAPTER_TEXT_TESTS_HPP_INCLUDED
+#define DATA_ADAPTER_TEXT_TESTS_HPP_INCLUDED
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <string>
+
+#if DATA_ADAPTER_HAS_FD_IO
+#include <fcntl.h>
+#include <unistd.h>
+#endif // DATA_ADAPTER_HAS_FD_IO
+
+#include "fixtures.hpp"
+
+namespace DataAdapter_Tests {
+
+    typedef DataAdapter_Text_TestFixtureTemplate<int> DataAdapter_Text_TestFixture;
+    typedef DataAdapter_Text_TestFixtureTemplate<long long> DataAdapter_Text_Long_TestFixture;
+    typedef DataAdapter_Text_TestFixtureTemplate<unsigned char> DataAdapter_Text_Byte_TestFixture;
+    typedef DataAdapter_Text_TestFixtureTemplate<double> DataAdapter_Text_Double_TestFixture;
+    typedef DataAdapter_Text_TestFixtureTemplate<float> DataAdapter_Text_Float_TestFixture;
+
+    TEST_F( DataAdapter_Text_TestFixture, Format ) {
+        ASSERT_EQ( "", da::format( A ) );
+
+        A.push_back( 0 );
+        A.push_back( -7 );
+        A.push_back( 42 );
+        A.push_back( 100 );
+        A.push_back( std::numeric_limits<int>::max() );
+        A.push_back( std::numeric_limits<int>::min() );
+
+        ASSERT_EQ( "0 -7 42 100 2147483647 -2147483648", da::format( A ) );
+        ASSERT_EQ( "0, -7, 42, 100, 2147483647, -2147483648", da::format( A, ", " ) );
+        ASSERT_EQ( "0-7421002147483647-2147483648", da::format( A, "" ) );
+    }
+
+    TEST_F( DataAdapter_Text_TestFixture, RoundTrip ) {
+        for ( int i = -5000; i < 5000; ++i ) {
+            A.push_back( i * 4099 );
+        }
+
+        std::string s = da::format( A, "\n" );
+
+        da::parse_from( B, s );
+
+        ASSERT_EQ( A.length(), B.length() );
+        ASSERT_TRUE( std::equal( A.begin(), A.end(), B.begin() ) );
+    }
+
+    TEST_F( DataAdapter_Text_TestFixture, Chunks ) {
+        for ( int i = 0; i < 1000; ++i ) {
+            A.push_back( i * i - 500 );
+        }
+
+        //As small a buffer as goes
+        char buffer[da::text_max_chars<int>::value + 2];
+        std::string s;
+
+        size_t first = 0;
+
+        ASSERT_THROW( da::format_to( A, buffer, sizeof( buffer ) - 1, first, "; " ), std::out_of_range );
+
+        for ( size_t from = 0; from < A.length(); ) {
+            size_t before = from;
+            size_t n = da::format_to( A, buffer, sizeof( buffer ), from, "; " );
+
+            ASSERT_GT( from, before );
+            ASSERT_LE( n, sizeof( buffer ) );
+
+            s.append( buffer, n );
+        }
+
+        ASSERT_EQ( da::format( A, "; " ), s );
+
+        //And read back in chunks of a few characters, which split numbers, carrying what's left over
+        std::string pending;
+
+        for ( size_t i = 0; i < s.size(); i += 5 ) {
+            pending += s.substr( i, 5 );
+
+            bool complete = i + 5 >= s.size();
+            const char *rest = da::parse_from( B, pending.data(), pending.data() + pending.size(), "; ", complete );
+
+            pending.erase( 0, static_cast<size_t>( rest - pending.data() ) );
+        }
+
+        ASSERT_TRUE( pending.empty() );
+        ASSERT_EQ( A.length(), B.length() );
+        ASSERT_TRUE( std::equal( A.begin(), A.end(), B.begin() ) );
+    }
+
+    TEST_F( DataAdapter_Text_TestFixture, Separators ) {
+        std::string s = " 1,2\t3\r\n  -4 ,, +5\n";
+
+        ASSERT_EQ( s.data() + s.size(), da::parse_from( A, s ) );
+        ASSERT_EQ( 5, A.length() );
+        ASSERT_EQ( "1 2 3 -4 5", da::format( A ) );
+
+        //Only the ones given
+        ASSERT_THROW( da::parse_from( B, std::string( "1,2" ), " " ), std::invalid_argument );
+
+        da::parse_from( B, std::string( "1|2||3" ), "|" );
+
+        ASSERT_EQ( "1 2 3", da::format( B ) );
+    }
+
+    TEST_F( DataAdapter_Text_TestFixture, Incomplete ) {
+        std::string s = "12 34 56";
+
+        //The last number might go on in the next chunk
+        const char *rest = da::parse_from( A, s.data(), s.data() + s.size(), " ", false );
+
+        ASSERT_EQ( 2, A.length() );
+        ASSERT_EQ( "56", std::string( rest ) );
+
+        rest = da::parse_from( A, rest, s.data() + s.size(), " ", true );
+
+        ASSERT_EQ( 3, A.length() );
+        ASSERT_EQ( 56, A[2] );
+    }
+
+    TEST_F( DataAdapter_Text_TestFixture, Errors ) {
+        ASSERT_THROW( da::parse_from( A, std::string( "1 2 x 4" ) ), std::invalid_argument );
+
+        //The ones before it are in
+        ASSERT_EQ( 2, A.length() );
+
+        ASSERT_THROW( da::parse_from( B, std::string( "-" ) ), std::invalid_argument );
+        ASSERT_THROW( da::parse_from( B, std::string( "+-5" ) ), std::invalid_argument );
+        ASSERT_THROW( da::parse_from( B, std::string( "1.5" ) ), std::invalid_argument );
+        ASSERT_THROW( da::parse_from( B, std::string( "12a" ) ), std::invalid_argument );
+        ASSERT_THROW( da::parse_from( B, std::string( "2147483648" ) ), std::out_of_range );
+        ASSERT_THROW( da::parse_from( B, std::string( "-2147483649" ) ), std::out_of_range );
+        ASSERT_THROW( da::parse_from( B, std::string( "99999999999999999999999" ) ), std::out_of_range );
+        ASSERT_TRUE( B.empty() );
+
+        da::parse_from( B, std::string( "-2147483648 2147483647 -0 000123" ) );
+
+        ASSERT_EQ( "-2147483648 2147483647 0 123", da::format( B ) );
+    }
+
+    TEST_F( DataAdapter_Text_Long_TestFixture, Limits ) {
+        A.push_back( std::numeric_limits<long long>::min() );
+        A.push_back( std::numeric_limits<long long>::max() );
+        A.push_back( -1 );
+
+        std::string s = da::format( A );
+
+        ASSERT_EQ( "-9223372036854775808 9223372036854775807 -1", s );
+
+        da::parse_from( B, s );
+
+        ASSERT_TRUE( std::equal( A.begin(), A.end(), B.begin() ) );
+        ASSERT_THROW( da::parse_from( B, std::string( "9223372036854775808" ) ), std::out_of_range );
+    }
+
+    TEST_F( DataAdapter_Text_Byte_TestFixture, Limits ) {
+        //Numbers, not characters
+        A.push_back( 0 );
+        A.push_back( 65 );
+        A.push_back( 255 );
+
+        ASSERT_EQ( "0 65 255", da::format( A ) );
+
+        da::parse_from( B, std::string( "0 65 255" ) );
+
+        ASSERT_TRUE( std::equal( A.begin(), A.end(), B.begin() ) );
+        ASSERT_THROW( da::parse_from( B, std::string( "256" ) ), std::out_of_range );
+        ASSERT_THROW( da::parse_from( B, std::string( "-1" ) ), std::out_of_range );
+    }
+
+    TEST_F( DataAdapter_Text_Double_TestFixture, RoundTrip ) {
+        A.push_back( 0.0 );
+        A.push_back( -1.5 );
+        A.push_back( 0.1 );
+        A.push_back( 1.0 / 3.0 );
+        A.push_back( 6.02214076e23 );
+        A.push_back( std::numeric_limits<double>::max() );
+        A.push_back( std::numeric_limits<double>::min() );
+        A.push_back( std::numeric_limits<double>::denorm_min() );
+        A.push_back( -std::numeric_limits<double>::infinity() );
+
+        for ( int i = 1; i < 1000; ++i ) {
+            A.push_back( 1.0 / i - i * 1e10 );
+        }
+
+        std::string s = da::format( A );
+
+        da::parse_from( B, s );
+
+        //Exactly the same numbers
+        ASSERT_EQ( A.length(), B.length() );
+        ASSERT_EQ( 0, std::memcmp( A.data(), B.data(), A.length() * sizeof( double ) ) );
+
+        ASSERT_THROW( da::parse_from( B, std::string( "1e999" ) ), std::out_of_range );
+        ASSERT_THROW( da::parse_from( B, std::string( "1.2.3" ) ), std::invalid_argument );
+        ASSERT_THROW( da::parse_from( B, std::string( "+-5" ) ), std::invalid_argument );
+        ASSERT_THROW( da::parse_from( B, std::string( "+-inf" ) ), std::invalid_argument );
+    }
+
+    TEST_F( DataAdapter_Text_Float_TestFixture, RoundTrip ) {
+        for ( int i = 1; i < 1000; ++i ) {
+            A.push_back( 1.0f / i + i );
+        }
+
+        A.push_back( std::numeric_limits<float>::max() );
+
+        std::string s = da::format( A, "," );
+
+        da::parse_from( B, s );
+
+        ASSERT_EQ( A.length(), B.length() );
+        ASSERT_EQ( 0, std::memcmp( A.data(), B.data(), A.length() * sizeof( float ) ) );
+
+        ASSERT_THROW( da::parse_from( B, std::string( "1e39" ) ), std::out_of_range );
+    }
+
+#if DATA_ADAPTER_HAS_FD_IO
+    TEST_F( DataAdapter_Text_TestFixture, Files ) {
+        for ( int i = 0; i < 100000; ++i ) {
+            A.push_back( i * 31 - 1000000 );
+        }
+
+        int fd = ::open( path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644 );
+
+        ASSERT_LE( 0, fd );
+
+        //Chunks much smaller than the file
+        da::write_text( A, fd, "\n", 4096 );
+        ::close( fd );
+
+        fd = ::open( path.c_str(), O_RDONLY );
+
+        ASSERT_LE( 0, fd );
+
+        da::read_text( B, fd, "\n", 1000 );
+        ::close( fd );
+
+        ASSERT_EQ( A.length(), B.length() );
+        ASSERT_TRUE( std::equal( A.begin(), A.end(), B.begin() ) );
+
+        ASSERT_THROW( da::write_text( A, -1 ), std::runtime_error );
+        ASSERT_THROW( da::read_text( B, -1 ), std::runtime_error );
+    }
+
+    TEST_F( DataAdapter_Text_TestFixture, LongNumbers ) {
+        //A number longer than a chunk
+        std::string s = "1 " + std::string( 100, '0' ) + "42 3";
+
+        int fd = ::open( path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644 );
+
+        ASSERT_LE( 0, fd );
+        ASSERT_EQ( static_cast<ssize_t>( s.size() ), ::write( fd, s.data(), s.size() ) );
+        ::close( fd );
+
+        fd = ::open( path.c_str(), O_RDONLY );
+
+        da::read_text( A, fd, " ", 16 );
+        ::close( fd );
+
+        ASSERT_EQ( "1 42 3", da::format( A ) );
+    }
+#endif // DATA_ADAPTER_HAS_FD_IO
+
+}
+
+#endif // DATA_ADAPTER_TEXT_TESTS_HPP_INCLUDED
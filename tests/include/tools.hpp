@@ -1,6 +1,10 @@
 #ifndef DATASTORE_TESTS_TOOLS_HPP_INCLUDED
 #define DATASTORE_TESTS_TOOLS_HPP_INCLUDED
 
+#include <cstddef>
+#include <memory>
+#include <stdexcept>
+
 namespace DataAdapter_Tests {
 
     template<class ForwardIt>
@@ -22,7 +26,7 @@ namespace DataAdapter_Tests {
 
     template<class ForwardIt>
     bool is_sorted( ForwardIt first, ForwardIt last ) {
-        return is_sorted_until( first, last ) == last;
+        return DataAdapter_Tests::is_sorted_until( first, last ) == last;
     }
 
     struct true_type {};
@@ -43,6 +47,168 @@ namespace DataAdapter_Tests {
         typedef true_type type;
     };
 
+    //Element type that counts how often it gets copied, to check that moves are used where they should be
+    struct copy_counter {
+        int value;
+
+        static int &copies() {
+            static int n = 0;
+            return n;
+        }
+
+        copy_counter( int v = 0 ) : value( v ) {}
+
+        copy_counter( const copy_counter &c ) : value( c.value ) {
+            ++copies();
+        }
+
+        copy_counter &operator=( const copy_counter &c ) {
+            value = c.value;
+            ++copies();
+            return *this;
+        }
+
+        copy_counter( copy_counter &&c ) noexcept : value( c.value ) {
+            c.value = -1;
+        }
+
+        copy_counter &operator=( copy_counter &&c ) noexcept {
+            value = c.value;
+            c.value = -1;
+            return *this;
+        }
+
+        bool operator==( const copy_counter &c ) const {
+            return value == c.value;
+        }
+
+        bool operator<( const copy_counter &c ) const {
+            return value < c.value;
+        }
+    };
+
+    //Element type without a default constructor that counts how many of it are alive
+    struct lifetime_counter {
+        int value;
+
+        static int &alive() {
+            static int n = 0;
+            return n;
+        }
+
+        explicit lifetime_counter( int v ) : value( v ) {
+            ++alive();
+        }
+
+        lifetime_counter( const lifetime_counter &c ) : value( c.value ) {
+            ++alive();
+        }
+
+        lifetime_counter &operator=( const lifetime_counter &c ) {
+            value = c.value;
+            return *this;
+        }
+
+        ~lifetime_counter() {
+            --alive();
+        }
+
+        bool operator==( const lifetime_counter &c ) const {
+            return value == c.value;
+        }
+
+        bool operator<( const lifetime_counter &c ) const {
+            return value < c.value;
+        }
+    };
+
+    //Counts what is alive like lifetime_counter, and throws from the copy after copies_left() of them
+    struct throwing_counter {
+        int value;
+
+        static int &alive() {
+            static int n = 0;
+            return n;
+        }
+
+        static int &copies_left() {
+            static int n = -1;
+            return n;
+        }
+
+        explicit throwing_counter( int v ) : value( v ) {
+            ++alive();
+        }
+
+        throwing_counter( const throwing_counter &c ) : value( c.value ) {
+            if ( copies_left() >= 0 && copies_left()-- == 0 ) {
+                throw std::runtime_error( "throwing_counter" );
+            }
+
+            ++alive();
+        }
+
+        throwing_counter &operator=( const throwing_counter &c ) {
+            value = c.value;
+            return *this;
+        }
+
+        ~throwing_counter() {
+            --alive();
+        }
+
+        bool operator<( const throwing_counter &c ) const {
+            return value < c.value;
+        }
+    };
+
+    /*
+        A stateful allocator in the spirit of an arena, which hands out blocks from the heap
+        but keeps count of how many it has out and how many elements they hold.
+    */
+    template <typename T>
+    class counting_allocator {
+        public:
+            typedef T               value_type;
+            typedef T              *pointer;
+            typedef const T        *const_pointer;
+            typedef T              &reference;
+            typedef const T        &const_reference;
+            typedef std::size_t     size_type;
+            typedef std::ptrdiff_t  difference_type;
+
+            template <typename U>
+            struct rebind {
+                typedef counting_allocator<U> other;
+            };
+
+            int *blocks;
+            size_type *elements;
+
+            counting_allocator( int *b, size_type *e ) : blocks( b ), elements( e ) {}
+
+            template <typename U>
+            counting_allocator( const counting_allocator<U> &a ) : blocks( a.blocks ), elements( a.elements ) {}
+
+            pointer allocate( size_type n ) {
+                ++*this->blocks;
+                *this->elements += n;
+
+                return std::allocator<T>().allocate( n );
+            }
+
+            void deallocate( pointer p, size_type n ) {
+                --*this->blocks;
+                *this->elements -= n;
+
+                std::allocator<T>().deallocate( p, n );
+            }
+
+            size_type max_size() const {
+                return 1000;
+            }
+    };
+
 #define ASSERT_EQUAL_RANGE(type, f1, l1, f2)    \
     for( type __f1 = f1, __l1 = l1, __f2 = f2;  \
             __f1 != __l1; ++__f1, ++__f2 )          \
@@ -0,0 +1,115 @@
+/*
+    Inserting ranges of any kind of iterator (see insert_range in the adapters), against what it took before,
+    which was inserting them one element at a time. The reported time is per inserted element.
+
+    "list" inserts a std::list of a thousand elements, a bidirectional range, in the middle of an adapter of ten
+    thousand, and "stream" the same from a stream through std::istream_iterator, an input range, which can't
+    be counted first. Both then erase what they inserted, the same for either variant. "assign" replaces the
+    contents with the std::list, against clear() and push_back() for each element.
+*/
+
+#include <data_adapter>
+
+#include <iterator>
+#include <list>
+#include <sstream>
+#include <string>
+
+#include <bench/tools.hpp>
+
+using namespace DataAdapter_Bench;
+
+static const size_t SIZE = 10000;
+static const size_t RANGE = 1000;
+
+template <typename _Adapter>
+static void run_bulk_insert( const char *suite ) {
+    typedef typename _Adapter::element_type element_type;
+
+    _Adapter A;
+    std::list<element_type> L;
+    std::string text;
+    xorshift rng;
+
+    for ( size_t i = 0; i < SIZE; ++i ) {
+        A.push_back( static_cast<element_type>( rng() ) );
+    }
+
+    for ( size_t i = 0; i < RANGE; ++i ) {
+        element_type e = static_cast<element_type>( rng() % 1000 );
+
+        L.push_back( e );
+        text += std::to_string( e ) + ' ';
+    }
+
+    size_t mid = SIZE / 2;
+
+    run( suite, "list", "insert_range", RANGE, [&] {
+        A.insert( A.begin() + mid, L.begin(), L.end() );
+        A.erase( A.begin() + mid, A.begin() + mid + RANGE );
+        do_not_optimize( A.length() );
+    }, RANGE );
+
+    run( suite, "list", "insert_each", RANGE, [&] {
+        size_t p = mid;
+
+        for ( typename std::list<element_type>::const_iterator it = L.begin(); it != L.end(); ++it ) {
+            A.insert( A.begin() + p++, *it );
+        }
+
+        A.erase( A.begin() + mid, A.begin() + mid + RANGE );
+        do_not_optimize( A.length() );
+    }, RANGE );
+
+    //Both parse the same text, so that much of the time is the same
+    run( suite, "stream", "insert_range", RANGE, [&] {
+        std::istringstream in( text );
+
+        A.insert( A.begin() + mid, std::istream_iterator<element_type>( in ), std::istream_iterator<element_type>() );
+        A.erase( A.begin() + mid, A.begin() + mid + RANGE );
+        do_not_optimize( A.length() );
+    }, RANGE );
+
+    run( suite, "stream", "insert_each", RANGE, [&] {
+        std::istringstream in( text );
+        size_t p = mid;
+
+        for ( std::istream_iterator<element_type> it( in ), end; it != end; ++it ) {
+            A.insert( A.begin() + p++, *it );
+        }
+
+        A.erase( A.begin() + mid, A.begin() + mid + RANGE );
+        do_not_optimize( A.length() );
+    }, RANGE );
+
+    _Adapter B;
+
+    run( suite, "assign", "assign", RANGE, [&] {
+        B.assign( L.begin(), L.end() );
+        do_not_optimize( B.length() );
+    }, RANGE );
+
+    run( suite, "assign", "push_back", RANGE, [&] {
+        B.clear();
+
+        for ( typename std::list<element_type>::const_iterator it = L.begin(); it != L.end(); ++it ) {
+            B.push_back( *it );
+        }
+
+        do_not_optimize( B.length() );
+    }, RANGE );
+}
+
+int main( int argc, char **argv ) {
+    parse_args( argc, argv );
+
+    report_header();
+
+    run_bulk_insert<DataAdapter<int[SIZE + RANGE]> >( "array" );
+    run_bulk_insert<DataAdapter<da::dynamic<int> > >( "dynamic" );
+    run_bulk_insert<DataAdapter<da::ring<int, SIZE + RANGE> > >( "ring" );
+
+    report_footer();
+
+    return 0;
+}
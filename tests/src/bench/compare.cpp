@@ -0,0 +1,124 @@
+/*
+    Comparing and hashing adapters (see detail/compare.hpp), against what they did before, going through the
+    elements one at a time with std::equal and std::lexicographical_compare over their iterators. The
+    reported time is per element.
+
+    "equal" compares two equal adapters of a million elements, which is the worst case, and "compare"
+    two that differ only in the last one. "hash" hashes one, against folding std::hash of every element into
+    a running hash. "dedup" puts ten thousand adapters of 256 elements, a tenth of them repeated, into a
+    std::unordered_set, which hashes and compares them both.
+*/
+
+#include <data_adapter>
+
+#include <algorithm>
+#include <cstdio>
+#include <functional>
+#include <unordered_set>
+#include <vector>
+
+#include <bench/tools.hpp>
+
+using namespace DataAdapter_Bench;
+
+static const size_t SIZE = 1 << 20;
+static const size_t BUFFERS = 10000;
+static const size_t BUFFER_SIZE = 256;
+
+template <typename _Adapter>
+struct elementwise_hash {
+    size_t operator()( const _Adapter &a ) const {
+        size_t h = 0;
+
+        for ( typename _Adapter::const_iterator it = a.cbegin(); it != a.cend(); ++it ) {
+            h ^= std::hash<typename _Adapter::element_type>()( *it ) + 0x9E3779B9 + ( h << 6 ) + ( h >> 2 );
+        }
+
+        return h;
+    }
+};
+
+template <typename _Adapter>
+struct elementwise_equal {
+    bool operator()( const _Adapter &a, const _Adapter &b ) const {
+        return a.length() == b.length() && std::equal( a.cbegin(), a.cend(), b.cbegin() );
+    }
+};
+
+template <typename T>
+static void run_compare( const char *type ) {
+    typedef DataAdapter<da::dynamic<T> > adapter_t;
+
+    adapter_t A, B;
+    xorshift rng;
+
+    for ( size_t i = 0; i < SIZE; ++i ) {
+        A.push_back( static_cast<T>( rng() ) );
+    }
+
+    B = A;
+
+    run( type, "equal", "operator==", SIZE, [&] {
+        do_not_optimize( A == B );
+    }, SIZE );
+
+    run( type, "equal", "std_equal", SIZE, [&] {
+        do_not_optimize( elementwise_equal<adapter_t>()( A, B ) );
+    }, SIZE );
+
+    B.back() += 1;
+
+    run( type, "compare", "compare", SIZE, [&] {
+        do_not_optimize( A.compare( B ) );
+    }, SIZE );
+
+    run( type, "compare", "lexicographic", SIZE, [&] {
+        do_not_optimize( std::lexicographical_compare( A.cbegin(), A.cend(), B.cbegin(), B.cend() ) );
+    }, SIZE );
+
+    run( type, "hash", "hash", SIZE, [&] {
+        do_not_optimize( A.hash() );
+    }, SIZE );
+
+    run( type, "hash", "std_hash", SIZE, [&] {
+        do_not_optimize( elementwise_hash<adapter_t>()( A ) );
+    }, SIZE );
+
+    //Buffers like snapshots of something, with some of them repeated
+    std::vector<adapter_t> buffers( BUFFERS );
+
+    for ( size_t b = 0; b < BUFFERS; ++b ) {
+        if ( b % 10 == 9 ) {
+            buffers[b] = buffers[b - 9];
+            continue;
+        }
+
+        for ( size_t i = 0; i < BUFFER_SIZE; ++i ) {
+            buffers[b].push_back( static_cast<T>( rng() ) );
+        }
+    }
+
+    run( type, "dedup", "hash", BUFFERS * BUFFER_SIZE, [&] {
+        std::unordered_set<adapter_t> unique( buffers.begin(), buffers.end() );
+        do_not_optimize( unique.size() );
+    }, BUFFERS * BUFFER_SIZE );
+
+    run( type, "dedup", "elementwise", BUFFERS * BUFFER_SIZE, [&] {
+        std::unordered_set<adapter_t, elementwise_hash<adapter_t>, elementwise_equal<adapter_t> > unique( buffers.begin(), buffers.end() );
+        do_not_optimize( unique.size() );
+    }, BUFFERS * BUFFER_SIZE );
+}
+
+int main( int argc, char **argv ) {
+    parse_args( argc, argv );
+
+    report_header();
+
+    run_compare<unsigned char>( "uint8" );
+    run_compare<int>( "int" );
+    run_compare<long long>( "int64" );
+
+    report_footer();
+
+    return 0;
+}
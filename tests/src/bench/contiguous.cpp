@@ -0,0 +1,102 @@
+/*
+    Shifting cost of the static array adapter.
+
+    "adapter" is what DataAdapter<T[N]> does now, shifting over data() with raw pointers.
+    "offset_iter" runs the same std algorithms through an iterator shaped like the old
+    parent + offset one, where every access goes through parent->at( off ), which is
+    what insert and erase used to do.
+*/
+
+#include <data_adapter>
+
+#include <bench/tools.hpp>
+
+using namespace DataAdapter_Bench;
+
+static const size_t SIZE = 65536;
+
+typedef DataAdapter<int[SIZE]> adapter_t;
+
+//Reproduction of the pre-pointer iterator, only as much as copy/copy_backward need
+class offset_iterator {
+    public:
+        typedef std::random_access_iterator_tag     iterator_category;
+        typedef int                                 value_type;
+        typedef std::ptrdiff_t                      difference_type;
+        typedef int                                *pointer;
+        typedef int                                &reference;
+
+        adapter_t *parent;
+        difference_type off;
+
+        offset_iterator( adapter_t *p, difference_type o ) : parent( p ), off( o ) {}
+
+        inline reference operator*() const {
+            return parent->at( static_cast<adapter_t::size_type>( off ) );
+        }
+
+        inline offset_iterator &operator++() {
+            ++off;
+            return *this;
+        }
+
+        inline offset_iterator &operator--() {
+            --off;
+            return *this;
+        }
+
+        inline difference_type operator-( const offset_iterator &it ) const {
+            return off - it.off;
+        }
+
+        inline bool operator==( const offset_iterator &it ) const {
+            return parent == it.parent && off == it.off;
+        }
+
+        inline bool operator!=( const offset_iterator &it ) const {
+            return !( *this == it );
+        }
+};
+
+int main( int argc, char **argv ) {
+    parse_args( argc, argv );
+
+    static adapter_t A;
+
+    A.resize( SIZE - 1, 7 );
+
+    report_header();
+
+    //Insert at the front, then drop the back so the length stays the same
+    report( "contiguous", "insert_front", "adapter", SIZE, measure( [&] {
+        A.insert( A.begin(), 1 );
+        A.pop_back();
+        do_not_optimize( A.front() );
+    } ) );
+
+    report( "contiguous", "insert_front", "offset_iter", SIZE, measure( [&] {
+        size_t len = A.resize( A.length() + 1 );
+        std::copy_backward( offset_iterator( &A, 0 ), offset_iterator( &A, len ), offset_iterator( &A, len + 1 ) );
+        A.front() = 1;
+        A.pop_back();
+        do_not_optimize( A.front() );
+    } ) );
+
+    //Erase 1024 elements near the front, then put them back at the end without shifting
+    report( "contiguous", "erase_range", "adapter", SIZE, measure( [&] {
+        A.erase( A.begin() + 16, A.begin() + 16 + 1024 );
+        A.resize( SIZE - 1, 7 );
+        do_not_optimize( A.front() );
+    } ) );
+
+    report( "contiguous", "erase_range", "offset_iter", SIZE, measure( [&] {
+        size_t len = A.length();
+        std::copy( offset_iterator( &A, 16 + 1024 ), offset_iterator( &A, len ), offset_iterator( &A, 16 ) );
+        std::fill( A.data() + len - 1024, A.data() + len, 7 );
+        do_not_optimize( A.front() );
+    } ) );
+
+    report_footer();
+
+    return 0;
+}
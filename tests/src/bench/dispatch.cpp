@@ -0,0 +1,85 @@
+/*
+    Compares the static (default) and virtual dispatch modes of DataAdapterBase.
+
+    This file is built twice, once as DataAdapter_Bench_Dispatch and once as
+    DataAdapter_Bench_Dispatch_Dynamic with DATA_ADAPTER_DYNAMIC_DISPATCH defined,
+    since the two modes can't be mixed in one program.
+*/
+
+#include <data_adapter>
+
+#include <bench/tools.hpp>
+
+using namespace DataAdapter_Bench;
+
+#ifdef DATA_ADAPTER_DYNAMIC_DISPATCH
+static const char *MODE = "dynamic";
+#else
+static const char *MODE = "static";
+#endif
+
+static const size_t SIZE = 4096;
+
+typedef DataAdapter<int[SIZE]> adapter_t;
+
+int main( int argc, char **argv ) {
+    parse_args( argc, argv );
+
+    static int source[SIZE];
+    static adapter_t A;
+
+    xorshift rng;
+
+    for ( size_t i = 0; i < SIZE; ++i ) {
+        source[i] = static_cast<int>( rng() % 1000000 );
+    }
+
+    report_header();
+
+    report( "dispatch", "sort", MODE, SIZE, measure( [&] {
+        A.assign( source, source + SIZE );
+        A.sort();
+        do_not_optimize( A.front() );
+    }, SIZE ) );
+
+    A.assign( source, source + SIZE );
+
+    report( "dispatch", "find", MODE, SIZE, measure( [&] {
+        //-1 is never generated, so this always scans everything
+        adapter_t::iterator it = A.find( -1 );
+        do_not_optimize( it );
+    }, SIZE ) );
+
+    A.sort();
+
+    report( "dispatch", "find_sorted", MODE, SIZE, measure( [&] {
+        for ( size_t i = 0; i < 256; ++i ) {
+            adapter_t::iterator it = A.find_sorted( source[i] );
+            do_not_optimize( it );
+        }
+    }, 256 ) );
+
+    report( "dispatch", "iterate", MODE, SIZE, measure( [&] {
+        long sum = 0;
+
+        for ( adapter_t::iterator it = A.begin(); it != A.end(); ++it ) {
+            sum += *it;
+        }
+
+        do_not_optimize( sum );
+    }, SIZE ) );
+
+    report( "dispatch", "insert_middle", MODE, SIZE / 4, measure( [&] {
+        A.clear();
+
+        for ( size_t i = 0; i < SIZE / 4; ++i ) {
+            A.insert( A.begin() + A.length() / 2, source[i] );
+        }
+
+        do_not_optimize( A.front() );
+    }, SIZE / 4 ) );
+
+    report_footer();
+
+    return 0;
+}
@@ -0,0 +1,80 @@
+/*
+    The growable adapter against std::vector.
+
+    "fill" builds a container of n elements with push_back from empty, so it includes every
+    reallocation on the way, and "fill_reserved" does the same after reserve( n ).
+    "malloc" is the adapter with da::malloc_allocator, which grows trivially relocatable elements with realloc.
+*/
+
+#include <data_adapter>
+
+#include <vector>
+
+#include <bench/tools.hpp>
+
+using namespace DataAdapter_Bench;
+
+struct blob {
+    char bytes[64];
+};
+
+template <typename T>
+static T make( size_t i ) {
+    return static_cast<T>( i );
+}
+
+template <>
+blob make<blob>( size_t i ) {
+    blob b;
+    b.bytes[0] = static_cast<char>( i );
+    return b;
+}
+
+template <typename Container, typename T>
+static void run_fill( const char *type, const char *variant, size_t n ) {
+    run( type, "fill", variant, n, [&] {
+        Container c;
+
+        for ( size_t i = 0; i < n; ++i ) {
+            c.push_back( make<T>( i ) );
+        }
+
+        do_not_optimize( c.data()[n - 1] );
+    }, n );
+
+    run( type, "fill_reserved", variant, n, [&] {
+        Container c;
+
+        c.reserve( n );
+
+        for ( size_t i = 0; i < n; ++i ) {
+            c.push_back( make<T>( i ) );
+        }
+
+        do_not_optimize( c.data()[n - 1] );
+    }, n );
+}
+
+template <typename T>
+static void run_all( const char *type ) {
+    static const size_t SIZES[] = { 16, 256, 4096, 65536, 1048576 };
+
+    for ( size_t s = 0; s < sizeof( SIZES ) / sizeof( SIZES[0] ); ++s ) {
+        run_fill<std::vector<T>, T>( type, "std::vector", SIZES[s] );
+        run_fill<DataAdapter<da::dynamic<T> >, T>( type, "dynamic", SIZES[s] );
+        run_fill<DataAdapter<da::dynamic<T, da::malloc_allocator<T> > >, T>( type, "malloc", SIZES[s] );
+    }
+}
+
+int main( int argc, char **argv ) {
+    parse_args( argc, argv );
+
+    report_header();
+
+    run_all<int>( "int" );
+    run_all<blob>( "blob64" );
+
+    report_footer();
+
+    return 0;
+}
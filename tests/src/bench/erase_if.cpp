@@ -0,0 +1,135 @@
+/*
+    Expiry sweeps over a session table in the static array adapter, erase_if() against erasing each expired
+    entry with erase( pos ), and unordered_erase() against erase( pos ) for single entries.
+
+    The table holds SIZE sessions of 32 bytes. Each sweep expires the given percentage of them, spread all
+    over the table, and refills it with the same sessions afterwards, which is the same for both variants.
+    The reported time is per session in the table. "single" erases entries from random places one at a time
+    and pushes them back, reported per erase.
+*/
+
+#include <data_adapter>
+
+#include <cstdio>
+
+#include <bench/tools.hpp>
+
+using namespace DataAdapter_Bench;
+
+static const size_t SIZE = 4096;
+
+struct session {
+    unsigned long long id;
+    unsigned long long expires;
+    unsigned long long bytes;
+    unsigned long long flags;
+
+    bool operator==( const session &s ) const {
+        return this->id == s.id;
+    }
+
+    bool operator<( const session &s ) const {
+        return this->id < s.id;
+    }
+};
+
+typedef DataAdapter<session[SIZE]> adapter_t;
+
+static adapter_t A, expired;
+
+struct expires_before {
+    unsigned long long now;
+
+    expires_before( unsigned long long n ) : now( n ) {}
+
+    bool operator()( const session &s ) const {
+        return s.expires < this->now;
+    }
+};
+
+int main( int argc, char **argv ) {
+    parse_args( argc, argv );
+
+    static const int EXPIRED[] = { 1, 10, 50 };
+
+    xorshift rng;
+
+    for ( size_t i = 0; i < SIZE; ++i ) {
+        session s = { i, rng() % 100, 0, 0 };
+
+        A.push_back( s );
+    }
+
+    report_header();
+
+    for ( size_t e = 0; e < sizeof( EXPIRED ) / sizeof( EXPIRED[0] ); ++e ) {
+        expires_before pred( EXPIRED[e] );
+        char name[32];
+
+        std::snprintf( name, sizeof( name ), "sweep_%d%%", EXPIRED[e] );
+
+        //Both keep what expired, to put it back afterwards
+        auto expire = [&]( const session & s ) {
+            if ( pred( s ) ) {
+                expired.push_back( s );
+                return true;
+            }
+
+            return false;
+        };
+
+        run( "session", name, "erase_if", SIZE, [&] {
+            expired.clear();
+
+            A.erase_if( expire );
+            A.append( expired.begin(), expired.end() );
+
+            do_not_optimize( A.length() );
+        }, SIZE );
+
+        run( "session", name, "erase", SIZE, [&] {
+            expired.clear();
+
+            for ( adapter_t::iterator it = A.begin(); it != A.end(); ) {
+                if ( expire( *it ) ) {
+                    it = A.erase( it );
+
+                } else {
+                    ++it;
+                }
+            }
+
+            A.append( expired.begin(), expired.end() );
+
+            do_not_optimize( A.length() );
+        }, SIZE );
+    }
+
+    run( "session", "single", "unordered_erase", SIZE, [&] {
+        for ( size_t i = 0; i < SIZE; ++i ) {
+            size_t pos = static_cast<size_t>( rng() % A.length() );
+            session s = A[pos];
+
+            A.unordered_erase( A.begin() + pos );
+            A.push_back( s );
+        }
+
+        do_not_optimize( A.length() );
+    }, SIZE );
+
+    run( "session", "single", "erase", SIZE, [&] {
+        for ( size_t i = 0; i < SIZE; ++i ) {
+            size_t pos = static_cast<size_t>( rng() % A.length() );
+            session s = A[pos];
+
+            A.erase( A.begin() + pos );
+            A.push_back( s );
+        }
+
+        do_not_optimize( A.length() );
+    }, SIZE );
+
+    report_footer();
+
+    return 0;
+}
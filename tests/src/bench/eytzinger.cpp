@@ -0,0 +1,64 @@
+/*
+    Lookups in a sorted table of ints, with a different pseudo random key every time.
+
+    "eytzinger" is da::eytzinger_index::lower_bound, "find_sorted" the branchless binary search of the
+    contiguous adapters, on a DataAdapter<da::dynamic<int> >, and "std" std::lower_bound on the same elements.
+    The table sizes go from fitting in L1 to well past the last level cache.
+*/
+
+#include <data_adapter>
+
+#include <algorithm>
+
+#include <bench/tools.hpp>
+
+using namespace DataAdapter_Bench;
+
+static inline size_t next_key( size_t &r, size_t n ) {
+    r = r * 6364136223846793005ull + 1442695040888963407ull;
+    return ( r >> 24 ) % ( 2 * n );
+}
+
+static void run_lookups( size_t n ) {
+    DataAdapter<da::dynamic<int> > A;
+
+    A.reserve( n );
+
+    //Odd keys, so about half the lookups are misses
+    for ( size_t i = 0; i < n; ++i ) {
+        A.push_back( static_cast<int>( 2 * i + 1 ) );
+    }
+
+    da::eytzinger_index<int> index( A );
+
+    const int *first = A.data(), *last = A.data() + n;
+    size_t r = 1;
+
+    run( "int", "lower_bound", "eytzinger", n, [&] {
+        do_not_optimize( index.lower_bound( static_cast<int>( next_key( r, n ) ) ) );
+    } );
+
+    run( "int", "lower_bound", "find_sorted", n, [&] {
+        do_not_optimize( A.find_sorted( static_cast<int>( next_key( r, n ) ) ) );
+    } );
+
+    run( "int", "lower_bound", "std", n, [&] {
+        do_not_optimize( std::lower_bound( first, last, static_cast<int>( next_key( r, n ) ) ) );
+    } );
+}
+
+int main( int argc, char **argv ) {
+    parse_args( argc, argv );
+
+    report_header();
+
+    static const size_t SIZES[] = { 1 << 10, 1 << 16, 1 << 20, 1 << 23 };
+
+    for ( size_t s = 0; s < sizeof( SIZES ) / sizeof( SIZES[0] ); ++s ) {
+        run_lookups( SIZES[s] );
+    }
+
+    report_footer();
+
+    return 0;
+}
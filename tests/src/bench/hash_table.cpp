@@ -0,0 +1,96 @@
+/*
+    Lookup and insertion cost of DataAdapter<da::hash_table<K, V>> against std::unordered_map.
+
+    "hit" looks up keys that are all present, "miss" keys that never are,
+    and "insert" builds a table from empty, so every growth step is included.
+    Keys come from xorshift, so the order of lookups has nothing to do with the order of insertion.
+*/
+
+#include <data_adapter>
+
+#include <unordered_map>
+#include <vector>
+
+#include <bench/tools.hpp>
+
+using namespace DataAdapter_Bench;
+
+typedef unsigned long long key_type;
+
+template <typename Table>
+static void run( const char *variant, size_t n ) {
+    std::vector<key_type> present, absent;
+
+    xorshift rng;
+
+    present.reserve( n );
+    absent.reserve( n );
+
+    //Odd keys go in, even keys stay out
+    for ( size_t i = 0; i < n; ++i ) {
+        present.push_back( rng() | 1 );
+        absent.push_back( rng() & ~1ULL );
+    }
+
+    Table table;
+
+    for ( size_t i = 0; i < n; ++i ) {
+        table[present[i]] = i;
+    }
+
+    report( "hash_table", "hit", variant, n, measure( [&] {
+        size_t sum = 0;
+
+        for ( size_t i = 0; i < n; ++i ) {
+            sum += table.find( present[i] )->second;
+        }
+
+        do_not_optimize( sum );
+    }, n ) );
+
+    report( "hash_table", "miss", variant, n, measure( [&] {
+        size_t found = 0;
+
+        for ( size_t i = 0; i < n; ++i ) {
+            found += table.find( absent[i] ) != table.end();
+        }
+
+        do_not_optimize( found );
+    }, n ) );
+
+    report( "hash_table", "insert", variant, n, measure( [&] {
+        Table t;
+
+        for ( size_t i = 0; i < n; ++i ) {
+            t[present[i]] = i;
+        }
+
+        do_not_optimize( t.size() );
+    }, n ) );
+
+    report( "hash_table", "insert_erase", variant, n, measure( [&] {
+        for ( size_t i = 0; i < n; ++i ) {
+            table.erase( present[i] );
+            table[present[i]] = i;
+        }
+
+        do_not_optimize( table.size() );
+    }, n ) );
+}
+
+int main( int argc, char **argv ) {
+    parse_args( argc, argv );
+
+    static const size_t SIZES[] = { 1000, 100000, 1000000 };
+
+    report_header();
+
+    for ( size_t i = 0; i < sizeof( SIZES ) / sizeof( SIZES[0] ); ++i ) {
+        run<DataAdapter<da::hash_table<key_type, size_t> > >( "adapter", SIZES[i] );
+        run<std::unordered_map<key_type, size_t> >( "unordered", SIZES[i] );
+    }
+
+    report_footer();
+
+    return 0;
+}
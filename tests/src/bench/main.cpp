@@ -0,0 +1,488 @@
+/*
+    DataAdapter_Bench, every common operation of DataAdapter<T[N]> against the standard containers.
+
+    Each operation is run through a small wrapper per container, so that the same benchmark code
+    drives all of them. The wrappers use whatever a user of that container would write for the
+    operation: std::array gets a separate length and the std algorithms, std::vector and std::deque
+    their own members, with upper_bound for the sorted operations.
+
+    Operations that would change the length are paired with their inverse (push_back with pop_back,
+    insert with erase) so every iteration starts from the same contents, half full unless noted.
+    sort and stable_sort restore shuffled contents before every call, and the cost of doing just
+    that is measured separately and subtracted.
+
+    Rows are reported with the element type as the suite, the operation as the benchmark,
+    and the container as the variant. Run with --format=csv or --format=json to keep results
+    around for comparing releases, and --filter to run only some of them.
+*/
+
+#include <data_adapter>
+
+#include <array>
+#include <deque>
+#include <vector>
+
+#include <bench/tools.hpp>
+
+using namespace DataAdapter_Bench;
+
+//Elements larger than a cache line's worth of ints, to see what moving them costs
+struct record {
+    long long key;
+    char payload[56];
+
+    record( long long k = 0 ) : key( k ) {
+        std::memset( payload, 0, sizeof( payload ) );
+    }
+
+    inline bool operator==( const record &r ) const {
+        return key == r.key;
+    }
+
+    inline bool operator<( const record &r ) const {
+        return key < r.key;
+    }
+};
+
+inline long long key_of( int v ) {
+    return v;
+}
+
+inline long long key_of( double v ) {
+    return static_cast<long long>( v );
+}
+
+inline long long key_of( const record &v ) {
+    return v.key;
+}
+
+template <typename T>
+inline T make( unsigned long long k ) {
+    return T( static_cast<long long>( k % 1000000 ) );
+}
+
+template <>
+inline double make<double>( unsigned long long k ) {
+    return static_cast<double>( k % 1000000 ) + 0.5;
+}
+
+//Number of elements the range and fill inserts add at once
+static const size_t CHUNK = 8;
+
+template <typename T, size_t N>
+class adapter_wrap {
+    public:
+        typedef DataAdapter<T[N]> container_type;
+
+        container_type c, chunk;
+
+        adapter_wrap() {
+            this->chunk.resize( CHUNK, make<T>( 1 ) );
+        }
+
+        inline size_t size() const {
+            return this->c.length();
+        }
+
+        void assign( const std::vector<T> &v ) {
+            this->c.assign( v.begin(), v.end() );
+        }
+
+        inline void push_back( const T &v ) {
+            this->c.push_back( v );
+        }
+
+        inline void pop_back() {
+            this->c.pop_back();
+        }
+
+        inline void push_front( const T &v ) {
+            this->c.push_front( v );
+        }
+
+        inline void pop_front() {
+            this->c.pop_front();
+        }
+
+        inline void insert( size_t off, const T &v ) {
+            this->c.insert( this->c.begin() + off, v );
+        }
+
+        inline void insert_fill( size_t off, const T &v ) {
+            this->c.insert( this->c.begin() + off, CHUNK, v );
+        }
+
+        inline void insert_range( size_t off ) {
+            this->c.insert( this->c.begin() + off, this->chunk.cbegin(), this->chunk.cend() );
+        }
+
+        inline void erase( size_t off, size_t n ) {
+            this->c.erase( this->c.begin() + off, this->c.begin() + ( off + n ) );
+        }
+
+        inline void sort() {
+            this->c.sort();
+        }
+
+        inline void stable_sort() {
+            this->c.stable_sort();
+        }
+
+        inline bool find( const T &v ) {
+            return this->c.find( v ) != this->c.end();
+        }
+
+        inline bool find_sorted( const T &v ) {
+            return this->c.find_sorted( v ) != this->c.end();
+        }
+
+        inline size_t sorted_insert( const T &v ) {
+            return this->c.sorted_insert( v ) - this->c.begin();
+        }
+
+        inline long long sum() const {
+            long long s = 0;
+
+            for ( typename container_type::const_iterator it = this->c.cbegin(); it != this->c.cend(); ++it ) {
+                s += key_of( *it );
+            }
+
+            return s;
+        }
+};
+
+template <typename T, size_t N>
+class array_wrap {
+    public:
+        std::array<T, N> c;
+        size_t len;
+
+        std::array<T, CHUNK> chunk;
+
+        array_wrap() : len( 0 ) {
+            this->chunk.fill( make<T>( 1 ) );
+        }
+
+        inline size_t size() const {
+            return this->len;
+        }
+
+        void assign( const std::vector<T> &v ) {
+            std::copy( v.begin(), v.end(), this->c.begin() );
+            this->len = v.size();
+        }
+
+        inline void push_back( const T &v ) {
+            this->c[this->len++] = v;
+        }
+
+        inline void pop_back() {
+            --this->len;
+        }
+
+        inline void push_front( const T &v ) {
+            std::copy_backward( this->c.begin(), this->c.begin() + this->len, this->c.begin() + this->len + 1 );
+            this->c[0] = v;
+            ++this->len;
+        }
+
+        inline void pop_front() {
+            std::copy( this->c.begin() + 1, this->c.begin() + this->len, this->c.begin() );
+            --this->len;
+        }
+
+        inline void insert( size_t off, const T &v ) {
+            std::copy_backward( this->c.begin() + off, this->c.begin() + this->len, this->c.begin() + this->len + 1 );
+            this->c[off] = v;
+            ++this->len;
+        }
+
+        inline void insert_fill( size_t off, const T &v ) {
+            std::copy_backward( this->c.begin() + off, this->c.begin() + this->len, this->c.begin() + this->len + CHUNK );
+            std::fill( this->c.begin() + off, this->c.begin() + off + CHUNK, v );
+            this->len += CHUNK;
+        }
+
+        inline void insert_range( size_t off ) {
+            std::copy_backward( this->c.begin() + off, this->c.begin() + this->len, this->c.begin() + this->len + CHUNK );
+            std::copy( this->chunk.begin(), this->chunk.end(), this->c.begin() + off );
+            this->len += CHUNK;
+        }
+
+        inline void erase( size_t off, size_t n ) {
+            std::copy( this->c.begin() + off + n, this->c.begin() + this->len, this->c.begin() + off );
+            this->len -= n;
+        }
+
+        inline void sort() {
+            std::sort( this->c.begin(), this->c.begin() + this->len );
+        }
+
+        inline void stable_sort() {
+            std::stable_sort( this->c.begin(), this->c.begin() + this->len );
+        }
+
+        inline bool find( const T &v ) {
+            return std::find( this->c.begin(), this->c.begin() + this->len, v ) != this->c.begin() + this->len;
+        }
+
+        inline bool find_sorted( const T &v ) {
+            return std::binary_search( this->c.begin(), this->c.begin() + this->len, v );
+        }
+
+        inline size_t sorted_insert( const T &v ) {
+            size_t off = std::upper_bound( this->c.begin(), this->c.begin() + this->len, v ) - this->c.begin();
+
+            this->insert( off, v );
+
+            return off;
+        }
+
+        inline long long sum() const {
+            long long s = 0;
+
+            for ( size_t i = 0; i < this->len; ++i ) {
+                s += key_of( this->c[i] );
+            }
+
+            return s;
+        }
+};
+
+//std::vector and std::deque, which only differ in push_front and pop_front
+template <typename Container>
+class sequence_wrap {
+    public:
+        typedef typename Container::value_type T;
+
+        Container c;
+        std::vector<T> chunk;
+
+        sequence_wrap() : chunk( CHUNK, make<T>( 1 ) ) {}
+
+        inline size_t size() const {
+            return this->c.size();
+        }
+
+        void assign( const std::vector<T> &v ) {
+            this->c.assign( v.begin(), v.end() );
+        }
+
+        inline void push_back( const T &v ) {
+            this->c.push_back( v );
+        }
+
+        inline void pop_back() {
+            this->c.pop_back();
+        }
+
+        inline void push_front( const T &v ) {
+            this->c.insert( this->c.begin(), v );
+        }
+
+        inline void pop_front() {
+            this->c.erase( this->c.begin() );
+        }
+
+        inline void insert( size_t off, const T &v ) {
+            this->c.insert( this->c.begin() + off, v );
+        }
+
+        inline void insert_fill( size_t off, const T &v ) {
+            this->c.insert( this->c.begin() + off, CHUNK, v );
+        }
+
+        inline void insert_range( size_t off ) {
+            this->c.insert( this->c.begin() + off, this->chunk.begin(), this->chunk.end() );
+        }
+
+        inline void erase( size_t off, size_t n ) {
+            this->c.erase( this->c.begin() + off, this->c.begin() + ( off + n ) );
+        }
+
+        inline void sort() {
+            std::sort( this->c.begin(), this->c.end() );
+        }
+
+        inline void stable_sort() {
+            std::stable_sort( this->c.begin(), this->c.end() );
+        }
+
+        inline bool find( const T &v ) {
+            return std::find( this->c.begin(), this->c.end(), v ) != this->c.end();
+        }
+
+        inline bool find_sorted( const T &v ) {
+            return std::binary_search( this->c.begin(), this->c.end(), v );
+        }
+
+        inline size_t sorted_insert( const T &v ) {
+            typename Container::iterator it = std::upper_bound( this->c.begin(), this->c.end(), v );
+            size_t off = it - this->c.begin();
+
+            this->c.insert( it, v );
+
+            return off;
+        }
+
+        inline long long sum() const {
+            long long s = 0;
+
+            for ( typename Container::const_iterator it = this->c.begin(); it != this->c.end(); ++it ) {
+                s += key_of( *it );
+            }
+
+            return s;
+        }
+};
+
+template <typename T>
+class deque_wrap : public sequence_wrap<std::deque<T> > {
+    public:
+        inline void push_front( const T &v ) {
+            this->c.push_front( v );
+        }
+
+        inline void pop_front() {
+            this->c.pop_front();
+        }
+};
+
+template <typename T>
+class vector_wrap : public sequence_wrap<std::vector<T> > {};
+
+/*
+    Runs every operation on one container. The wrapper is static, since the fixed size ones
+    can be far too large for the stack.
+*/
+template <typename Wrap, typename T>
+void run_container( const char *suite, const char *variant, size_t n ) {
+    static Wrap w;
+
+    std::vector<T> shuffled, sorted, keys;
+
+    xorshift rng;
+
+    //Half full, so there is room for everything that grows the contents
+    for ( size_t i = 0; i < n / 2; ++i ) {
+        shuffled.push_back( make<T>( rng() ) );
+    }
+
+    sorted = shuffled;
+    std::sort( sorted.begin(), sorted.end() );
+
+    //Keys that are present, in an order unrelated to the contents
+    for ( size_t i = 0; i < 256; ++i ) {
+        keys.push_back( shuffled[rng() % shuffled.size()] );
+    }
+
+    size_t k = 0;
+    T v = make<T>( 42 );
+    size_t mid = n / 4;
+
+    w.assign( shuffled );
+
+    run( suite, "push_back+pop_back", variant, n, [&] {
+        w.push_back( v );
+        w.pop_back();
+        clobber();
+    } );
+
+    run( suite, "push_front+pop_front", variant, n, [&] {
+        w.push_front( v );
+        w.pop_front();
+        clobber();
+    } );
+
+    run( suite, "insert+erase", variant, n, [&] {
+        w.insert( mid, v );
+        w.erase( mid, 1 );
+        clobber();
+    } );
+
+    run( suite, "insert_fill+erase", variant, n, [&] {
+        w.insert_fill( mid, v );
+        w.erase( mid, CHUNK );
+        clobber();
+    } );
+
+    run( suite, "insert_range+erase", variant, n, [&] {
+        w.insert_range( mid );
+        w.erase( mid, CHUNK );
+        clobber();
+    } );
+
+    run( suite, "find", variant, n, [&] {
+        do_not_optimize( w.find( keys[k++ & 255] ) );
+    } );
+
+    run( suite, "iterate", variant, n, [&] {
+        do_not_optimize( w.sum() );
+    }, n / 2 );
+
+    bool sort = selected( suite, "sort", variant ), stable_sort = selected( suite, "stable_sort", variant );
+
+    if ( sort || stable_sort ) {
+        double reset = measure( [&] {
+            w.assign( shuffled );
+            clobber();
+        } );
+
+        if ( sort ) {
+            report( suite, "sort", variant, n, measure( [&] {
+                w.assign( shuffled );
+                w.sort();
+                clobber();
+            } ) - reset );
+        }
+
+        if ( stable_sort ) {
+            report( suite, "stable_sort", variant, n, measure( [&] {
+                w.assign( shuffled );
+                w.stable_sort();
+                clobber();
+            } ) - reset );
+        }
+    }
+
+    w.assign( sorted );
+
+    run( suite, "find_sorted", variant, n, [&] {
+        do_not_optimize( w.find_sorted( keys[k++ & 255] ) );
+    } );
+
+    run( suite, "sorted_insert+erase", variant, n, [&] {
+        w.erase( w.sorted_insert( keys[k++ & 255] ), 1 );
+        clobber();
+    } );
+}
+
+template <typename T, size_t N>
+void run_size( const char *suite ) {
+    run_container<adapter_wrap<T, N>, T>( suite, "adapter", N );
+    run_container<array_wrap<T, N>, T>( suite, "std::array", N );
+    run_container<vector_wrap<T>, T>( suite, "std::vector", N );
+    run_container<deque_wrap<T>, T>( suite, "std::deque", N );
+}
+
+template <typename T>
+void run_type( const char *suite ) {
+    run_size<T, 16>( suite );
+    run_size<T, 256>( suite );
+    run_size<T, 4096>( suite );
+    run_size<T, 65536>( suite );
+}
+
+int main( int argc, char **argv ) {
+    parse_args( argc, argv );
+
+    report_header();
+
+    run_type<int>( "int" );
+    run_type<double>( "double" );
+    run_type<record>( "record" );
+
+    report_footer();
+
+    return 0;
+}
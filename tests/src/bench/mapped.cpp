@@ -0,0 +1,93 @@
+/*
+    DataAdapter<da::mapped<int> > against DataAdapter<da::dynamic<int> > with the same elements, for a table of
+    4M ints (16MB) in a file in TMPDIR, or /tmp.
+
+    "push_back" builds the table one element at a time from empty, which for the mapped adapter includes
+    creating the file and growing it through every remap. "find_sorted" is random lookups in the finished
+    table, which should cost the same for both once its pages are in memory. "startup" is what a restarted
+    process has to do before its first lookup: opening the file as a mapped adapter, or reading the
+    snapshot back into a DataAdapter<int[N]> with da::load. The file is in the page cache throughout.
+*/
+
+#include <data_adapter>
+
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
+#include <bench/tools.hpp>
+
+using namespace DataAdapter_Bench;
+
+static const size_t SIZE = 1 << 22;
+
+static inline int next_key( size_t &r ) {
+    r = r * 6364136223846793005ull + 1442695040888963407ull;
+    return static_cast<int>( ( r >> 24 ) % ( 2 * SIZE ) );
+}
+
+int main( int argc, char **argv ) {
+    parse_args( argc, argv );
+
+    report_header();
+
+    const char *dir = std::getenv( "TMPDIR" );
+    std::string path = std::string( dir != NULL ? dir : "/tmp" ) + "/data_adapter_bench_mapped.snap";
+
+    run( "int", "push_back", "mapped", SIZE, [&] {
+        std::remove( path.c_str() );
+
+        DataAdapter<da::mapped<int> > A( path.c_str() );
+
+        for ( size_t i = 0; i < SIZE; ++i ) {
+            A.push_back( static_cast<int>( 2 * i ) );
+        }
+    }, SIZE );
+
+    run( "int", "push_back", "dynamic", SIZE, [] {
+        DataAdapter<da::dynamic<int> > A;
+
+        for ( size_t i = 0; i < SIZE; ++i ) {
+            A.push_back( static_cast<int>( 2 * i ) );
+        }
+
+        do_not_optimize( A.back() );
+    }, SIZE );
+
+    //The last run of push_back left the whole table in the file
+    {
+        DataAdapter<da::mapped<int> > M( path.c_str() );
+        DataAdapter<da::dynamic<int> > D;
+        size_t r = 1;
+
+        D.assign( M.begin(), M.end() );
+        M.advise( da::advice::random );
+
+        run( "int", "find_sorted", "mapped", SIZE, [&] {
+            do_not_optimize( M.find_sorted( next_key( r ) ) );
+        } );
+
+        run( "int", "find_sorted", "dynamic", SIZE, [&] {
+            do_not_optimize( D.find_sorted( next_key( r ) ) );
+        } );
+    }
+
+    static DataAdapter<int[SIZE]> S;
+    size_t r = 1;
+
+    run( "int", "startup", "mapped", SIZE, [&] {
+        DataAdapter<da::mapped<int> > M( path.c_str() );
+        do_not_optimize( M.find_sorted( next_key( r ) ) );
+    } );
+
+    run( "int", "startup", "load", SIZE, [&] {
+        da::load( S, path.c_str() );
+        do_not_optimize( S.find_sorted( next_key( r ) ) );
+    } );
+
+    std::remove( path.c_str() );
+
+    report_footer();
+
+    return 0;
+}
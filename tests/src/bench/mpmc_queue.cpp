@@ -0,0 +1,132 @@
+/*
+    Scalability of da::mpmc_queue against a DataAdapter<da::ring<T, N> > behind a std::mutex, which is
+    what a shared queue is without it.
+
+    Each row runs n threads, half of them pushing and half popping (one of each for n = 1, on two threads),
+    until a million ints have gone through, and reports the time per element over all of them. With one
+    thread per core that shows how well the queue scales. Past that, or on a machine with fewer cores,
+    it mostly shows how the two cope with waiting threads being switched out.
+*/
+
+#include <data_adapter>
+
+#include <cstdio>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <bench/tools.hpp>
+
+using namespace DataAdapter_Bench;
+
+static const size_t CAPACITY = 1024;
+static const size_t COUNT = 1000000;
+
+typedef da::mpmc_queue<int, CAPACITY> queue_t;
+
+class locked_ring {
+    private:
+        std::mutex lock;
+        DataAdapter<da::ring<int, CAPACITY> > ring;
+
+    public:
+        bool try_push( int x ) {
+            std::lock_guard<std::mutex> g( this->lock );
+
+            if ( this->ring.full() ) {
+                return false;
+            }
+
+            this->ring.push_back( x );
+            return true;
+        }
+
+        bool try_pop( int &x ) {
+            std::lock_guard<std::mutex> g( this->lock );
+
+            if ( this->ring.empty() ) {
+                return false;
+            }
+
+            x = this->ring.pop_front();
+            return true;
+        }
+};
+
+//Both ends of every thread's share of COUNT, spread as evenly as it goes
+static inline size_t share( size_t i, size_t threads ) {
+    return COUNT * ( i + 1 ) / threads - COUNT * i / threads;
+}
+
+template <typename Q>
+static void transfer( Q &q, size_t threads ) {
+    size_t producers = threads > 1 ? threads / 2 : 1;
+    size_t consumers = threads > 1 ? threads - producers : 1;
+
+    std::vector<std::thread> pool;
+
+    for ( size_t p = 0; p < producers; ++p ) {
+        pool.push_back( std::thread( [&q, p, producers] {
+            for ( size_t i = share( p, producers ); i != 0; ) {
+                if ( q.try_push( static_cast<int>( i ) ) ) {
+                    --i;
+
+                } else {
+                    std::this_thread::yield();
+                }
+            }
+        } ) );
+    }
+
+    for ( size_t c = 0; c < consumers; ++c ) {
+        pool.push_back( std::thread( [&q, c, consumers] {
+            int x = 0;
+
+            for ( size_t i = share( c, consumers ); i != 0; ) {
+                if ( q.try_pop( x ) ) {
+                    --i;
+
+                } else {
+                    std::this_thread::yield();
+                }
+            }
+
+            do_not_optimize( x );
+        } ) );
+    }
+
+    for ( size_t t = 0; t < pool.size(); ++t ) {
+        pool[t].join();
+    }
+}
+
+int main( int argc, char **argv ) {
+    parse_args( argc, argv );
+
+    if ( settings().format == FORMAT_TABLE ) {
+        std::printf( "%u cores\n", std::thread::hardware_concurrency() );
+    }
+
+    report_header();
+
+    static queue_t q;
+    static locked_ring lq;
+
+    static const size_t THREADS[] = { 1, 2, 4, 8, 16, 32 };
+
+    for ( size_t t = 0; t < sizeof( THREADS ) / sizeof( THREADS[0] ); ++t ) {
+        size_t threads = THREADS[t];
+
+        run( "int", "transfer", "mpmc", threads, [threads] {
+            transfer( q, threads );
+        }, COUNT );
+
+        run( "int", "transfer", "mutex_ring", threads, [threads] {
+            transfer( lq, threads );
+        }, COUNT );
+    }
+
+    report_footer();
+
+    return 0;
+}
@@ -0,0 +1,92 @@
+/*
+    sort( threads ) and stable_sort( threads ) on a DataAdapter<da::dynamic<T> > against the sequential
+    sort() and stable_sort(), for 1, 2, 4 and one thread per core.
+
+    Every call first copies the same unsorted elements back in, so all variants pay for that copy too,
+    and the reported time is per element. The speedup needs cores to show: with a single one the
+    parallel variants only add the merge rounds on top of the sequential sort.
+*/
+
+#include <data_adapter>
+
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+#include <bench/tools.hpp>
+
+using namespace DataAdapter_Bench;
+
+template <typename T>
+static void run_sorts( const char *type, size_t n ) {
+    typedef DataAdapter<da::dynamic<T> > adapter_t;
+
+    xorshift rng;
+    std::vector<T> unsorted;
+
+    for ( size_t i = 0; i < n; ++i ) {
+        unsorted.push_back( static_cast<T>( rng() % ( n * 4 ) ) );
+    }
+
+    adapter_t A;
+
+    A.reserve( n );
+
+    for ( size_t i = 0; i < n; ++i ) {
+        A.push_back( unsorted[i] );
+    }
+
+    T *data = A.data();
+
+    run( type, "sort", "sequential", n, [&] {
+        std::copy( unsorted.begin(), unsorted.end(), data );
+        A.sort();
+        do_not_optimize( A.front() );
+    }, n );
+
+    run( type, "stable_sort", "sequential", n, [&] {
+        std::copy( unsorted.begin(), unsorted.end(), data );
+        A.stable_sort();
+        do_not_optimize( A.front() );
+    }, n );
+
+    static const unsigned THREADS[] = { 1, 2, 4, 0 };
+    static const char *VARIANTS[] = { "threads=1", "threads=2", "threads=4", "cores" };
+
+    for ( size_t t = 0; t < sizeof( THREADS ) / sizeof( THREADS[0] ); ++t ) {
+        unsigned threads = THREADS[t];
+
+        run( type, "sort", VARIANTS[t], n, [&] {
+            std::copy( unsorted.begin(), unsorted.end(), data );
+            A.sort( threads );
+            do_not_optimize( A.front() );
+        }, n );
+
+        run( type, "stable_sort", VARIANTS[t], n, [&] {
+            std::copy( unsorted.begin(), unsorted.end(), data );
+            A.stable_sort( threads );
+            do_not_optimize( A.front() );
+        }, n );
+    }
+}
+
+int main( int argc, char **argv ) {
+    parse_args( argc, argv );
+
+    if ( settings().format == FORMAT_TABLE ) {
+        std::printf( "%u cores\n", std::thread::hardware_concurrency() );
+    }
+
+    report_header();
+
+    static const size_t SIZES[] = { 65536, 1048576, 8388608 };
+
+    for ( size_t s = 0; s < sizeof( SIZES ) / sizeof( SIZES[0] ); ++s ) {
+        run_sorts<int>( "int", SIZES[s] );
+        run_sorts<double>( "double", SIZES[s] );
+    }
+
+    report_footer();
+
+    return 0;
+}
@@ -0,0 +1,91 @@
+/*
+    sort() on DataAdapter<T[N]> with integer keys, which is a radix sort past a few hundred elements,
+    against the std::sort it used to be, on the same raw elements.
+
+    "uniform" keys are spread over the whole range of T, so every byte takes a pass. "skewed" keys are
+    mostly below 64 with a few large ones in between, like sizes or counts tend to be, and "narrow" keys
+    are all below 1000, so the radix sort skips the passes for their high bytes. Every call first copies
+    the same unsorted elements back in, which both variants pay for, and the reported time is per element.
+*/
+
+#include <data_adapter>
+
+#include <algorithm>
+#include <vector>
+
+#include <bench/tools.hpp>
+
+using namespace DataAdapter_Bench;
+
+static const size_t SIZE = 1 << 20;
+
+template <typename T>
+static void run_sorts( const char *type, const char *name, size_t n, int distribution ) {
+    typedef DataAdapter<T[SIZE]> adapter_t;
+
+    //Far too big for the stack
+    static adapter_t A;
+
+    xorshift rng;
+    std::vector<T> unsorted;
+
+    for ( size_t i = 0; i < n; ++i ) {
+        unsigned long long r = rng();
+
+        switch ( distribution ) {
+            case 0:
+                unsorted.push_back( static_cast<T>( r ) );
+                break;
+
+            case 1:
+                unsorted.push_back( static_cast<T>( ( r & 0xff ) < 230 ? ( r >> 8 ) % 64 : r >> 8 ) );
+                break;
+
+            default:
+                unsorted.push_back( static_cast<T>( ( r >> 8 ) % 1000 ) );
+        }
+    }
+
+    A.clear();
+    A.assign( unsorted.begin(), unsorted.end() );
+
+    T *data = A.data();
+
+    run( type, name, "adapter", n, [&] {
+        std::copy( unsorted.begin(), unsorted.end(), data );
+        A.sort();
+        do_not_optimize( A.front() );
+    }, n );
+
+    run( type, name, "std", n, [&] {
+        std::copy( unsorted.begin(), unsorted.end(), data );
+        std::sort( data, data + n );
+        do_not_optimize( A.front() );
+    }, n );
+}
+
+template <typename T>
+static void run_distributions( const char *type, size_t n ) {
+    run_sorts<T>( type, "sort_uniform", n, 0 );
+    run_sorts<T>( type, "sort_skewed", n, 1 );
+    run_sorts<T>( type, "sort_narrow", n, 2 );
+}
+
+int main( int argc, char **argv ) {
+    parse_args( argc, argv );
+
+    report_header();
+
+    static const size_t SIZES[] = { 256, 4096, 65536, SIZE };
+
+    for ( size_t s = 0; s < sizeof( SIZES ) / sizeof( SIZES[0] ); ++s ) {
+        run_distributions<unsigned int>( "uint32", SIZES[s] );
+        run_distributions<unsigned long long>( "uint64", SIZES[s] );
+        run_distributions<int>( "int32", SIZES[s] );
+        run_distributions<double>( "double", SIZES[s] );
+    }
+
+    report_footer();
+
+    return 0;
+}
@@ -0,0 +1,179 @@
+/*
+    Read scalability of da::read_mostly against the same table of DataAdapter<T[N]> behind a std::mutex,
+    and behind a std::shared_timed_mutex where there is one, which is what readers sharing it would be without it.
+
+    Each row runs n reader threads doing find_sorted on a sorted table of 1024 ints, a hundred thousand
+    lookups each, while another thread publishes a changed table every millisecond, and reports the time per
+    lookup over all of them. Reads that scale perfectly make that time drop in proportion to the number of
+    threads, up to the number of cores.
+*/
+
+#include <data_adapter>
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#if __cplusplus >= 201402L
+#   include <shared_mutex>
+#endif
+
+#include <bench/tools.hpp>
+
+using namespace DataAdapter_Bench;
+
+static const size_t SIZE = 1024;
+static const size_t LOOKUPS = 100000;
+
+typedef DataAdapter<int[SIZE]> table_t;
+
+//Bumps one element of the table, keeping it sorted
+static void change( table_t &t ) {
+    t.back() += 1;
+}
+
+class locked_table {
+    private:
+        std::mutex lock;
+        table_t table;
+
+    public:
+        explicit locked_table( const table_t &t ) : table( t ) {}
+
+        bool contains( int x ) {
+            std::lock_guard<std::mutex> g( this->lock );
+
+            return this->table.find_sorted( x ) != this->table.end();
+        }
+
+        void update() {
+            std::lock_guard<std::mutex> g( this->lock );
+
+            change( this->table );
+        }
+};
+
+#if __cplusplus >= 201402L
+class shared_locked_table {
+    private:
+        std::shared_timed_mutex lock;
+        table_t table;
+
+    public:
+        explicit shared_locked_table( const table_t &t ) : table( t ) {}
+
+        bool contains( int x ) {
+            std::shared_lock<std::shared_timed_mutex> g( this->lock );
+
+            return this->table.find_sorted( x ) != this->table.end();
+        }
+
+        void update() {
+            std::lock_guard<std::shared_timed_mutex> g( this->lock );
+
+            change( this->table );
+        }
+};
+#endif
+
+class read_mostly_table {
+    private:
+        da::read_mostly<table_t> table;
+
+    public:
+        explicit read_mostly_table( const table_t &t ) : table( t ) {}
+
+        bool contains( int x ) {
+            da::read_mostly<table_t>::snapshot s = this->table.read();
+
+            return s.find_sorted( x ) != s.end();
+        }
+
+        void update() {
+            this->table.update( change );
+        }
+};
+
+template <typename Table>
+static void lookups( Table &t, size_t threads ) {
+    std::atomic<bool> done( false );
+
+    std::thread writer( [&t, &done] {
+        while ( !done.load( std::memory_order_relaxed ) ) {
+            t.update();
+            std::this_thread::sleep_for( std::chrono::milliseconds( 1 ) );
+        }
+    } );
+
+    std::vector<std::thread> pool;
+
+    for ( size_t r = 0; r < threads; ++r ) {
+        pool.push_back( std::thread( [&t, r] {
+            xorshift rng( r + 1 );
+            size_t found = 0;
+
+            for ( size_t i = 0; i < LOOKUPS; ++i ) {
+                found += t.contains( static_cast<int>( rng() % ( 2 * SIZE ) ) );
+            }
+
+            do_not_optimize( found );
+        } ) );
+    }
+
+    for ( size_t p = 0; p < pool.size(); ++p ) {
+        pool[p].join();
+    }
+
+    done.store( true );
+    writer.join();
+}
+
+int main( int argc, char **argv ) {
+    parse_args( argc, argv );
+
+    if ( settings().format == FORMAT_TABLE ) {
+        std::printf( "%u cores\n", std::thread::hardware_concurrency() );
+    }
+
+    report_header();
+
+    //Even numbers, so about half the lookups find something
+    static table_t initial;
+
+    for ( size_t i = 0; i < SIZE; ++i ) {
+        initial.push_back( static_cast<int>( i * 2 ) );
+    }
+
+    static read_mostly_table rm( initial );
+    static locked_table lt( initial );
+#if __cplusplus >= 201402L
+    static shared_locked_table st( initial );
+#endif
+
+    static const size_t THREADS[] = { 1, 2, 4, 8, 16, 32 };
+
+    for ( size_t n = 0; n < sizeof( THREADS ) / sizeof( THREADS[0] ); ++n ) {
+        size_t threads = THREADS[n];
+
+        run( "int", "find_sorted", "read_mostly", threads, [threads] {
+            lookups( rm, threads );
+        }, threads * LOOKUPS );
+
+        run( "int", "find_sorted", "mutex", threads, [threads] {
+            lookups( lt, threads );
+        }, threads * LOOKUPS );
+
+#if __cplusplus >= 201402L
+        run( "int", "find_sorted", "shared_mutex", threads, [threads] {
+            lookups( st, threads );
+        }, threads * LOOKUPS );
+#endif
+    }
+
+    report_footer();
+
+    return 0;
+}
@@ -0,0 +1,49 @@
+/*
+    The ring buffer adapter against the static array adapter, used as a fixed capacity queue.
+
+    "queue" pushes at the back and pops at the front of a half full container,
+    and "insert_middle" inserts and then erases one element in the middle of it.
+*/
+
+#include <data_adapter>
+
+#include <bench/tools.hpp>
+
+using namespace DataAdapter_Bench;
+
+template <typename Adapter>
+static void run( const char *variant ) {
+    static Adapter A;
+
+    size_t n = A.capacity();
+
+    A.clear();
+    A.resize( n / 2, 7 );
+
+    report( "ring", "queue", variant, n, measure( [&] {
+        A.push_back( 1 );
+        do_not_optimize( A.pop_front() );
+    } ) );
+
+    report( "ring", "insert_middle", variant, n, measure( [&] {
+        A.insert( A.begin() + A.length() / 2, 1 );
+        A.erase( A.begin() + A.length() / 2 );
+        do_not_optimize( A.front() );
+    } ) );
+}
+
+int main( int argc, char **argv ) {
+    parse_args( argc, argv );
+
+    report_header();
+
+    run<DataAdapter<int[1024]> >( "array" );
+    run<DataAdapter<da::ring<int, 1024> > >( "ring" );
+
+    run<DataAdapter<int[65536]> >( "array" );
+    run<DataAdapter<da::ring<int, 65536> > >( "ring" );
+
+    report_footer();
+
+    return 0;
+}
@@ -0,0 +1,85 @@
+/*
+    Searches on the contiguous adapters against the std algorithms on the same raw elements.
+
+    "adapter" is find, count, min_element and find_sorted on a DataAdapter<da::dynamic<T> >, which go
+    to the SIMD kernels and the branchless lower_bound in detail/simd.hpp. "std" is std::find and friends
+    over data(). find looks for a value that isn't there, so both scan everything, and find_sorted looks
+    up a different pseudo random value every time, so its branches can't be predicted.
+*/
+
+#include <data_adapter>
+
+#include <algorithm>
+
+#include <bench/tools.hpp>
+
+using namespace DataAdapter_Bench;
+
+template <typename T>
+static void run_searches( const char *type, size_t n ) {
+    typedef DataAdapter<da::dynamic<T> > adapter_t;
+
+    adapter_t A;
+
+    for ( size_t i = 0; i < n; ++i ) {
+        A.push_back( static_cast<T>( i % 1000 ) );
+    }
+
+    const T *first = A.data(), *last = A.data() + n;
+    const T missing = static_cast<T>( -1 );
+
+    run( type, "find", "adapter", n, [&] {
+        do_not_optimize( A.find( missing ) );
+    }, n );
+
+    run( type, "find", "std", n, [&] {
+        do_not_optimize( std::find( first, last, missing ) );
+    }, n );
+
+    run( type, "count", "adapter", n, [&] {
+        do_not_optimize( A.count( static_cast<T>( 7 ) ) );
+    }, n );
+
+    run( type, "count", "std", n, [&] {
+        do_not_optimize( std::count( first, last, static_cast<T>( 7 ) ) );
+    }, n );
+
+    run( type, "min_element", "adapter", n, [&] {
+        do_not_optimize( A.min_element() );
+    }, n );
+
+    run( type, "min_element", "std", n, [&] {
+        do_not_optimize( std::min_element( first, last ) );
+    }, n );
+
+    A.sort();
+
+    size_t r = 1;
+
+    run( type, "find_sorted", "adapter", n, [&] {
+        r = r * 6364136223846793005ull + 1442695040888963407ull;
+        do_not_optimize( A.find_sorted( static_cast<T>( ( r >> 33 ) % 1000 ) ) );
+    } );
+
+    run( type, "find_sorted", "std", n, [&] {
+        r = r * 6364136223846793005ull + 1442695040888963407ull;
+        do_not_optimize( std::lower_bound( first, last, static_cast<T>( ( r >> 33 ) % 1000 ) ) );
+    } );
+}
+
+int main( int argc, char **argv ) {
+    parse_args( argc, argv );
+
+    report_header();
+
+    static const size_t SIZES[] = { 64, 4096, 262144 };
+
+    for ( size_t s = 0; s < sizeof( SIZES ) / sizeof( SIZES[0] ); ++s ) {
+        run_searches<int>( "int", SIZES[s] );
+        run_searches<float>( "float", SIZES[s] );
+    }
+
+    report_footer();
+
+    return 0;
+}
@@ -0,0 +1,47 @@
+/*
+    The small buffer adapter against the dynamic adapter, std::vector and a fixed array,
+    building a short lived container of n ints and throwing it away again, like a per request collection.
+
+    With n up to the inline capacity of 16 the small buffer adapter never allocates, past it it
+    has to spill everything over to the heap once.
+*/
+
+#include <data_adapter>
+
+#include <vector>
+
+#include <bench/tools.hpp>
+
+using namespace DataAdapter_Bench;
+
+template <typename Container>
+static void run_build( const char *variant, size_t n ) {
+    run( "int", "build", variant, n, [&] {
+        Container c;
+
+        for ( size_t i = 0; i < n; ++i ) {
+            c.push_back( static_cast<int>( i ) );
+        }
+
+        do_not_optimize( c.front() );
+    }, n );
+}
+
+int main( int argc, char **argv ) {
+    parse_args( argc, argv );
+
+    report_header();
+
+    static const size_t SIZES[] = { 4, 16, 64, 1024 };
+
+    for ( size_t s = 0; s < sizeof( SIZES ) / sizeof( SIZES[0] ); ++s ) {
+        run_build<DataAdapter<da::small<int, 16> > >( "small<16>", SIZES[s] );
+        run_build<DataAdapter<da::dynamic<int> > >( "dynamic", SIZES[s] );
+        run_build<std::vector<int> >( "std::vector", SIZES[s] );
+        run_build<DataAdapter<int[1024]> >( "int[1024]", SIZES[s] );
+    }
+
+    report_footer();
+
+    return 0;
+}
@@ -0,0 +1,103 @@
+/*
+    Saving and loading a DataAdapter<T[N]> of a million elements as a snapshot (see io/snapshot.hpp), against
+    writing it out with operator<< and reading it back with operator>> through file streams, which is how
+    it would be done without them. The reported time is per element.
+
+    "load_mapped" maps the file and only checks the header, which is all it takes before the elements can be
+    used, and "load_mapped_sum" also adds them all up, which reads every page. The file is in the page cache
+    throughout, so none of these include reading from the disk itself.
+*/
+
+#include <data_adapter>
+
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <string>
+
+#include <bench/tools.hpp>
+
+using namespace DataAdapter_Bench;
+
+static const size_t SIZE = 1 << 20;
+
+template <typename T>
+static void run_snapshots( const char *type ) {
+    typedef DataAdapter<T[SIZE]> adapter_t;
+
+    //Far too big for the stack
+    static adapter_t A, B;
+
+    const char *dir = std::getenv( "TMPDIR" );
+    std::string path = std::string( dir != NULL ? dir : "/tmp" ) + "/data_adapter_bench.snap";
+    std::string text = path + ".txt";
+
+    xorshift rng;
+
+    A.clear();
+
+    for ( size_t i = 0; i < SIZE; ++i ) {
+        A.push_back( static_cast<T>( rng() % 1000000 ) );
+    }
+
+    run( type, "save", "snapshot", SIZE, [&] {
+        da::save( A, path.c_str() );
+    }, SIZE );
+
+    run( type, "save", "ostream", SIZE, [&] {
+        std::ofstream out( text.c_str() );
+        out << A;
+    }, SIZE );
+
+    run( type, "load", "snapshot", SIZE, [&] {
+        da::load( B, path.c_str() );
+        do_not_optimize( B.back() );
+    }, SIZE );
+
+    run( type, "load", "istream", SIZE, [&] {
+        std::ifstream in( text.c_str() );
+        T x;
+
+        B.clear();
+
+        while ( in >> x ) {
+            B.push_back( x );
+        }
+
+        do_not_optimize( B.back() );
+    }, SIZE );
+
+#if DATA_ADAPTER_HAS_MMAP
+    run( type, "load", "load_mapped", SIZE, [&] {
+        da::mapped_snapshot<T> M = da::load_mapped<T>( path.c_str() );
+        do_not_optimize( M.length() );
+    }, SIZE );
+
+    run( type, "load", "load_mapped_sum", SIZE, [&] {
+        da::mapped_snapshot<T> M = da::load_mapped<T>( path.c_str() );
+        T sum = 0;
+
+        for ( typename da::mapped_snapshot<T>::const_iterator it = M.begin(); it != M.end(); ++it ) {
+            sum += *it;
+        }
+
+        do_not_optimize( sum );
+    }, SIZE );
+#endif // DATA_ADAPTER_HAS_MMAP
+
+    std::remove( path.c_str() );
+    std::remove( text.c_str() );
+}
+
+int main( int argc, char **argv ) {
+    parse_args( argc, argv );
+
+    report_header();
+
+    run_snapshots<int>( "int" );
+    run_snapshots<double>( "double" );
+
+    report_footer();
+
+    return 0;
+}
@@ -0,0 +1,102 @@
+/*
+    Columnar scans over a 128 byte record, the structure-of-arrays adapter against the static array adapter
+    holding the same records whole.
+
+    "scan" sums one field over every row, "find" looks a key up by one field, with find_by() against
+    find_if(), and "sort" sorts every row by one field, with sort_by() against std::stable_sort() on the
+    records. Before each sort both copy the same unsorted table back in, which is timed for both. The reported
+    time is per row.
+*/
+
+#include <data_adapter>
+
+#include <algorithm>
+#include <numeric>
+#include <tuple>
+
+#include <bench/tools.hpp>
+
+using namespace DataAdapter_Bench;
+
+static const size_t SIZE = 4096;
+
+typedef unsigned long long u64;
+
+struct record {
+    u64 id, key, price, qty;
+    u64 pad[12];
+};
+
+typedef std::tuple<u64, u64, u64, u64, u64, u64, u64, u64, u64, u64, u64, u64, u64, u64, u64, u64> row_t;
+
+typedef DataAdapter<record[SIZE]> aos_t;
+typedef DataAdapter<da::soa<row_t, SIZE> > soa_t;
+
+static aos_t A, A_unsorted;
+static soa_t S, S_unsorted;
+
+int main( int argc, char **argv ) {
+    parse_args( argc, argv );
+
+    xorshift rng;
+
+    for ( size_t i = 0; i < SIZE; ++i ) {
+        record r = { i, rng() % 1000, rng() % 100, rng() % 10, { 0 } };
+
+        A.push_back( r );
+        S.push_back( row_t( r.id, r.key, r.price, r.qty, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 ) );
+    }
+
+    A_unsorted = A;
+    S_unsorted = S;
+
+    report_header();
+
+    run( "record", "scan", "soa", SIZE, [&] {
+        soa_t::column_view<2> price = S.column<2>();
+
+        do_not_optimize( std::accumulate( price.begin(), price.end(), u64( 0 ) ) );
+    }, SIZE );
+
+    run( "record", "scan", "array", SIZE, [&] {
+        u64 sum = 0;
+
+        for ( aos_t::const_iterator it = A.cbegin(); it != A.cend(); ++it ) {
+            sum += it->price;
+        }
+
+        do_not_optimize( sum );
+    }, SIZE );
+
+    //Looks up the last row, so both walk the whole table
+    run( "record", "find", "soa", SIZE, [&] {
+        do_not_optimize( S.find_by<0>( SIZE - 1 ) );
+    }, SIZE );
+
+    run( "record", "find", "array", SIZE, [&] {
+        do_not_optimize( std::find_if( A.begin(), A.end(), []( const record & r ) {
+            return r.id == SIZE - 1;
+        } ) );
+    }, SIZE );
+
+    run( "record", "sort", "soa", SIZE, [&] {
+        S = S_unsorted;
+        S.sort_by<1>();
+
+        do_not_optimize( S.column<0>()[0] );
+    }, SIZE );
+
+    run( "record", "sort", "array", SIZE, [&] {
+        A = A_unsorted;
+
+        std::stable_sort( A.begin(), A.end(), []( const record & a, const record & b ) {
+            return a.key < b.key;
+        } );
+
+        do_not_optimize( A[0].id );
+    }, SIZE );
+
+    report_footer();
+
+    return 0;
+}
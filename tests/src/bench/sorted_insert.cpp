@@ -0,0 +1,104 @@
+/*
+    Sorted insertion into the static array adapter at several fill levels.
+
+    Each measurement inserts a batch of BATCH random keys into contents that are already
+    filled to the given percentage, and reports the time per inserted key.
+
+    "swap" is the old sorted_insert, push_back and then swapping down one slot at a time,
+    "single" is sorted_insert( element ) in a loop, and "batch" is sorted_insert( first, last ).
+*/
+
+#include <data_adapter>
+
+#include <vector>
+
+#include <bench/tools.hpp>
+
+using namespace DataAdapter_Bench;
+
+static const size_t SIZE = 65536;
+static const size_t BATCH = 1024;
+
+typedef DataAdapter<int[SIZE]> adapter_t;
+
+static adapter_t base, A;
+
+static void swap_insert( adapter_t &a, int n ) {
+    a.push_back( n );
+
+    for ( size_t i = a.length() - 1; i > 0 && a[i] < a[i - 1]; --i ) {
+        std::swap( a[i], a[i - 1] );
+    }
+}
+
+int main( int argc, char **argv ) {
+    parse_args( argc, argv );
+
+    static const int FILL[] = { 10, 50, 90 };
+
+    xorshift rng;
+
+    std::vector<int> keys( BATCH );
+
+    for ( size_t i = 0; i < BATCH; ++i ) {
+        keys[i] = static_cast<int>( rng() >> 33 );
+    }
+
+    report_header();
+
+    for ( size_t f = 0; f < sizeof( FILL ) / sizeof( FILL[0] ); ++f ) {
+        size_t n = SIZE * FILL[f] / 100;
+        char variant[32];
+
+        base.clear();
+
+        for ( size_t i = 0; i < n; ++i ) {
+            base.push_back( static_cast<int>( rng() >> 33 ) );
+        }
+
+        base.sort();
+
+        std::snprintf( variant, sizeof( variant ), "swap_%d%%", FILL[f] );
+
+        //Restoring the contents is included in the time, so it is measured on its own to subtract
+        double reset = measure( [&] {
+            A = base;
+            clobber();
+        } );
+
+        report( "sorted_insert", "per_key", variant, n, ( measure( [&] {
+            A = base;
+
+            for ( size_t i = 0; i < BATCH; ++i ) {
+                swap_insert( A, keys[i] );
+            }
+
+            do_not_optimize( A.back() );
+        } ) - reset ) / BATCH );
+
+        std::snprintf( variant, sizeof( variant ), "single_%d%%", FILL[f] );
+
+        report( "sorted_insert", "per_key", variant, n, ( measure( [&] {
+            A = base;
+
+            for ( size_t i = 0; i < BATCH; ++i ) {
+                A.sorted_insert( keys[i] );
+            }
+
+            do_not_optimize( A.back() );
+        } ) - reset ) / BATCH );
+
+        std::snprintf( variant, sizeof( variant ), "batch_%d%%", FILL[f] );
+
+        report( "sorted_insert", "per_key", variant, n, ( measure( [&] {
+            A = base;
+            A.sorted_insert( keys.begin(), keys.end() );
+
+            do_not_optimize( A.back() );
+        } ) - reset ) / BATCH );
+    }
+
+    report_footer();
+
+    return 0;
+}
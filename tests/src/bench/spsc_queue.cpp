@@ -0,0 +1,194 @@
+/*
+    da::spsc_queue between two threads, against the same hand-off through a DataAdapter<da::ring<T, N> >
+    behind a std::mutex.
+
+    "throughput" moves a million ints from a producer thread to the consumer, one at a time with try_push
+    and try_pop, or 32 at a time with push_n and pop_n, and reports the time per element. "round_trip" sends
+    one element to an echo thread and waits for it to come back, over a queue each way, and reports the
+    time per round trip, which is twice the hand-off latency. Either side yields when it has to wait.
+
+    The numbers only mean something with at least two cores. On one, every hand-off waits for the
+    scheduler to switch threads.
+*/
+
+#include <data_adapter>
+
+#include <cstdio>
+#include <mutex>
+#include <thread>
+
+#include <bench/tools.hpp>
+
+using namespace DataAdapter_Bench;
+
+static const size_t CAPACITY = 1024;
+static const size_t COUNT = 1000000;
+static const size_t TRIPS = 20000;
+static const size_t BATCH = 32;
+
+typedef da::spsc_queue<int, CAPACITY> queue_t;
+
+//The baseline, with the operations the benchmarks need
+class locked_ring {
+    private:
+        std::mutex lock;
+        DataAdapter<da::ring<int, CAPACITY> > ring;
+
+    public:
+        bool try_push( int x ) {
+            std::lock_guard<std::mutex> g( this->lock );
+
+            if ( this->ring.full() ) {
+                return false;
+            }
+
+            this->ring.push_back( x );
+            return true;
+        }
+
+        bool try_pop( int &x ) {
+            std::lock_guard<std::mutex> g( this->lock );
+
+            if ( this->ring.empty() ) {
+                return false;
+            }
+
+            x = this->ring.pop_front();
+            return true;
+        }
+};
+
+template <typename Q>
+static void transfer_single( Q &q ) {
+    std::thread producer( [&q] {
+        for ( size_t i = 0; i < COUNT; ) {
+            if ( q.try_push( static_cast<int>( i ) ) ) {
+                ++i;
+
+            } else {
+                std::this_thread::yield();
+            }
+        }
+    } );
+
+    int x = 0;
+
+    for ( size_t i = 0; i < COUNT; ) {
+        if ( q.try_pop( x ) ) {
+            ++i;
+
+        } else {
+            std::this_thread::yield();
+        }
+    }
+
+    producer.join();
+    do_not_optimize( x );
+}
+
+static void transfer_batched( queue_t &q ) {
+    std::thread producer( [&q] {
+        int batch[BATCH];
+
+        for ( size_t i = 0; i < COUNT; ) {
+            size_t n = COUNT - i < BATCH ? COUNT - i : BATCH;
+
+            for ( size_t j = 0; j < n; ++j ) {
+                batch[j] = static_cast<int>( i + j );
+            }
+
+            size_t pushed = q.push_n( batch, n );
+
+            if ( pushed == 0 ) {
+                std::this_thread::yield();
+            }
+
+            i += pushed;
+        }
+    } );
+
+    int batch[BATCH];
+
+    for ( size_t i = 0; i < COUNT; ) {
+        size_t popped = q.pop_n( batch, BATCH );
+
+        if ( popped == 0 ) {
+            std::this_thread::yield();
+        }
+
+        i += popped;
+    }
+
+    producer.join();
+    do_not_optimize( batch[0] );
+}
+
+template <typename Q>
+static void round_trips( Q &there, Q &back ) {
+    std::thread echo( [&there, &back] {
+        int x;
+
+        for ( size_t i = 0; i < TRIPS; ++i ) {
+            while ( !there.try_pop( x ) ) {
+                std::this_thread::yield();
+            }
+
+            while ( !back.try_push( x ) ) {
+                std::this_thread::yield();
+            }
+        }
+    } );
+
+    int x = 0;
+
+    for ( size_t i = 0; i < TRIPS; ++i ) {
+        while ( !there.try_push( static_cast<int>( i ) ) ) {
+            std::this_thread::yield();
+        }
+
+        while ( !back.try_pop( x ) ) {
+            std::this_thread::yield();
+        }
+    }
+
+    echo.join();
+    do_not_optimize( x );
+}
+
+int main( int argc, char **argv ) {
+    parse_args( argc, argv );
+
+    if ( settings().format == FORMAT_TABLE ) {
+        std::printf( "%u cores\n", std::thread::hardware_concurrency() );
+    }
+
+    report_header();
+
+    //Big enough with the padding that they shouldn't go on the stack
+    static queue_t q, r;
+    static locked_ring lq, lr;
+
+    run( "int", "throughput", "spsc", CAPACITY, [] {
+        transfer_single( q );
+    }, COUNT );
+
+    run( "int", "throughput", "spsc_batch", CAPACITY, [] {
+        transfer_batched( q );
+    }, COUNT );
+
+    run( "int", "throughput", "mutex_ring", CAPACITY, [] {
+        transfer_single( lq );
+    }, COUNT );
+
+    run( "int", "round_trip", "spsc", CAPACITY, [] {
+        round_trips( q, r );
+    }, TRIPS );
+
+    run( "int", "round_trip", "mutex_ring", CAPACITY, [] {
+        round_trips( lq, lr );
+    }, TRIPS );
+
+    report_footer();
+
+    return 0;
+}
@@ -0,0 +1,131 @@
+/*
+    Writing a million elements out as text and reading them back (see io/text.hpp), against operator<< and
+    operator>> through string streams, which is how it would be done without it. The reported time is per
+    element.
+
+    "format" and "parse" convert in memory, to and from one std::string. "write_text" and "read_text" go
+    through a file in chunks, against file streams, with the file in the page cache, so neither includes
+    the disk itself.
+*/
+
+#include <data_adapter>
+
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <limits>
+#include <sstream>
+#include <string>
+
+#if DATA_ADAPTER_HAS_FD_IO
+#include <fcntl.h>
+#include <unistd.h>
+#endif // DATA_ADAPTER_HAS_FD_IO
+
+#include <bench/tools.hpp>
+
+using namespace DataAdapter_Bench;
+
+static const size_t SIZE = 1 << 20;
+
+template <typename T>
+static void run_text( const char *type, T scale ) {
+    typedef DataAdapter<da::dynamic<T> > adapter_t;
+
+    adapter_t A, B;
+
+    const char *dir = std::getenv( "TMPDIR" );
+    std::string path = std::string( dir != NULL ? dir : "/tmp" ) + "/data_adapter_bench.txt";
+
+    xorshift rng;
+
+    A.reserve( SIZE );
+    B.reserve( SIZE );
+
+    for ( size_t i = 0; i < SIZE; ++i ) {
+        A.push_back( static_cast<T>( static_cast<T>( rng() % 2000000 ) / scale ) - static_cast<T>( 1000000 / scale ) );
+    }
+
+    std::string text = da::format( A );
+
+    run( type, "format", "format", SIZE, [&] {
+        std::string s = da::format( A );
+        do_not_optimize( s.size() );
+    }, SIZE );
+
+    run( type, "format", "ostream", SIZE, [&] {
+        std::ostringstream out;
+        out.precision( std::numeric_limits<T>::max_digits10 );
+        out << A;
+        do_not_optimize( out.str().size() );
+    }, SIZE );
+
+    run( type, "parse", "parse_from", SIZE, [&] {
+        B.clear();
+        da::parse_from( B, text );
+        do_not_optimize( B.back() );
+    }, SIZE );
+
+    run( type, "parse", "istream", SIZE, [&] {
+        std::istringstream in( text );
+        T x;
+
+        B.clear();
+
+        while ( in >> x ) {
+            B.push_back( x );
+        }
+
+        do_not_optimize( B.back() );
+    }, SIZE );
+
+#if DATA_ADAPTER_HAS_FD_IO
+    run( type, "write", "write_text", SIZE, [&] {
+        int fd = ::open( path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644 );
+        da::write_text( A, fd );
+        ::close( fd );
+    }, SIZE );
+
+    run( type, "write", "ofstream", SIZE, [&] {
+        std::ofstream out( path.c_str() );
+        out.precision( std::numeric_limits<T>::max_digits10 );
+        out << A;
+    }, SIZE );
+
+    run( type, "read", "read_text", SIZE, [&] {
+        int fd = ::open( path.c_str(), O_RDONLY );
+        B.clear();
+        da::read_text( B, fd );
+        ::close( fd );
+        do_not_optimize( B.back() );
+    }, SIZE );
+
+    run( type, "read", "ifstream", SIZE, [&] {
+        std::ifstream in( path.c_str() );
+        T x;
+
+        B.clear();
+
+        while ( in >> x ) {
+            B.push_back( x );
+        }
+
+        do_not_optimize( B.back() );
+    }, SIZE );
+#endif // DATA_ADAPTER_HAS_FD_IO
+
+    std::remove( path.c_str() );
+}
+
+int main( int argc, char **argv ) {
+    parse_args( argc, argv );
+
+    report_header();
+
+    run_text<int>( "int", 1 );
+    run_text<double>( "double", 7.0 );
+
+    report_footer();
+
+    return 0;
+}